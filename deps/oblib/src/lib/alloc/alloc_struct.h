@@ -220,6 +220,8 @@ struct AObject {
     struct {
       uint16_t in_use_ : 1;
       uint16_t is_large_ : 1;
+      // kept by ObMallocThreadCache, freeing it again must abort
+      uint16_t in_cache_ : 1;
     };
   } __attribute__((packed));
 
@@ -16,6 +16,7 @@
 #include "lib/alloc/alloc_struct.h"
 #include "lib/alloc/object_set.h"
 #include "lib/alloc/memory_sanity.h"
+#include "lib/alloc/ob_malloc_thread_cache.h"
 #include "lib/utility/ob_tracepoint.h"
 #include "lib/allocator/ob_mem_leak_checker.h"
 #include "lib/allocator/ob_page_manager.h"
@@ -161,7 +162,9 @@ void ObMallocAllocator::free(void *ptr)
     abort_unless(block->obj_set_ != NULL);
 
     ObjectSet *set = block->obj_set_;
-    set->free_object(obj);
+    if (!ObMallocThreadCache::free(*set, obj)) {
+      set->free_object(obj);
+    }
   }
 #endif // PERF_MODE
 }
@@ -302,6 +305,24 @@ int64_t ObMallocAllocator::get_tenant_limit(uint64_t tenant_id)
   return limit;
 }
 
+int ObMallocAllocator::set_tenant_numa_node(uint64_t tenant_id, int64_t node)
+{
+  return with_resource_handle_invoke(tenant_id, [node](ObTenantMemoryMgr *mgr) {
+      mgr->set_numa_node(node);
+      return OB_SUCCESS;
+    });
+}
+
+int64_t ObMallocAllocator::get_tenant_numa_node(uint64_t tenant_id)
+{
+  int64_t node = -1;
+  with_resource_handle_invoke(tenant_id, [&node](ObTenantMemoryMgr *mgr) {
+      node = mgr->get_numa_node();
+      return OB_SUCCESS;
+    });
+  return node;
+}
+
 int64_t ObMallocAllocator::get_tenant_hold(uint64_t tenant_id)
 {
   int64_t hold = 0;
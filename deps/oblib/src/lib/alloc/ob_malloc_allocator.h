@@ -58,6 +58,9 @@ public:
   static int64_t get_tenant_limit(uint64_t tenant_id);
   static int64_t get_tenant_hold(uint64_t tenant_id);
   static int64_t get_tenant_remain(uint64_t tenant_id);
+  // chunks of tenant allocated afterwards prefer numa node, -1 to unbind
+  static int set_tenant_numa_node(uint64_t tenant_id, int64_t node);
+  static int64_t get_tenant_numa_node(uint64_t tenant_id);
   int64_t get_tenant_ctx_hold(const uint64_t tenant_id, const uint64_t ctx_id) const;
   void get_tenant_label_usage(uint64_t tenant_id, ObLabel &label, common::ObLabelItem &item) const;
 
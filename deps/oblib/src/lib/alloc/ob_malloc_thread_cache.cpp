@@ -0,0 +1,269 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX LIB
+
+#include "lib/alloc/ob_malloc_thread_cache.h"
+#include <pthread.h>
+#include "lib/alloc/object_set.h"
+#include "lib/alloc/ob_tenant_ctx_allocator.h"
+#include "lib/lock/ob_mutex.h"
+
+using namespace oceanbase::lib;
+using namespace oceanbase::common;
+
+namespace
+{
+const char *const CACHED_LABEL = "MallocTCache";
+
+// caches of all the living threads, used to flush objects of a deleted
+// tenant and to run the flush on thread exit.
+struct CacheRegistry
+{
+  CacheRegistry()
+    : mutex_(ObLatchIds::ALLOC_OBJECT_LOCK), key_(), key_created_(false), head_(nullptr)
+  {
+    mutex_.enable_record_stat(false);
+    key_created_ = 0 == pthread_key_create(&key_, ObMallocThreadCache::destroy_thread_cache);
+  }
+  ObMutex mutex_;
+  pthread_key_t key_;
+  bool key_created_;
+  ObMallocThreadCache *head_;
+};
+} // end of anonymous namespace
+
+static CacheRegistry &get_registry()
+{
+  static CacheRegistry registry;
+  return registry;
+}
+
+int64_t ObMallocThreadCache::max_cache_size_ = 0;
+int64_t ObMallocThreadCache::total_hold_ = 0;
+
+ObMallocThreadCache::ObMallocThreadCache()
+  : lock_(), registered_(false), disabled_(false), hold_(0), prev_(nullptr), next_(nullptr)
+{
+  MEMSET(slots_, 0, sizeof(slots_));
+}
+
+ObMallocThreadCache *ObMallocThreadCache::get_instance()
+{
+  static thread_local ObMallocThreadCache cache;
+  ObMallocThreadCache *ret = &cache;
+  if (OB_UNLIKELY(!cache.registered_)) {
+    if (cache.disabled_) {
+      ret = nullptr;
+    } else {
+      cache.register_self();
+      if (!cache.registered_) {
+        ret = nullptr;
+      }
+    }
+  }
+  return ret;
+}
+
+void ObMallocThreadCache::register_self()
+{
+  CacheRegistry &registry = get_registry();
+  if (!registry.key_created_ || 0 != pthread_setspecific(registry.key_, this)) {
+    disabled_ = true;
+  } else {
+    ObMutexGuard guard(registry.mutex_);
+    next_ = registry.head_;
+    if (nullptr != next_) {
+      next_->prev_ = this;
+    }
+    registry.head_ = this;
+    registered_ = true;
+  }
+}
+
+void ObMallocThreadCache::unregister_self()
+{
+  CacheRegistry &registry = get_registry();
+  ObMutexGuard guard(registry.mutex_);
+  if (registered_) {
+    if (nullptr != prev_) {
+      prev_->next_ = next_;
+    } else {
+      registry.head_ = next_;
+    }
+    if (nullptr != next_) {
+      next_->prev_ = prev_;
+    }
+    prev_ = next_ = nullptr;
+    registered_ = false;
+  }
+}
+
+void ObMallocThreadCache::destroy_thread_cache(void *ptr)
+{
+  ObMallocThreadCache *cache = reinterpret_cast<ObMallocThreadCache*>(ptr);
+  if (OB_NOT_NULL(cache)) {
+    {
+      ObByteLockGuard guard(cache->lock_);
+      // the thread may still free memory after this, never cache again
+      cache->disabled_ = true;
+      for (int64_t i = 0; i < SLOT_CNT; i++) {
+        cache->do_flush(cache->slots_[i]);
+      }
+    }
+    cache->unregister_self();
+  }
+}
+
+AObject *ObMallocThreadCache::alloc(ObTenantCtxAllocator &ta, const int64_t cls)
+{
+  AObject *obj = nullptr;
+  ObMallocThreadCache *cache = get_instance();
+  if (OB_NOT_NULL(cache)) {
+    ObByteLockGuard guard(cache->lock_);
+    Slot &slot = cache->slot_of(&ta);
+    if (slot.ta_ == &ta && nullptr != (obj = slot.lists_[cls])) {
+      slot.lists_[cls] = obj->next_;
+      slot.cnts_[cls]--;
+      obj->in_cache_ = false;
+      cache->hold_ -= size_of(cls);
+      IGNORE_RETURN ATOMIC_FAA(&total_hold_, -size_of(cls));
+    }
+  }
+  return obj;
+}
+
+void ObMallocThreadCache::refill(ObTenantCtxAllocator &ta, const int64_t cls,
+                                 AObject **objs, const int64_t cnt)
+{
+  int64_t pos = 0;
+  ObMallocThreadCache *cache = get_instance();
+  if (OB_NOT_NULL(cache) && cnt > 0) {
+    ObByteLockGuard guard(cache->lock_);
+    if (!cache->disabled_ && !ta.has_tenant_deleted()) {
+      Slot &slot = cache->slot_of(&ta);
+      if (slot.ta_ != &ta) {
+        cache->do_flush(slot);
+        slot.ta_ = &ta;
+      }
+      const int64_t size = size_of(cls);
+      for (; pos < cnt && slot.cnts_[cls] < MAX_CLASS_OBJ_CNT &&
+             cache->hold_ + size <= max_cache_size_; pos++) {
+        AObject *obj = objs[pos];
+        STRNCPY(&obj->label_[0], CACHED_LABEL, sizeof(obj->label_));
+        obj->label_[sizeof(obj->label_) - 1] = '\0';
+        obj->in_cache_ = true;
+        obj->next_ = slot.lists_[cls];
+        slot.lists_[cls] = obj;
+        slot.cnts_[cls]++;
+        cache->hold_ += size;
+      }
+      IGNORE_RETURN ATOMIC_FAA(&total_hold_, pos * size);
+    }
+  }
+  for (; pos < cnt; pos++) {
+    objs[pos]->block()->obj_set_->free_object(objs[pos]);
+  }
+}
+
+bool ObMallocThreadCache::free(ObjectSet &set, AObject *obj)
+{
+  bool cached = false;
+  const int64_t size = obj->alloc_bytes_;
+  if (is_enabled() && set.is_thread_cache_enabled() && !obj->is_large_ &&
+      0 == size % CLASS_SIZE_STEP && size <= MAX_CLASS_SIZE) {
+    ObTenantCtxAllocator &ta = set.get_block_mgr()->get_tenant_ctx_allocator();
+    ObMallocThreadCache *cache = nullptr;
+    if (is_cacheable(ta.get_ctx_id(), size) && OB_NOT_NULL(cache = get_instance())) {
+      ObByteLockGuard guard(cache->lock_);
+      if (!cache->disabled_ && !ta.has_tenant_deleted()) {
+        const int64_t cls = class_of(size);
+        Slot &slot = cache->slot_of(&ta);
+        if (slot.ta_ != &ta) {
+          cache->do_flush(slot);
+          slot.ta_ = &ta;
+        }
+        if (slot.cnts_[cls] >= MAX_CLASS_OBJ_CNT) {
+          cache->do_flush_list(slot, cls, MAX_CLASS_OBJ_CNT / 2);
+        }
+        if (cache->hold_ + size > max_cache_size_) {
+          // the limit may be lowered, give back the whole slot
+          cache->do_flush(slot);
+          slot.ta_ = &ta;
+        }
+        if (cache->hold_ + size <= max_cache_size_) {
+          STRNCPY(&obj->label_[0], CACHED_LABEL, sizeof(obj->label_));
+          obj->label_[sizeof(obj->label_) - 1] = '\0';
+          obj->in_cache_ = true;
+          obj->next_ = slot.lists_[cls];
+          slot.lists_[cls] = obj;
+          slot.cnts_[cls]++;
+          cache->hold_ += size;
+          IGNORE_RETURN ATOMIC_FAA(&total_hold_, size);
+          cached = true;
+        }
+      }
+    }
+  }
+  return cached;
+}
+
+void ObMallocThreadCache::flush(ObTenantCtxAllocator &ta)
+{
+  ObMallocThreadCache *cache = get_instance();
+  if (OB_NOT_NULL(cache)) {
+    ObByteLockGuard guard(cache->lock_);
+    Slot &slot = cache->slot_of(&ta);
+    if (slot.ta_ == &ta) {
+      cache->do_flush(slot);
+    }
+  }
+}
+
+void ObMallocThreadCache::flush_all(ObTenantCtxAllocator &ta)
+{
+  CacheRegistry &registry = get_registry();
+  ObMutexGuard guard(registry.mutex_);
+  for (ObMallocThreadCache *cache = registry.head_; nullptr != cache; cache = cache->next_) {
+    ObByteLockGuard cache_guard(cache->lock_);
+    Slot &slot = cache->slot_of(&ta);
+    if (slot.ta_ == &ta) {
+      cache->do_flush(slot);
+    }
+  }
+}
+
+void ObMallocThreadCache::do_flush(Slot &slot)
+{
+  for (int64_t cls = 0; cls < CLASS_CNT; cls++) {
+    do_flush_list(slot, cls, 0);
+  }
+  slot.ta_ = nullptr;
+}
+
+void ObMallocThreadCache::do_flush_list(Slot &slot, const int64_t cls, const int64_t keep_cnt)
+{
+  const int64_t size = size_of(cls);
+  int64_t flushed = 0;
+  while (slot.cnts_[cls] > keep_cnt) {
+    AObject *obj = slot.lists_[cls];
+    slot.lists_[cls] = obj->next_;
+    slot.cnts_[cls]--;
+    obj->in_cache_ = false;
+    obj->block()->obj_set_->free_object(obj);
+    flushed++;
+  }
+  if (flushed > 0) {
+    hold_ -= flushed * size;
+    IGNORE_RETURN ATOMIC_FAA(&total_hold_, -flushed * size);
+  }
+}
@@ -0,0 +1,128 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef _OB_MALLOC_THREAD_CACHE_H_
+#define _OB_MALLOC_THREAD_CACHE_H_
+
+#include "lib/alloc/alloc_struct.h"
+#include "lib/allocator/ob_mod_define.h"
+#include "lib/atomic/ob_atomic.h"
+#include "lib/lock/ob_small_spin_lock.h"
+
+namespace oceanbase
+{
+namespace lib
+{
+class ObTenantCtxAllocator;
+class ObjectSet;
+
+// Per-thread free lists of small objects in front of ObjectMgr.
+//
+// Objects cached are taken from ObjectMgr with their size rounded up
+// to a size class, so an object can be handed to any request of the
+// same class without touching the object set and its lock. They stay
+// in use in their object set while cached, which keeps them charged to
+// the tenant ctx they come from, and are marked in_cache_ so that the
+// magic check of a second free aborts as it does for a freed object.
+//
+// A thread caches objects of at most SLOT_CNT tenant ctx allocators,
+// slots are selected by allocator address and a slot is flushed when
+// another allocator takes it. All the cached objects are given back on
+// thread exit, and objects of one allocator are given back from every
+// thread when its tenant is deleted.
+class ObMallocThreadCache
+{
+public:
+  static const int64_t SLOT_CNT = 16;
+  static const int64_t CLASS_SIZE_STEP = 32;
+  static const int64_t CLASS_CNT = 32;
+  static const int64_t MAX_CLASS_SIZE = CLASS_CNT * CLASS_SIZE_STEP;
+  static const int64_t MAX_CLASS_OBJ_CNT = 64;
+  static const int64_t BATCH_CNT = 8;
+private:
+  struct Slot
+  {
+    ObTenantCtxAllocator *ta_;
+    AObject *lists_[CLASS_CNT];
+    int32_t cnts_[CLASS_CNT];
+  };
+public:
+  // max bytes cached by one thread, 0 disables caching.
+  static void set_max_cache_size(const int64_t size)
+  { ATOMIC_STORE(&max_cache_size_, size); }
+  static int64_t get_max_cache_size() { return ATOMIC_LOAD(&max_cache_size_); }
+  static int64_t get_total_hold() { return ATOMIC_LOAD(&total_hold_); }
+  OB_INLINE static bool is_enabled()
+  {
+#ifndef ENABLE_SANITY
+    return max_cache_size_ > 0;
+#else
+    // cached objects are written through while poisoned
+    return false;
+#endif
+  }
+  OB_INLINE static bool is_cacheable(const uint64_t ctx_id, const int64_t size)
+  {
+    return size > 0 && size <= MAX_CLASS_SIZE &&
+        common::ObCtxIds::LOGGER_CTX_ID != ctx_id && common::ObCtxIds::LIBEASY != ctx_id;
+  }
+  OB_INLINE static int64_t class_of(const int64_t size)
+  {
+    return (size - 1) / CLASS_SIZE_STEP;
+  }
+  OB_INLINE static int64_t size_of(const int64_t cls)
+  {
+    return (cls + 1) * CLASS_SIZE_STEP;
+  }
+
+  // return nullptr if nothing cached, the object returned keeps the
+  // label it had when cached.
+  static AObject *alloc(ObTenantCtxAllocator &ta, const int64_t cls);
+  // refill the list of cls with objs, objs[0] is kept by caller.
+  static void refill(ObTenantCtxAllocator &ta, const int64_t cls, AObject **objs, const int64_t cnt);
+  // return false if obj is not cached and should be freed to its set.
+  static bool free(ObjectSet &set, AObject *obj);
+
+  // give back objects of ta cached by current thread
+  static void flush(ObTenantCtxAllocator &ta);
+  // give back objects of ta cached by all threads
+  static void flush_all(ObTenantCtxAllocator &ta);
+  // destructor of the pthread key, flushes the cache of exiting thread
+  static void destroy_thread_cache(void *ptr);
+private:
+  ObMallocThreadCache();
+  static ObMallocThreadCache *get_instance();
+  void do_flush(Slot &slot);
+  void do_flush_list(Slot &slot, const int64_t cls, const int64_t keep_cnt);
+  OB_INLINE Slot &slot_of(const ObTenantCtxAllocator *ta)
+  {
+    return slots_[(reinterpret_cast<uint64_t>(ta) >> 6) % SLOT_CNT];
+  }
+  void register_self();
+  void unregister_self();
+private:
+  static int64_t max_cache_size_;
+  static int64_t total_hold_;
+  common::ObByteLock lock_;
+  bool registered_;
+  bool disabled_;
+  int64_t hold_;
+  ObMallocThreadCache *prev_;
+  ObMallocThreadCache *next_;
+  Slot slots_[SLOT_CNT];
+  DISALLOW_COPY_AND_ASSIGN(ObMallocThreadCache);
+};
+
+} // end of namespace lib
+} // end of namespace oceanbase
+
+#endif /* _OB_MALLOC_THREAD_CACHE_H_ */
@@ -17,6 +17,7 @@
 #include "lib/utility/ob_print_utils.h"
 #include "lib/alloc/memory_dump.h"
 #include "lib/alloc/memory_sanity.h"
+#include "lib/alloc/ob_malloc_thread_cache.h"
 #include "lib/oblog/ob_log.h"
 #include "common/ob_smart_var.h"
 #include "rpc/obrpc/ob_rpc_packet.h"
@@ -27,6 +28,7 @@ using namespace oceanbase::common;
 void ObTenantCtxAllocator::set_tenant_deleted()
 {
   ATOMIC_STORE(&has_deleted_, true);
+  ObMallocThreadCache::flush_all(*this);
   set_idle(0);
 }
 
@@ -37,7 +39,12 @@ void *ObTenantCtxAllocator::alloc(const int64_t size, const ObMemAttr &attr)
   abort_unless(attr.ctx_id_ == ctx_id_);
   BACKTRACE(WARN, !attr.label_.is_valid(), "[OB_MOD_DO_NOT_USE_ME ALLOC]size:%ld", size);
   void *ptr = NULL;
-  AObject *obj = obj_mgr_.alloc_object(size, attr);
+  AObject *obj = NULL;
+  if (ObMallocThreadCache::is_enabled() && ObMallocThreadCache::is_cacheable(ctx_id_, size)) {
+    obj = alloc_cached_object(size, attr);
+  } else {
+    obj = obj_mgr_.alloc_object(size, attr);
+  }
   if(OB_ISNULL(obj) && g_alloc_failed_ctx().need_wash()) {
     int64_t total_size = sync_wash();
     obj = obj_mgr_.alloc_object(size, attr);
@@ -61,6 +68,30 @@ void *ObTenantCtxAllocator::alloc(const int64_t size, const ObMemAttr &attr)
   return ptr;
 }
 
+AObject *ObTenantCtxAllocator::alloc_cached_object(const int64_t size, const ObMemAttr &attr)
+{
+  const int64_t cls = ObMallocThreadCache::class_of(size);
+  AObject *obj = ObMallocThreadCache::alloc(*this, cls);
+  if (OB_NOT_NULL(obj)) {
+    if (attr.label_.str_ != nullptr) {
+      STRNCPY(&obj->label_[0], attr.label_.str_, sizeof(obj->label_));
+      obj->label_[sizeof(obj->label_) - 1] = '\0';
+    } else {
+      obj->label_[0] = '\0';
+    }
+  } else {
+    // take a batch under one lock, the rest refills the thread cache
+    AObject *objs[ObMallocThreadCache::BATCH_CNT];
+    const int64_t cnt = obj_mgr_.alloc_objects(ObMallocThreadCache::size_of(cls), attr,
+                                               objs, ObMallocThreadCache::BATCH_CNT);
+    if (cnt > 0) {
+      obj = objs[0];
+      ObMallocThreadCache::refill(*this, cls, objs + 1, cnt - 1);
+    }
+  }
+  return obj;
+}
+
 int64_t ObTenantCtxAllocator::get_obj_hold(void *ptr)
 {
   AObject *obj = reinterpret_cast<AObject*>((char*)(ptr) - AOBJECT_HEADER_SIZE);
@@ -115,7 +146,9 @@ void ObTenantCtxAllocator::free(void *ptr)
                  || obj->MAGIC_CODE_ == BIG_AOBJECT_MAGIC_CODE);
     abort_unless(obj->in_use_);
     SANITY_POISON(obj->data_, obj->alloc_bytes_);
-    obj_mgr_.free_object(obj);
+    if (!ObMallocThreadCache::free(*obj->block()->obj_set_, obj)) {
+      obj_mgr_.free_object(obj);
+    }
   }
 }
 int ObTenantCtxAllocator::iter_label(VisitFunc func) const
@@ -431,6 +464,8 @@ int64_t ObTenantCtxAllocator::sync_wash(int64_t wash_size)
 {
   int64_t washed_size = 0;
 
+  // objects cached by any thread keep their blocks from being washed
+  ObMallocThreadCache::flush_all(*this);
   auto stat = obj_mgr_.get_stat();
   const double min_utilization = 0.9;
   if (stat.payload_ * min_utilization > stat.used_) {
@@ -174,6 +174,7 @@ public:
   void update_wash_stat(int64_t related_chunks, int64_t blocks, int64_t size);
 private:
   void print_usage() const;
+  AObject *alloc_cached_object(const int64_t size, const ObMemAttr &attr);
   AChunk *pop_chunk();
   void push_chunk(AChunk *chunk);
   int with_resource_handle_invoke(InvokeFunc func) const
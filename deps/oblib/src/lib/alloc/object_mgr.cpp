@@ -27,6 +27,7 @@ SubObjectMgr::SubObjectMgr(const bool for_logger)
   bs_.set_locker(&locker_);
   os_.set_locker(&locker_);
   os_.set_block_mgr(this);
+  os_.set_thread_cache_enabled(!for_logger);
 #ifndef ENABLE_SANITY
   mutex_.enable_record_stat(false);
 #endif
@@ -122,6 +123,30 @@ AObject *ObjectMgr::alloc_object(uint64_t size, const ObMemAttr &attr)
   return obj;
 }
 
+int64_t ObjectMgr::alloc_objects(uint64_t size, const ObMemAttr &attr, AObject **objs, const int64_t cnt)
+{
+  int64_t alloc_cnt = 0;
+  const uint64_t start = common::get_itid();
+  SubObjectMgr *sub_mgr = nullptr;
+  for (uint64_t i = 0; 0 == alloc_cnt && i < ATOMIC_LOAD(&sub_cnt_); i++) {
+    uint64_t idx = (start + i) % sub_cnt_;
+    sub_mgr = ATOMIC_LOAD(&sub_mgrs_[idx]);
+    if (OB_ISNULL(sub_mgr)) {
+      // do nothing
+    } else if (sub_mgr->trylock()) {
+      AObject *obj = nullptr;
+      while (alloc_cnt < cnt && OB_NOT_NULL(obj = sub_mgr->alloc_object(size, attr))) {
+        objs[alloc_cnt++] = obj;
+      }
+      sub_mgr->unlock();
+    }
+  }
+  if (0 == alloc_cnt && OB_NOT_NULL(objs[0] = alloc_object(size, attr))) {
+    alloc_cnt = 1;
+  }
+  return alloc_cnt;
+}
+
 AObject *ObjectMgr::realloc_object(
     AObject *obj, const uint64_t size, const ObMemAttr &attr)
 {
@@ -94,6 +94,8 @@ public:
   void reset();
 
   AObject *alloc_object(uint64_t size, const ObMemAttr &attr);
+  // alloc at most cnt objects of size under one lock, return the count
+  int64_t alloc_objects(uint64_t size, const ObMemAttr &attr, AObject **objs, const int64_t cnt);
   AObject *realloc_object(
       AObject *obj, const uint64_t size, const ObMemAttr &attr);
   void free_object(AObject *obj);
@@ -35,7 +35,7 @@ void __attribute__((weak)) has_unfree_callback(char *info)
 }
 
 ObjectSet::ObjectSet(__MemoryContext__ *mem_context, const uint32_t ablock_size)
-  : check_unfree_(false), mem_context_(mem_context), locker_(nullptr),
+  : check_unfree_(false), enable_thread_cache_(false), mem_context_(mem_context), locker_(nullptr),
     blk_mgr_(nullptr), blist_(NULL), last_remainder_(NULL),
     bm_(NULL), free_lists_(NULL),
     dirty_list_mutex_(common::ObLatchIds::ALLOC_OBJECT_LOCK), dirty_list_(nullptr), dirty_objs_(0),
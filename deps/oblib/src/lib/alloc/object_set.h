@@ -70,6 +70,9 @@ public:
   inline int64_t get_normal_used() const;
   inline int64_t get_normal_alloc() const;
   void set_check_unfree(bool check_unfree) { check_unfree_ = check_unfree; }
+  // objects of the set may be kept by ObMallocThreadCache when freed
+  void set_thread_cache_enabled(bool enabled) { enable_thread_cache_ = enabled; }
+  bool is_thread_cache_enabled() const { return enable_thread_cache_; }
 
 private:
   AObject *alloc_normal_object(const uint32_t cls, const ObMemAttr &attr);
@@ -95,6 +98,7 @@ private:
 
 private:
   bool check_unfree_;
+  bool enable_thread_cache_;
   __MemoryContext__ *mem_context_;
   ISetLocker *locker_;
   IBlockMgr *blk_mgr_;
@@ -105,7 +105,8 @@ int ObZstdCompressor_1_3_8::compress(const char *src_buffer,
                                           static_cast<size_t>(src_data_size),
                                           dst_buffer,
                                           static_cast<size_t>(dst_buffer_size),
-                                          compress_ret_size))) {
+                                          compress_ret_size,
+                                          static_cast<int>(compress_level_)))) {
     LIB_LOG(WARN, "failed to compress zstd", K(ret), K(compress_ret_size));
   } else {
     dst_data_size = compress_ret_size;
@@ -161,6 +162,19 @@ void ObZstdCompressor_1_3_8::reset_mem()
   }
 }
 
+int ObZstdCompressor_1_3_8::set_compress_level(const int64_t compress_level)
+{
+  int ret = OB_SUCCESS;
+  if (compress_level < ObZstdWrapper::MIN_COMPRESS_LEVEL
+      || compress_level > ObZstdWrapper::MAX_COMPRESS_LEVEL) {
+    ret = OB_INVALID_ARGUMENT;
+    LIB_LOG(WARN, "invalid argument, ", K(ret), K(compress_level));
+  } else {
+    compress_level_ = compress_level;
+  }
+  return ret;
+}
+
 const char *ObZstdCompressor_1_3_8::get_compressor_name() const
 {
   return all_compressor_name[ObCompressorType::ZSTD_1_3_8_COMPRESSOR];
@@ -39,7 +39,7 @@ private:
 class __attribute__((visibility ("default"))) ObZstdCompressor_1_3_8 : public ObCompressor
 {
 public:
-  explicit ObZstdCompressor_1_3_8() {}
+  explicit ObZstdCompressor_1_3_8(int64_t compress_level = 1) : compress_level_(compress_level) {}
   virtual ~ObZstdCompressor_1_3_8() {}
   int compress(const char *src_buffer,
                const int64_t src_data_size,
@@ -56,7 +56,10 @@ public:
   int get_max_overflow_size(const int64_t src_data_size,
                             int64_t &max_overflow_size) const;
   void reset_mem();
+  int set_compress_level(const int64_t compress_level);
 
+private:
+  int64_t compress_level_;
 };
 } // namespace zstd_1_3_8
 } //namespace common
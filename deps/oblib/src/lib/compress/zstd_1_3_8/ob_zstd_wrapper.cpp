@@ -27,7 +27,7 @@ constexpr int OB_ERR_COMPRESS_DECOMPRESS_DATA        = -4257;
 constexpr int OB_IO_ERROR                            = -4009;
 constexpr int OB_ZSTD_VERSION_138                    = 138;
 
-static const int OB_ZSTD_COMPRESS_LEVEL = 1;
+static const int OB_ZSTD_COMPRESS_LEVEL = ObZstdWrapper::DEFAULT_COMPRESS_LEVEL;
 
 int ObZstdWrapper::compress(
     OB_ZSTD_customMem &ob_zstd_mem,
@@ -35,7 +35,8 @@ int ObZstdWrapper::compress(
     const size_t src_data_size,
     char *dst_buffer,
     const size_t dst_buffer_size,
-    size_t &compress_ret_size)
+    size_t &compress_ret_size,
+    const int compress_level)
 {
   int ret = OB_SUCCESS;
   ZSTD_CCtx *zstd_cctx = NULL;
@@ -48,10 +49,12 @@ int ObZstdWrapper::compress(
   if (NULL == src_buffer
       || 0 >= src_data_size
       || NULL == dst_buffer
-      || 0 >= dst_buffer_size) {
+      || 0 >= dst_buffer_size
+      || compress_level < MIN_COMPRESS_LEVEL
+      || compress_level > MAX_COMPRESS_LEVEL) {
     ret = OB_INVALID_ARGUMENT;
-    fprintf(stderr, __FILE__ ": invalid args, ret=%d src_buffer=%p src_data_size=%lu dst_buffer=%p dst_buffer_size=%lu\n",
-          ret, src_buffer, src_data_size, dst_buffer, dst_buffer_size);
+    fprintf(stderr, __FILE__ ": invalid args, ret=%d src_buffer=%p src_data_size=%lu dst_buffer=%p dst_buffer_size=%lu compress_level=%d\n",
+          ret, src_buffer, src_data_size, dst_buffer, dst_buffer_size, compress_level);
   } else if (NULL == (zstd_cctx = ZSTD_createCCtx_advanced(zstd_mem))) {
     ret = OB_ALLOCATE_MEMORY_FAILED;
     fprintf(stderr, __FILE__ ": failed to create cctx\n");
@@ -61,12 +64,12 @@ int ObZstdWrapper::compress(
                                           dst_buffer_size,
                                           src_buffer,
                                           src_data_size,
-                                          OB_ZSTD_COMPRESS_LEVEL,
+                                          compress_level,
                                           &zstd_version);
     if (0 != ZSTD_isError(compress_ret_size)) {
       ret = OB_ERR_COMPRESS_DECOMPRESS_DATA;
       fprintf(stderr, __FILE__ ": fail to compress data, ret=%d compress_ret_size=%lu src_buffer=%p src_data_size=%lu  dst_buffer=%p dst_buffer_size=%lu compress_level=%d\n",
-          ret, compress_ret_size, src_buffer, src_data_size, dst_buffer, dst_buffer_size, OB_ZSTD_COMPRESS_LEVEL);
+          ret, compress_ret_size, src_buffer, src_data_size, dst_buffer, dst_buffer_size, compress_level);
     } else if (OB_ZSTD_VERSION_138 != zstd_version) {
       ret = OB_IO_ERROR;
       fprintf(stderr, __FILE__ ": invalid ZSTD_compressCCtx version, ret=%d lib version=%d expect version=%d",
@@ -33,6 +33,9 @@ typedef struct { OB_ZSTD_allocFunction customAlloc; OB_ZSTD_freeFunction customF
 class OB_PUBLIC_API ObZstdWrapper final
 {
 public:
+  static const int DEFAULT_COMPRESS_LEVEL = 1;
+  static const int MIN_COMPRESS_LEVEL = 1;
+  static const int MAX_COMPRESS_LEVEL = 22;
   // for normal
   static int compress(
       OB_ZSTD_customMem &zstd_mem,
@@ -40,7 +43,8 @@ public:
       const size_t src_data_size,
       char *dst_buffer,
       const size_t dst_buffer_size,
-      size_t &compress_ret_size);
+      size_t &compress_ret_size,
+      const int compress_level = DEFAULT_COMPRESS_LEVEL);
   static int decompress(
       OB_ZSTD_customMem &zstd_mem,
       const char *src_buffer,
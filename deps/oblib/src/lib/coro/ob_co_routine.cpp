@@ -0,0 +1,182 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX LIB
+#include "lib/coro/ob_co_routine.h"
+#include "lib/oblog/ob_log.h"
+#include "lib/thread/protected_stack_allocator.h"
+#include "common/ob_common_utility.h"
+#include "common/ob_smart_call.h"
+
+using namespace oceanbase::common;
+
+namespace oceanbase
+{
+namespace lib
+{
+
+__thread ObCoRoutine *ObCoRoutine::current_ = nullptr;
+
+ObCoRoutine::ObCoRoutine()
+  : stack_(nullptr),
+    stack_size_(0),
+    func_(nullptr),
+    arg_(nullptr),
+    state_(CO_IDLE),
+    stack_addr_(nullptr),
+    stack_attr_size_(0),
+    all_stack_size_(0),
+    caller_stack_addr_(nullptr),
+    caller_stack_attr_size_(0),
+    caller_all_stack_size_(0)
+{
+  MEMSET(&ctx_, 0, sizeof(ctx_));
+  MEMSET(&caller_ctx_, 0, sizeof(caller_ctx_));
+}
+
+ObCoRoutine::~ObCoRoutine()
+{
+  destroy();
+}
+
+int ObCoRoutine::init(const uint64_t tenant_id, const int64_t stack_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_NOT_NULL(stack_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("coroutine has been inited", K(ret));
+  } else if (OB_UNLIKELY(stack_size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid stack size", K(ret), K(stack_size));
+  } else if (OB_ISNULL(stack_ = g_stack_allocer.alloc(tenant_id, stack_size))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc coroutine stack failed", K(ret), K(tenant_id), K(stack_size));
+  } else {
+    stack_size_ = stack_size;
+    state_ = CO_IDLE;
+  }
+  return ret;
+}
+
+void ObCoRoutine::destroy()
+{
+  if (OB_NOT_NULL(stack_)) {
+    // objects on a suspended stack would never be destructed, the
+    // owner should drive it to the end before destroying.
+    if (OB_UNLIKELY(CO_RUNNING == state_ || CO_SUSPENDED == state_)) {
+      LOG_ERROR("destroy unfinished coroutine", K(*this));
+    }
+    g_stack_allocer.dealloc(stack_);
+    stack_ = nullptr;
+  }
+  stack_size_ = 0;
+  func_ = nullptr;
+  arg_ = nullptr;
+  state_ = CO_IDLE;
+}
+
+int ObCoRoutine::start(Func func, void *arg)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(stack_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("coroutine not init", K(ret));
+  } else if (OB_ISNULL(func)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid coroutine function", K(ret));
+  } else if (OB_UNLIKELY(CO_IDLE != state_ && CO_FINISHED != state_)) {
+    ret = OB_STATE_NOT_MATCH;
+    LOG_WARN("coroutine is busy", K(ret), K(*this));
+  } else if (OB_UNLIKELY(0 != getcontext(&ctx_))) {
+    ret = OB_ERR_SYS;
+    LOG_WARN("getcontext failed", K(ret), K(errno));
+  } else {
+    const uint64_t self = reinterpret_cast<uint64_t>(this);
+    ctx_.uc_stack.ss_sp = stack_;
+    ctx_.uc_stack.ss_size = stack_size_;
+    ctx_.uc_link = nullptr;
+    makecontext(&ctx_, (void (*)())entry, 2,
+                static_cast<uint32_t>(self), static_cast<uint32_t>(self >> 32));
+    func_ = func;
+    arg_ = arg;
+    stack_addr_ = stack_;
+    stack_attr_size_ = stack_size_;
+    all_stack_size_ = 0;
+    state_ = CO_READY;
+  }
+  return ret;
+}
+
+int ObCoRoutine::resume()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_runnable())) {
+    ret = OB_STATE_NOT_MATCH;
+    LOG_WARN("coroutine is not runnable", K(ret), K(*this));
+  } else if (OB_NOT_NULL(current_)) {
+    // nested coroutine is not supported
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("resume coroutine inside coroutine", K(ret), K(*this), KPC(current_));
+  } else {
+    switch_in();
+    if (OB_UNLIKELY(0 != swapcontext(&caller_ctx_, &ctx_))) {
+      ret = OB_ERR_SYS;
+      LOG_ERROR("swapcontext failed", K(ret), K(errno));
+      switch_out();
+      state_ = CO_FINISHED;
+    }
+  }
+  return ret;
+}
+
+void ObCoRoutine::yield()
+{
+  abort_unless(this == current_);
+  switch_out();
+  state_ = CO_SUSPENDED;
+  abort_unless(0 == swapcontext(&ctx_, &caller_ctx_));
+}
+
+void ObCoRoutine::switch_in()
+{
+  IGNORE_RETURN get_stackattr(caller_stack_addr_, caller_stack_attr_size_);
+  caller_all_stack_size_ = all_stack_size;
+  set_stackattr(stack_addr_, stack_attr_size_);
+  all_stack_size = all_stack_size_;
+  current_ = this;
+  state_ = CO_RUNNING;
+}
+
+void ObCoRoutine::switch_out()
+{
+  IGNORE_RETURN get_stackattr(stack_addr_, stack_attr_size_);
+  all_stack_size_ = all_stack_size;
+  set_stackattr(caller_stack_addr_, caller_stack_attr_size_);
+  all_stack_size = caller_all_stack_size_;
+  current_ = nullptr;
+}
+
+void ObCoRoutine::entry(uint32_t low, uint32_t high)
+{
+  ObCoRoutine *co = reinterpret_cast<ObCoRoutine*>(
+      static_cast<uint64_t>(low) | (static_cast<uint64_t>(high) << 32));
+  co->func_(co->arg_);
+  co->func_ = nullptr;
+  co->arg_ = nullptr;
+  co->switch_out();
+  co->state_ = CO_FINISHED;
+  // never come back unless restarted, which makes a new context
+  setcontext(&co->caller_ctx_);
+}
+
+} // end of namespace lib
+} // end of namespace oceanbase
@@ -0,0 +1,103 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_LIB_CORO_OB_CO_ROUTINE_H_
+#define OCEANBASE_LIB_CORO_OB_CO_ROUTINE_H_
+
+#include <ucontext.h>
+#include <stdint.h>
+#include "lib/utility/ob_macro_utils.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace lib
+{
+
+// Stackful coroutine bound to the thread which resumes it.
+//
+// The coroutine is switched in explicitly by resume() and gives the
+// cpu back by yield() from inside; it never migrates between threads.
+// Stack is allocated from g_stack_allocer so that it has a guard page
+// and shows up in the stack manager like a thread stack does.
+//
+// Thread-local stack attributes used by check_stack_overflow() and
+// SMART_CALL are switched together with the context, other thread
+// local states are up to the caller.
+class ObCoRoutine
+{
+public:
+  typedef void (*Func)(void *arg);
+  enum State
+  {
+    CO_IDLE = 0,    // no function bound
+    CO_READY,       // function bound, never run
+    CO_RUNNING,
+    CO_SUSPENDED,   // yielded, waiting for resume
+    CO_FINISHED,    // function returned
+  };
+
+public:
+  ObCoRoutine();
+  ~ObCoRoutine();
+
+  int init(const uint64_t tenant_id, const int64_t stack_size);
+  void destroy();
+
+  // Bind function to the coroutine, only allowed in IDLE or FINISHED.
+  int start(Func func, void *arg);
+  // Switch into the coroutine, return when it yields or finishes.
+  int resume();
+  // Called inside the coroutine, switch back to the resumer.
+  void yield();
+
+  State get_state() const { return state_; }
+  bool is_inited() const { return nullptr != stack_; }
+  bool is_suspended() const { return CO_SUSPENDED == state_; }
+  bool is_runnable() const { return CO_READY == state_ || CO_SUSPENDED == state_; }
+
+  // Coroutine running on current thread, nullptr if not in any.
+  static ObCoRoutine *current() { return current_; }
+
+  TO_STRING_KV(KP_(stack), K_(stack_size), K_(state));
+
+private:
+  static void entry(uint32_t low, uint32_t high);
+  void switch_in();
+  void switch_out();
+
+private:
+  static __thread ObCoRoutine *current_;
+
+  ucontext_t ctx_;
+  ucontext_t caller_ctx_;
+  void *stack_;
+  int64_t stack_size_;
+  Func func_;
+  void *arg_;
+  State state_;
+  // stack attributes of the coroutine and its resumer, maybe changed
+  // by SMART_CALL before yield.
+  void *stack_addr_;
+  size_t stack_attr_size_;
+  int64_t all_stack_size_;
+  void *caller_stack_addr_;
+  size_t caller_stack_attr_size_;
+  int64_t caller_all_stack_size_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObCoRoutine);
+};
+
+} // end of namespace lib
+} // end of namespace oceanbase
+
+#endif /* OCEANBASE_LIB_CORO_OB_CO_ROUTINE_H_ */
@@ -13,9 +13,13 @@
 #include "lib/cpu/ob_cpu_topology.h"
 
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <pthread.h>
+#include <unistd.h>
+#include <sys/syscall.h>
 #include "lib/ob_define.h"
+#include "lib/oblog/ob_log.h"
 
 using namespace oceanbase::common;
 
@@ -26,6 +30,143 @@ int64_t __attribute__((weak)) get_cpu_count()
 {
   return get_cpu_num();
 }
+
+ObNumaTopology &ObNumaTopology::instance()
+{
+  static ObNumaTopology topology;
+  return topology;
+}
+
+ObNumaTopology::ObNumaTopology()
+  : node_cnt_(0)
+{
+  load();
+}
+
+void ObNumaTopology::load()
+{
+  MEMSET(cpu_nodes_, -1, sizeof(cpu_nodes_));
+  for (int64_t node = 0; node < MAX_NUMA_NODE_CNT; ++node) {
+    CPU_ZERO(&node_cpus_[node]);
+  }
+  node_cnt_ = 0;
+  char path[128];
+  char cpu_list[4096];
+  bool node_exist = true;
+  // node id is contiguous when all nodes are online, stop at the first missing node
+  for (int64_t node = 0; node_exist && node < MAX_NUMA_NODE_CNT; ++node) {
+    FILE *file = nullptr;
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%ld/cpulist", node);
+    if (nullptr == (file = fopen(path, "r"))) {
+      node_exist = false;
+    } else {
+      if (nullptr != fgets(cpu_list, sizeof(cpu_list), file)
+          && OB_SUCCESS == parse_cpu_list(cpu_list, node_cpus_[node])) {
+        for (int64_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+          if (CPU_ISSET(cpu, &node_cpus_[node])) {
+            cpu_nodes_[cpu] = static_cast<int8_t>(node);
+          }
+        }
+        ++node_cnt_;
+      } else {
+        node_exist = false;
+      }
+      fclose(file);
+    }
+  }
+  if (0 == node_cnt_) {
+    node_cnt_ = 1;
+    for (int64_t cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+      cpu_nodes_[cpu] = 0;
+      CPU_SET(cpu, &node_cpus_[0]);
+    }
+  }
+  _OB_LOG(INFO, "numa topology loaded, node_cnt=%ld", node_cnt_);
+}
+
+// cpu list format: "0-15,32-47"
+int ObNumaTopology::parse_cpu_list(const char *cpu_list, cpu_set_t &cpus)
+{
+  int ret = OB_SUCCESS;
+  const char *pos = cpu_list;
+  CPU_ZERO(&cpus);
+  while (OB_SUCC(ret) && nullptr != pos && *pos >= '0' && *pos <= '9') {
+    char *end = nullptr;
+    const int64_t begin_cpu = strtol(pos, &end, 10);
+    int64_t end_cpu = begin_cpu;
+    if ('-' == *end) {
+      end_cpu = strtol(end + 1, &end, 10);
+    }
+    if (begin_cpu < 0 || end_cpu < begin_cpu || end_cpu >= CPU_SETSIZE) {
+      ret = OB_INVALID_DATA;
+    } else {
+      for (int64_t cpu = begin_cpu; cpu <= end_cpu; ++cpu) {
+        CPU_SET(cpu, &cpus);
+      }
+      pos = (',' == *end) ? end + 1 : nullptr;
+    }
+  }
+  if (OB_SUCC(ret) && 0 == CPU_COUNT(&cpus)) {
+    ret = OB_INVALID_DATA;
+  }
+  return ret;
+}
+
+int64_t ObNumaTopology::get_cpu_node(const int64_t cpu_id) const
+{
+  return (cpu_id >= 0 && cpu_id < CPU_SETSIZE) ? cpu_nodes_[cpu_id] : -1;
+}
+
+int ObNumaTopology::bind_thread_to_node(const int64_t node) const
+{
+  int ret = OB_SUCCESS;
+  int sys_ret = 0;
+  if (OB_UNLIKELY(node < 0 || node >= node_cnt_)) {
+    ret = OB_INVALID_ARGUMENT;
+    _OB_LOG(WARN, "invalid numa node, ret=%d, node=%ld, node_cnt=%ld", ret, node, node_cnt_);
+  } else if (0 != (sys_ret = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &node_cpus_[node]))) {
+    ret = OB_ERR_SYS;
+    _OB_LOG(WARN, "bind thread to numa node failed, ret=%d, node=%ld, errno=%d", ret, node, sys_ret);
+  }
+  return ret;
+}
+
+int ObNumaTopology::bind_memory_to_node(void *addr, const int64_t size, const int64_t node) const
+{
+  int ret = OB_SUCCESS;
+  // same as MPOL_PREFERRED in <numaif.h>, falls back to other nodes
+  // instead of failing when the node is short of memory.
+  static const int MPOL_PREFERRED_MODE = 1;
+  unsigned long node_mask[MAX_NUMA_NODE_CNT / 64] = {0};
+  if (OB_UNLIKELY(node < 0 || node >= node_cnt_ || nullptr == addr || size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    _OB_LOG(WARN, "invalid argument, ret=%d, node=%ld, node_cnt=%ld, addr=%p, size=%ld",
+            ret, node, node_cnt_, addr, size);
+  } else if (FALSE_IT(node_mask[node / 64] |= 1UL << (node % 64))) {
+  } else if (0 != syscall(__NR_mbind, addr, size, MPOL_PREFERRED_MODE,
+                          node_mask, MAX_NUMA_NODE_CNT + 1, 0)) {
+    ret = OB_ERR_SYS;
+    _OB_LOG(WARN, "bind memory to numa node failed, ret=%d, node=%ld, addr=%p, size=%ld, errno=%d",
+            ret, node, addr, size, errno);
+  }
+  return ret;
+}
+
+int ObNumaTopology::unbind_memory(void *addr, const int64_t size) const
+{
+  int ret = OB_SUCCESS;
+  // same as MPOL_DEFAULT in <numaif.h>
+  static const int MPOL_DEFAULT_MODE = 0;
+  if (OB_UNLIKELY(nullptr == addr || size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    _OB_LOG(WARN, "invalid argument, ret=%d, addr=%p, size=%ld", ret, addr, size);
+  } else if (0 != syscall(__NR_mbind, addr, size, MPOL_DEFAULT_MODE, nullptr, 0, 0)) {
+    ret = OB_ERR_SYS;
+    _OB_LOG(WARN, "unbind memory failed, ret=%d, addr=%p, size=%ld, errno=%d",
+            ret, addr, size, errno);
+  }
+  return ret;
+}
 } // common
 } // oceanbase
 
@@ -14,6 +14,7 @@
 #define OCEANBASE_LIB_OB_CPU_TOPOLOGY_
 
 #include <stdint.h>
+#include <sched.h>
 #include "lib/utility/ob_macro_utils.h"
 #include "lib/utility/utility.h"
 
@@ -22,6 +23,36 @@ namespace oceanbase
 namespace common
 {
 int64_t get_cpu_count();
+
+// numa topology read from /sys/devices/system/node, so that libnuma is not needed.
+// a machine without numa info is treated as one node containing all cpus.
+class ObNumaTopology
+{
+public:
+  static const int64_t MAX_NUMA_NODE_CNT = 64;
+  static ObNumaTopology &instance();
+  int64_t get_node_count() const { return node_cnt_; }
+  // return -1 if cpu_id is unknown
+  int64_t get_cpu_node(const int64_t cpu_id) const;
+  int64_t get_current_node() const { return get_cpu_node(sched_getcpu()); }
+  const cpu_set_t &get_node_cpus(const int64_t node) const { return node_cpus_[node]; }
+  // bind the calling thread to the cpus of numa node
+  int bind_thread_to_node(const int64_t node) const;
+  // prefer numa node for pages of [addr, addr + size) faulted in later,
+  // pages already faulted in are not migrated. addr must be page aligned.
+  int bind_memory_to_node(void *addr, const int64_t size, const int64_t node) const;
+  // back to the default policy of the process for [addr, addr + size)
+  int unbind_memory(void *addr, const int64_t size) const;
+private:
+  ObNumaTopology();
+  void load();
+  static int parse_cpu_list(const char *cpu_list, cpu_set_t &cpus);
+private:
+  int64_t node_cnt_;
+  int8_t cpu_nodes_[CPU_SETSIZE];
+  cpu_set_t node_cpus_[MAX_NUMA_NODE_CNT];
+  DISALLOW_COPY_AND_ASSIGN(ObNumaTopology);
+};
 } // namespace common
 } // namespace oceanbase
 
@@ -18,6 +18,7 @@
 #include "lib/atomic/ob_atomic.h"
 #include "lib/lock/ob_futex.h"
 #include "lib/stat/ob_latch_define.h"
+#include "lib/coro/co_var.h"
 #ifdef ENABLE_LATCH_DIAGNOSE
 #include<mutex>
 #include "lib/list/ob_dlist.h"
@@ -29,12 +30,39 @@ namespace common
 {
 extern bool USE_CO_LATCH;
 
-#define HOLD_LOCK_INC()             \
-  do {                              \
+// Number of latches (ObLatch and ObLatchMutex) held by current thread,
+// a request running on coroutine must not give the thread out while it
+// holds any. Only counted on threads which run requests on coroutines.
+// A latch unlocked by another thread than the locker never takes the
+// count below zero, the locker's count stays raised and only keeps it
+// from yielding.
+OB_INLINE bool &get_count_hold_latch()
+{
+  RLOCAL_INLINE(bool, count_hold_latch);
+  return count_hold_latch;
+}
+
+OB_INLINE int64_t &get_hold_latch_cnt()
+{
+  RLOCAL_INLINE(int64_t, hold_latch_cnt);
+  return hold_latch_cnt;
+}
+
+#define HOLD_LOCK_INC()                                       \
+  do {                                                        \
+    if (OB_SUCC(ret) && OB_UNLIKELY(get_count_hold_latch())) { \
+      ++get_hold_latch_cnt();                                 \
+    }                                                         \
   } while(0)
 
-#define HOLD_LOCK_DEC()             \
-  do {                              \
+#define HOLD_LOCK_DEC()                                       \
+  do {                                                        \
+    if (OB_SUCC(ret) && OB_UNLIKELY(get_count_hold_latch())) { \
+      int64_t &hold_latch_cnt = get_hold_latch_cnt();         \
+      if (hold_latch_cnt > 0) {                               \
+        --hold_latch_cnt;                                     \
+      }                                                       \
+    }                                                         \
   } while(0)
 
 #if !PERF_MODE
@@ -0,0 +1,287 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_QUEUE_OB_WORK_STEALING_QUEUE_
+#define OCEANBASE_QUEUE_OB_WORK_STEALING_QUEUE_
+#include "lib/ob_define.h"
+#include "lib/queue/ob_link.h"  // ObLink
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/lock/ob_scond.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/utility/utility.h"
+
+namespace oceanbase
+{
+namespace common
+{
+
+// FIFO queue sharded by consumer.
+//
+// Every consumer owns one shard and pops from it first. When its own
+// shard is empty, the consumer steals a batch from the longest shard
+// and keeps the remainder locally, so consumers seldom meet on the same
+// queue head. Producers put data into the shorter one of two randomly
+// chosen active shards. Order is only kept within one shard.
+//
+// Consumers finding nothing wait on one condition of the whole queue, so
+// whichever of them wakes up on a push steals the data if it isn't its
+// own.
+class ObWorkStealingQueue
+{
+public:
+  static const int64_t MAX_SHARD_CNT = 256;
+  static const int64_t STEAL_BATCH_CNT = 16;
+
+public:
+  ObWorkStealingQueue()
+      : buf_(nullptr), shards_(nullptr), shard_cnt_(0), active_shard_cnt_(0),
+        limit_(INT64_MAX), size_(0), cond_()
+  {}
+  ~ObWorkStealingQueue() { destroy(); }
+
+  int init(const int64_t shard_cnt, const lib::ObMemAttr &attr)
+  {
+    int ret = OB_SUCCESS;
+    if (OB_NOT_NULL(shards_)) {
+      ret = OB_INIT_TWICE;
+      COMMON_LOG(WARN, "init twice", K(ret));
+    } else if (OB_UNLIKELY(shard_cnt <= 0 || shard_cnt > MAX_SHARD_CNT)) {
+      ret = OB_INVALID_ARGUMENT;
+      COMMON_LOG(WARN, "invalid shard count", K(ret), K(shard_cnt));
+    } else if (OB_ISNULL(buf_ = ob_malloc(sizeof(Shard) * shard_cnt + CACHE_ALIGN_SIZE, attr))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      COMMON_LOG(WARN, "alloc shards fail", K(ret), K(shard_cnt));
+    } else {
+      // ob_malloc doesn't promise cache line alignment
+      shards_ = reinterpret_cast<Shard*>(upper_align(reinterpret_cast<int64_t>(buf_), CACHE_ALIGN_SIZE));
+      for (int64_t i = 0; i < shard_cnt; i++) {
+        new (&shards_[i]) Shard();
+      }
+      shard_cnt_ = shard_cnt;
+      active_shard_cnt_ = shard_cnt;
+    }
+    return ret;
+  }
+
+  // data left in queue are dropped, the caller should drain it first.
+  void destroy()
+  {
+    if (OB_NOT_NULL(shards_)) {
+      for (int64_t i = 0; i < shard_cnt_; i++) {
+        shards_[i].~Shard();
+      }
+      ob_free(buf_);
+      buf_ = nullptr;
+      shards_ = nullptr;
+    }
+    shard_cnt_ = 0;
+    active_shard_cnt_ = 0;
+    size_ = 0;
+  }
+
+  bool is_inited() const { return nullptr != shards_; }
+  int64_t get_shard_cnt() const { return shard_cnt_; }
+  int64_t get_active_shard_cnt() const { return ATOMIC_LOAD(&active_shard_cnt_); }
+
+  // limit of data in all shards
+  void set_limit(const int64_t limit) { ATOMIC_STORE(&limit_, limit); }
+
+  // producers only put data into the first `cnt' shards, the others are
+  // still drained by their owners or stolen.
+  void set_active_shard_cnt(const int64_t cnt)
+  {
+    if (shard_cnt_ > 0) {
+      ATOMIC_STORE(&active_shard_cnt_, min(max(cnt, 1L), shard_cnt_));
+    }
+  }
+
+  int64_t size() const { return ATOMIC_LOAD(&size_); }
+
+  int64_t shard_size(const int64_t idx) const
+  {
+    return (shard_cnt_ > 0) ? ATOMIC_LOAD(&shards_[idx % shard_cnt_].size_) : 0;
+  }
+
+  int push(ObLink *data)
+  {
+    int ret = OB_SUCCESS;
+    if (OB_ISNULL(shards_)) {
+      ret = OB_NOT_INIT;
+    } else if (OB_ISNULL(data)) {
+      ret = OB_INVALID_ARGUMENT;
+    } else if (ATOMIC_AAF(&size_, 1) > ATOMIC_LOAD(&limit_)) {
+      ATOMIC_DEC(&size_);
+      ret = OB_SIZE_OVERFLOW;
+    } else {
+      const int64_t active_cnt = ATOMIC_LOAD(&active_shard_cnt_);
+      const uint64_t r = next_rand();
+      int64_t idx = static_cast<int64_t>(r % active_cnt);
+      if (active_cnt > 1) {
+        const int64_t idx2 = static_cast<int64_t>((r >> 32) % active_cnt);
+        if (ATOMIC_LOAD(&shards_[idx2].size_) < ATOMIC_LOAD(&shards_[idx].size_)) {
+          idx = idx2;
+        }
+      }
+      shards_[idx].push(data, data, 1);
+      cond_.signal();
+    }
+    return ret;
+  }
+
+  // wake up one waiting consumer, for callers that feed consumers of this
+  // queue from somewhere else.
+  void notify() { cond_.signal(); }
+
+  // Pop from shard `idx', steal from others if it's empty, then wait for
+  // at most `timeout_us' until data is pushed or notify() is called.
+  int pop(const int64_t idx, ObLink *&data, const int64_t timeout_us)
+  {
+    int ret = OB_SUCCESS;
+    data = nullptr;
+    if (OB_ISNULL(shards_)) {
+      ret = OB_NOT_INIT;
+    } else if (OB_UNLIKELY(idx < 0 || timeout_us < 0)) {
+      ret = OB_INVALID_ARGUMENT;
+    } else {
+      Shard &shard = shards_[idx % shard_cnt_];
+      const uint32_t key = cond_.get_key();
+      if (nullptr == (data = shard.pop()) && nullptr == (data = steal(shard))) {
+        cond_.wait(key, timeout_us);
+        if (nullptr == (data = shard.pop())) {
+          data = steal(shard);
+        }
+      }
+      if (nullptr == data) {
+        ret = OB_ENTRY_NOT_EXIST;
+      } else {
+        ATOMIC_DEC(&size_);
+      }
+    }
+    return ret;
+  }
+
+private:
+  struct Shard
+  {
+    Shard() : lock_(), head_(nullptr), tail_(nullptr), size_(0) {}
+    void push(ObLink *head, ObLink *tail, const int64_t cnt)
+    {
+      ObSpinLockGuard guard(lock_);
+      tail->next_ = nullptr;
+      if (nullptr == tail_) {
+        head_ = head;
+      } else {
+        tail_->next_ = head;
+      }
+      tail_ = tail;
+      ATOMIC_AAF(&size_, cnt);
+    }
+    ObLink *pop()
+    {
+      ObLink *tail = nullptr;
+      int64_t cnt = 1;
+      ObLink *data = pop_batch(cnt, tail);
+      if (nullptr != data) {
+        data->next_ = nullptr;
+      }
+      return data;
+    }
+    // detach at most `cnt' items from head, `cnt' is set to the number
+    // actually detached.
+    ObLink *pop_batch(int64_t &cnt, ObLink *&tail)
+    {
+      ObLink *head = nullptr;
+      tail = nullptr;
+      if (0 == ATOMIC_LOAD(&size_)) {
+        cnt = 0;
+      } else {
+        ObSpinLockGuard guard(lock_);
+        int64_t n = 0;
+        head = head_;
+        for (ObLink *p = head_; nullptr != p && n < cnt; p = p->next_) {
+          tail = p;
+          n++;
+        }
+        if (nullptr != tail) {
+          head_ = tail->next_;
+          if (nullptr == head_) {
+            tail_ = nullptr;
+          }
+          tail->next_ = nullptr;
+          ATOMIC_AAF(&size_, -n);
+        }
+        cnt = n;
+      }
+      return head;
+    }
+
+    ObSpinLock lock_;
+    ObLink *head_;
+    ObLink *tail_;
+    int64_t size_;
+  } CACHE_ALIGNED;
+
+  ObLink *steal(Shard &self)
+  {
+    Shard *victim = nullptr;
+    int64_t max_size = 0;
+    for (int64_t i = 0; i < shard_cnt_; i++) {
+      const int64_t size = ATOMIC_LOAD(&shards_[i].size_);
+      if (&shards_[i] != &self && size > max_size) {
+        max_size = size;
+        victim = &shards_[i];
+      }
+    }
+    ObLink *data = nullptr;
+    if (nullptr != victim) {
+      int64_t cnt = min(STEAL_BATCH_CNT, (max_size + 1) / 2);
+      ObLink *tail = nullptr;
+      if (nullptr != (data = victim->pop_batch(cnt, tail))) {
+        ObLink *rest = data->next_;
+        data->next_ = nullptr;
+        // keep the rest locally, they are still visible to other stealers
+        if (nullptr != rest) {
+          self.push(rest, tail, cnt - 1);
+        }
+      }
+    }
+    return data;
+  }
+
+  static uint64_t next_rand()
+  {
+    static __thread uint64_t seed = 0;
+    if (OB_UNLIKELY(0 == seed)) {
+      seed = reinterpret_cast<uint64_t>(&seed) | 1;
+    }
+    seed ^= seed << 13;
+    seed ^= seed >> 7;
+    seed ^= seed << 17;
+    return seed;
+  }
+
+private:
+  void *buf_;
+  Shard *shards_;
+  int64_t shard_cnt_;
+  int64_t active_shard_cnt_;
+  int64_t limit_;
+  // data in all shards, stolen data stays counted until it's popped
+  int64_t size_ CACHE_ALIGNED;
+  SimpleCond cond_;
+  DISALLOW_COPY_AND_ASSIGN(ObWorkStealingQueue);
+};
+
+} // end namespace common
+} // end namespace oceanbase
+
+#endif /* OCEANBASE_QUEUE_OB_WORK_STEALING_QUEUE_ */
@@ -746,6 +746,10 @@ public:
     abort_unless(prev_ != nullptr);
     return *prev_;
   }
+  // Used by coroutine switching, each coroutine has its own flow stack
+  // which is rooted at the flow of the thread.
+  static Flow *get_current() { return g_flow(); }
+  static void set_current(Flow *flow) { g_flow() = flow; }
 private:
   static Flow *&g_flow()
   {
@@ -26,8 +26,10 @@
 #include "lib/stat/ob_diagnose_info.h"
 
 using namespace oceanbase::lib;
+using namespace oceanbase::common;
 
 int ObLargePageHelper::large_page_type_ = INVALID_LARGE_PAGE_TYPE;
+int ObLargePageHelper::ctx_large_page_types_[ObCtxIds::MAX_CTX_ID] = {0};
 
 void ObLargePageHelper::set_param(const char *param)
 {
@@ -52,6 +54,84 @@ int ObLargePageHelper::get_type()
 #endif
 }
 
+int ObLargePageHelper::parse_ctx_param(const char *param, int *types)
+{
+  int ret = OB_SUCCESS;
+  char buf[MAX_CTX_PARAM_LEN];
+  if (OB_ISNULL(param) || OB_ISNULL(types)) {
+    ret = OB_INVALID_ARGUMENT;
+  } else if (OB_UNLIKELY(STRLEN(param) >= sizeof(buf))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("param is too long", K(ret), K(param));
+  } else {
+    STRNCPY(buf, param, sizeof(buf));
+    char *save_ptr = nullptr;
+    for (char *token = strtok_r(buf, ",", &save_ptr);
+         OB_SUCC(ret) && nullptr != token;
+         token = strtok_r(nullptr, ",", &save_ptr)) {
+      char *policy = strchr(token, ':');
+      uint64_t ctx_id = 0;
+      int type = INVALID_LARGE_PAGE_TYPE;
+      if (OB_ISNULL(policy)) {
+        ret = OB_INVALID_ARGUMENT;
+      } else {
+        *policy++ = '\0';
+        for (int i = 0; i < ARRAYSIZEOF(ctx_large_pages_confs); i++) {
+          if (0 == strcasecmp(policy, ctx_large_pages_confs[i])) {
+            type = i;
+          }
+        }
+        if (INVALID_LARGE_PAGE_TYPE == type ||
+            !get_global_ctx_info().is_valid_ctx_name(token, ctx_id)) {
+          ret = OB_INVALID_ARGUMENT;
+        } else {
+          types[ctx_id] = type + 1;
+        }
+      }
+      if (OB_FAIL(ret)) {
+        LOG_WARN("invalid ctx large pages param", K(ret), K(param), K(token));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObLargePageHelper::check_ctx_param(const char *param)
+{
+  int types[ObCtxIds::MAX_CTX_ID] = {0};
+  return parse_ctx_param(param, types);
+}
+
+int ObLargePageHelper::set_ctx_param(const char *param)
+{
+  int ret = OB_SUCCESS;
+  int types[ObCtxIds::MAX_CTX_ID] = {0};
+  if (OB_ISNULL(param) || '\0' == param[0]) {
+    // use global type for all ctx
+  } else if (OB_FAIL(parse_ctx_param(param, types))) {
+    LOG_WARN("parse ctx large pages param failed", K(ret), K(param));
+  } else {
+    MEMCPY(ctx_large_page_types_, types, sizeof(types));
+    LOG_INFO("set ctx large page param", K(param));
+  }
+  return ret;
+}
+
+int ObLargePageHelper::get_type(const uint64_t ctx_id)
+{
+  int type = INVALID_LARGE_PAGE_TYPE;
+#ifndef ENABLE_SANITY
+  if (ctx_id < ObCtxIds::MAX_CTX_ID && 0 != ctx_large_page_types_[ctx_id]) {
+    type = ctx_large_page_types_[ctx_id] - 1;
+  } else {
+    type = large_page_type_;
+  }
+#else
+  type = NO_LARGE_PAGE;
+#endif
+  return type;
+}
+
 AChunkMgr &AChunkMgr::instance()
 {
   static AChunkMgr mgr;
@@ -59,12 +139,13 @@ AChunkMgr &AChunkMgr::instance()
 }
 
 AChunkMgr::AChunkMgr()
-  : free_list_(), chunk_bitmap_(nullptr), limit_(DEFAULT_LIMIT), urgent_(0), hold_(0),
-    total_hold_(0), maps_(0), unmaps_(0), large_maps_(0), large_unmaps_(0), shadow_hold_(0)
+  : free_list_(), large_free_list_(), huge_page_pool_(), chunk_bitmap_(nullptr), limit_(DEFAULT_LIMIT),
+    urgent_(0), hold_(0), total_hold_(0), maps_(0), unmaps_(0), large_maps_(0), large_unmaps_(0),
+    shadow_hold_(0), hugetlb_hold_(0)
 {
 }
 
-void *AChunkMgr::direct_alloc(const uint64_t size, const bool can_use_huge_page, bool &huge_page_used, const bool alloc_shadow)
+void *AChunkMgr::direct_alloc(const uint64_t size, const int large_page_type, bool &huge_page_used, const bool alloc_shadow)
 {
   common::ObTimeGuard time_guard(__func__, 1000 * 1000);
   int orig_errno = errno;
@@ -72,14 +153,14 @@ void *AChunkMgr::direct_alloc(const uint64_t size, const bool can_use_huge_page,
   EVENT_ADD(MMAP_SIZE, size);
 
   void *ptr = nullptr;
-  ptr = low_alloc(size, can_use_huge_page, huge_page_used, alloc_shadow);
+  ptr = low_alloc(size, large_page_type, huge_page_used, alloc_shadow);
   if (nullptr != ptr) {
     if (((uint64_t)ptr & (INTACT_ACHUNK_SIZE - 1)) != 0) {
       // not aligned
       low_free(ptr, size);
 
       uint64_t new_size = size + INTACT_ACHUNK_SIZE;
-      ptr = low_alloc(new_size, can_use_huge_page, huge_page_used, alloc_shadow);
+      ptr = low_alloc(new_size, large_page_type, huge_page_used, alloc_shadow);
       if (nullptr != ptr) {
         const uint64_t addr = align_up2((uint64_t)ptr, INTACT_ACHUNK_SIZE);
         if (addr - (uint64_t)ptr > 0) {
@@ -100,6 +181,9 @@ void *AChunkMgr::direct_alloc(const uint64_t size, const bool can_use_huge_page,
     if (size > INTACT_ACHUNK_SIZE) {
       ATOMIC_FAA(&large_maps_, 1);
     }
+    if (huge_page_used) {
+      IGNORE_RETURN ATOMIC_FAA(&hugetlb_hold_, size);
+    }
   } else {
     LOG_ERROR("low alloc fail", K(size), K(orig_errno), K(errno));
     auto &afc = g_alloc_failed_ctx();
@@ -125,7 +209,7 @@ void AChunkMgr::direct_free(const void *ptr, const uint64_t size)
 
 static int64_t global_canonical_addr = SANITY_MIN_CANONICAL_ADDR;
 
-void *AChunkMgr::low_alloc(const uint64_t size, const bool can_use_huge_page, bool &huge_page_used, const bool alloc_shadow)
+void *AChunkMgr::low_alloc(const uint64_t size, const int large_page_type, bool &huge_page_used, const bool alloc_shadow)
 {
   void *ptr = nullptr;
   huge_page_used = false;
@@ -133,13 +217,12 @@ void *AChunkMgr::low_alloc(const uint64_t size, const bool can_use_huge_page, bo
   int flags = MAP_PRIVATE | MAP_ANONYMOUS | (SANITY_BOOL_EXPR(alloc_shadow) ? MAP_FIXED : 0);
   int huge_flags = flags;
 #ifdef MAP_HUGETLB
-  if (OB_LIKELY(can_use_huge_page)) {
+  if (OB_LIKELY(ObLargePageHelper::NO_LARGE_PAGE != large_page_type)) {
     huge_flags = flags | MAP_HUGETLB;
   }
 #endif
   const int fd = -1;
   const int offset = 0;
-  const int large_page_type = ObLargePageHelper::get_type();
   if (SANITY_BOOL_EXPR(alloc_shadow)) {
     int64_t new_addr = ATOMIC_FAA(&global_canonical_addr, size);
     if (!SANITY_ADDR_IN_RANGE((void*)new_addr)) {
@@ -153,14 +236,15 @@ void *AChunkMgr::low_alloc(const uint64_t size, const bool can_use_huge_page, bo
     }
   }
   if (OB_LIKELY(ObLargePageHelper::PREFER_LARGE_PAGE != large_page_type) &&
-      OB_LIKELY(ObLargePageHelper::ONLY_LARGE_PAGE != large_page_type)) {
+      OB_LIKELY(ObLargePageHelper::ONLY_LARGE_PAGE != large_page_type) &&
+      OB_LIKELY(ObLargePageHelper::POOL_LARGE_PAGE != large_page_type)) {
     if (MAP_FAILED == (ptr = ::mmap(ptr, size, prot, flags, fd, offset))) {
       ptr = nullptr;
     }
   } else {
     if (MAP_FAILED == (ptr = ::mmap(ptr, size, prot, huge_flags, fd, offset))) {
       ptr = nullptr;
-      if (ObLargePageHelper::PREFER_LARGE_PAGE == large_page_type) {
+      if (ObLargePageHelper::ONLY_LARGE_PAGE != large_page_type) {
         if (MAP_FAILED == (ptr = ::mmap(ptr, size, prot, flags, fd, offset))) {
           ptr = nullptr;
         }
@@ -196,24 +280,87 @@ void AChunkMgr::low_free(const void *ptr, const uint64_t size)
   ::munmap((void*)ptr, size);
 }
 
-AChunk *AChunkMgr::alloc_chunk(const uint64_t size, bool high_prio)
+AChunk *AChunkMgr::pop_free_chunk(const int large_page_type)
+{
+  AChunk *chunk = nullptr;
+  if (ObLargePageHelper::PREFER_LARGE_PAGE != large_page_type &&
+      ObLargePageHelper::ONLY_LARGE_PAGE != large_page_type) {
+    if (free_list_.count() > 0) {
+      chunk = free_list_.pop();
+    }
+  } else if (large_free_list_.count() > 0) {
+    chunk = large_free_list_.pop();
+  }
+  if (OB_ISNULL(chunk) && ObLargePageHelper::PREFER_LARGE_PAGE == large_page_type &&
+      free_list_.count() > 0) {
+    // reuse a cached chunk rather than mapping a new one
+    chunk = free_list_.pop();
+  }
+  return chunk;
+}
+
+int AChunkMgr::init_huge_page_pool(const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(huge_page_pool_.init(size))) {
+    LOG_WARN("init huge page pool failed", K(ret), K(size));
+  } else if (OB_FAIL(charge_huge_page_pool())) {
+    LOG_WARN("charge huge page pool failed", K(ret), K(size));
+  }
+  return ret;
+}
+
+int AChunkMgr::charge_huge_page_pool()
+{
+  int ret = OB_SUCCESS;
+  // The pool is populated and never given back to os, so it's charged
+  // as a whole here and chunks in it are not charged again.
+  const int64_t total = huge_page_pool_.get_total();
+  if (!update_hold(total, false)) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("huge page pool exceeds memory limit", K(ret), K(total), K_(hold), K_(limit));
+    huge_page_pool_.destroy();
+  } else {
+    IGNORE_RETURN ATOMIC_FAA(&total_hold_, total);
+  }
+  return ret;
+}
+
+void AChunkMgr::free_direct_chunk(AChunk *chunk, const uint64_t all_size)
+{
+  if (chunk->is_hugetlb_) {
+    IGNORE_RETURN ATOMIC_FAA(&hugetlb_hold_, -all_size);
+  }
+  direct_free(chunk, all_size);
+}
+
+AChunk *AChunkMgr::alloc_chunk(const uint64_t size, bool high_prio, const int large_page_type)
 {
   const int64_t hold_size = hold(size);
   const int64_t all_size = aligned(size);
   const int64_t achunk_size = INTACT_ACHUNK_SIZE;
   bool is_allocated = true;
+  int type = ObLargePageHelper::INVALID_LARGE_PAGE_TYPE == large_page_type ?
+      ObLargePageHelper::get_type() : large_page_type;
 
   AChunk *chunk = nullptr;
   if (achunk_size == hold_size) {
+    if (ObLargePageHelper::POOL_LARGE_PAGE == type) {
+      void *ptr = huge_page_pool_.alloc();
+      if (OB_ISNULL(ptr)) {
+        // pool exhausted, behave as prefer
+        type = ObLargePageHelper::PREFER_LARGE_PAGE;
+      } else {
+        chunk = new (ptr) AChunk();
+        chunk->is_hugetlb_ = huge_page_pool_.is_hugetlb();
+      }
+    }
     // TODO by fengshuo.fs: chunk cached by freelist may not use all memory in it,
     //                      so update_hold can use hold_size too.
-    if (free_list_.count() > 0) {
-      chunk = free_list_.pop();
-    }
-    if (OB_ISNULL(chunk)) {
+    if (OB_ISNULL(chunk) && OB_ISNULL(chunk = pop_free_chunk(type))) {
       if (update_hold(hold_size, high_prio)) {
         bool hugetlb_used = false;
-        void *ptr = direct_alloc(all_size, true, hugetlb_used, SANITY_BOOL_EXPR(true));
+        void *ptr = direct_alloc(all_size, type, hugetlb_used, SANITY_BOOL_EXPR(true));
         if (ptr != nullptr) {
           chunk = new (ptr) AChunk();
           chunk->is_hugetlb_ = hugetlb_used;
@@ -222,21 +369,26 @@ AChunk *AChunkMgr::alloc_chunk(const uint64_t size, bool high_prio)
         }
       }
     } else {
+      // reused from free list or pool, both are charged already
       is_allocated = false;
     }
   } else {
     bool updated = false;
-    while (!(updated = update_hold(hold_size, high_prio)) && free_list_.count() > 0) {
-      if (OB_NOT_NULL(chunk = free_list_.pop())) {
-        direct_free(chunk, achunk_size);
+    while (!(updated = update_hold(hold_size, high_prio)) && get_free_chunk_count() > 0) {
+      if (OB_NOT_NULL(chunk = free_list_.pop()) || OB_NOT_NULL(chunk = large_free_list_.pop())) {
+        free_direct_chunk(chunk, achunk_size);
         IGNORE_RETURN update_hold(-achunk_size, high_prio);
         IGNORE_RETURN ATOMIC_FAA(&total_hold_, -achunk_size);
         chunk = nullptr;
       }
     }
     if (updated) {
+      // the pool only serves standard chunks
+      if (ObLargePageHelper::POOL_LARGE_PAGE == type) {
+        type = ObLargePageHelper::PREFER_LARGE_PAGE;
+      }
       bool hugetlb_used = false;
-      void *ptr = direct_alloc(all_size, true, hugetlb_used, SANITY_BOOL_EXPR(true));
+      void *ptr = direct_alloc(all_size, type, hugetlb_used, SANITY_BOOL_EXPR(true));
       if (ptr != nullptr) {
         chunk = new (ptr) AChunk();
         chunk->is_hugetlb_ = hugetlb_used;
@@ -267,16 +419,20 @@ void AChunkMgr::free_chunk(AChunk *chunk)
     const uint64_t all_size = chunk->aligned();
     const int64_t achunk_size = INTACT_ACHUNK_SIZE;
     bool freed = true;
-    if (achunk_size == hold_size) {
+    if (huge_page_pool_.contains(chunk)) {
+      // memory of pool is never given back to os and stays charged
+      huge_page_pool_.free(chunk);
+      freed = false;
+    } else if (achunk_size == hold_size) {
       if (hold_ + hold_size <= limit_) {
-        freed = !free_list_.push(chunk);
+        freed = chunk->is_hugetlb_ ? !large_free_list_.push(chunk) : !free_list_.push(chunk);
       }
       if (freed) {
-        direct_free(chunk, all_size);
+        free_direct_chunk(chunk, all_size);
         IGNORE_RETURN update_hold(-hold_size, false);
       }
     } else {
-      direct_free(chunk, all_size);
+      free_direct_chunk(chunk, all_size);
       IGNORE_RETURN update_hold(-hold_size, false);
     }
     if (freed) {
@@ -294,9 +450,9 @@ AChunk *AChunkMgr::alloc_co_chunk(const uint64_t size)
 
   AChunk *chunk = nullptr;
   bool updated = false;
-  while (!(updated = update_hold(hold_size, true)) && free_list_.count() > 0) {
-    if (OB_NOT_NULL(chunk = free_list_.pop())) {
-      direct_free(chunk, achunk_size);
+  while (!(updated = update_hold(hold_size, true)) && get_free_chunk_count() > 0) {
+    if (OB_NOT_NULL(chunk = free_list_.pop()) || OB_NOT_NULL(chunk = large_free_list_.pop())) {
+      free_direct_chunk(chunk, achunk_size);
       IGNORE_RETURN update_hold(-achunk_size, true);
       IGNORE_RETURN ATOMIC_FAA(&total_hold_, -achunk_size);
       chunk = nullptr;
@@ -305,7 +461,7 @@ AChunk *AChunkMgr::alloc_co_chunk(const uint64_t size)
   if (updated) {
     // there is performance drop when thread stack on huge_page memory.
     bool hugetlb_used = false;
-    void *ptr = direct_alloc(all_size, false, hugetlb_used, SANITY_BOOL_EXPR(false));
+    void *ptr = direct_alloc(all_size, ObLargePageHelper::NO_LARGE_PAGE, hugetlb_used, SANITY_BOOL_EXPR(false));
     if (ptr != nullptr) {
       chunk = new (ptr) AChunk();
       chunk->is_hugetlb_ = hugetlb_used;
@@ -334,7 +490,7 @@ void AChunkMgr::free_co_chunk(AChunk *chunk)
     const int64_t hold_size = chunk->hold();
     const uint64_t all_size = chunk->aligned();
     const int64_t achunk_size = INTACT_ACHUNK_SIZE;
-    direct_free(chunk, all_size);
+    free_direct_chunk(chunk, all_size);
     IGNORE_RETURN update_hold(-hold_size, false);
     IGNORE_RETURN ATOMIC_FAA(&total_hold_, -all_size);
   }
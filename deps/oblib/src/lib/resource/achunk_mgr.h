@@ -22,6 +22,8 @@
 #include "lib/atomic/ob_atomic.h"
 #include "lib/ob_define.h"
 #include "lib/lock/ob_mutex.h"
+#include "lib/allocator/ob_mod_define.h"
+#include "lib/resource/ob_huge_page_pool.h"
 
 namespace oceanbase
 {
@@ -149,6 +151,16 @@ const char *const use_large_pages_confs[] =
   "only"
 };
 
+// policies allowed for one ctx, "pool" takes chunk from the reserved
+// huge page pool first and behaves as "true" after it's exhausted.
+const char *const ctx_large_pages_confs[] =
+{
+  "false",
+  "true",
+  "only",
+  "pool"
+};
+
 class ObLargePageHelper
 {
 public:
@@ -156,11 +168,22 @@ public:
   static const int NO_LARGE_PAGE = 0;
   static const int PREFER_LARGE_PAGE = 1;
   static const int ONLY_LARGE_PAGE = 2;
+  static const int POOL_LARGE_PAGE = 3;
+  static const int64_t MAX_CTX_PARAM_LEN = 4096;
 public:
   static void set_param(const char *param);
   static int get_type();
+  // param is like "MEMSTORE_CTX_ID:pool,WORK_AREA:true", ctx not
+  // listed follows the global type.
+  static int set_ctx_param(const char *param);
+  static int check_ctx_param(const char *param);
+  static int get_type(const uint64_t ctx_id);
+private:
+  static int parse_ctx_param(const char *param, int *types);
 private:
   static int large_page_type_;
+  // 0 means not set, otherwise type + 1
+  static int ctx_large_page_types_[common::ObCtxIds::MAX_CTX_ID];
 };
 
 class AChunkMgr
@@ -175,16 +198,24 @@ public:
 public:
   AChunkMgr();
 
+  // large_page_type is one of ObLargePageHelper types, INVALID means
+  // the global one.
   AChunk *alloc_chunk(
       const uint64_t size = ACHUNK_SIZE,
-      bool high_prio = false);
+      bool high_prio = false,
+      const int large_page_type = ObLargePageHelper::INVALID_LARGE_PAGE_TYPE);
   void free_chunk(AChunk *chunk);
   AChunk *alloc_co_chunk(const uint64_t size = ACHUNK_SIZE);
   void free_co_chunk(AChunk *chunk);
   static OB_INLINE uint64_t aligned(const uint64_t size);
   static OB_INLINE uint64_t hold(const uint64_t size);
   void set_max_chunk_cache_cnt(const int cnt)
-  { free_list_.set_max_chunk_cache_cnt(cnt); }
+  {
+    free_list_.set_max_chunk_cache_cnt(cnt);
+    large_free_list_.set_max_chunk_cache_cnt(cnt);
+  }
+  // the whole pool is charged to hold when it's reserved
+  int init_huge_page_pool(const int64_t size);
 
   inline static AChunk *ptr2chunk(const void *ptr);
   bool update_hold(int64_t bytes, bool high_prio);
@@ -205,19 +236,30 @@ public:
   inline int64_t get_large_maps()  { return large_maps_; }
   inline int64_t get_large_unmaps()  { return large_unmaps_; }
   inline int64_t get_shadow_hold() const { return ATOMIC_LOAD(&shadow_hold_); }
+  // chunks on huge pages mapped directly, cached ones included
+  inline int64_t get_hugetlb_hold() const { return ATOMIC_LOAD(&hugetlb_hold_); }
+  inline int64_t get_huge_page_pool_total() const { return huge_page_pool_.get_total(); }
+  inline int64_t get_huge_page_pool_used() const { return huge_page_pool_.get_used(); }
+  inline int64_t get_huge_page_pool_page_size() const { return huge_page_pool_.get_page_size(); }
 
 private:
   typedef ABitSet ChunkBitMap;
 
 private:
-  void *direct_alloc(const uint64_t size, const bool can_use_huge_page, bool &huge_page_used, const bool alloc_shadow);
+  void *direct_alloc(const uint64_t size, const int large_page_type, bool &huge_page_used, const bool alloc_shadow);
   void direct_free(const void *ptr, const uint64_t size);
   // wrap for mmap
-  void *low_alloc(const uint64_t size, const bool can_use_huge_page, bool &huge_page_used, const bool alloc_shadow);
+  void *low_alloc(const uint64_t size, const int large_page_type, bool &huge_page_used, const bool alloc_shadow);
+  AChunk *pop_free_chunk(const int large_page_type);
+  int charge_huge_page_pool();
+  void free_direct_chunk(AChunk *chunk, const uint64_t all_size);
   void low_free(const void *ptr, const uint64_t size);
 
 protected:
   AChunkList free_list_;
+  // cached chunks on huge pages
+  AChunkList large_free_list_;
+  ObHugePagePool huge_page_pool_;
   ChunkBitMap *chunk_bitmap_;
 
   int64_t limit_;
@@ -230,6 +272,7 @@ protected:
   int64_t large_maps_;
   int64_t large_unmaps_;
   int64_t shadow_hold_;
+  int64_t hugetlb_hold_;
 }; // end of class AChunkMgr
 
 OB_INLINE AChunk *AChunkMgr::ptr2chunk(const void *ptr)
@@ -274,27 +317,27 @@ inline int64_t AChunkMgr::get_hold() const
 
 inline int64_t AChunkMgr::get_used() const
 {
-  return hold_ - get_freelist_hold();
+  return hold_ - get_freelist_hold() - (huge_page_pool_.get_total() - huge_page_pool_.get_used());
 }
 
 inline int64_t AChunkMgr::get_free_chunk_count() const
 {
-  return free_list_.count();
+  return free_list_.count() + large_free_list_.count();
 }
 
 inline int64_t AChunkMgr::get_free_chunk_pushes() const
 {
-  return free_list_.get_pushes();
+  return free_list_.get_pushes() + large_free_list_.get_pushes();
 }
 
 inline int64_t AChunkMgr::get_free_chunk_pops() const
 {
-  return free_list_.get_pops();
+  return free_list_.get_pops() + large_free_list_.get_pops();
 }
 
 inline int64_t AChunkMgr::get_freelist_hold() const
 {
-  return free_list_.count() * INTACT_ACHUNK_SIZE;
+  return get_free_chunk_count() * INTACT_ACHUNK_SIZE;
 }
 
 } // end of namespace lib
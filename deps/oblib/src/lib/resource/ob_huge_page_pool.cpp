@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX LIB
+
+#include "lib/resource/ob_huge_page_pool.h"
+#include <sys/mman.h>
+#include "lib/oblog/ob_log.h"
+#include "lib/utility/utility.h"
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#ifndef MAP_HUGE_1GB
+#define MAP_HUGE_1GB (30 << MAP_HUGE_SHIFT)
+#endif
+
+using namespace oceanbase::common;
+
+namespace oceanbase
+{
+namespace lib
+{
+
+ObHugePagePool::ObHugePagePool()
+  : base_(nullptr), size_(0), page_size_(0), used_(0),
+    mutex_(common::ObLatchIds::ALLOC_CHUNK_LOCK), free_slots_(nullptr)
+{
+  mutex_.enable_record_stat(false);
+}
+
+int ObHugePagePool::init(const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_NOT_NULL(base_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("huge page pool has been inited", K(ret), KP_(base), K_(size));
+  } else if (OB_UNLIKELY(size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid size", K(ret), K(size));
+  } else if (OB_FAIL(reserve(size, GIGA_PAGE_SIZE))) {
+    LOG_WARN("reserve 1GB pages failed, try 2MB pages", K(ret), K(size));
+    ret = reserve(size, HUGE_PAGE_SIZE);
+  }
+  if (OB_SUCC(ret)) {
+    LOG_INFO("huge page pool reserved", KP_(base), K_(size), K_(page_size));
+  } else {
+    LOG_WARN("reserve huge page pool failed", K(ret), K(size));
+  }
+  return ret;
+}
+
+int ObHugePagePool::reserve(const int64_t size, const int64_t page_size)
+{
+  int ret = OB_SUCCESS;
+  int flags = MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE;
+  int64_t align_size = INTACT_ACHUNK_SIZE;
+#ifdef MAP_HUGETLB
+  if (GIGA_PAGE_SIZE == page_size) {
+    flags |= MAP_HUGETLB | MAP_HUGE_1GB;
+  } else if (page_size > 0) {
+    flags |= MAP_HUGETLB;
+  }
+#endif
+  if (page_size > 0) {
+    align_size = max(align_size, page_size);
+  }
+  const int64_t reserve_size = upper_align(size, align_size);
+  // hugetlb mapping is aligned to its page size, normal pages used by
+  // test need extra space to align to chunk.
+  const int64_t map_size = page_size > 0 ? reserve_size : reserve_size + INTACT_ACHUNK_SIZE;
+  void *ptr = ::mmap(nullptr, map_size, PROT_READ | PROT_WRITE, flags, -1, 0);
+  if (MAP_FAILED == ptr) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("mmap huge pages failed", K(ret), K(reserve_size), K(page_size), K(errno));
+  } else {
+    if (map_size > reserve_size) {
+      const uint64_t addr = upper_align((uint64_t)ptr, INTACT_ACHUNK_SIZE);
+      if (addr > (uint64_t)ptr) {
+        ::munmap(ptr, addr - (uint64_t)ptr);
+      }
+      if ((uint64_t)ptr + map_size > addr + reserve_size) {
+        ::munmap((void*)(addr + reserve_size), (uint64_t)ptr + map_size - addr - reserve_size);
+      }
+      ptr = (void*)addr;
+    }
+    base_ = (char*)ptr;
+    size_ = reserve_size;
+    page_size_ = page_size;
+    // slots are linked through their first bytes, lower address first
+    for (int64_t offset = reserve_size - INTACT_ACHUNK_SIZE; offset >= 0; offset -= INTACT_ACHUNK_SIZE) {
+      Slot *slot = reinterpret_cast<Slot*>(base_ + offset);
+      slot->next_ = free_slots_;
+      free_slots_ = slot;
+    }
+  }
+  return ret;
+}
+
+void ObHugePagePool::destroy()
+{
+  if (OB_NOT_NULL(base_)) {
+    abort_unless(0 == ATOMIC_LOAD(&used_));
+    ::munmap(base_, size_);
+    base_ = nullptr;
+    size_ = 0;
+    page_size_ = 0;
+    free_slots_ = nullptr;
+  }
+}
+
+void *ObHugePagePool::alloc()
+{
+  Slot *slot = nullptr;
+  if (nullptr != ATOMIC_LOAD(&free_slots_)) {
+    ObMutexGuard guard(mutex_);
+    if (nullptr != (slot = free_slots_)) {
+      free_slots_ = slot->next_;
+      IGNORE_RETURN ATOMIC_AAF(&used_, INTACT_ACHUNK_SIZE);
+    }
+  }
+  return slot;
+}
+
+void ObHugePagePool::free(void *ptr)
+{
+  abort_unless(contains(ptr) && 0 == ((uint64_t)ptr & (INTACT_ACHUNK_SIZE - 1)));
+  Slot *slot = reinterpret_cast<Slot*>(ptr);
+  ObMutexGuard guard(mutex_);
+  slot->next_ = free_slots_;
+  free_slots_ = slot;
+  IGNORE_RETURN ATOMIC_AAF(&used_, -static_cast<int64_t>(INTACT_ACHUNK_SIZE));
+}
+
+} // end of namespace lib
+} // end of namespace oceanbase
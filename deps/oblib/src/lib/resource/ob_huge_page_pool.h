@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef _OCEABASE_LIB_RESOURCE_OB_HUGE_PAGE_POOL_H_
+#define _OCEABASE_LIB_RESOURCE_OB_HUGE_PAGE_POOL_H_
+
+#include <stdint.h>
+#include "lib/alloc/alloc_struct.h"
+#include "lib/atomic/ob_atomic.h"
+#include "lib/lock/ob_mutex.h"
+
+namespace oceanbase
+{
+namespace lib
+{
+
+// Memory reserved on hugetlb pages when server starts and cut into
+// INTACT_ACHUNK_SIZE slots for chunks.
+//
+// 1GB pages are tried first and 2MB pages next. Reserving in advance
+// means chunks still get huge pages after physical memory fragments,
+// the reserved memory is never given back to os.
+class ObHugePagePool
+{
+public:
+  static const int64_t GIGA_PAGE_SIZE = 1L << 30;
+  static const int64_t HUGE_PAGE_SIZE = 2L << 20;
+public:
+  ObHugePagePool();
+  ~ObHugePagePool() {}
+
+  int init(const int64_t size);
+  // unmap the pool, all chunks must have been given back
+  void destroy();
+  bool is_inited() const { return nullptr != base_; }
+
+  // return nullptr if pool is exhausted
+  void *alloc();
+  void free(void *ptr);
+  OB_INLINE bool contains(const void *ptr) const
+  {
+    return (const char*)ptr >= base_ && (const char*)ptr < base_ + size_;
+  }
+
+  bool is_hugetlb() const { return page_size_ > 0; }
+  int64_t get_page_size() const { return page_size_; }
+  int64_t get_total() const { return size_; }
+  int64_t get_used() const { return ATOMIC_LOAD(&used_); }
+
+private:
+  struct Slot
+  {
+    Slot *next_;
+  };
+  // page_size 0 means normal pages, only for test
+  int reserve(const int64_t size, const int64_t page_size);
+
+private:
+  char *base_;
+  int64_t size_;
+  int64_t page_size_;
+  int64_t used_;
+  ObMutex mutex_;
+  Slot *free_slots_;
+  DISALLOW_COPY_AND_ASSIGN(ObHugePagePool);
+};
+
+} // end of namespace lib
+} // end of namespace oceanbase
+
+#endif /* _OCEABASE_LIB_RESOURCE_OB_HUGE_PAGE_POOL_H_ */
@@ -20,6 +20,7 @@
 #include "lib/stat/ob_diagnose_info.h"
 #include "lib/utility/utility.h"
 #include "lib/alloc/alloc_failed_reason.h"
+#include "lib/cpu/ob_cpu_topology.h"
 
 namespace oceanbase
 {
@@ -29,7 +30,7 @@ namespace lib
 ObTenantMemoryMgr::ObTenantMemoryMgr()
   : cache_washer_(NULL), tenant_id_(common::OB_INVALID_ID),
     limit_(INT64_MAX), sum_hold_(0), rpc_hold_(0), cache_hold_(0),
-    cache_item_count_(0)
+    cache_item_count_(0), numa_node_(-1)
 {
   for (uint64_t i = 0; i < common::ObCtxIds::MAX_CTX_ID; i++) {
     ATOMIC_STORE(&(hold_bytes_[i]), 0);
@@ -40,7 +41,7 @@ ObTenantMemoryMgr::ObTenantMemoryMgr()
 ObTenantMemoryMgr::ObTenantMemoryMgr(const uint64_t tenant_id)
   : cache_washer_(NULL), tenant_id_(tenant_id),
     limit_(INT64_MAX), sum_hold_(0), rpc_hold_(0), cache_hold_(0),
-    cache_item_count_(0)
+    cache_item_count_(0), numa_node_(-1)
 {
   for (uint64_t i = 0; i < common::ObCtxIds::MAX_CTX_ID; i++) {
     ATOMIC_STORE(&(hold_bytes_[i]), 0);
@@ -330,7 +331,18 @@ AChunk *ObTenantMemoryMgr::alloc_chunk_(const int64_t size, const ObMemAttr &att
   if (OB_UNLIKELY(attr.ctx_id_ == ObCtxIds::CO_STACK)) {
     chunk = CHUNK_MGR.alloc_co_chunk(static_cast<uint64_t>(size));
   } else {
-    chunk = CHUNK_MGR.alloc_chunk(static_cast<uint64_t>(size), OB_HIGH_ALLOC == attr.prio_);
+    chunk = CHUNK_MGR.alloc_chunk(static_cast<uint64_t>(size), OB_HIGH_ALLOC == attr.prio_,
+                                  ObLargePageHelper::get_type(attr.ctx_id_));
+    const int64_t numa_node = ATOMIC_LOAD(&numa_node_);
+    if (OB_UNLIKELY(numa_node >= 0) && OB_NOT_NULL(chunk)) {
+      // best effort, pages of a reused chunk already faulted in stay
+      // where they are.
+      int tmp_ret = common::ObNumaTopology::instance().bind_memory_to_node(
+          chunk, static_cast<int64_t>(chunk->hold()), numa_node);
+      if (OB_SUCCESS != tmp_ret && REACH_TIME_INTERVAL(10 * 1000 * 1000)) {
+        LOG_WARN("bind chunk to numa node failed", K(tmp_ret), K_(tenant_id), K(numa_node));
+      }
+    }
   }
   return chunk;
 }
@@ -340,6 +352,15 @@ void ObTenantMemoryMgr::free_chunk_(AChunk *chunk, const ObMemAttr &attr)
   if (OB_UNLIKELY(attr.ctx_id_ == ObCtxIds::CO_STACK)) {
     CHUNK_MGR.free_co_chunk(chunk);
   } else {
+    if (OB_UNLIKELY(ATOMIC_LOAD(&numa_node_) >= 0) && OB_NOT_NULL(chunk)) {
+      // the chunk may be cached and reused by other tenants, don't leave
+      // the preferred node on it.
+      int tmp_ret = common::ObNumaTopology::instance().unbind_memory(
+          chunk, static_cast<int64_t>(chunk->hold()));
+      if (OB_SUCCESS != tmp_ret && REACH_TIME_INTERVAL(10 * 1000 * 1000)) {
+        LOG_WARN("unbind chunk from numa node failed", K(tmp_ret), K_(tenant_id));
+      }
+    }
     CHUNK_MGR.free_chunk(chunk);
   }
 }
@@ -55,6 +55,9 @@ public:
   int64_t get_rpc_hold() const { return rpc_hold_; }
 
   void update_rpc_hold(const int64_t size) { ATOMIC_AAF(&rpc_hold_, size); }
+  // chunks allocated afterwards prefer this numa node, -1 means no binding
+  void set_numa_node(const int64_t node) { ATOMIC_STORE(&numa_node_, node); }
+  int64_t get_numa_node() const { return ATOMIC_LOAD(&numa_node_); }
   const volatile int64_t *get_ctx_hold_bytes() const { return hold_bytes_; }
   inline static int64_t align(const int64_t size)
   {
@@ -80,6 +83,7 @@ private:
   int64_t cache_item_count_;
   volatile int64_t hold_bytes_[common::ObCtxIds::MAX_CTX_ID];
   volatile int64_t limit_bytes_[common::ObCtxIds::MAX_CTX_ID];
+  int64_t numa_node_;
 };
 
 struct ObTenantResourceMgr : public common::ObLink
@@ -48,6 +48,7 @@ public:
   inline ObDISessionCollect *get_curr_session() {return session_collect_;}
   inline ObDITenantCollect *get_curr_tenant() {return curr_tenant_collect_;}
   inline ObDIThreadTenantCache &get_tenant_cache() {return tenant_cache_;}
+  inline bool is_multi_thread_plan() const {return session_collect_ == &local_session_collect_;}
 private:
   ObDIThreadTenantCache tenant_cache_;
   ObDISessionCollect local_session_collect_;
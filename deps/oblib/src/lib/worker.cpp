@@ -13,10 +13,12 @@
 #define USING_LOG_PREFIX LIB
 #include "worker.h"
 #include <stdlib.h>
+#include <utility>
 #include "lib/ob_define.h"
 #include "lib/oblog/ob_log.h"
 #include "lib/time/ob_time_utility.h"
 #include "lib/allocator/ob_malloc.h"
+#include "lib/utility/utility.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::lib;
@@ -110,3 +112,34 @@ bool Worker::is_timeout() const
 {
   return ObTimeUtility::current_time() >= timeout_ts_;
 }
+
+void Worker::sleep_us(const int64_t us)
+{
+  if (us <= 0) {
+    // do nothing
+  } else if (can_coro_yield()) {
+    const int64_t end_ts = ObTimeUtility::current_time() + us;
+    do {
+      coro_yield();
+    } while (ObTimeUtility::current_time() < end_ts);
+  } else {
+    ob_usleep(static_cast<useconds_t>(us));
+  }
+}
+
+void Worker::swap_req_ctx(ReqCtx &ctx)
+{
+  std::swap(allocator_, ctx.allocator_);
+  std::swap(req_flag_, ctx.req_flag_);
+  std::swap(curr_request_level_, ctx.curr_request_level_);
+  std::swap(rpc_stat_srv_, ctx.rpc_stat_srv_);
+  std::swap(st_current_priority_, ctx.st_current_priority_);
+  std::swap(session_, ctx.session_);
+  std::swap(timeout_ts_, ctx.timeout_ts_);
+  std::swap(ntp_offset_, ctx.ntp_offset_);
+  std::swap(rpc_tenant_id_, ctx.rpc_tenant_id_);
+  std::swap(disable_wait_, ctx.disable_wait_);
+  const CompatMode compat_mode = get_compatibility_mode();
+  set_compatibility_mode(ctx.compat_mode_);
+  ctx.compat_mode_ = compat_mode;
+}
@@ -151,6 +151,43 @@ public:
     session_ = session;
   }
 
+  // Coroutine execution.
+  //
+  // can_coro_yield() tells whether current request runs on a coroutine
+  // which is allowed to give the thread out at a blocking wait point.
+  // coro_yield() switches back to the scheduler and returns after being
+  // resumed, callers must poll their wait condition again.
+  virtual bool can_coro_yield() const { return false; }
+  virtual void coro_yield() {}
+  // Sleep `us' microseconds, other coroutines are run meanwhile rather
+  // than blocking the thread if can_coro_yield().
+  void sleep_us(const int64_t us);
+
+  // Request related states of the worker. When a thread executes
+  // multiple requests on coroutines alternately, each coroutine keeps
+  // its own copy and swaps it with the worker on switching.
+  struct ReqCtx
+  {
+    ReqCtx()
+      : allocator_(nullptr), req_flag_(false), curr_request_level_(0),
+        rpc_stat_srv_(nullptr), st_current_priority_(0), session_(nullptr),
+        timeout_ts_(INT64_MAX), ntp_offset_(0), rpc_tenant_id_(0),
+        disable_wait_(false), compat_mode_(CompatMode::MYSQL)
+    {}
+    ObIAllocator *allocator_;
+    bool req_flag_;
+    int32_t curr_request_level_;
+    void *rpc_stat_srv_;
+    int64_t st_current_priority_;
+    sql::ObSQLSessionInfo *session_;
+    int64_t timeout_ts_;
+    int64_t ntp_offset_;
+    uint64_t rpc_tenant_id_;
+    bool disable_wait_;
+    CompatMode compat_mode_;
+  };
+  void swap_req_ctx(ReqCtx &ctx);
+
 public:
   static __thread Worker *self_;
 
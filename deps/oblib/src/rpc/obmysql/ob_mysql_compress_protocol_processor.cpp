@@ -16,6 +16,7 @@
 #include "rpc/obmysql/ob_mysql_util.h"
 #include "rpc/obmysql/ob_mysql_request_utils.h"
 #include "lib/compress/zlib/ob_zlib_compressor.h"
+#include "lib/compress/zstd_1_3_8/ob_zstd_compressor_1_3_8.h"
 #include "rpc/obmysql/obsm_struct.h"
 
 namespace oceanbase
@@ -77,7 +78,9 @@ int ObMysqlCompressProtocolProcessor::do_decode(ObSMConnection& conn, ObICSMemPo
 int ObMysqlCompressProtocolProcessor::do_splice(observer::ObSMConnection& conn, ObICSMemPool& pool, void*& pkt, bool& need_decode_more)
 {
   INIT_SUCC(ret);
-  if (OB_FAIL(process_compressed_packet(conn.compressed_pkt_context_, conn.mysql_pkt_context_, pool, pkt, need_decode_more))) {
+  const bool use_zstd = (ObCompressType::ZSTD_COMPRESS == conn.get_compress_type());
+  if (OB_FAIL(process_compressed_packet(conn.compressed_pkt_context_, conn.mysql_pkt_context_, pool,
+                                        use_zstd, pkt, need_decode_more))) {
     LOG_ERROR("fail to process_compressed_packet", K(ret));
   }
   return ret;
@@ -111,7 +114,7 @@ inline int ObMysqlCompressProtocolProcessor::decode_compressed_body(ObICSMemPool
 inline int ObMysqlCompressProtocolProcessor::decode_compressed_packet(
     const char *comp_buf, const uint32_t comp_pktlen,
     const uint32_t pktlen_before_compress, char *&pkt_body,
-    const uint32_t pkt_body_size)
+    const uint32_t pkt_body_size, const bool use_zstd)
 {
   int ret = OB_SUCCESS;
   if (OB_ISNULL(comp_buf) || OB_ISNULL(pkt_body)) {
@@ -127,10 +130,14 @@ inline int ObMysqlCompressProtocolProcessor::decode_compressed_packet(
     if (0 == pktlen_before_compress) {
       pkt_body = const_cast<char *>(comp_buf);
     } else {
-      ObZlibCompressor compressor;
+      ObZlibCompressor zlib_compressor;
+      zstd_1_3_8::ObZstdCompressor_1_3_8 zstd_compressor;
+      ObCompressor *compressor = (use_zstd
+                                  ? static_cast<ObCompressor *>(&zstd_compressor)
+                                  : static_cast<ObCompressor *>(&zlib_compressor));
       int64_t decompress_data_len = 0;
-      if (OB_FAIL(compressor.decompress(comp_buf, comp_pktlen, pkt_body,
-                                        pktlen_before_compress, decompress_data_len))) {
+      if (OB_FAIL(compressor->decompress(comp_buf, comp_pktlen, pkt_body,
+                                         pktlen_before_compress, decompress_data_len))) {
         LOG_ERROR("failed to decompress packet", K(ret));
       } else if (OB_UNLIKELY(pktlen_before_compress != decompress_data_len)) {
         ret = OB_ERR_UNEXPECTED;
@@ -144,7 +151,7 @@ inline int ObMysqlCompressProtocolProcessor::decode_compressed_packet(
 
 inline int ObMysqlCompressProtocolProcessor::process_compressed_packet(
     ObCompressedPktContext& context, ObMysqlPktContext &mysql_pkt_context, ObICSMemPool& pool,
-    void *&ipacket, bool &need_decode_more)
+    const bool use_zstd, void *&ipacket, bool &need_decode_more)
 {
   int ret = OB_SUCCESS;
   need_decode_more = true;
@@ -173,7 +180,7 @@ inline int ObMysqlCompressProtocolProcessor::process_compressed_packet(
       decompress_data_buf = tmp_buffer;
       if (OB_FAIL(decode_compressed_packet(iraw_pkt->get_cdata(), iraw_pkt->get_comp_len(),
                                            iraw_pkt->get_uncomp_len(), decompress_data_buf,
-                                           decompress_data_size))) {
+                                           decompress_data_size, use_zstd))) {
         LOG_ERROR("fail to decode_compressed_packet", K(ret));
       } else if (OB_FAIL(process_fragment_mysql_packet(mysql_pkt_context, pool, decompress_data_buf,
               decompress_data_size, ipacket, need_decode_more))) {
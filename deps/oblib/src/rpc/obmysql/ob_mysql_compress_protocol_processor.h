@@ -44,10 +44,10 @@ private:
 
   int decode_compressed_packet(const char *comp_buf, const uint32_t comp_pktlen,
                                const uint32_t pktlen_before_compress, char *&pkt_body,
-                               const uint32_t pkt_body_size);
+                               const uint32_t pkt_body_size, const bool use_zstd);
 
   int process_compressed_packet(ObCompressedPktContext& context, ObMysqlPktContext &mysql_pkt_context, ObICSMemPool& pool,
-                                void *&ipacket, bool &need_decode_more);
+                                const bool use_zstd, void *&ipacket, bool &need_decode_more);
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObMysqlCompressProtocolProcessor);
@@ -204,7 +204,8 @@ union ObMySQLCapabilityFlags
     uint32_t OB_CLIENT_CAN_HANDLE_EXPIRED_PASSWORDS:    1;
     uint32_t OB_CLIENT_SESSION_TRACK:                   1;
     uint32_t OB_CLIENT_DEPRECATE_EOF:                   1;
-    uint32_t OB_CLIENT_RESERVED_NOT_USE:                2;
+    uint32_t OB_CLIENT_OPTIONAL_RESULTSET_METADATA:     1;
+    uint32_t OB_CLIENT_ZSTD_COMPRESSION_ALGORITHM:      1;
     uint32_t OB_CLIENT_SUPPORT_ORACLE_MODE:             1;
     uint32_t OB_CLIENT_RETURN_HIDDEN_ROWID:             1;
     uint32_t OB_CLIENT_USE_LOB_LOCATOR:                 1;
@@ -240,7 +241,8 @@ enum ObClientCapabilityPos
   OB_CLIENT_CAN_HANDLE_EXPIRED_PASSWORDS_POS,
   OB_CLIENT_SESSION_TRACK_POS,
   OB_CLIENT_DEPRECATE_EOF_POS,
-  //RESERVED 2
+  OB_CLIENT_OPTIONAL_RESULTSET_METADATA_POS,
+  OB_CLIENT_ZSTD_COMPRESSION_ALGORITHM_POS,
   OB_CLIENT_SUPPORT_ORACLE_MODE_POS = 27,
   OB_CLIENT_RETURN_ROWID_POS = 28,
   OB_CLIENT_USE_LOB_LOCATOR_POS = 29,
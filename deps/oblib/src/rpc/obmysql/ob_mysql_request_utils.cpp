@@ -13,7 +13,9 @@
 #include "ob_mysql_request_utils.h"
 #include "lib/allocator/ob_malloc.h"
 #include "lib/compress/zlib/ob_zlib_compressor.h"
+#include "lib/compress/zstd_1_3_8/ob_zstd_compressor_1_3_8.h"
 #include "lib/stat/ob_diagnose_info.h"
+#include "lib/time/ob_time_utility.h"
 #include "rpc/ob_request.h"
 #include "rpc/obmysql/ob_mysql_util.h"
 #include "rpc/obmysql/ob_mysql_packet.h"
@@ -30,12 +32,21 @@ ObMySQLRequestUtils::ObMySQLRequestUtils(){}
 
 ObMySQLRequestUtils::~ObMySQLRequestUtils(){}
 
-static int64_t get_max_comp_pkt_size(const int64_t uncomp_pkt_size)
+static int64_t get_max_comp_pkt_size(const int64_t uncomp_pkt_size, const bool is_zstd)
 {
   int64_t ret_size = 0;
   if (uncomp_pkt_size > MAX_COMPRESSED_BUF_SIZE) {
     //limit max comp_buf_size is 2M-1k
     ret_size = MAX_COMPRESSED_BUF_SIZE;
+  } else if (is_zstd) {
+    // same as ObZstdCompressor_1_3_8::get_max_overflow_size
+    ret_size = (common::OB_MYSQL_COMPRESSED_HEADER_SIZE
+                + uncomp_pkt_size
+                + (uncomp_pkt_size >> 7)
+                + 512 + 12);
+    if (ret_size > MAX_COMPRESSED_BUF_SIZE) {
+      ret_size = MAX_COMPRESSED_BUF_SIZE;
+    }
   } else {
     ret_size = (common::OB_MYSQL_COMPRESSED_HEADER_SIZE
                 + uncomp_pkt_size
@@ -73,19 +84,29 @@ static int build_compressed_packet(ObEasyBuffer &src_buf,
   } else {
     ObEasyBuffer dst_buf(*context.send_buf_);
     const int64_t comp_buf_size = dst_buf.write_avail_size() - OB_MYSQL_COMPRESSED_HEADER_SIZE;
-    ObZlibCompressor compressor;
+    ObZlibCompressor zlib_compressor;
+    zstd_1_3_8::ObZstdCompressor_1_3_8 zstd_compressor;
+    ObCompressor *compressor = &zlib_compressor;
     bool use_real_compress = true;
     if (context.use_checksum()) {
-      compressor.set_compress_level(0);
+      zlib_compressor.set_compress_level(0);
       use_real_compress = !context.is_checksum_off_;
+    } else if (context.is_zstd_compress()) {
+      compressor = &zstd_compressor;
+      if (context.zstd_level_ > 0
+          && OB_FAIL(zstd_compressor.set_compress_level(context.zstd_level_))) {
+        SERVER_LOG(WARN, "invalid zstd compress level", K(context), K(ret));
+      }
     }
     int64_t dst_data_size = 0;
     int64_t pos = 0;
     int64_t len_before_compress = 0;
-    if (use_real_compress) {
-      if (OB_FAIL(compressor.compress(src_buf.read_pos(), next_compress_size,
-                                      dst_buf.last() + OB_MYSQL_COMPRESSED_HEADER_SIZE,
-                                      comp_buf_size, dst_data_size))) {
+    const int64_t begin_ts = ObTimeUtility::fast_current_time();
+    if (OB_FAIL(ret)) {
+    } else if (use_real_compress) {
+      if (OB_FAIL(compressor->compress(src_buf.read_pos(), next_compress_size,
+                                       dst_buf.last() + OB_MYSQL_COMPRESSED_HEADER_SIZE,
+                                       comp_buf_size, dst_data_size))) {
         SERVER_LOG(WARN, "compress packet failed", K(ret));
       } else if (OB_UNLIKELY(dst_data_size > comp_buf_size)) {
         ret = OB_SIZE_OVERFLOW;
@@ -117,6 +138,11 @@ static int build_compressed_packet(ObEasyBuffer &src_buf,
       src_buf.read(next_compress_size);
       dst_buf.write(dst_data_size + OB_MYSQL_COMPRESSED_HEADER_SIZE);
       ++context.seq_;
+      if (use_real_compress) {
+        EVENT_ADD(MYSQL_COMPRESS_ORIGINAL_SIZE, next_compress_size);
+        EVENT_ADD(MYSQL_COMPRESS_COMPRESSED_SIZE, dst_data_size);
+        EVENT_ADD(MYSQL_COMPRESS_TIME, ObTimeUtility::fast_current_time() - begin_ts);
+      }
     }
   }
   return ret;
@@ -135,7 +161,7 @@ static int build_compressed_buffer(ObEasyBuffer &orig_send_buf,
       const int64_t max_read_step = context.get_max_read_step();
       int64_t next_read_size = orig_send_buf.get_next_read_size(context.last_pkt_pos_, max_read_step);
       int64_t last_read_size = 0;
-      int64_t max_comp_pkt_size = get_max_comp_pkt_size(next_read_size);
+      int64_t max_comp_pkt_size = get_max_comp_pkt_size(next_read_size, context.is_zstd_compress());
       while (OB_SUCC(ret)
              && next_read_size > 0
              && max_comp_pkt_size <= comp_send_buf.write_avail_size()) {
@@ -151,7 +177,7 @@ static int build_compressed_buffer(ObEasyBuffer &orig_send_buf,
           last_read_size = next_read_size;
           next_read_size = orig_send_buf.get_next_read_size(context.last_pkt_pos_, max_read_step);
           if (last_read_size != next_read_size) {
-            max_comp_pkt_size = get_max_comp_pkt_size(next_read_size);
+            max_comp_pkt_size = get_max_comp_pkt_size(next_read_size, context.is_zstd_compress());
           }
         }
       }
@@ -168,9 +194,11 @@ static int reuse_compress_buffer(ObCompressionContext &comp_context, ObEasyBuffe
   if (NULL == comp_context.send_buf_) {
     need_alloc = true;
     //use buf_size to avoid alloc again next time
-    comp_buf_size = get_max_comp_pkt_size(orig_send_buf.orig_buf_size());
+    comp_buf_size = get_max_comp_pkt_size(orig_send_buf.orig_buf_size(),
+                                          comp_context.is_zstd_compress());
   } else {
-    const int64_t new_size = get_max_comp_pkt_size(orig_send_buf.read_avail_size());
+    const int64_t new_size = get_max_comp_pkt_size(orig_send_buf.read_avail_size(),
+                                                   comp_context.is_zstd_compress());
     if (new_size <= comp_buf_size) {
       //reusing last size is enough
     } else {
@@ -312,7 +340,8 @@ int ObMySQLRequestUtils::check_flush_param(ObFlushBufferParam &param)
       ret = OB_ERR_UNEXPECTED;
       SERVER_LOG(ERROR, "last_pkt_pos_ or send_buf is not null", K(param.comp_context_), K(ret));
     }
-  } else if (param.comp_context_.is_default_compress()) {
+  } else if (param.comp_context_.is_default_compress()
+             || param.comp_context_.is_zstd_compress()) {
     if (OB_NOT_NULL(param.comp_context_.last_pkt_pos_)) {
       ret = OB_ERR_UNEXPECTED;
       SERVER_LOG(ERROR, "last_pkt_pos_ is not null", K(param.comp_context_), K(ret));
@@ -394,13 +423,16 @@ int ObMySQLRequestUtils::reuse_compressed_buffer(ObFlushBufferParam &param,
     need_alloc = true;
     if (is_last_flush) {
       //use data size is enough
-      comp_buf_size = get_max_comp_pkt_size(param.orig_send_buf_.orig_data_size());
+      comp_buf_size = get_max_comp_pkt_size(param.orig_send_buf_.orig_data_size(),
+                                           param.comp_context_.is_zstd_compress());
     } else {
       //use buf_size to avoid alloc again next time
-      comp_buf_size = get_max_comp_pkt_size(param.orig_send_buf_.orig_buf_size());
+      comp_buf_size = get_max_comp_pkt_size(param.orig_send_buf_.orig_buf_size(),
+                                           param.comp_context_.is_zstd_compress());
     }
   } else {
-    const int64_t new_size = get_max_comp_pkt_size(param.orig_send_buf_.read_avail_size());
+    const int64_t new_size = get_max_comp_pkt_size(param.orig_send_buf_.read_avail_size(),
+                                           param.comp_context_.is_zstd_compress());
     if (new_size <= comp_buf_size) {
       //reusing last size is enough
     } else {
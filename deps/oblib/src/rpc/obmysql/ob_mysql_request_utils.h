@@ -218,6 +218,7 @@ enum ObCompressType
                     //2. put error+ok/eof+ok/ok in one compressed packet, and seq=last seq
   DEFAULT_CHECKSUM, //use level 0 compress based on DEFAULT_COMPRESS
   PROXY_CHECKSUM,   //use level 0 compress based on PROXY_COMPRESS
+  ZSTD_COMPRESS,    //same as DEFAULT_COMPRESS, but use zstd instead of zlib (mysql 8.0 zstd)
 };
 
 class ObCompressionContext
@@ -233,6 +234,7 @@ public:
   bool is_default_compress() const { return DEFAULT_COMPRESS == type_; }
   bool is_default_checksum() const { return DEFAULT_CHECKSUM == type_; }
   bool is_proxy_checksum() const { return PROXY_CHECKSUM == type_; }
+  bool is_zstd_compress() const { return ZSTD_COMPRESS == type_; }
   bool is_proxy_compress_based() const { return is_proxy_checksum() || is_proxy_compress(); }
   bool use_checksum() const { return is_proxy_checksum() || is_default_checksum(); }
   void update_last_pkt_pos(char *pkt_pos)
@@ -263,7 +265,7 @@ public:
   {
     int64_t pos = 0;
     J_OBJ_START();
-    J_KV(K_(sessid), K_(type), K_(is_checksum_off), K_(seq), KP_(last_pkt_pos));
+    J_KV(K_(sessid), K_(type), K_(is_checksum_off), K_(seq), KP_(last_pkt_pos), K_(zstd_level));
     J_COMMA();
     if (NULL != send_buf_) {
       J_KV("send_buf", ObEasyBuffer(*send_buf_));
@@ -281,6 +283,7 @@ public:
   easy_buf_t *send_buf_;
   char *last_pkt_pos_;//proxy last pkt(error+ok, eof+ok, ok)'s pos in orig_ezbuf, default is null
   uint32_t sessid_;
+  int8_t zstd_level_;//only used by ZSTD_COMPRESS, 0 means default level
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObCompressionContext);
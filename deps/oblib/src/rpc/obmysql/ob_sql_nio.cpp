@@ -144,6 +144,11 @@ public:
   }
   int64_t get_remain_sz() const { return remain(); }
   void set_fd(int fd) { fd_ = fd; }
+  // data already read from fd but not consumed, never trigger read
+  void get_buffered_data(const char*& buf, int64_t& sz) const {
+    buf = cur_buf_;
+    sz = remain();
+  }
   int peek_data(int64_t limit, const char*& buf, int64_t& sz) {
     int ret = OB_SUCCESS;
     if (OB_FAIL(try_read_fd(limit))) {
@@ -343,6 +348,9 @@ public:
     return  read_buffer_.peek_data(limit ,buf, sz);
   }
   int consume_data(int64_t sz) { return read_buffer_.consume_data(sz); }
+  void get_buffered_data(const char*& buf, int64_t& sz) const {
+    read_buffer_.get_buffered_data(buf, sz);
+  }
   void init_write_task(const char* buf, int64_t sz) {
     pending_write_task_.init(buf, sz);
   }
@@ -930,6 +938,11 @@ int ObSqlNio::consume_data(void* sess, int64_t sz)
   return sess2sock(sess)->consume_data(sz);
 }
 
+void ObSqlNio::get_buffered_data(void* sess, const char*& buf, int64_t& sz)
+{
+  sess2sock(sess)->get_buffered_data(buf, sz);
+}
+
 int ObSqlNio::write_data(void* sess, const char* buf, int64_t sz)
 {
   return sess2sock(sess)->write_data(buf, sz);
@@ -15,6 +15,7 @@
 #include <pthread.h>
 #include <stdint.h>
 #include "lib/thread/threads.h"
+#include "lib/atomic/ob_atomic.h"
 
 namespace oceanbase
 {
@@ -25,7 +26,7 @@ class ObISqlSockHandler;
 class ObSqlNio: public lib::Threads
 {
 public:
-  ObSqlNio(): impl_(NULL) {}
+  ObSqlNio(): impl_(NULL), pipeline_coalesce_size_(0) {}
   virtual ~ObSqlNio() {}
   int start(int port, ObISqlSockHandler* handler, int n_thread);
   bool has_error(void* sess);
@@ -33,6 +34,7 @@ public:
   void revert_sock(void* sess);
   int peek_data(void* sess, int64_t limit, const char*& buf, int64_t& sz);
   int consume_data(void* sess, int64_t sz);
+  void get_buffered_data(void* sess, const char*& buf, int64_t& sz);
   int write_data(void* sess, const char* buf, int64_t sz);
   void async_write_data(void* sess, const char* buf, int64_t sz);
   void stop();
@@ -43,10 +45,14 @@ public:
   void set_sql_session_info(void* sess, void* sql_session);
   void set_shutdown(void* sess);
   void shutdown(void* sess);
+  // 客户端 pipeline 发送请求时, 最多合并多少字节的响应再写 socket, 0 表示不合并
+  void set_pipeline_coalesce_size(int64_t size) { ATOMIC_STORE(&pipeline_coalesce_size_, size); }
+  int64_t get_pipeline_coalesce_size() const { return ATOMIC_LOAD(&pipeline_coalesce_size_); }
 private:
   void run(int64_t idx);
 private:
   ObSqlNioImpl* impl_;
+  int64_t pipeline_coalesce_size_;
 };
 
 }; // end namespace obmysql
@@ -30,6 +30,7 @@ public:
   int peek_data(void* sess, int64_t limit, const char*& buf, int64_t& sz);
   int consume_data(void* sess, int64_t sz);
   int write_data(void* sess, const char* buf, int64_t sz);
+  void set_pipeline_coalesce_size(int64_t size) { nio_.set_pipeline_coalesce_size(size); }
   void stop();
   void wait();
   void destroy();
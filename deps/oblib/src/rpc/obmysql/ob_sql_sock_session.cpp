@@ -12,7 +12,9 @@
 
 #define USING_LOG_PREFIX RPC_OBMYSQL
 #include "rpc/obmysql/ob_sql_sock_session.h"
+#include "lib/allocator/ob_malloc.h"
 #include "rpc/obmysql/ob_sql_nio.h"
+#include "rpc/obmysql/ob_mysql_util.h"
 
 namespace oceanbase
 {
@@ -28,7 +30,10 @@ ObSqlSockSession::ObSqlSockSession(ObISMConnectionCallback& conn_cb, ObSqlNio& n
     sql_req_(ObRequest::OB_MYSQL, 1),
     last_pkt_sz_(0),
     pending_write_buf_(NULL),
-    pending_write_sz_(0)
+    pending_write_sz_(0),
+    coalesce_buf_(NULL),
+    coalesce_buf_size_(0),
+    coalesce_data_sz_(0)
 {
   sql_req_.set_server_handle_context(this);
 }
@@ -44,6 +49,12 @@ void ObSqlSockSession::destroy()
 {
   sm_conn_cb_.destroy(conn_);
   pool_.reset();
+  if (NULL != coalesce_buf_) {
+    ob_free(coalesce_buf_);
+    coalesce_buf_ = NULL;
+    coalesce_buf_size_ = 0;
+    coalesce_data_sz_ = 0;
+  }
 }
 
 void ObSqlSockSession::destroy_sock()
@@ -73,11 +84,24 @@ void ObSqlSockSession::revert_sock()
     last_pkt_sz_ = 0;
   }
   sql_req_.reset_trace_id();
-  if (pending_write_buf_) {
-    const char * data = pending_write_buf_;
-    int64_t sz = pending_write_sz_;
-    pending_write_buf_ = NULL;
-    pending_write_sz_ = 0;
+  const char *data = pending_write_buf_;
+  int64_t sz = pending_write_sz_;
+  pending_write_buf_ = NULL;
+  pending_write_sz_ = 0;
+  if (NULL != data && has_pipelined_request() && try_coalesce_write(data, sz)) {
+    // 后续请求已在读缓冲中, 响应留到后续请求处理完后一起写出
+    data = NULL;
+    sz = 0;
+  } else if (coalesce_data_sz_ > 0) {
+    if (NULL == data || try_coalesce_write(data, sz)) {
+      data = coalesce_buf_;
+      sz = coalesce_data_sz_;
+    } else if (OB_SUCCESS != flush_coalesced_data()) {
+      data = NULL;
+      sz = 0;
+    }
+  }
+  if (NULL != data) {
     nio_.async_write_data((void*)this, data, sz);
   } else {
     pool_.reuse();
@@ -89,10 +113,74 @@ void ObSqlSockSession::on_flushed()
 {
   /* TODO should not go here*/
   //abort();
+  coalesce_data_sz_ = 0;
   pool_.reuse();
   nio_.revert_sock((void*)this);
 }
 
+bool ObSqlSockSession::has_pipelined_request()
+{
+  // 只识别普通 MySQL 协议: 读缓冲中已有一个完整的后续请求包
+  bool bret = false;
+  const char *buf = NULL;
+  int64_t sz = 0;
+  if (OB_MYSQL_CS_TYPE == conn_.get_cs_protocol_type() && conn_.is_in_authed_phase()) {
+    nio_.get_buffered_data((void*)this, buf, sz);
+    if (sz >= OB_MYSQL_HEADER_LENGTH) {
+      uint32_t pkt_len = 0;
+      ObMySQLUtil::get_uint3(buf, pkt_len);
+      bret = sz >= OB_MYSQL_HEADER_LENGTH + pkt_len;
+    }
+  }
+  return bret;
+}
+
+bool ObSqlSockSession::try_coalesce_write(const char* buf, int64_t sz)
+{
+  bool bret = false;
+  const int64_t limit = nio_.get_pipeline_coalesce_size();
+  if (limit <= 0 || coalesce_data_sz_ + sz > limit) {
+    // too large, write directly
+  } else {
+    if (NULL == coalesce_buf_ || coalesce_buf_size_ < limit) {
+      char *new_buf = static_cast<char*>(ob_malloc(limit, "SqlPipeline"));
+      if (NULL != new_buf) {
+        if (coalesce_data_sz_ > 0) {
+          MEMCPY(new_buf, coalesce_buf_, coalesce_data_sz_);
+        }
+        if (NULL != coalesce_buf_) {
+          ob_free(coalesce_buf_);
+        }
+        coalesce_buf_ = new_buf;
+        coalesce_buf_size_ = limit;
+      }
+    }
+    if (NULL != coalesce_buf_ && coalesce_data_sz_ + sz <= coalesce_buf_size_) {
+      MEMCPY(coalesce_buf_ + coalesce_data_sz_, buf, sz);
+      coalesce_data_sz_ += sz;
+      bret = true;
+    }
+  }
+  return bret;
+}
+
+int ObSqlSockSession::flush_coalesced_data()
+{
+  int ret = OB_SUCCESS;
+  if (coalesce_data_sz_ > 0) {
+    const int64_t sz = coalesce_data_sz_;
+    coalesce_data_sz_ = 0;
+    if (has_error()) {
+      ret = OB_IO_ERROR;
+      LOG_WARN("sock has error", K(ret));
+    } else if (OB_FAIL(nio_.write_data((void*)this, coalesce_buf_, sz))) {
+      LOG_WARN("write coalesced data fail", K(ret), K(sz));
+      destroy_sock();
+    }
+  }
+  return ret;
+}
+
 bool ObSqlSockSession::has_error()
 {
   return nio_.has_error((void*)this);
@@ -134,7 +222,9 @@ void ObSqlSockSession::set_last_decode_succ_and_deliver_time(int64_t time)
 int ObSqlSockSession::write_data(const char* buf, int64_t sz)
 {
   int ret = OB_SUCCESS;
-  if (has_error()) {
+  // keep the order of responses, write the coalesced responses of previous requests first
+  if (OB_FAIL(flush_coalesced_data())) {
+  } else if (has_error()) {
     ret = OB_IO_ERROR;
     LOG_WARN("sock has error", K(ret));
   } else if (OB_FAIL(nio_.write_data((void*)this, buf, sz))) {
@@ -59,6 +59,11 @@ public:
   int on_disconnect();
   void clear_sql_session_info();
   void set_sql_session_info(void* sess);
+private:
+  bool has_pipelined_request();
+  bool try_coalesce_write(const char* buf, int64_t sz);
+  int flush_coalesced_data();
+public:
   ObSqlNio& nio_;
   ObISMConnectionCallback& sm_conn_cb_;
   rpc::ObRequest sql_req_;
@@ -67,6 +72,10 @@ public:
   int64_t last_pkt_sz_; // to be consumed
   const char* pending_write_buf_;
   int64_t pending_write_sz_;
+  // 客户端 pipeline 时, 已经收到后续请求, 当前请求的响应先合并到这里, 与后续响应一起写出
+  char* coalesce_buf_;
+  int64_t coalesce_buf_size_;
+  int64_t coalesce_data_sz_;
   common::ObAddr client_addr_;
 };
 
@@ -65,6 +65,7 @@ public:
     proxy_version_ = 0;
     group_id_ = 0;
     client_cs_type_ = 0;
+    zstd_compress_level_ = 0;
   }
 
   obmysql::ObCompressType get_compress_type() {
@@ -98,6 +99,10 @@ public:
       } else {
         type_ret = obmysql::ObCompressType::DEFAULT_COMPRESS;
       }
+    } else if (is_in_authed_phase() && is_normal_client()
+               && 1 == cap_flags_.cap_flags_.OB_CLIENT_ZSTD_COMPRESSION_ALGORITHM) {
+      // mysql 8.0 client with --compression-algorithms=zstd
+      type_ret = obmysql::ObCompressType::ZSTD_COMPRESS;
     }
     return type_ret;
   }
@@ -129,7 +134,8 @@ public:
     common::ObCSProtocolType type = common::OB_INVALID_CS_TYPE;
     if (proxy_cap_flags_.is_ob_protocol_v2_support()) {
       type = common::OB_2_0_CS_TYPE;
-    } else if (1 == cap_flags_.cap_flags_.OB_CLIENT_COMPRESS) {
+    } else if (1 == cap_flags_.cap_flags_.OB_CLIENT_COMPRESS
+               || 1 == cap_flags_.cap_flags_.OB_CLIENT_ZSTD_COMPRESSION_ALGORITHM) {
       type = common::OB_MYSQL_COMPRESS_CS_TYPE;
     } else {
       type = common::OB_MYSQL_CS_TYPE;
@@ -180,6 +186,7 @@ public:
   uint64_t proxy_version_;
   int32_t group_id_;
   int32_t client_cs_type_;
+  int8_t zstd_compress_level_; // zstd level requested by client in handshake response
 };
 } // end of namespace observer
 } // end of namespace oceanbase
@@ -64,6 +64,13 @@ public:
   {
     server_capabilities_lower_.capability_flag_.OB_SERVER_SSL = (use_ssl ? 1 : 0);
   }
+  // zstd 压缩协议依赖 compress 能力, 两者需要同时打开
+  void set_compress_cap(const bool use_compress, const bool use_zstd)
+  {
+    server_capabilities_lower_.capability_flag_.OB_SERVER_CAN_USE_COMPRESS = (use_compress ? 1 : 0);
+    server_capabilities_upper_.capability_flag_.OB_SERVER_ZSTD_COMPRESSION_ALGORITHM =
+        (use_compress && use_zstd ? 1 : 0);
+  }
 
   struct CapabilitiesFlagLower
   {
@@ -101,7 +108,8 @@ public:
     uint16_t OB_SERVER_CAN_HANDLE_EXPIRED_PASSWORDS:1;
     uint16_t OB_SERVER_SESSION_VARIABLE_TRACK:1;
     uint16_t OB_SERVER_DEPRECATE_EOF:1;
-    uint16_t OB_SERVER_RESERVED:2;
+    uint16_t OB_SERVER_OPTIONAL_RESULTSET_METADATA:1;
+    uint16_t OB_SERVER_ZSTD_COMPRESSION_ALGORITHM:1;
     uint16_t OB_SERVER_SUPPORT_ORACLE_MODE:1;
     uint16_t OB_SERVER_RETURN_HIDDEN_ROWID:1;
     uint16_t OB_SERVER_USE_LOB_LOCATOR:1;
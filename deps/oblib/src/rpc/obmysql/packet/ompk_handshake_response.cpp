@@ -29,6 +29,7 @@ void OMPKHandshakeResponse::reset()
   database_.reset();
   auth_plugin_name_.reset();
   connect_attrs_.reset();
+  zstd_compression_level_ = 0;
 }
 
 int OMPKHandshakeResponse::decode()
@@ -181,6 +182,13 @@ int OMPKHandshakeResponse::decode()
     }
   }
 
+  // zstd_compression_level, only sent by mysql 8.0 client with CLIENT_ZSTD_COMPRESSION_ALGORITHM
+  if (OB_SUCC(ret) && pos < end) {
+    if (capability_.cap_flags_.OB_CLIENT_ZSTD_COMPRESSION_ALGORITHM) {
+      ObMySQLUtil::get_uint1(pos, zstd_compression_level_);
+    }
+  }
+
   // MySQL doesn't care whether there's bytes remain, we do so.  JDBC
   // won't set OB_CLIENT_CONNECT_WITH_DB but leaves a '\0' in the db
   // field when database name isn't specified. It can confuse us if we
@@ -214,6 +222,9 @@ int64_t OMPKHandshakeResponse::get_serialize_size() const
     all_attr_len += ObMySQLUtil::get_number_store_len(all_attr_len);
     len += all_attr_len;
   }
+  if (capability_.cap_flags_.OB_CLIENT_ZSTD_COMPRESSION_ALGORITHM) {
+    len += 1;
+  }
   return len;
 }
 
@@ -299,6 +310,13 @@ int OMPKHandshakeResponse::serialize(char *buffer, const int64_t length, int64_t
           }
         }
       }
+      if (capability_.cap_flags_.OB_CLIENT_ZSTD_COMPRESSION_ALGORITHM) {
+        if (OB_SUCC(ret)) {
+          if (OB_FAIL(ObMySQLUtil::store_int1(buffer, length, zstd_compression_level_, pos))) {
+            LOG_WARN("store fail", K(ret), KP(buffer), K(length), K(pos));
+          }
+        }
+      }
     }
   }
   return ret;
@@ -29,7 +29,8 @@ class OMPKHandshakeResponse : public ObMySQLPacket
 public:
   OMPKHandshakeResponse()
     : capability_(), max_packet_size_(0), character_set_(0), username_(),
-      auth_response_(), database_(), auth_plugin_name_(), connect_attrs_() {}
+      auth_response_(), database_(), auth_plugin_name_(), connect_attrs_(),
+      zstd_compression_level_(0) {}
 
   virtual ~OMPKHandshakeResponse() { }
 
@@ -56,6 +57,7 @@ public:
   inline const ObString &get_database() const { return database_; }
   inline const ObString &get_auth_plugin_name() const { return auth_plugin_name_; }
   inline const common::ObIArray<ObStringKV> &get_connect_attrs() const { return connect_attrs_; }
+  inline uint8_t get_zstd_compression_level() const { return zstd_compression_level_; }
   bool is_obproxy_client_mode() const;
   bool is_java_client_mode() const;
   bool is_oci_client_mode() const;
@@ -68,12 +70,13 @@ public:
   inline void set_auth_response(const ObString &auth_response) { auth_response_ = auth_response; }
   inline void set_database(const ObString &database) { database_ = database; }
   inline void set_auth_plugin_name(const ObString &plugin_name) { auth_plugin_name_ = plugin_name; }
+  inline void set_zstd_compression_level(const uint8_t level) { zstd_compression_level_ = level; }
   int add_connect_attr(const ObStringKV &string_kv);
   void reset_connect_attr() { connect_attrs_.reset(); }
 
   VIRTUAL_TO_STRING_KV("header", hdr_, K_(capability_.capability), K_(max_packet_size),
                        K_(character_set), K_(username), K_(database), K_(auth_plugin_name),
-                       K_(connect_attrs));
+                       K_(connect_attrs), K_(zstd_compression_level));
 private:
   uint64_t get_connect_attrs_len() const;
 
@@ -100,6 +103,8 @@ private:
   ObString auth_plugin_name_;
   // connection attributes
   common::ObSEArray<ObStringKV, 8> connect_attrs_;
+  // compression level of zstd, only valid when OB_CLIENT_ZSTD_COMPRESSION_ALGORITHM is set
+  uint8_t zstd_compression_level_;
 }; // end of class OMPKHandshakeResponse
 
 } // end of namespace obmysql
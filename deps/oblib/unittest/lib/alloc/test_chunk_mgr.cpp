@@ -82,3 +82,72 @@ TEST_F(TestChunkMgr, FreeListManyChunk)
   EXPECT_EQ(500*2, free_list_.get_pushes());
   EXPECT_EQ(500, free_list_.get_pops());
 }
+
+TEST_F(TestChunkMgr, HugePagePool)
+{
+  // normal pages stand in for huge pages in test
+  const int64_t pool_size = 4 * INTACT_ACHUNK_SIZE;
+  ASSERT_EQ(OB_SUCCESS, huge_page_pool_.reserve(pool_size, 0));
+  ASSERT_EQ(pool_size, huge_page_pool_.get_total());
+  ASSERT_FALSE(huge_page_pool_.is_hugetlb());
+  // the whole pool is charged once reserved
+  const int64_t hold = get_hold();
+  const int64_t total_hold = get_total_hold();
+  ASSERT_EQ(OB_SUCCESS, charge_huge_page_pool());
+  EXPECT_EQ(hold + pool_size, get_hold());
+  EXPECT_EQ(total_hold + pool_size, get_total_hold());
+  EXPECT_EQ(0, get_used());
+
+  AChunk *chunks[5] = {};
+  for (int i = 0; i < 4; i++) {
+    chunks[i] = alloc_chunk(OB_MALLOC_BIG_BLOCK_SIZE, false, ObLargePageHelper::POOL_LARGE_PAGE);
+    ASSERT_NE(nullptr, chunks[i]);
+    EXPECT_TRUE(huge_page_pool_.contains(chunks[i]));
+    EXPECT_EQ(0, (uint64_t)chunks[i] & (INTACT_ACHUNK_SIZE - 1));
+  }
+  EXPECT_EQ(pool_size, huge_page_pool_.get_used());
+  EXPECT_EQ(hold + pool_size, get_hold());
+  EXPECT_EQ(pool_size, get_used());
+  // pool exhausted, mapped directly
+  chunks[4] = alloc_chunk(OB_MALLOC_BIG_BLOCK_SIZE, false, ObLargePageHelper::POOL_LARGE_PAGE);
+  ASSERT_NE(nullptr, chunks[4]);
+  EXPECT_FALSE(huge_page_pool_.contains(chunks[4]));
+  // large chunk is never served by pool
+  AChunk *large = alloc_chunk(2 * INTACT_ACHUNK_SIZE, false, ObLargePageHelper::POOL_LARGE_PAGE);
+  ASSERT_NE(nullptr, large);
+  EXPECT_FALSE(huge_page_pool_.contains(large));
+  free_chunk(large);
+
+  const int64_t pushes = get_free_chunk_pushes();
+  for (int i = 0; i < 5; i++) {
+    free_chunk(chunks[i]);
+  }
+  EXPECT_EQ(0, huge_page_pool_.get_used());
+  // pool chunks stay charged
+  EXPECT_EQ(hold + pool_size, get_hold() - get_freelist_hold());
+  // only the mapped one is cached
+  EXPECT_EQ(pushes + 1, get_free_chunk_pushes());
+
+  // chunks with other policy don't touch pool
+  AChunk *chunk = alloc_chunk(OB_MALLOC_BIG_BLOCK_SIZE, false, ObLargePageHelper::NO_LARGE_PAGE);
+  ASSERT_NE(nullptr, chunk);
+  EXPECT_FALSE(huge_page_pool_.contains(chunk));
+  EXPECT_EQ(0, huge_page_pool_.get_used());
+  free_chunk(chunk);
+  EXPECT_EQ(pool_size, get_hold() - get_freelist_hold());
+  EXPECT_EQ(0, get_used());
+}
+
+TEST_F(TestChunkMgr, CtxLargePageParam)
+{
+  EXPECT_EQ(OB_SUCCESS, ObLargePageHelper::check_ctx_param("MEMSTORE_CTX_ID:pool,WORK_AREA:true"));
+  EXPECT_NE(OB_SUCCESS, ObLargePageHelper::check_ctx_param("MEMSTORE_CTX_ID"));
+  EXPECT_NE(OB_SUCCESS, ObLargePageHelper::check_ctx_param("MEMSTORE_CTX_ID:maybe"));
+  EXPECT_NE(OB_SUCCESS, ObLargePageHelper::check_ctx_param("NO_SUCH_CTX:true"));
+
+  ObLargePageHelper::set_param("false");
+  ASSERT_EQ(OB_SUCCESS, ObLargePageHelper::set_ctx_param("MEMSTORE_CTX_ID:pool,WORK_AREA:only"));
+  EXPECT_EQ(ObLargePageHelper::POOL_LARGE_PAGE, ObLargePageHelper::get_type(ObCtxIds::MEMSTORE_CTX_ID));
+  EXPECT_EQ(ObLargePageHelper::ONLY_LARGE_PAGE, ObLargePageHelper::get_type(ObCtxIds::WORK_AREA));
+  EXPECT_EQ(ObLargePageHelper::NO_LARGE_PAGE, ObLargePageHelper::get_type(ObCtxIds::DEFAULT_CTX_ID));
+}
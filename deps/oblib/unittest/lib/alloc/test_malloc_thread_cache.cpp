@@ -0,0 +1,198 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "lib/alloc/ob_malloc_thread_cache.h"
+#include "lib/alloc/ob_malloc_allocator.h"
+#include "lib/allocator/ob_malloc.h"
+#include "lib/time/ob_time_utility.h"
+
+using namespace std;
+using namespace oceanbase::lib;
+using namespace oceanbase::common;
+
+class TestMallocThreadCache
+    : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    ObMallocThreadCache::set_max_cache_size(64L << 10);
+  }
+
+  virtual void TearDown()
+  {
+    auto *ta = ObMallocAllocator::get_instance()->get_tenant_ctx_allocator(
+        OB_SERVER_TENANT_ID, ObCtxIds::DEFAULT_CTX_ID);
+    ObMallocThreadCache::flush(*ta);
+    ObMallocThreadCache::set_max_cache_size(0);
+  }
+};
+
+TEST_F(TestMallocThreadCache, Basic)
+{
+  ObMemAttr attr(OB_SERVER_TENANT_ID, "TCacheTest");
+  void *ptr = ob_malloc(100, attr);
+  ASSERT_NE(nullptr, ptr);
+  AObject *obj = reinterpret_cast<AObject*>((char*)ptr - AOBJECT_HEADER_SIZE);
+  // rounded up to size class
+  EXPECT_EQ(128, obj->alloc_bytes_);
+  const int64_t hold = ObMallocThreadCache::get_total_hold();
+  ob_free(ptr);
+  EXPECT_EQ(hold + 128, ObMallocThreadCache::get_total_hold());
+  EXPECT_STREQ("MallocTCache", obj->label_);
+  // a second free fails the magic check
+  EXPECT_TRUE(obj->in_cache_);
+  EXPECT_NE(AOBJECT_MAGIC_CODE, obj->MAGIC_CODE_);
+
+  // same class reuses the cached object
+  void *ptr2 = ob_malloc(120, "TCacheTest2");
+  EXPECT_EQ(ptr, ptr2);
+  EXPECT_STREQ("TCacheTest2", obj->label_);
+  EXPECT_EQ(AOBJECT_MAGIC_CODE, obj->MAGIC_CODE_);
+  EXPECT_EQ(hold, ObMallocThreadCache::get_total_hold());
+  ob_free(ptr2);
+
+  // large objects bypass the cache
+  void *big = ob_malloc(ObMallocThreadCache::MAX_CLASS_SIZE + 1, attr);
+  ASSERT_NE(nullptr, big);
+  const int64_t hold2 = ObMallocThreadCache::get_total_hold();
+  ob_free(big);
+  EXPECT_EQ(hold2, ObMallocThreadCache::get_total_hold());
+
+  auto *ta = ObMallocAllocator::get_instance()->get_tenant_ctx_allocator(
+      OB_SERVER_TENANT_ID, ObCtxIds::DEFAULT_CTX_ID);
+  ObMallocThreadCache::flush(*ta);
+  EXPECT_EQ(0, ObMallocThreadCache::get_total_hold());
+}
+
+TEST_F(TestMallocThreadCache, Bounded)
+{
+  const int64_t cnt = 1024;
+  vector<void*> ptrs;
+  for (int64_t i = 0; i < cnt; i++) {
+    void *ptr = ob_malloc(32 * (1 + i % ObMallocThreadCache::CLASS_CNT), "TCacheTest");
+    ASSERT_NE(nullptr, ptr);
+    ptrs.push_back(ptr);
+  }
+  for (auto *ptr : ptrs) {
+    ob_free(ptr);
+  }
+  EXPECT_LE(ObMallocThreadCache::get_total_hold(), ObMallocThreadCache::get_max_cache_size());
+}
+
+TEST_F(TestMallocThreadCache, ThreadExit)
+{
+  const int64_t hold = ObMallocThreadCache::get_total_hold();
+  thread th([]() {
+    void *ptrs[16] = {};
+    for (int i = 0; i < 16; i++) {
+      ptrs[i] = ob_malloc(64, "TCacheTest");
+    }
+    for (int i = 0; i < 16; i++) {
+      ob_free(ptrs[i]);
+    }
+    EXPECT_LT(0, ObMallocThreadCache::get_total_hold());
+  });
+  th.join();
+  EXPECT_EQ(hold, ObMallocThreadCache::get_total_hold());
+}
+
+TEST_F(TestMallocThreadCache, TenantDeleted)
+{
+  const uint64_t tenant_id = 1001;
+  ObMallocAllocator::get_instance()->create_tenant_ctx_allocator(tenant_id, ObCtxIds::DEFAULT_CTX_ID);
+  auto *ta = ObMallocAllocator::get_instance()->get_tenant_ctx_allocator(
+      tenant_id, ObCtxIds::DEFAULT_CTX_ID);
+  ASSERT_NE(nullptr, ta);
+  ta->set_limit(INT64_MAX);
+  const int64_t hold = ObMallocThreadCache::get_total_hold();
+  bool stop = false;
+  thread th([&]() {
+    ob_free(ob_malloc(64, ObMemAttr(tenant_id, "TCacheTest")));
+    while (!ATOMIC_LOAD(&stop)) {
+      usleep(1000);
+    }
+  });
+  while (hold == ObMallocThreadCache::get_total_hold()) {
+    usleep(1000);
+  }
+  // objects cached by other threads are given back
+  ta->set_tenant_deleted();
+  EXPECT_EQ(hold, ObMallocThreadCache::get_total_hold());
+  ATOMIC_STORE(&stop, true);
+  th.join();
+}
+
+TEST_F(TestMallocThreadCache, SyncWash)
+{
+  auto *ta = ObMallocAllocator::get_instance()->get_tenant_ctx_allocator(
+      OB_SERVER_TENANT_ID, ObCtxIds::DEFAULT_CTX_ID);
+  const int64_t hold = ObMallocThreadCache::get_total_hold();
+  bool stop = false;
+  thread th([&]() {
+    ob_free(ob_malloc(64, "TCacheTest"));
+    while (!ATOMIC_LOAD(&stop)) {
+      usleep(1000);
+    }
+  });
+  while (hold == ObMallocThreadCache::get_total_hold()) {
+    usleep(1000);
+  }
+  // washing gives back objects cached by every thread
+  ta->sync_wash(0);
+  EXPECT_EQ(0, ObMallocThreadCache::get_total_hold());
+  ATOMIC_STORE(&stop, true);
+  th.join();
+}
+
+// microbenchmark, small allocations from several threads with and
+// without the thread cache, run it with --gtest_also_run_disabled_tests.
+TEST_F(TestMallocThreadCache, DISABLED_Bench)
+{
+  const int64_t th_cnt = 8;
+  const int64_t loop = 1L << 17;
+  auto bench = [&](const int64_t cache_size) {
+    ObMallocThreadCache::set_max_cache_size(cache_size);
+    vector<thread> ths;
+    const int64_t start = ObTimeUtility::current_time();
+    for (int64_t i = 0; i < th_cnt; i++) {
+      ths.push_back(thread([&]() {
+        void *ptrs[16] = {};
+        for (int64_t j = 0; j < loop; j++) {
+          for (int64_t k = 0; k < 16; k++) {
+            ptrs[k] = ob_malloc(16 + (j + k) % 512, "TCacheBench");
+          }
+          for (int64_t k = 0; k < 16; k++) {
+            ob_free(ptrs[k]);
+          }
+        }
+      }));
+    }
+    for (auto &th : ths) {
+      th.join();
+    }
+    return ObTimeUtility::current_time() - start;
+  };
+  const int64_t without_cache = bench(0);
+  const int64_t with_cache = bench(64L << 10);
+  cout << "threads: " << th_cnt << " allocs per thread: " << loop * 16
+       << " without cache: " << without_cache << "us with cache: " << with_cache << "us" << endl;
+}
+
+int main(int argc, char *argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -18,6 +18,7 @@
 #include "lib/alloc/alloc_func.h"
 #include "lib/ob_define.h"
 #include "lib/compress/zlib/zlib.h"
+#include "lib/compress/zstd_1_3_8/ob_zstd_compressor_1_3_8.h"
 #include "lib/checksum/ob_crc64.h"
 #include "lib/coro/testing.h"
 
@@ -377,6 +378,37 @@ TEST_F(ObCompressorTest, test_zstd)
   test_normal(zstd_compressor);
 }
 
+TEST_F(ObCompressorTest, test_zstd_1_3_8_level)
+{
+  static const int64_t DATA_SIZE = 64 * 1024;
+  char data[DATA_SIZE];
+  for (int64_t i = 0; i < DATA_SIZE; ++i) {
+    data[i] = static_cast<char>('a' + (i % 7) + ((i / 1024) % 3));
+  }
+  zstd_1_3_8::ObZstdCompressor_1_3_8 compressor;
+  int64_t max_overflow_size = 0;
+  ASSERT_EQ(OB_SUCCESS, compressor.get_max_overflow_size(DATA_SIZE, max_overflow_size));
+  const int64_t comp_buf_size = DATA_SIZE + max_overflow_size;
+  char *comp_buf = new char[comp_buf_size];
+  char *decomp_buf = new char[DATA_SIZE];
+
+  ASSERT_EQ(OB_INVALID_ARGUMENT, compressor.set_compress_level(0));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, compressor.set_compress_level(23));
+  const int64_t levels[] = {1, 3, 9, 19};
+  for (int64_t i = 0; i < static_cast<int64_t>(sizeof(levels) / sizeof(levels[0])); ++i) {
+    int64_t comp_size = 0;
+    int64_t decomp_size = 0;
+    ASSERT_EQ(OB_SUCCESS, compressor.set_compress_level(levels[i]));
+    ASSERT_EQ(OB_SUCCESS, compressor.compress(data, DATA_SIZE, comp_buf, comp_buf_size, comp_size));
+    ASSERT_LT(comp_size, DATA_SIZE);
+    ASSERT_EQ(OB_SUCCESS, compressor.decompress(comp_buf, comp_size, decomp_buf, DATA_SIZE, decomp_size));
+    ASSERT_EQ(DATA_SIZE, decomp_size);
+    ASSERT_EQ(0, memcmp(data, decomp_buf, DATA_SIZE));
+  }
+  delete [] comp_buf;
+  delete [] decomp_buf;
+}
+
 TEST(ObCompressorStress, compress_stable)
 {
   int ret = OB_SUCCESS;
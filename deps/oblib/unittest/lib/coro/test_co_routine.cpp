@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "lib/coro/ob_co_routine.h"
+#include "lib/ob_errno.h"
+#include "common/ob_common_utility.h"
+
+using namespace oceanbase::lib;
+using namespace oceanbase::common;
+
+static const int64_t STACK_SIZE = 256L << 10;
+
+struct Ctx
+{
+  ObCoRoutine *co_;
+  int64_t step_;
+};
+
+static void yield_twice(void *arg)
+{
+  Ctx &ctx = *static_cast<Ctx*>(arg);
+  ASSERT_EQ(ctx.co_, ObCoRoutine::current());
+  ctx.step_++;
+  ctx.co_->yield();
+  ctx.step_++;
+  ctx.co_->yield();
+  ctx.step_++;
+}
+
+TEST(TestCoRoutine, ResumeAndYield)
+{
+  ObCoRoutine co;
+  Ctx ctx{&co, 0};
+  ASSERT_EQ(OB_NOT_INIT, co.start(yield_twice, &ctx));
+  ASSERT_EQ(OB_SUCCESS, co.init(OB_SERVER_TENANT_ID, STACK_SIZE));
+  ASSERT_EQ(OB_SUCCESS, co.start(yield_twice, &ctx));
+  ASSERT_EQ(OB_STATE_NOT_MATCH, co.start(yield_twice, &ctx));
+  ASSERT_EQ(ObCoRoutine::CO_READY, co.get_state());
+  ASSERT_EQ(OB_SUCCESS, co.resume());
+  ASSERT_EQ(1, ctx.step_);
+  ASSERT_TRUE(co.is_suspended());
+  ASSERT_EQ(nullptr, ObCoRoutine::current());
+  ASSERT_EQ(OB_SUCCESS, co.resume());
+  ASSERT_EQ(2, ctx.step_);
+  ASSERT_EQ(OB_SUCCESS, co.resume());
+  ASSERT_EQ(3, ctx.step_);
+  ASSERT_EQ(ObCoRoutine::CO_FINISHED, co.get_state());
+  ASSERT_EQ(OB_STATE_NOT_MATCH, co.resume());
+
+  // restart on the same stack
+  ctx.step_ = 0;
+  ASSERT_EQ(OB_SUCCESS, co.start(yield_twice, &ctx));
+  while (co.is_runnable()) {
+    ASSERT_EQ(OB_SUCCESS, co.resume());
+  }
+  ASSERT_EQ(3, ctx.step_);
+}
+
+static void check_stack(void *arg)
+{
+  ObCoRoutine *co = static_cast<ObCoRoutine*>(arg);
+  void *addr = nullptr;
+  size_t size = 0;
+  bool is_overflow = false;
+  ASSERT_EQ(OB_SUCCESS, get_stackattr(addr, size));
+  ASSERT_EQ(STACK_SIZE, static_cast<int64_t>(size));
+  ASSERT_TRUE((char*)&addr > (char*)addr && (char*)&addr < (char*)addr + size);
+  ASSERT_EQ(OB_SUCCESS, check_stack_overflow(is_overflow));
+  ASSERT_FALSE(is_overflow);
+  co->yield();
+}
+
+TEST(TestCoRoutine, StackAttr)
+{
+  void *th_addr = nullptr;
+  size_t th_size = 0;
+  ASSERT_EQ(OB_SUCCESS, get_stackattr(th_addr, th_size));
+  ObCoRoutine cos[4];
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(OB_SUCCESS, cos[i].init(OB_SERVER_TENANT_ID, STACK_SIZE));
+    ASSERT_EQ(OB_SUCCESS, cos[i].start(check_stack, &cos[i]));
+    ASSERT_EQ(OB_SUCCESS, cos[i].resume());
+  }
+  // stack attributes of the thread are restored after switching back
+  void *addr = nullptr;
+  size_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, get_stackattr(addr, size));
+  ASSERT_EQ(th_addr, addr);
+  ASSERT_EQ(th_size, size);
+  for (int i = 0; i < 4; i++) {
+    ASSERT_EQ(OB_SUCCESS, cos[i].resume());
+    ASSERT_EQ(ObCoRoutine::CO_FINISHED, cos[i].get_state());
+  }
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define private public
+#include "lib/cpu/ob_cpu_topology.h"
+#undef private
+#include "lib/oblog/ob_log.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace unittest
+{
+// policy of the page at addr, -1 if the kernel has no numa support
+static int get_mem_policy(void *addr)
+{
+  // same as MPOL_F_ADDR in <numaif.h>
+  static const unsigned long MPOL_F_ADDR_FLAG = 2;
+  int mode = -1;
+  if (0 != syscall(__NR_get_mempolicy, &mode, nullptr, 0, addr, MPOL_F_ADDR_FLAG)) {
+    mode = -1;
+  }
+  return mode;
+}
+
+TEST(TestNumaTopology, basic)
+{
+  ObNumaTopology &topology = ObNumaTopology::instance();
+  ASSERT_GE(topology.get_node_count(), 1);
+  const int64_t node = topology.get_current_node();
+  ASSERT_TRUE(node >= 0 && node < topology.get_node_count());
+  ASSERT_GT(CPU_COUNT(&topology.get_node_cpus(node)), 0);
+  ASSERT_EQ(-1, topology.get_cpu_node(-1));
+
+  cpu_set_t cpus;
+  ASSERT_EQ(OB_SUCCESS, ObNumaTopology::parse_cpu_list("0-3,8,10-11\n", cpus));
+  ASSERT_EQ(7, CPU_COUNT(&cpus));
+  ASSERT_TRUE(CPU_ISSET(8, &cpus));
+  ASSERT_FALSE(CPU_ISSET(9, &cpus));
+  ASSERT_EQ(OB_INVALID_DATA, ObNumaTopology::parse_cpu_list("3-1", cpus));
+  ASSERT_EQ(OB_INVALID_DATA, ObNumaTopology::parse_cpu_list("\n", cpus));
+}
+
+TEST(TestNumaTopology, bind_memory)
+{
+  ObNumaTopology &topology = ObNumaTopology::instance();
+  const int64_t size = 2 << 20;
+  void *ptr = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  ASSERT_NE(MAP_FAILED, ptr);
+  ASSERT_EQ(OB_INVALID_ARGUMENT, topology.bind_memory_to_node(ptr, size, -1));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, topology.bind_memory_to_node(ptr, size, topology.get_node_count()));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, topology.bind_memory_to_node(nullptr, size, 0));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, topology.unbind_memory(nullptr, size));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, topology.unbind_memory(ptr, 0));
+  // kernel without numa support rejects mbind
+  int ret = topology.bind_memory_to_node(ptr, size, 0);
+  ASSERT_TRUE(OB_SUCCESS == ret || OB_ERR_SYS == ret);
+  if (OB_SUCCESS == ret) {
+    // MPOL_PREFERRED
+    ASSERT_EQ(1, get_mem_policy(ptr));
+    ASSERT_EQ(1, get_mem_policy(static_cast<char*>(ptr) + size - 1));
+  }
+  MEMSET(ptr, 0, size);
+  ret = topology.unbind_memory(ptr, size);
+  ASSERT_TRUE(OB_SUCCESS == ret || OB_ERR_SYS == ret);
+  if (OB_SUCCESS == ret) {
+    // MPOL_DEFAULT
+    ASSERT_EQ(0, get_mem_policy(ptr));
+    ASSERT_EQ(0, get_mem_policy(static_cast<char*>(ptr) + size - 1));
+  }
+  munmap(ptr, size);
+}
+
+} // end namespace unittest
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_cpu_topology.log*");
+  OB_LOGGER.set_file_name("test_cpu_topology.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,190 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+#include "lib/allocator/ob_malloc.h"
+#include "lib/queue/ob_work_stealing_queue.h"
+#include "lib/time/ob_time_utility.h"
+
+using namespace oceanbase::lib;
+using namespace oceanbase::common;
+
+struct QData: public ObLink
+{
+  QData(): val_(0) {}
+  QData(int64_t x): val_(x) {}
+  int64_t val_;
+};
+
+TEST(TestWorkStealingQueue, Basic)
+{
+  ObWorkStealingQueue queue;
+  ObLink *data = nullptr;
+  ASSERT_EQ(OB_NOT_INIT, queue.push(data));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, queue.init(0, ObMemAttr(OB_SERVER_TENANT_ID, "TestWSQ")));
+  ASSERT_EQ(OB_SUCCESS, queue.init(1, ObMemAttr(OB_SERVER_TENANT_ID, "TestWSQ")));
+  ASSERT_EQ(OB_INIT_TWICE, queue.init(1, ObMemAttr(OB_SERVER_TENANT_ID, "TestWSQ")));
+
+  // FIFO within one shard
+  QData items[10];
+  for (int64_t i = 0; i < 10; i++) {
+    items[i].val_ = i;
+    ASSERT_EQ(OB_SUCCESS, queue.push(&items[i]));
+  }
+  ASSERT_EQ(10, queue.size());
+  for (int64_t i = 0; i < 10; i++) {
+    ASSERT_EQ(OB_SUCCESS, queue.pop(0, data, 0));
+    ASSERT_EQ(i, static_cast<QData*>(data)->val_);
+  }
+  ASSERT_EQ(0, queue.size());
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, queue.pop(0, data, 1000));
+
+  queue.set_limit(2);
+  ASSERT_EQ(OB_SUCCESS, queue.push(&items[0]));
+  ASSERT_EQ(OB_SUCCESS, queue.push(&items[1]));
+  ASSERT_EQ(OB_SIZE_OVERFLOW, queue.push(&items[2]));
+  ASSERT_EQ(OB_SUCCESS, queue.pop(0, data, 0));
+  ASSERT_EQ(OB_SUCCESS, queue.pop(0, data, 0));
+}
+
+TEST(TestWorkStealingQueue, Steal)
+{
+  ObWorkStealingQueue queue;
+  ASSERT_EQ(OB_SUCCESS, queue.init(4, ObMemAttr(OB_SERVER_TENANT_ID, "TestWSQ")));
+  // producers only put data into shard 0
+  queue.set_active_shard_cnt(1);
+  QData items[20];
+  for (int64_t i = 0; i < 20; i++) {
+    ASSERT_EQ(OB_SUCCESS, queue.push(&items[i]));
+  }
+  ASSERT_EQ(20, queue.shard_size(0));
+
+  // shard 1 steals a batch and keeps the rest of it locally
+  ObLink *data = nullptr;
+  ASSERT_EQ(OB_SUCCESS, queue.pop(1, data, 0));
+  ASSERT_EQ(&items[0], data);
+  ASSERT_EQ(20 - 10, queue.shard_size(0));
+  ASSERT_EQ(10 - 1, queue.shard_size(1));
+  ASSERT_EQ(OB_SUCCESS, queue.pop(1, data, 0));
+  ASSERT_EQ(&items[1], data);
+
+  int64_t cnt = 2;
+  while (OB_SUCCESS == queue.pop(cnt % 4, data, 0)) {
+    cnt++;
+  }
+  ASSERT_EQ(20, cnt);
+  ASSERT_EQ(0, queue.size());
+}
+
+TEST(TestWorkStealingQueue, Limit)
+{
+  ObWorkStealingQueue queue;
+  ASSERT_EQ(OB_SUCCESS, queue.init(4, ObMemAttr(OB_SERVER_TENANT_ID, "TestWSQ")));
+  // the limit counts all shards, no matter how many of them are active
+  queue.set_active_shard_cnt(1);
+  queue.set_limit(8);
+  QData items[9];
+  for (int64_t i = 0; i < 8; i++) {
+    ASSERT_EQ(OB_SUCCESS, queue.push(&items[i]));
+  }
+  ASSERT_EQ(OB_SIZE_OVERFLOW, queue.push(&items[8]));
+  ASSERT_EQ(8, queue.size());
+
+  // stolen data is still counted until it's popped
+  ObLink *data = nullptr;
+  ASSERT_EQ(OB_SUCCESS, queue.pop(1, data, 0));
+  ASSERT_EQ(7, queue.size());
+  ASSERT_EQ(OB_SUCCESS, queue.push(&items[8]));
+  ASSERT_EQ(OB_SIZE_OVERFLOW, queue.push(data));
+  while (OB_SUCCESS == queue.pop(2, data, 0)) {
+  }
+  ASSERT_EQ(0, queue.size());
+}
+
+TEST(TestWorkStealingQueue, Wakeup)
+{
+  const int64_t timeout_us = 10 * 1000 * 1000;
+  ObWorkStealingQueue queue;
+  ASSERT_EQ(OB_SUCCESS, queue.init(4, ObMemAttr(OB_SERVER_TENANT_ID, "TestWSQ")));
+  queue.set_active_shard_cnt(1);
+  QData item;
+  int ret = OB_SUCCESS;
+  ObLink *data = nullptr;
+  // waiter of shard 3 picks up data pushed into shard 0
+  int64_t start = ObTimeUtility::current_time();
+  std::thread popper([&]() { ret = queue.pop(3, data, timeout_us); });
+  usleep(100 * 1000);
+  ASSERT_EQ(OB_SUCCESS, queue.push(&item));
+  popper.join();
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(&item, data);
+  ASSERT_LT(ObTimeUtility::current_time() - start, timeout_us);
+
+  // notify wakes up a waiter with nothing to pop
+  start = ObTimeUtility::current_time();
+  std::thread waiter([&]() { ret = queue.pop(3, data, timeout_us); });
+  usleep(100 * 1000);
+  queue.notify();
+  waiter.join();
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, ret);
+  ASSERT_LT(ObTimeUtility::current_time() - start, timeout_us);
+}
+
+TEST(TestWorkStealingQueue, MultiThread)
+{
+  const int64_t n_pusher = 4;
+  const int64_t n_popper = 8;
+  const int64_t n_per_pusher = 100000;
+  ObWorkStealingQueue queue;
+  ASSERT_EQ(OB_SUCCESS, queue.init(n_popper, ObMemAttr(OB_SERVER_TENANT_ID, "TestWSQ")));
+  queue.set_limit(65536);
+  int64_t pop_cnt = 0;
+  int64_t pop_sum = 0;
+  std::vector<std::thread> threads;
+  for (int64_t i = 0; i < n_pusher; i++) {
+    threads.emplace_back([&queue]() {
+      for (int64_t j = 1; j <= n_per_pusher; j++) {
+        QData *data = new QData(j);
+        while (OB_SUCCESS != queue.push(data)) {
+          sched_yield();
+        }
+      }
+    });
+  }
+  for (int64_t i = 0; i < n_popper; i++) {
+    threads.emplace_back([&queue, &pop_cnt, &pop_sum, i]() {
+      ObLink *data = nullptr;
+      while (ATOMIC_LOAD(&pop_cnt) < n_pusher * n_per_pusher) {
+        if (OB_SUCCESS == queue.pop(i, data, 1000)) {
+          ATOMIC_FAA(&pop_sum, static_cast<QData*>(data)->val_);
+          ATOMIC_FAA(&pop_cnt, 1);
+          delete static_cast<QData*>(data);
+        }
+      }
+    });
+  }
+  for (auto &th : threads) {
+    th.join();
+  }
+  ASSERT_EQ(n_pusher * n_per_pusher, pop_cnt);
+  ASSERT_EQ(n_pusher * n_per_pusher * (n_per_pusher + 1) / 2, pop_sum);
+  ASSERT_EQ(0, queue.size());
+}
+
+int main(int argc, char *argv[])
+{
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  testing::InitGoogleTest(&argc,argv);
+  return RUN_ALL_TESTS();
+}
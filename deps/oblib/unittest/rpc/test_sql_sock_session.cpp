@@ -0,0 +1,306 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX RPC_OBMYSQL
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+#include <signal.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include "lib/oblog/ob_log.h"
+#include "rpc/obmysql/ob_sql_nio.h"
+#include "rpc/obmysql/ob_sql_sock_session.h"
+#include "rpc/obmysql/ob_i_sql_sock_handler.h"
+#include "rpc/obmysql/ob_mysql_util.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::obmysql;
+using namespace oceanbase::observer;
+
+static const int64_t COALESCE_SIZE = 64 * 1024;
+
+class TestConnCallback : public ObISMConnectionCallback
+{
+public:
+  virtual int init(ObSqlSockSession& sess, ObSMConnection& conn)
+  {
+    UNUSED(sess);
+    conn.set_auth_phase();
+    return OB_SUCCESS;
+  }
+  virtual void destroy(ObSMConnection& conn) { UNUSED(conn); }
+  virtual int on_disconnect(ObSMConnection& conn) { UNUSED(conn); return OB_SUCCESS; }
+};
+
+// Handles the requests on the nio thread. The first byte of a request decides the action:
+//   'q': async response "r<id>"
+//   's': sync write "w<id>" in the middle of the request, then async response "r<id>"
+//   'f': the socket breaks before the sync write of "w<id>", then async response "r<id>"
+class TestSockHandler : public ObISqlSockHandler
+{
+public:
+  TestSockHandler(ObSqlNio &nio) : nio_(nio) { reset(); }
+  void reset()
+  {
+    request_cnt_ = 0;
+    flushed_cnt_ = 0;
+    closed_cnt_ = 0;
+    write_ret_ = OB_SUCCESS;
+    coalesced_after_write_ = -1;
+  }
+  static std::string make_packet(const std::string &payload)
+  {
+    char header[OB_MYSQL_HEADER_LENGTH];
+    int64_t pos = 0;
+    ObMySQLUtil::store_int3(header, OB_MYSQL_HEADER_LENGTH, static_cast<int32_t>(payload.size()), pos);
+    ObMySQLUtil::store_int1(header, OB_MYSQL_HEADER_LENGTH, 0, pos);
+    return std::string(header, OB_MYSQL_HEADER_LENGTH) + payload;
+  }
+  virtual int on_connect(void* udata, int fd)
+  {
+    UNUSED(fd);
+    ObSqlSockSession* sess = new(udata)ObSqlSockSession(conn_cb_, nio_);
+    return sess->init();
+  }
+  virtual void on_close(void* udata, int err)
+  {
+    UNUSED(err);
+    ObSqlSockSession* sess = (ObSqlSockSession*)udata;
+    sess->destroy();
+    ATOMIC_INC(&closed_cnt_);
+  }
+  virtual void on_flushed(void* udata)
+  {
+    ObSqlSockSession* sess = (ObSqlSockSession*)udata;
+    ATOMIC_INC(&flushed_cnt_);
+    sess->on_flushed();
+  }
+  virtual int on_readable(void* udata)
+  {
+    int ret = OB_SUCCESS;
+    ObSqlSockSession* sess = (ObSqlSockSession*)udata;
+    const char *buf = NULL;
+    int64_t sz = 0;
+    uint32_t pkt_len = 0;
+    if (OB_FAIL(sess->peek_data(OB_MYSQL_HEADER_LENGTH, buf, sz))) {
+      LOG_WARN("peek header fail", K(ret));
+    } else if (sz < OB_MYSQL_HEADER_LENGTH) {
+      sess->revert_sock();
+    } else if (FALSE_IT(ObMySQLUtil::get_uint3(buf, pkt_len))) {
+    } else if (OB_FAIL(sess->peek_data(OB_MYSQL_HEADER_LENGTH + pkt_len, buf, sz))) {
+      LOG_WARN("peek body fail", K(ret));
+    } else if (sz < OB_MYSQL_HEADER_LENGTH + pkt_len) {
+      sess->revert_sock();
+    } else {
+      sess->set_last_pkt_sz(OB_MYSQL_HEADER_LENGTH + pkt_len);
+      handle_request(*sess, std::string(buf + OB_MYSQL_HEADER_LENGTH, pkt_len));
+    }
+    return ret;
+  }
+private:
+  void handle_request(ObSqlSockSession &sess, const std::string &req)
+  {
+    const std::string id = req.substr(1);
+    ATOMIC_INC(&request_cnt_);
+    if ('s' == req[0] || 'f' == req[0]) {
+      const std::string w = make_packet("w" + id);
+      if ('f' == req[0]) {
+        sess.destroy_sock();
+      }
+      write_ret_ = sess.write_data(w.data(), w.size());
+      coalesced_after_write_ = sess.coalesce_data_sz_;
+    }
+    const std::string r = make_packet("r" + id);
+    char *buf = static_cast<char*>(sess.alloc(r.size()));
+    MEMCPY(buf, r.data(), r.size());
+    sess.async_write_data(buf, r.size());
+    sess.revert_sock();
+  }
+public:
+  ObSqlNio &nio_;
+  TestConnCallback conn_cb_;
+  int64_t request_cnt_;
+  int64_t flushed_cnt_;
+  int64_t closed_cnt_;
+  int write_ret_;
+  int64_t coalesced_after_write_;
+};
+
+class TestSqlSockSession : public ::testing::Test
+{
+public:
+  static void SetUpTestCase()
+  {
+    port_ = 30000 + getpid() % 20000;
+    handler_ = new TestSockHandler(nio_);
+    ASSERT_EQ(OB_SUCCESS, nio_.start(port_, handler_, 1));
+  }
+  static void TearDownTestCase()
+  {
+    nio_.stop();
+    nio_.wait();
+  }
+  virtual void SetUp()
+  {
+    handler_->reset();
+    fd_ = -1;
+  }
+  virtual void TearDown()
+  {
+    if (fd_ >= 0) {
+      close(fd_);
+      // the close of the server side is counted before the next case starts
+      wait_until(handler_->closed_cnt_, 1);
+    }
+  }
+  void connect_server()
+  {
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(static_cast<uint16_t>(port_));
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    struct timeval tv = {5, 0};
+    ASSERT_LE(0, fd_ = socket(AF_INET, SOCK_STREAM, 0));
+    ASSERT_EQ(0, setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv)));
+    ASSERT_EQ(0, connect(fd_, (struct sockaddr*)&addr, sizeof(addr)));
+  }
+  // send all the requests with one write, so they are pipelined in the read buffer of the server
+  void send_requests(const std::vector<std::string> &reqs)
+  {
+    std::string data;
+    for (size_t i = 0; i < reqs.size(); ++i) {
+      data += TestSockHandler::make_packet(reqs[i]);
+    }
+    ASSERT_EQ(static_cast<ssize_t>(data.size()), write(fd_, data.data(), data.size()));
+  }
+  // read the responses until %cnt packets arrived or the connection is closed
+  void recv_responses(const int64_t cnt, std::vector<std::string> &resps)
+  {
+    std::string data;
+    char buf[1024];
+    bool eof = false;
+    while (!eof && static_cast<int64_t>(resps.size()) < cnt) {
+      ssize_t rbytes = read(fd_, buf, sizeof(buf));
+      if (rbytes <= 0) {
+        eof = true;
+      } else {
+        data.append(buf, rbytes);
+      }
+      while (data.size() >= OB_MYSQL_HEADER_LENGTH) {
+        const char *pos = data.data();
+        uint32_t pkt_len = 0;
+        ObMySQLUtil::get_uint3(pos, pkt_len);
+        if (data.size() < OB_MYSQL_HEADER_LENGTH + pkt_len) {
+          break;
+        }
+        resps.push_back(data.substr(OB_MYSQL_HEADER_LENGTH, pkt_len));
+        data.erase(0, OB_MYSQL_HEADER_LENGTH + pkt_len);
+      }
+    }
+  }
+  static void wait_until(const int64_t &v, int64_t expect)
+  {
+    for (int64_t i = 0; i < 500 && ATOMIC_LOAD(&v) < expect; ++i) {
+      usleep(10 * 1000);
+    }
+  }
+protected:
+  static ObSqlNio nio_;
+  static TestSockHandler *handler_;
+  static int port_;
+  int fd_;
+};
+
+ObSqlNio TestSqlSockSession::nio_;
+TestSockHandler *TestSqlSockSession::handler_ = NULL;
+int TestSqlSockSession::port_ = 0;
+
+TEST_F(TestSqlSockSession, no_coalesce)
+{
+  nio_.set_pipeline_coalesce_size(0);
+  connect_server();
+  std::vector<std::string> reqs = {"q0", "q1", "q2", "q3"};
+  std::vector<std::string> resps;
+  send_requests(reqs);
+  recv_responses(4, resps);
+  ASSERT_EQ(std::vector<std::string>({"r0", "r1", "r2", "r3"}), resps);
+  // one write per response
+  wait_until(handler_->flushed_cnt_, 4);
+  ASSERT_EQ(4, ATOMIC_LOAD(&handler_->flushed_cnt_));
+}
+
+TEST_F(TestSqlSockSession, pipeline_order)
+{
+  nio_.set_pipeline_coalesce_size(COALESCE_SIZE);
+  connect_server();
+  std::vector<std::string> reqs = {"q0", "q1", "q2", "q3"};
+  std::vector<std::string> resps;
+  send_requests(reqs);
+  recv_responses(4, resps);
+  ASSERT_EQ(std::vector<std::string>({"r0", "r1", "r2", "r3"}), resps);
+  // the responses of the pipelined requests are written together
+  wait_until(handler_->flushed_cnt_, 1);
+  usleep(100 * 1000);
+  ASSERT_EQ(4, ATOMIC_LOAD(&handler_->request_cnt_));
+  ASSERT_LT(ATOMIC_LOAD(&handler_->flushed_cnt_), 4);
+
+  // the next round is not pipelined
+  resps.clear();
+  send_requests({"q4"});
+  recv_responses(1, resps);
+  ASSERT_EQ(std::vector<std::string>({"r4"}), resps);
+}
+
+TEST_F(TestSqlSockSession, sync_write_flush)
+{
+  nio_.set_pipeline_coalesce_size(COALESCE_SIZE);
+  connect_server();
+  std::vector<std::string> reqs = {"q0", "q1", "s2", "q3"};
+  std::vector<std::string> resps;
+  send_requests(reqs);
+  recv_responses(5, resps);
+  // the coalesced responses of q0 and q1 go out before the sync write of s2
+  ASSERT_EQ(std::vector<std::string>({"r0", "r1", "w2", "r2", "r3"}), resps);
+  ASSERT_EQ(OB_SUCCESS, handler_->write_ret_);
+  ASSERT_EQ(0, handler_->coalesced_after_write_);
+}
+
+TEST_F(TestSqlSockSession, flush_fail)
+{
+  nio_.set_pipeline_coalesce_size(COALESCE_SIZE);
+  connect_server();
+  std::vector<std::string> reqs = {"q0", "q1", "f2", "q3"};
+  std::vector<std::string> resps;
+  send_requests(reqs);
+  recv_responses(5, resps);
+  // the coalesced responses are dropped with the broken socket, nothing after them is written
+  ASSERT_TRUE(resps.empty());
+  ASSERT_EQ(OB_IO_ERROR, handler_->write_ret_);
+  ASSERT_EQ(0, handler_->coalesced_after_write_);
+  wait_until(handler_->closed_cnt_, 1);
+  ASSERT_EQ(1, ATOMIC_LOAD(&handler_->closed_cnt_));
+  ASSERT_EQ(3, ATOMIC_LOAD(&handler_->request_cnt_));
+}
+
+int main(int argc, char **argv)
+{
+  signal(SIGPIPE, SIG_IGN);
+  system("rm -f test_sql_sock_session.log*");
+  OB_LOGGER.set_file_name("test_sql_sock_session.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
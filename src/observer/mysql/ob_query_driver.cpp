@@ -16,6 +16,8 @@
 #include "ob_mysql_result_set.h"
 #include "obmp_base.h"
 #include "obsm_row.h"
+#include "obsm_datum_row.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 #include "rpc/obmysql/packet/ompk_row.h"
 #include "rpc/obmysql/packet/ompk_resheader.h"
 #include "rpc/obmysql/packet/ompk_field.h"
@@ -138,7 +140,18 @@ int ObQueryDriver::response_query_result(ObResultSet &result,
       LOG_WARN("fields is null", K(ret), KP(fields));
     }
   }
-  while (OB_SUCC(ret) && row_num < limit_count && !OB_FAIL(result.get_next_row(result_row)) ) {
+  // 向量化计划的结果行直接从 output expr 的 datum 编码, 省去 datum -> ObObj 的转换
+  ObSMDatumRowEncoder datum_encoder;
+  bool use_datum_encoder = false;
+  int64_t batch_idx = 0;
+  if (OB_SUCC(ret) && OB_FAIL(init_datum_row_encoder(result, is_ps_protocol, is_packed,
+                                                     datum_encoder, use_datum_encoder))) {
+    LOG_WARN("fail to init datum row encoder", K(ret));
+  }
+  while (OB_SUCC(ret) && row_num < limit_count
+         && !OB_FAIL(use_datum_encoder
+                     ? result.get_next_batch_row_idx(batch_idx)
+                     : result.get_next_row(result_row))) {
     ObNewRow *row = const_cast<ObNewRow*>(result_row);
     if (is_prexecute_ && row_num == limit_count - 1) {
       LOG_DEBUG("is_prexecute_ and row_num is equal with limit_count", K(limit_count));
@@ -152,54 +165,65 @@ int ObQueryDriver::response_query_result(ObResultSet &result,
         LOG_WARN("fail to response query header", K(ret), K(row_num), K(can_retry));
       }
     }
-    for (int64_t i = 0; OB_SUCC(ret) && i < row->get_count(); i++) {
-      ObObj& value = row->get_cell(i);
-      if (result.is_ps_protocol() && !is_packed) {
-        if (value.get_type() != fields->at(i).type_.get_type()) {
-          ObCastCtx cast_ctx(&result.get_mem_pool(), NULL, CM_WARN_ON_FAIL,
-            fields->at(i).type_.get_collation_type());
-          if (OB_FAIL(common::ObObjCaster::to_type(fields->at(i).type_.get_type(),
-                                           cast_ctx,
-                                           value,
-                                           value))) {
-            LOG_WARN("failed to cast object", K(ret), K(value),
-                     K(value.get_type()), K(fields->at(i).type_.get_type()));
-          }
-        }
-      }
-      if (OB_SUCC(ret) && !is_packed) {
-        if (ob_is_string_type(value.get_type())
-                  && CS_TYPE_INVALID != value.get_collation_type()) {
-          OZ(convert_string_value_charset(value, result));
-        } else if (value.is_clob_locator()
-                  && OB_FAIL(convert_lob_value_charset(value, result))) {
-          LOG_WARN("convert lob value charset failed", K(ret));
-        }
-        if (OB_SUCC(ret) && lib::is_oracle_mode()
-                        && (value.is_lob() || value.is_lob_locator())
-                        && OB_FAIL(convert_lob_locator_to_longtext(value, result))) {
-          LOG_WARN("convert lob locator to longtext failed", K(ret));
-        }
-      }
-    }
-    if (OB_SUCC(ret)) {
-      const ObDataTypeCastParams dtc_params = ObBasicSessionInfo::create_dtc_params(&session_);
-      ObSMRow sm(protocol_type, *row, dtc_params,
-                         result.get_field_columns(),
-                         ctx_.schema_guard_,
-                         session_.get_effective_tenant_id());
-      sm.set_packed(is_packed);
+    if (OB_FAIL(ret)) {
+    } else if (use_datum_encoder) {
+      ObSMDatumRow sm(datum_encoder, batch_idx);
       OMPKRow rp(sm);
-      rp.set_is_packed(is_packed);
       if (OB_FAIL(sender_.response_packet(rp, &result.get_session()))) {
-        LOG_WARN("response packet fail", K(ret), KP(row), K(row_num),
-            K(can_retry));
-        // break;
+        LOG_WARN("response packet fail", K(ret), K(batch_idx), K(row_num), K(can_retry));
       } else {
-        LOG_DEBUG("response row succ", K(*row));
+        ++row_num;
+      }
+    } else {
+      for (int64_t i = 0; OB_SUCC(ret) && i < row->get_count(); i++) {
+        ObObj& value = row->get_cell(i);
+        if (result.is_ps_protocol() && !is_packed) {
+          if (value.get_type() != fields->at(i).type_.get_type()) {
+            ObCastCtx cast_ctx(&result.get_mem_pool(), NULL, CM_WARN_ON_FAIL,
+              fields->at(i).type_.get_collation_type());
+            if (OB_FAIL(common::ObObjCaster::to_type(fields->at(i).type_.get_type(),
+                                             cast_ctx,
+                                             value,
+                                             value))) {
+              LOG_WARN("failed to cast object", K(ret), K(value),
+                       K(value.get_type()), K(fields->at(i).type_.get_type()));
+            }
+          }
+        }
+        if (OB_SUCC(ret) && !is_packed) {
+          if (ob_is_string_type(value.get_type())
+                    && CS_TYPE_INVALID != value.get_collation_type()) {
+            OZ(convert_string_value_charset(value, result));
+          } else if (value.is_clob_locator()
+                    && OB_FAIL(convert_lob_value_charset(value, result))) {
+            LOG_WARN("convert lob value charset failed", K(ret));
+          }
+          if (OB_SUCC(ret) && lib::is_oracle_mode()
+                          && (value.is_lob() || value.is_lob_locator())
+                          && OB_FAIL(convert_lob_locator_to_longtext(value, result))) {
+            LOG_WARN("convert lob locator to longtext failed", K(ret));
+          }
+        }
       }
       if (OB_SUCC(ret)) {
-        ++row_num;
+        const ObDataTypeCastParams dtc_params = ObBasicSessionInfo::create_dtc_params(&session_);
+        ObSMRow sm(protocol_type, *row, dtc_params,
+                           result.get_field_columns(),
+                           ctx_.schema_guard_,
+                           session_.get_effective_tenant_id());
+        sm.set_packed(is_packed);
+        OMPKRow rp(sm);
+        rp.set_is_packed(is_packed);
+        if (OB_FAIL(sender_.response_packet(rp, &result.get_session()))) {
+          LOG_WARN("response packet fail", K(ret), KP(row), K(row_num),
+              K(can_retry));
+          // break;
+        } else {
+          LOG_DEBUG("response row succ", K(*row));
+        }
+        if (OB_SUCC(ret)) {
+          ++row_num;
+        }
       }
     }
   }
@@ -224,6 +248,36 @@ int ObQueryDriver::response_query_result(ObResultSet &result,
   return ret;
 }
 
+int ObQueryDriver::init_datum_row_encoder(ObResultSet &result,
+                                          bool is_ps_protocol,
+                                          bool is_packed,
+                                          ObSMDatumRowEncoder &encoder,
+                                          bool &is_usable)
+{
+  int ret = OB_SUCCESS;
+  is_usable = false;
+  ObOperator *root = NULL;
+  const ColumnsFieldIArray *fields = result.get_field_columns();
+  ObCharsetType charset_type = CHARSET_INVALID;
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(session_.get_effective_tenant_id()));
+  if (is_packed || result.is_ps_protocol() != is_ps_protocol || OB_ISNULL(fields)) {
+    // packed 结果已在算子中编码; ps 协议标记不一致时需要走 cast 路径
+  } else if (!tenant_config.is_valid() || !tenant_config->_enable_vectorized_result_encoding) {
+  } else if (OB_ISNULL(root = result.get_vectorized_root())) {
+  } else if (OB_FAIL(session_.get_character_set_results(charset_type))) {
+    LOG_WARN("fail to get result charset", K(ret));
+  } else if (OB_FAIL(encoder.init(is_ps_protocol ? BINARY : TEXT,
+                                  root->get_spec().output_,
+                                  root->get_eval_ctx(),
+                                  *fields,
+                                  ObBasicSessionInfo::create_dtc_params(&session_),
+                                  charset_type,
+                                  is_usable))) {
+    LOG_WARN("fail to init datum row encoder", K(ret));
+  }
+  return ret;
+}
+
 int ObQueryDriver::convert_field_charset(ObIAllocator& allocator,
                                          const ObCollationType& from_collation,
                                          const ObCollationType& dest_collation,
@@ -28,6 +28,11 @@ class ObResultSet;
 }
 
 
+namespace common
+{
+class ObSMDatumRowEncoder;
+}
+
 namespace observer
 {
 
@@ -84,6 +89,11 @@ public:
                                        common::ObIAllocator &allocator);
 
 private:
+  int init_datum_row_encoder(sql::ObResultSet &result,
+                             bool is_ps_protocol,
+                             bool is_packed,
+                             common::ObSMDatumRowEncoder &encoder,
+                             bool &is_usable);
   int convert_field_charset(common::ObIAllocator& allocator,
       const common::ObCollationType& from_collation,
       const common::ObCollationType& dest_collation,
@@ -86,7 +86,7 @@ void ObRetryPolicy::sleep_before_local_retry(ObRetryParam &v,
       LOG_INFO("will sleep", K(sleep_us), K(remain_us), K(base_sleep_us),
                K(retry_sleep_type), K(v.stmt_retry_times_), K(timeout_timestamp));
       THIS_WORKER.sched_wait();
-      ob_usleep(static_cast<uint32_t>(sleep_us));
+      THIS_WORKER.sleep_us(sleep_us);
       THIS_WORKER.sched_run();
       if (THIS_WORKER.is_timeout()) {
         v.client_ret_ = OB_TIMEOUT;
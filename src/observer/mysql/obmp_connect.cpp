@@ -1595,6 +1595,8 @@ int ObMPConnect::check_common_property(ObSMConnection &conn, ObMySQLCapabilityFl
   } else {
     conn.proxy_sessid_ = proxy_sessid;
     conn.sess_create_time_ = sess_create_time;
+    // zstd compress is only supported for clients connecting directly
+    client_cap.cap_flags_.OB_CLIENT_ZSTD_COMPRESSION_ALGORITHM = 0;
     if (conn.proxy_cap_flags_.is_ob_protocol_v2_support()) {
       // when used 2.0 protocol, do not use mysql compress
       client_cap.cap_flags_.OB_CLIENT_COMPRESS = 0;
@@ -1663,6 +1665,7 @@ int ObMPConnect::check_client_property(ObSMConnection &conn)
 
   hsr_.set_capability_flags(client_cap);
   conn.cap_flags_ = client_cap;
+  conn.zstd_compress_level_ = static_cast<int8_t>(hsr_.get_zstd_compression_level());
   return ret;
 }
 
@@ -158,6 +158,13 @@ int ObMPPacketSender::do_init(rpc::ObRequest *req,
     comp_context_.type_ = conn->get_compress_type();
     comp_context_.seq_ = seq_;
     comp_context_.sessid_ = sessid_;
+    if (comp_context_.is_zstd_compress()) {
+      // 配置项优先, 为 0 时使用客户端握手时指定的压缩级别
+      const int64_t zstd_level = GCONF._mysql_zstd_compress_level;
+      comp_context_.zstd_level_ = static_cast<int8_t>(zstd_level > 0
+                                                      ? zstd_level
+                                                      : conn->zstd_compress_level_);
+    }
 
     // init proto20 context
     bool is_proto20_supported = (OB_2_0_CS_TYPE == conn->get_cs_protocol_type());
@@ -18,6 +18,7 @@
 #include "rpc/obmysql/packet/ompk_handshake.h"
 #include "lib/random/ob_mysql_random.h"
 #include "observer/ob_server_struct.h"
+#include "share/config/ob_server_config.h"
 #include "sql/session/ob_sql_session_mgr.h"
 #include "observer/omt/ob_tenant.h"
 
@@ -93,6 +94,7 @@ static int sm_conn_build_handshake(ObSMConnection& conn, obmysql::OMPKHandshake&
   RLOCAL(common::ObMysqlRandom, thread_scramble_rand);
   hsp.set_thread_id(conn.sessid_);
   hsp.set_ssl_cap(false);
+  hsp.set_compress_cap(GCONF._enable_mysql_compress_protocol, true);
   const int64_t BUF_LEN = sizeof(conn.scramble_buf_);
   if (OB_FAIL(create_scramble_string(conn.scramble_buf_, BUF_LEN, thread_scramble_rand))) {
     LOG_WARN("create scramble string failed", K(ret));
@@ -0,0 +1,206 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SERVER
+
+#include "obsm_datum_row.h"
+
+#include "observer/mysql/obsm_utils.h"
+#include "sql/engine/expr/ob_expr.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::obmysql;
+using namespace oceanbase::sql;
+
+ObSMDatumRowEncoder::ObSMDatumRowEncoder()
+  : is_inited_(false),
+    type_(TEXT),
+    eval_ctx_(NULL),
+    dtc_params_(),
+    columns_()
+{
+}
+
+bool ObSMDatumRowEncoder::need_convert_charset(const ObCollationType cs_type,
+                                               const ObCharsetType result_charset)
+{
+  // 与 ObQueryDriver::convert_string_value_charset 的判断保持一致
+  bool need = false;
+  if (ObCharset::is_valid_charset(result_charset) && CHARSET_BINARY != result_charset) {
+    const ObCollationType to_cs_type = ObCharset::get_default_collation(result_charset);
+    const ObCharsetInfo *from_info = ObCharset::get_charset(cs_type);
+    const ObCharsetInfo *to_info = ObCharset::get_charset(to_cs_type);
+    if (OB_ISNULL(from_info) || OB_ISNULL(to_info)
+        || CS_TYPE_INVALID == cs_type || CS_TYPE_INVALID == to_cs_type) {
+      // let the slow path report the error
+      need = true;
+    } else if (CS_TYPE_BINARY != cs_type && CS_TYPE_BINARY != to_cs_type
+               && 0 != strcmp(from_info->csname, to_info->csname)) {
+      need = true;
+    }
+  }
+  return need;
+}
+
+int ObSMDatumRowEncoder::init(MYSQL_PROTOCOL_TYPE type,
+                              const ObIArray<ObExpr *> &exprs,
+                              ObEvalCtx &eval_ctx,
+                              const ColumnsFieldIArray &fields,
+                              const ObDataTypeCastParams &dtc_params,
+                              const ObCharsetType result_charset,
+                              bool &is_usable)
+{
+  int ret = OB_SUCCESS;
+  is_usable = true;
+  columns_.reuse();
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (exprs.count() != fields.count() || 0 == exprs.count()) {
+    is_usable = false;
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && is_usable && i < exprs.count(); ++i) {
+    const ObExpr *expr = exprs.at(i);
+    const ObField &field = fields.at(i);
+    ColumnEncoder col;
+    if (OB_ISNULL(expr)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("output expr is null", K(ret), K(i));
+    } else if (BINARY == type && expr->obj_meta_.get_type() != field.type_.get_type()) {
+      // ps 协议下需要先 cast 到 field 类型
+      is_usable = false;
+    } else {
+      col.expr_ = expr;
+      col.field_ = &field;
+      col.obj_type_ = expr->obj_meta_.get_type();
+      col.scale_ = field.accuracy_.get_scale();
+      col.zerofill_ = field.flags_ & ZEROFILL_FLAG;
+      col.zflength_ = field.length_;
+      switch (expr->obj_meta_.get_type_class()) {
+        case ObIntTC:
+          col.kind_ = CELL_INT;
+          break;
+        case ObUIntTC:
+          col.kind_ = CELL_UINT;
+          break;
+        case ObNumberTC:
+          col.kind_ = CELL_NUMBER;
+          break;
+        case ObStringTC:
+          if (need_convert_charset(expr->obj_meta_.get_collation_type(), result_charset)) {
+            is_usable = false;
+          } else {
+            col.kind_ = CELL_STRING;
+          }
+          break;
+        case ObNullTC:
+        case ObFloatTC:
+        case ObDoubleTC:
+        case ObDateTimeTC:
+        case ObDateTC:
+        case ObTimeTC:
+        case ObYearTC:
+        case ObOTimestampTC:
+        case ObBitTC:
+        case ObIntervalTC:
+          col.kind_ = CELL_GENERIC;
+          break;
+        default:
+          // text/lob/json/raw/enumset/extend ... 需要额外处理, 走原有的 ObSMRow 路径
+          is_usable = false;
+          break;
+      }
+      if (OB_SUCC(ret) && is_usable && OB_FAIL(columns_.push_back(col))) {
+        LOG_WARN("push back column encoder failed", K(ret));
+      }
+    }
+  }
+  if (OB_SUCC(ret) && is_usable) {
+    type_ = type;
+    eval_ctx_ = &eval_ctx;
+    dtc_params_ = dtc_params;
+    is_inited_ = true;
+  } else {
+    columns_.reset();
+  }
+  return ret;
+}
+
+int ObSMDatumRowEncoder::encode_cell(const int64_t col_idx, const int64_t batch_idx,
+                                     char *buf, const int64_t len, int64_t &pos,
+                                     char *bitmap) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(col_idx < 0 || col_idx >= columns_.count())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid column index", K(ret), K(col_idx), K(columns_.count()));
+  } else {
+    const ColumnEncoder &col = columns_.at(col_idx);
+    // expressions are evaluated in get_next_batch(), get datum value directly
+    const ObDatum &datum = *(col.expr_->locate_batch_datums(*eval_ctx_)
+                             + (col.expr_->is_batch_result() ? batch_idx : 0));
+    if (datum.is_null()) {
+      ret = ObMySQLUtil::null_cell_str(buf, len, type_, pos, col_idx, bitmap);
+    } else {
+      switch (col.kind_) {
+        case CELL_INT:
+          ret = ObMySQLUtil::int_cell_str(buf, len, datum.get_int(), col.obj_type_, false,
+                                          type_, pos, col.zerofill_, col.zflength_);
+          break;
+        case CELL_UINT:
+          ret = ObMySQLUtil::int_cell_str(buf, len, datum.get_int(), col.obj_type_, true,
+                                          type_, pos, col.zerofill_, col.zflength_);
+          break;
+        case CELL_NUMBER: {
+          const number::ObNumber nmb(datum.get_number());
+          ret = ObMySQLUtil::number_cell_str(buf, len, nmb, pos, col.scale_,
+                                             col.zerofill_, col.zflength_);
+          break;
+        }
+        case CELL_STRING: {
+          // 文本和二进制协议下字符串都是 length encoded, 短串只需一个字节的长度
+          const int64_t str_len = datum.len_;
+          if (str_len < 251 && len - pos > str_len) {
+            buf[pos++] = static_cast<char>(str_len);
+            MEMCPY(buf + pos, datum.ptr_, str_len);
+            pos += str_len;
+          } else {
+            ret = ObMySQLUtil::varchar_cell_str(buf, len, datum.get_string(), false, pos);
+          }
+          break;
+        }
+        default:
+          ret = encode_generic(col, datum, col_idx, buf, len, pos, bitmap);
+          break;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObSMDatumRowEncoder::encode_generic(const ColumnEncoder &col, const ObDatum &datum,
+                                        const int64_t col_idx, char *buf, const int64_t len,
+                                        int64_t &pos, char *bitmap) const
+{
+  int ret = OB_SUCCESS;
+  ObObj obj;
+  if (OB_FAIL(datum.to_obj(obj, col.expr_->obj_meta_, col.expr_->obj_datum_map_))) {
+    LOG_WARN("convert datum to obj failed", K(ret));
+  } else {
+    ret = ObSMUtils::cell_str(buf, len, obj, type_, pos, col_idx, bitmap, dtc_params_,
+                              col.field_);
+  }
+  return ret;
+}
@@ -0,0 +1,131 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef _OCEABASE_COMMON_OBSM_DATUM_ROW_H_
+#define _OCEABASE_COMMON_OBSM_DATUM_ROW_H_
+
+#include "lib/container/ob_se_array.h"
+#include "lib/timezone/ob_time_convert.h"
+#include "rpc/obmysql/ob_mysql_row.h"
+#include "common/ob_field.h"
+
+namespace oceanbase
+{
+
+namespace sql
+{
+struct ObExpr;
+struct ObEvalCtx;
+}
+
+namespace common
+{
+
+/**
+ * 向量化执行时, 结果行直接从 output expr 的 batch datum 编码成 MySQL 行,
+ * 不再经过 datum -> ObObj -> ObNewRow 的转换.
+ * 每列的编码方式在 init 时根据 expr 类型和 field 预先确定, 整数/定点数/字符串走特化路径,
+ * 其余可直接编码的类型转成 ObObj 后复用 ObSMUtils::cell_str.
+ * 需要类型转换(ps 协议)、字符集转换或 lob 处理的结果集不能使用, 由 init 返回 is_usable = false.
+ */
+class ObSMDatumRowEncoder
+{
+public:
+  ObSMDatumRowEncoder();
+  ~ObSMDatumRowEncoder() {}
+
+  int init(obmysql::MYSQL_PROTOCOL_TYPE type,
+           const ObIArray<sql::ObExpr *> &exprs,
+           sql::ObEvalCtx &eval_ctx,
+           const ColumnsFieldIArray &fields,
+           const ObDataTypeCastParams &dtc_params,
+           const ObCharsetType result_charset,
+           bool &is_usable);
+  int encode_cell(const int64_t col_idx, const int64_t batch_idx,
+                  char *buf, const int64_t len, int64_t &pos, char *bitmap) const;
+  int64_t get_column_cnt() const { return columns_.count(); }
+  obmysql::MYSQL_PROTOCOL_TYPE get_protocol_type() const { return type_; }
+  bool is_inited() const { return is_inited_; }
+
+  TO_STRING_KV(K_(is_inited), K_(type), K_(columns));
+
+private:
+  enum CellKind
+  {
+    CELL_INT = 0,
+    CELL_UINT,
+    CELL_NUMBER,
+    CELL_STRING,
+    CELL_GENERIC,
+  };
+  struct ColumnEncoder
+  {
+    ColumnEncoder()
+      : kind_(CELL_GENERIC), expr_(NULL), field_(NULL), obj_type_(ObNullType),
+        scale_(0), zerofill_(false), zflength_(0)
+    {}
+    TO_STRING_KV(K_(kind), KP_(expr), KP_(field), K_(obj_type), K_(scale),
+                 K_(zerofill), K_(zflength));
+    CellKind kind_;
+    const sql::ObExpr *expr_;
+    const ObField *field_;
+    ObObjType obj_type_;
+    int16_t scale_;
+    bool zerofill_;
+    int32_t zflength_;
+  };
+  static bool need_convert_charset(const ObCollationType cs_type,
+                                   const ObCharsetType result_charset);
+  int encode_generic(const ColumnEncoder &col, const ObDatum &datum, const int64_t col_idx,
+                     char *buf, const int64_t len, int64_t &pos, char *bitmap) const;
+
+private:
+  bool is_inited_;
+  obmysql::MYSQL_PROTOCOL_TYPE type_;
+  sql::ObEvalCtx *eval_ctx_;
+  ObDataTypeCastParams dtc_params_;
+  ObSEArray<ColumnEncoder, 16> columns_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObSMDatumRowEncoder);
+};
+
+class ObSMDatumRow
+    : public obmysql::ObMySQLRow
+{
+public:
+  ObSMDatumRow(const ObSMDatumRowEncoder &encoder, const int64_t batch_idx)
+    : ObMySQLRow(encoder.get_protocol_type()),
+      encoder_(encoder),
+      batch_idx_(batch_idx)
+  {}
+  virtual ~ObSMDatumRow() {}
+
+protected:
+  virtual int64_t get_cells_cnt() const { return encoder_.get_column_cnt(); }
+  virtual int encode_cell(
+      int64_t idx, char *buf,
+      int64_t len, int64_t &pos, char *bitmap) const
+  {
+    return encoder_.encode_cell(idx, batch_idx_, buf, len, pos, bitmap);
+  }
+
+private:
+  const ObSMDatumRowEncoder &encoder_;
+  const int64_t batch_idx_;
+
+  DISALLOW_COPY_AND_ASSIGN(ObSMDatumRow);
+};
+
+} // end of namespace common
+} // end of namespace oceanbase
+
+#endif /* _OCEABASE_COMMON_OBSM_DATUM_ROW_H_ */
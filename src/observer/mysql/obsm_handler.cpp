@@ -88,6 +88,7 @@ int ObSMHandler::on_connect(easy_connection_t *c)
       hsp.set_thread_id(sessid);
       const bool suppot_ssl = GCONF.ssl_client_authentication;
       hsp.set_ssl_cap(suppot_ssl);
+      hsp.set_compress_cap(GCONF._enable_mysql_compress_protocol, true);
       c->ssl_sm_ = (suppot_ssl ? SSM_BEFORE_FIRST_PKT : SSM_NONE);
       const int64_t BUF_LEN = sizeof(conn->scramble_buf_);
       if (OB_ISNULL(conn = reinterpret_cast<ObSMConnection*>(easy_alloc(c->pool, sizeof(ObSMConnection))))) {
@@ -339,7 +340,8 @@ bool ObSMHandler::is_compressed(easy_connection_t *c) const
     LOG_ERROR("easy_connection_t is null");
   } else {
     ObSMConnection *conn = reinterpret_cast<ObSMConnection*>(c->user_data);
-    bool_ret = (1 == conn->cap_flags_.cap_flags_.OB_CLIENT_COMPRESS);
+    bool_ret = (1 == conn->cap_flags_.cap_flags_.OB_CLIENT_COMPRESS
+                || 1 == conn->cap_flags_.cap_flags_.OB_CLIENT_ZSTD_COMPRESSION_ALGORITHM);
   }
   return bool_ret;
 }
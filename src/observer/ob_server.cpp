@@ -181,6 +181,16 @@ int ObServer::init(const ObServerOptions &opts, const ObPLogWriterCfg &log_cfg)
 
   // set large page param
   ObLargePageHelper::set_param(config_.use_large_pages);
+  if (OB_SUCC(ret)) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCCESS != (tmp_ret = ObLargePageHelper::set_ctx_param(config_._ctx_large_pages))) {
+      LOG_WARN("set ctx large page param failed", K(tmp_ret));
+    } else if (config_._large_page_pool_size > 0 &&
+               OB_SUCCESS != (tmp_ret = CHUNK_MGR.init_huge_page_pool(config_._large_page_pool_size))) {
+      // chunks of ctx with pool policy fall back to mapped huge pages
+      LOG_WARN("init huge page pool failed", K(tmp_ret), K(config_._large_page_pool_size));
+    }
+  }
 
   if (FAILEDx(OB_LOGGER.init(log_cfg))) {
     LOG_ERROR("async log init error.", KR(ret));
@@ -15,6 +15,7 @@
 #include "ob_server_reload_config.h"
 #include "lib/alloc/alloc_func.h"
 #include "lib/alloc/ob_malloc_allocator.h"
+#include "lib/alloc/ob_malloc_thread_cache.h"
 #include "lib/allocator/ob_tc_malloc.h"
 #include "lib/allocator/ob_mem_leak_checker.h"
 #include "share/scheduler/ob_dag_scheduler.h"
@@ -27,6 +28,7 @@
 #include "observer/ob_server.h"
 #include "observer/ob_server_utils.h"
 #include "observer/ob_service.h"
+#include "sql/engine/ob_exec_page_allocator.h"
 #include "storage/tx_storage/ob_tenant_freezer.h"
 #include "storage/compaction/ob_tenant_tablet_scheduler.h"
 #include "storage/slog/ob_storage_logger_manager.h"
@@ -175,6 +177,8 @@ int ObServerReloadConfig::operator()()
   const int64_t cache_size = GCONF.memory_chunk_cache_size;
   const int cache_cnt = (cache_size > 0 ? cache_size : GMEMCONF.get_server_memory_limit()) / INTACT_ACHUNK_SIZE;
   lib::AChunkMgr::instance().set_max_chunk_cache_cnt(cache_cnt);
+  lib::ObMallocThreadCache::set_max_cache_size(GCONF._malloc_thread_cache_size);
+  sql::ObExecPageAllocator::set_enabled(GCONF._enable_exec_page_cache);
   if (GCONF.cluster_id.get_value() >= 0) {
     obrpc::ObRpcNetHandler::CLUSTER_ID = GCONF.cluster_id.get_value();
     LOG_INFO("set CLUSTER_ID for rpc", "cluster_id", GCONF.cluster_id.get_value());
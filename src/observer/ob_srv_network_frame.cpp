@@ -175,6 +175,8 @@ int ObSrvNetworkFrame::start()
         if (0 == net_thread_count) {
           net_thread_count = get_default_net_thread_count();
         }
+        obmysql::global_sql_nio_server->set_pipeline_coalesce_size(
+            GCONF._sql_pipeline_response_coalesce_size);
         if(OB_FAIL(obmysql::global_sql_nio_server->start(GCONF.mysql_port, &deliver_, net_thread_count))) {
           LOG_ERROR("sql nio server start failed", K(ret));
         }
@@ -217,6 +219,10 @@ int ObSrvNetworkFrame::reload_config()
                                                           tcp_keepcnt))) {
     LOG_WARN("Failed to set sql tcp keepalive parameters.");
   }
+  if (NULL != obmysql::global_sql_nio_server) {
+    obmysql::global_sql_nio_server->set_pipeline_coalesce_size(
+        GCONF._sql_pipeline_response_coalesce_size);
+  }
 
   return ret;
 }
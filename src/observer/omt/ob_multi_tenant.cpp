@@ -677,6 +677,13 @@ int ObMultiTenant::create_tenant(const ObTenantMeta &meta, bool write_slog, cons
       LOG_ERROR("create tenant allocator fail", K(ret), K(ctx_id));
     }
   }
+  const int64_t numa_node = OB_SUCC(ret)
+      ? ObTenantNodeBalancer::get_instance().choose_numa_node(tenant_id, min_cpu) : -1;
+  if (OB_SUCC(ret) && numa_node >= 0) {
+    if (OB_FAIL(malloc_allocator->set_tenant_numa_node(tenant_id, numa_node))) {
+      LOG_WARN("set tenant numa node failed", K(ret), K(tenant_id), K(numa_node));
+    }
+  }
   if (OB_SUCC(ret)) {
     if (OB_FAIL(update_tenant_memory(tenant_id, meta.unit_.config_.memory_size(), allowed_mem_limit))) {
       LOG_WARN("fail to update tenant memory", K(ret), K(tenant_id));
@@ -711,6 +718,7 @@ int ObMultiTenant::create_tenant(const ObTenantMeta &meta, bool write_slog, cons
     LOG_WARN("new tenant fail", K(ret));
   } else if (FALSE_IT(create_step = ObTenantCreateStep::STEP_TENANT_NEWED)) { //step2
 
+  } else if (FALSE_IT(tenant->set_numa_node(numa_node))) {
   } else if (OB_FAIL(tenant->init_ctx())) {
     LOG_WARN("init ctx fail", K(tenant_id), K(ret));
   } else if (write_slog) {
@@ -954,6 +962,9 @@ int ObMultiTenant::update_tenant_config(uint64_t tenant_id)
       if (OB_SUCCESS != (tmp_ret = update_tenant_dag_scheduler_config())) {
         LOG_WARN("failed to update tenant dag scheduler config", K(tmp_ret), K(tenant_id));
       }
+      if (OB_SUCCESS != (tmp_ret = update_tenant_kvcache_config(tenant_id, tenant_config))) {
+        LOG_WARN("failed to update tenant kvcache config", K(tmp_ret), K(tenant_id));
+      }
     }
   }
   LOG_INFO("update_tenant_config success", K(tenant_id));
@@ -989,6 +1000,29 @@ int ObMultiTenant::update_tenant_dag_scheduler_config()
   return ret;
 }
 
+int ObMultiTenant::update_tenant_kvcache_config(const uint64_t tenant_id, ObTenantConfigGuard &tenant_config)
+{
+  int ret = OB_SUCCESS;
+  const int64_t priority_class = tenant_config->_kvcache_priority_class;
+  const char *cache_names[] = { "index_block_cache", "user_block_cache", "user_row_cache", "bf_cache" };
+  const int64_t reserved_sizes[] = {
+    tenant_config->_index_block_cache_reserved_size,
+    tenant_config->_user_block_cache_reserved_size,
+    tenant_config->_user_row_cache_reserved_size,
+    tenant_config->_bf_cache_reserved_size };
+  STATIC_ASSERT(ARRAYSIZEOF(cache_names) == ARRAYSIZEOF(reserved_sizes), "cache qos config mismatch");
+  for (int64_t i = 0; i < ARRAYSIZEOF(cache_names); ++i) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_TMP_FAIL(ObKVGlobalCache::get_instance().set_tenant_cache_qos(
+        tenant_id, cache_names[i], priority_class, reserved_sizes[i]))) {
+      LOG_WARN("failed to set tenant cache qos", K(tmp_ret), K(tenant_id), K(cache_names[i]),
+               K(priority_class), K(reserved_sizes[i]));
+      ret = OB_SUCC(ret) ? tmp_ret : ret;
+    }
+  }
+  return ret;
+}
+
 int ObMultiTenant::update_tenant_freezer_mem_limit(const uint64_t tenant_id,
                                                 const int64_t tenant_min_mem,
                                                 const int64_t tenant_max_mem)
@@ -121,6 +121,7 @@ public:
   int update_tenant_config(uint64_t tenant_id);
   int update_palf_disk_config(ObTenantConfigGuard &tenant_config);
   int update_tenant_dag_scheduler_config();
+  int update_tenant_kvcache_config(const uint64_t tenant_id, ObTenantConfigGuard &tenant_config);
   int get_tenant(const uint64_t tenant_id, ObTenant *&tenant) const;
   int get_tenant_with_tenant_lock(const uint64_t tenant_id, common::ObLDHandle &handle, ObTenant *&tenant) const;
   int update_tenant(uint64_t tenant_id, std::function<int(ObTenant&)> &&func);
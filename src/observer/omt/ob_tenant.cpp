@@ -37,6 +37,7 @@
 #include "sql/engine/ob_tenant_sql_memory_manager.h"
 #include "storage/meta_mem/ob_tenant_meta_mem_mgr.h"
 #include "lib/worker.h"
+#include "lib/cpu/ob_cpu_topology.h"
 #include "ob_tenant_mtl_helper.h"
 #include "storage/ob_file_system_router.h"
 #include "storage/slog/ob_storage_logger.h"
@@ -543,6 +544,7 @@ ObTenant::ObTenant(const int64_t id,
       wait_mtl_finished_(false),
       req_queue_(),
       large_req_queue_(),
+      local_req_queue_(),
       recv_hp_rpc_cnt_(0),
       recv_np_rpc_cnt_(0),
       recv_lp_rpc_cnt_(0),
@@ -603,6 +605,11 @@ int ObTenant::init(const ObTenantMeta &meta)
   if (OB_FAIL(ObTenantBase::init(&cgroup_ctrl_))) {
     LOG_WARN("fail to init tenant base", K(ret));
   } else if (FALSE_IT(req_queue_.set_limit(common::ObServerConfig::get_instance().tenant_task_queue_size))) {
+  } else if (OB_FAIL(local_req_queue_.init(
+          std::min(get_cpu_count(), ObWorkStealingQueue::MAX_SHARD_CNT),
+          ObMemAttr(OB_SERVER_TENANT_ID, ObModIds::OMT_TENANT)))) {
+    LOG_WARN("init local request queue failed", K(ret), K_(id));
+  } else if (FALSE_IT(local_req_queue_.set_limit(common::ObServerConfig::get_instance().tenant_task_queue_size))) {
   } else if (worker_pool_.init(1, 1)) {
     // useless now, but maybe useful later
     LOG_WARN("init worker pool fail", K(ret));
@@ -904,6 +911,7 @@ void ObTenant::destroy()
     common::ob_delete(multi_level_queue_);
     multi_level_queue_ = nullptr;
   }
+  local_req_queue_.destroy();
   if (nullptr != rpc_stat_info_) {
     common::ob_delete(rpc_stat_info_);
     rpc_stat_info_ = nullptr;
@@ -1060,13 +1068,25 @@ int ObTenant::get_new_request(
             acquire_lq_token()) {
           w.set_lq_token();
         }
+        const bool local_queue_enabled = GCONF._enable_tenant_worker_local_queue;
         if (OB_LIKELY(!w.has_lq_token())) {
-          ret = req_queue_.pop(task, 0L);
+          // req_queue_ only holds high priority requests and rpc when
+          // local queue is enabled, don't touch it if it's empty.
+          if (!local_queue_enabled || req_queue_.size() > 0) {
+            ret = req_queue_.pop(task, 0L);
+          }
+          // requests left in local queue after it's disabled are still
+          // drained here.
+          if (nullptr == task && (local_queue_enabled || local_req_queue_.size() > 0)) {
+            ret = local_req_queue_.pop(get_local_queue_idx(w), task, 0L);
+          }
         }
         if (OB_UNLIKELY(nullptr == task)) {
           // If large query flag is set, we prefer large query.
           if (OB_SUCC(large_req_queue_.pop(task))) {
             w.set_large_query();
+          } else if (local_queue_enabled) {
+            ret = pop_local_request(w, task, timeout);
           } else {
             // Ignore return code from large queue and get request from
             // normal queue.
@@ -1102,6 +1122,37 @@ int ObTenant::get_new_request(
   return ret;
 }
 
+int64_t ObTenant::get_local_queue_idx(const ObThWorker &w) const
+{
+  // worker 0 and 1 are reserved for high priority requests and never
+  // pop normal ones except the queue has only two workers.
+  const int64_t tidx = w.Worker::get_tidx();
+  return tidx >= 2 ? tidx - 2 : tidx;
+}
+
+int ObTenant::pop_local_request(ObThWorker &w, ObLink *&task, int64_t timeout)
+{
+  // Requests pushed into any shard wake up one of the waiters, so do the
+  // ones pushed into req_queue_, see recv_request.
+  int ret = local_req_queue_.pop(get_local_queue_idx(w), task, std::max(timeout, 0L));
+  if (nullptr == task && req_queue_.size() > 0) {
+    ret = req_queue_.pop(task, 0L);
+  }
+  return ret;
+}
+
+int ObTenant::push_normal_request(rpc::ObRequest &req, bool &local_queued)
+{
+  int ret = OB_SUCCESS;
+  local_queued = GCONF._enable_tenant_worker_local_queue;
+  if (local_queued) {
+    ret = local_req_queue_.push(&req);
+  } else {
+    ret = req_queue_.push(&req, RQ_NORMAL);
+  }
+  return ret;
+}
+
 using oceanbase::obrpc::ObRpcPacket;
 inline bool is_high_prio(const ObRpcPacket &pkt)
 {
@@ -1132,6 +1183,9 @@ int ObTenant::recv_request(ObRequest &req)
 {
   int ret = OB_SUCCESS;
   int req_level = 0;
+  // req may be processed and freed once it's pushed, don't touch it after
+  const bool in_group = 0 != req.get_group_id();
+  bool local_queued = false;
   if (ATOMIC_LOAD(&stopped_)) {
     ret = OB_IN_STOP_STATE;
     LOG_WARN("receive request but tenant has already stopped", K(ret), K(id_));
@@ -1219,7 +1273,7 @@ int ObTenant::recv_request(ObRequest &req)
         }
       } else {
         ATOMIC_INC(&recv_mysql_cnt_);
-        if (OB_FAIL(req_queue_.push(&req, RQ_NORMAL))) {
+        if (OB_FAIL(push_normal_request(req, local_queued))) {
           LOG_WARN("push request to queue fail", K(ret), K(this));
         }
       }
@@ -1231,7 +1285,7 @@ int ObTenant::recv_request(ObRequest &req)
       }
     } else if (req.get_type() == ObRequest::OB_SQL_TASK) {
       ATOMIC_INC(&recv_sql_task_cnt_);
-      if (OB_FAIL(req_queue_.push(&req, RQ_NORMAL))) {
+      if (OB_FAIL(push_normal_request(req, local_queued))) {
         LOG_WARN("push request to queue fail", K(ret), K(this));
       }
     } else {
@@ -1243,6 +1297,11 @@ int ObTenant::recv_request(ObRequest &req)
   if (OB_SUCC(ret)) {
     ObTenantStatEstGuard guard(id_);
     EVENT_INC(REQUEST_ENQUEUE_COUNT);
+    // normal workers wait on local queue if it's enabled, wake one of
+    // them up for requests in req_queue_.
+    if (!in_group && !local_queued && GCONF._enable_tenant_worker_local_queue) {
+      local_req_queue_.notify();
+    }
   }
 
   return ret;
@@ -1428,6 +1487,8 @@ int ObTenant::check_worker_count()
       }
     }
     actives_ = active_workers;
+    // producers of local queue only pick shards owned by active workers
+    local_req_queue_.set_active_shard_cnt(active_workers > 2 ? active_workers - 2 : active_workers);
 
     const auto diff = token_cnt_ - ass_token_cnt_;
     if (diff > 0) {
@@ -1652,7 +1713,7 @@ void ObTenant::check_paused_worker(ObThWorker &w)
     if (w.has_lq_token() || acquire_lq_token()) {
       w.set_lq_token(true);
     }
-    if (w.has_lq_token() || req_queue_.size() == 0) {
+    if (w.has_lq_token() || (req_queue_.size() == 0 && local_req_queue_.size() == 0)) {
       ObMutexGuard guard(lq_waiting_workers_lock_);
       auto *node = lq_waiting_workers_.remove_first();
       if (nullptr != node) {
@@ -1749,6 +1810,7 @@ bool ObTenant::has_task() const
   bool result = false;
   if (!result) {
     result = req_queue_.size() > 0 ||
+        local_req_queue_.size() > 0 ||
         large_req_queue_.size() > 0 ||
         lq_waiting_workers_.get_size() > 0;
   }
@@ -1757,13 +1819,13 @@ bool ObTenant::has_task() const
 
 int64_t ObTenant::get_request_queue_length() const
 {
-  return req_queue_.size();
+  return req_queue_.size() + local_req_queue_.size();
 }
 
 int64_t ObTenant::waiting_count() const
 {
   // TODO: add waiting workers with paused task.
-  return req_queue_.size();
+  return req_queue_.size() + local_req_queue_.size();
 }
 
 // thread unsafe
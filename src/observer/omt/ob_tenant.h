@@ -18,6 +18,7 @@
 #include "lib/time/ob_time_utility.h"
 #include "lib/list/ob_dlist.h"
 #include "lib/queue/ob_priority_queue.h"
+#include "lib/queue/ob_work_stealing_queue.h"
 #include "lib/queue/ob_fixed_queue.h"
 #include "lib/lock/ob_spin_lock.h"
 #include "lib/lock/ob_mutex.h"
@@ -492,6 +493,7 @@ public:
                "lq waiting workers", lq_waiting_workers_.get_size(),
                K_(req_queue),
                "large queued", large_req_queue_.size(),
+               "local queued", local_req_queue_.size(),
                K_(multi_level_queue),
                K_(recv_level_rpc_cnt),
                K_(group_map),
@@ -563,6 +565,9 @@ private:
   inline void resume_it(ObThWorker &w);
 
   int pop_req(common::ObLink *&req, int64_t timeout);
+  int64_t get_local_queue_idx(const ObThWorker &w) const;
+  int pop_local_request(ObThWorker &w, common::ObLink *&task, int64_t timeout);
+  int push_normal_request(rpc::ObRequest &req, bool &local_queued);
 
   // read tenant variable PARALLEL_SERVERS_TARGET
   void check_parallel_servers_target();
@@ -615,6 +620,10 @@ protected:
   // 'hp' for high priority and 'np' for normal priority
   common::ObPriorityQueue2<1, QQ_MAX_PRIO - 1, RQ_MAX_PRIO - QQ_MAX_PRIO> req_queue_;
   common::ObLinkQueue large_req_queue_;
+  // normal priority mysql requests and sql tasks go here instead of
+  // req_queue_ if _enable_tenant_worker_local_queue is on, sharded by
+  // normal level 0 workers.
+  common::ObWorkStealingQueue local_req_queue_;
 
   //Create a request queue for each level of nested requests
   ObMultiLevelQueue *multi_level_queue_;
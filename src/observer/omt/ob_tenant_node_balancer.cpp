@@ -15,6 +15,7 @@
 #include "lib/time/ob_time_utility.h"
 #include "lib/oblog/ob_log.h"
 #include "lib/alloc/ob_malloc_allocator.h"
+#include "lib/cpu/ob_cpu_topology.h"
 #include "lib/container/ob_se_array_iterator.h"
 #include "lib/mysqlclient/ob_mysql_proxy.h"
 #include "share/ob_tenant_mgr.h"
@@ -97,6 +98,7 @@ void ObTenantNodeBalancer::run1()
       LOG_WARN("failed to refresh tenant", K(ret), K(units));
     } else if (FALSE_IT(periodically_check_tenant())) {
       // never reach here
+    } else if (FALSE_IT(print_numa_node_stats())) {
     }
 
     FLOG_INFO("refresh tenant units", K(sys_unit_cnt), K(units), KR(ret));
@@ -427,6 +429,74 @@ void ObTenantNodeBalancer::periodically_check_tenant()
   }
 }
 
+int64_t ObTenantNodeBalancer::choose_numa_node(const uint64_t tenant_id, const double min_cpu) const
+{
+  int ret = OB_SUCCESS;
+  int64_t node = -1;
+  ObSEArray<NumaNodeStat, 4> stats;
+  if (!GCONF._enable_numa_aware_tenant
+      || is_virtual_tenant_id(tenant_id)
+      || ObNumaTopology::instance().get_node_count() <= 1) {
+    // no binding
+  } else if (OB_FAIL(get_numa_node_stats(stats))) {
+    LOG_WARN("get numa node stats failed", K(ret), K(tenant_id));
+  } else {
+    double min_load = 0;
+    for (int64_t i = 0; i < stats.count(); i++) {
+      const NumaNodeStat &stat = stats.at(i);
+      const double load = (stat.min_cpu_ + min_cpu) / static_cast<double>(max(stat.cpu_cnt_, 1L));
+      if (stat.cpu_cnt_ > 0 && (-1 == node || load < min_load)) {
+        node = stat.node_;
+        min_load = load;
+      }
+    }
+    LOG_INFO("choose numa node for tenant", K(tenant_id), K(min_cpu), K(node), K(stats));
+  }
+  return node;
+}
+
+int ObTenantNodeBalancer::get_numa_node_stats(ObIArray<NumaNodeStat> &stats) const
+{
+  int ret = OB_SUCCESS;
+  const ObNumaTopology &topology = ObNumaTopology::instance();
+  stats.reset();
+  for (int64_t i = 0; OB_SUCC(ret) && i < topology.get_node_count(); i++) {
+    NumaNodeStat stat;
+    stat.node_ = i;
+    stat.cpu_cnt_ = CPU_COUNT(&topology.get_node_cpus(i));
+    if (OB_FAIL(stats.push_back(stat))) {
+      LOG_WARN("push back numa node stat failed", K(ret), K(i));
+    }
+  }
+  if (OB_SUCC(ret) && OB_NOT_NULL(GCTX.omt_)) {
+    ret = GCTX.omt_->for_each([&stats](ObTenant &tenant) {
+        const int64_t node = tenant.get_numa_node();
+        if (node >= 0 && node < stats.count()) {
+          NumaNodeStat &stat = stats.at(node);
+          stat.tenant_cnt_++;
+          stat.min_cpu_ += tenant.unit_min_cpu();
+          stat.max_cpu_ += tenant.unit_max_cpu();
+          stat.memory_hold_ += ObMallocAllocator::get_tenant_hold(tenant.id());
+        }
+        return OB_SUCCESS;
+      });
+  }
+  return ret;
+}
+
+void ObTenantNodeBalancer::print_numa_node_stats() const
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<NumaNodeStat, 4> stats;
+  if (!GCONF._enable_numa_aware_tenant || ObNumaTopology::instance().get_node_count() <= 1) {
+    // skip
+  } else if (OB_FAIL(get_numa_node_stats(stats))) {
+    LOG_WARN("get numa node stats failed", K(ret));
+  } else {
+    LOG_INFO("numa node stats", K(stats));
+  }
+}
+
 // Although unit has been deleted, the local cached unit cannot be deleted if the tenant still holds resource
 int ObTenantNodeBalancer::fetch_effective_tenants(const TenantUnits &old_tenants, TenantUnits &new_tenants)
 {
@@ -53,6 +53,23 @@ public:
     int64_t log_disk_size_;
   };
 
+  // resource of tenants bound to one numa node
+  struct NumaNodeStat
+  {
+  public:
+    NumaNodeStat() : node_(-1), cpu_cnt_(0), tenant_cnt_(0), min_cpu_(0),
+                     max_cpu_(0), memory_hold_(0) {}
+    ~NumaNodeStat() {}
+    TO_STRING_KV(K_(node), K_(cpu_cnt), K_(tenant_cnt), K_(min_cpu), K_(max_cpu),
+                 K_(memory_hold));
+    int64_t node_;
+    int64_t cpu_cnt_;
+    int64_t tenant_cnt_;
+    double min_cpu_;
+    double max_cpu_;
+    int64_t memory_hold_;
+  };
+
 public:
   static OB_INLINE ObTenantNodeBalancer &get_instance();
 
@@ -71,6 +88,12 @@ public:
 
   int update_tenant_memory(const obrpc::ObTenantMemoryArg &tenant_memory);
 
+  // Choose numa node for new tenant, the one with lowest min cpu per
+  // core. Return -1 if _enable_numa_aware_tenant is off, tenant is
+  // virtual or machine has only one node.
+  int64_t choose_numa_node(const uint64_t tenant_id, const double min_cpu) const;
+  int get_numa_node_stats(common::ObIArray<NumaNodeStat> &stats) const;
+
   virtual void run1();
 
 private:
@@ -84,6 +107,7 @@ private:
   void periodically_check_tenant();
   int fetch_effective_tenants(const share::TenantUnits &old_tenants, share::TenantUnits &new_tenants);
   int refresh_tenant(share::TenantUnits &units);
+  void print_numa_node_stats() const;
   DISALLOW_COPY_AND_ASSIGN(ObTenantNodeBalancer);
 
 private:
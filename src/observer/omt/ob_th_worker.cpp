@@ -16,17 +16,22 @@
 #include "share/ob_define.h"
 #include "lib/time/ob_time_utility.h"
 #include "lib/oblog/ob_trace_log.h"
+#include "lib/oblog/ob_warning_buffer.h"
 #include "lib/stat/ob_diagnose_info.h"
+#include "lib/lock/ob_latch.h"
 #include "lib/stat/ob_session_stat.h"
+#include "lib/ash/ob_active_session_guard.h"
 #include "lib/allocator/ob_page_manager.h"
 #include "lib/rc/context.h"
 #include "lib/thread/ob_thread_name.h"
+#include "lib/cpu/ob_cpu_topology.h"
 #include "ob_tenant.h"
 #include "ob_worker_processor.h"
 #include "share/config/ob_server_config.h"
 #include "observer/ob_server.h"
 #include "storage/memtable/ob_lock_wait_mgr.h"
 #include "sql/session/ob_sql_session_info.h"
+#include "sql/engine/ob_exec_page_allocator.h"
 
 using namespace oceanbase;
 using namespace oceanbase::lib;
@@ -52,7 +57,10 @@ ObThWorker::ObThWorker()
       query_start_time_(0), last_check_time_(0),
       can_retry_(true), need_retry_(false),
       active_(false), waiting_active_(false),
-      active_inactive_ts_(0L), lq_token_(false), has_add_to_cgroup_(false)
+      active_inactive_ts_(0L), lq_token_(false), has_add_to_cgroup_(false),
+      numa_node_(-1),
+      co_root_flow_(nullptr), co_tasks_(nullptr), co_task_cnt_(0), co_task_inited_(false),
+      cur_co_task_(nullptr), suspended_co_cnt_(0)
 {
 }
 
@@ -268,6 +276,20 @@ ObThWorker::Status ObThWorker::check_wait()
   return st;
 }
 
+void ObThWorker::process_request_in_place(rpc::ObRequest &req, const int64_t start_time)
+{
+  query_start_time_ = start_time;
+  query_enqueue_time_ = req.get_enqueue_timestamp();
+  last_check_time_ = start_time;
+  set_rpc_stat_srv(&(tenant_->rpc_stat_info_->rpc_stat_srv_));
+  const int64_t req_start_time = ObTimeUtility::current_time();
+  process_request(req);
+  const int64_t req_end_time = ObTimeUtility::current_time();
+  tenant_->add_worker_time(req_end_time - req_start_time);
+  query_enqueue_time_ = INT64_MAX;
+  query_start_time_ = INT64_MAX;
+}
+
 inline void ObThWorker::process_request(rpc::ObRequest &req)
 {
   // reset retry flags
@@ -348,6 +370,15 @@ void ObThWorker::set_th_worker_thread_name(uint64_t tenant_id)
   }
 }
 
+static inline void init_req_context_param(lib::ContextParam &param, const uint64_t tenant_id)
+{
+  param.set_mem_attr(tenant_id, ObModIds::OB_SQL_EXECUTOR, ObCtxIds::DEFAULT_CTX_ID)
+    .set_page_size(!lib::is_mini_mode() ?
+        OB_MALLOC_BIG_BLOCK_SIZE : OB_MALLOC_MIDDLE_BLOCK_SIZE)
+    .set_properties(lib::USE_TL_PAGE_OPTIONAL)
+    .set_ablock_size(lib::INTACT_MIDDLE_AOBJECT_SIZE);
+}
+
 void ObThWorker::worker(int64_t &tenant_id, int64_t &req_recv_timestamp, int32_t &worker_level)
 {
   int ret = OB_SUCCESS;
@@ -355,9 +386,10 @@ void ObThWorker::worker(int64_t &tenant_id, int64_t &req_recv_timestamp, int32_t
   lib::Worker::self_ = this;
   int64_t wait_start_time = 0;
   int64_t wait_end_time = 0;
-  int64_t req_start_time = 0;
-  int64_t req_end_time = 0;
   th_created();
+  // contexts created on coroutines are rooted here rather than the
+  // temporary context of each round, which may end before them.
+  co_root_flow_ = &lib::Flow::current_flow();
 
   // Avoid adding and deleting entities from the root node for every request, the parameters are meaningless
   CREATE_WITH_TEMP_ENTITY(RESOURCE_OWNER, OB_SERVER_TENANT_ID) {
@@ -380,6 +412,14 @@ void ObThWorker::worker(int64_t &tenant_id, int64_t &req_recv_timestamp, int32_t
           GCTX.cgroup_ctrl_->add_thread_to_cgroup(get_tid(), tenant_->id(), get_group_id());
           has_add_to_cgroup_ = true;
         }
+        if (tenant_->get_numa_node() >= 0 && numa_node_ != tenant_->get_numa_node()) {
+          // don't retry on failure, tenant worker still works unbound
+          numa_node_ = tenant_->get_numa_node();
+          int tmp_ret = ObNumaTopology::instance().bind_thread_to_node(numa_node_);
+          if (OB_SUCCESS != tmp_ret) {
+            LOG_WARN("bind worker to numa node failed", K(tmp_ret), K(tenant_id), K_(numa_node));
+          }
+        }
         if (OB_LIKELY(pm != nullptr)) {
           if (pm->get_used() != 0) {
             LOG_ERROR("page manager's used should be 0, unexpected!!!", KP(pm));
@@ -388,15 +428,20 @@ void ObThWorker::worker(int64_t &tenant_id, int64_t &req_recv_timestamp, int32_t
             ret = pm->set_tenant_ctx(tenant_->id(), ObCtxIds::DEFAULT_CTX_ID);
           }
         }
+        sql::ObExecPageAllocator::set_thread_tenant(tenant_->id());
+        if (OB_SUCC(ret) && !co_task_inited_ &&
+            this->get_worker_level() == 0 && this->get_group() == nullptr) {
+          co_task_inited_ = true;
+          if (GCONF._ob_worker_coroutine_cnt > 0 && OB_FAIL(init_co_tasks())) {
+            LOG_WARN("init worker coroutines fail, process requests on thread", K(ret));
+            ret = OB_SUCCESS;
+          }
+        }
         CLEAR_INTERRUPTABLE();
         set_th_worker_thread_name(tenant_->id());
         lib::ContextTLOptGuard guard(true);
         lib::ContextParam param;
-        param.set_mem_attr(tenant_->id(), ObModIds::OB_SQL_EXECUTOR, ObCtxIds::DEFAULT_CTX_ID)
-          .set_page_size(!lib::is_mini_mode() ?
-              OB_MALLOC_BIG_BLOCK_SIZE : OB_MALLOC_MIDDLE_BLOCK_SIZE)
-          .set_properties(lib::USE_TL_PAGE_OPTIONAL)
-          .set_ablock_size(lib::INTACT_MIDDLE_AOBJECT_SIZE);
+        init_req_context_param(param, tenant_->id());
         CREATE_WITH_TEMP_CONTEXT(param) {
           class AllocatorGuard {
           public:
@@ -420,43 +465,38 @@ void ObThWorker::worker(int64_t &tenant_id, int64_t &req_recv_timestamp, int32_t
               ObTenantStatEstGuard guard(tenant_->id());
               set_compatibility_mode(tenant_->get_compat_mode());
 
-              // get request from queue and process it
-              rpc::ObRequest *req = NULL;
-              wait_start_time = ObTimeUtility::current_time();
-
-              /// get request from tenant
-              {
-                ObWaitEventGuard wait_guard(ObWaitEventIds::OMT_IDLE, 0, wait_start_time, 0, 0);
-                ret = tenant_->get_new_request(*this, REQUEST_WAIT_TIME, req);
-                wait_end_time = ObTimeUtility::current_time();
-              }
+              if (co_task_cnt_ > 0 && this->get_worker_level() == 0 && this->get_group() == nullptr) {
+                co_worker(req_recv_timestamp);
+              } else {
+                // get request from queue and process it
+                rpc::ObRequest *req = NULL;
+                wait_start_time = ObTimeUtility::current_time();
+
+                /// get request from tenant
+                {
+                  ObWaitEventGuard wait_guard(ObWaitEventIds::OMT_IDLE, 0, wait_start_time, 0, 0);
+                  ret = tenant_->get_new_request(*this, REQUEST_WAIT_TIME, req);
+                  wait_end_time = ObTimeUtility::current_time();
+                }
 
-              if (OB_SUCC(ret)) {
-                if (OB_LIKELY(nullptr != req)) {
-                  req_recv_timestamp = req->get_receive_timestamp(); // Update backtrace printing parameters
-                  EVENT_ADD(REQUEST_QUEUE_TIME, wait_end_time - req->get_enqueue_timestamp());
-                  req->set_push_pop_diff(wait_end_time);
-                  query_start_time_ = wait_end_time;
-                  query_enqueue_time_ = req->get_enqueue_timestamp();
-                  last_check_time_ = wait_end_time;
-                  set_rpc_stat_srv(&(tenant_->rpc_stat_info_->rpc_stat_srv_));
-                  req_start_time = ObTimeUtility::current_time();
-                  process_request(*req);
-                  req_end_time = ObTimeUtility::current_time();
-                  tenant_->add_worker_time(req_end_time - req_start_time);
-                  query_enqueue_time_ = INT64_MAX;
-                  query_start_time_ = INT64_MAX;
-                } else {
-                  ret = OB_ERR_UNEXPECTED;
-                  LOG_ERROR(
-                      "got NULL request from tenant",
-                      K(tenant_), K(ret), K(req));
+                if (OB_SUCC(ret)) {
+                  if (OB_LIKELY(nullptr != req)) {
+                    req_recv_timestamp = req->get_receive_timestamp(); // Update backtrace printing parameters
+                    EVENT_ADD(REQUEST_QUEUE_TIME, wait_end_time - req->get_enqueue_timestamp());
+                    req->set_push_pop_diff(wait_end_time);
+                    process_request_in_place(*req, wait_end_time);
+                  } else {
+                    ret = OB_ERR_UNEXPECTED;
+                    LOG_ERROR(
+                        "got NULL request from tenant",
+                        K(tenant_), K(ret), K(req));
+                  }
+                } else if (OB_ENTRY_NOT_EXIST == ret) {
+                  // timeout while waiting for request from tenant request queue
+                  ret = OB_SUCCESS;
                 }
-              } else if (OB_ENTRY_NOT_EXIST == ret) {
-                // timeout while waiting for request from tenant request queue
-                ret = OB_SUCCESS;
+                tenant_->add_idle_time(wait_end_time - wait_start_time);
               }
-              tenant_->add_idle_time(wait_end_time - wait_start_time);
               if (this->get_worker_level() == 0 && this->get_group() == nullptr) {
                 tenant_->check_worker_count(*this);
                 tenant_->check_paused_worker(*this);
@@ -470,6 +510,9 @@ void ObThWorker::worker(int64_t &tenant_id, int64_t &req_recv_timestamp, int32_t
     }
   }
 
+  destroy_co_tasks();
+  // tenant memory may be destroyed once workers stop
+  sql::ObExecPageAllocator::set_thread_tenant(OB_INVALID_TENANT_ID);
   th_destroy();
 }
 
@@ -536,3 +579,291 @@ int ObThWorker::check_status()
   }
   return ret;
 }
+
+int ObThWorker::init_co_tasks()
+{
+  int ret = OB_SUCCESS;
+  const int64_t cnt = GCONF._ob_worker_coroutine_cnt;
+  const int64_t stack_size = GCONF._ob_worker_coroutine_stack_size;
+  ObMemAttr attr(OB_SERVER_TENANT_ID, "WorkerCoTask");
+  void *buf = nullptr;
+  if (OB_NOT_NULL(co_tasks_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("worker coroutines have been inited", K(ret));
+  } else if (cnt <= 0) {
+    // do nothing
+  } else if (OB_ISNULL(buf = ob_malloc(sizeof(CoTask) * cnt, attr))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("alloc worker coroutines fail", K(ret), K(cnt));
+  } else {
+    co_tasks_ = static_cast<CoTask*>(buf);
+    for (int64_t i = 0; i < cnt; i++) {
+      new (&co_tasks_[i]) CoTask();
+      co_tasks_[i].worker_ = this;
+    }
+    co_task_cnt_ = cnt;
+    for (int64_t i = 0; OB_SUCC(ret) && i < cnt; i++) {
+      // stacks are shared by all tenants the worker serves
+      if (OB_FAIL(co_tasks_[i].co_.init(OB_SERVER_TENANT_ID, stack_size))) {
+        LOG_WARN("init worker coroutine fail", K(ret), K(i), K(stack_size));
+      }
+    }
+    if (OB_FAIL(ret)) {
+      destroy_co_tasks();
+    } else {
+      // latches are counted only on threads running coroutines
+      get_count_hold_latch() = true;
+      LOG_INFO("worker coroutines inited", K(cnt), K(stack_size));
+    }
+  }
+  return ret;
+}
+
+void ObThWorker::destroy_co_tasks()
+{
+  if (OB_NOT_NULL(co_tasks_)) {
+    if (OB_UNLIKELY(suspended_co_cnt_ > 0)) {
+      LOG_ERROR("destroy worker coroutines with suspended requests", K_(suspended_co_cnt));
+    }
+    for (int64_t i = 0; i < co_task_cnt_; i++) {
+      co_tasks_[i].~CoTask();
+    }
+    ob_free(co_tasks_);
+    co_tasks_ = nullptr;
+  }
+  co_task_cnt_ = 0;
+  cur_co_task_ = nullptr;
+  suspended_co_cnt_ = 0;
+  get_count_hold_latch() = false;
+  get_hold_latch_cnt() = 0;
+}
+
+// Requests are processed on coroutines, when one of them waits for
+// something it gives the worker out and is resumed by the loop below
+// to poll its wait condition. The loop doesn't return until there's
+// no suspended coroutine so that the tenant relating scopes entered
+// by the caller outlive all of them.
+void ObThWorker::co_worker(int64_t &req_recv_timestamp)
+{
+  int ret = OB_SUCCESS;
+  do {
+    resume_co_tasks();
+    int64_t wait_start_time = ObTimeUtility::current_time();
+    int64_t wait_end_time = wait_start_time;
+    CoTask *task = get_free_co_task();
+    if (OB_ISNULL(task)) {
+      // all coroutines are waiting
+      ob_usleep<ObWaitEventIds::OMT_IDLE>(CO_POLL_WAIT_TIME);
+      wait_end_time = ObTimeUtility::current_time();
+    } else {
+      rpc::ObRequest *req = NULL;
+      const int64_t timeout = suspended_co_cnt_ > 0 ? CO_POLL_WAIT_TIME : REQUEST_WAIT_TIME;
+      {
+        ObWaitEventGuard wait_guard(ObWaitEventIds::OMT_IDLE, 0, wait_start_time, 0, 0);
+        ret = tenant_->get_new_request(*this, timeout, req);
+        wait_end_time = ObTimeUtility::current_time();
+      }
+      if (OB_SUCC(ret)) {
+        if (OB_LIKELY(nullptr != req)) {
+          req_recv_timestamp = req->get_receive_timestamp(); // Update backtrace printing parameters
+          EVENT_ADD(REQUEST_QUEUE_TIME, wait_end_time - req->get_enqueue_timestamp());
+          req->set_push_pop_diff(wait_end_time);
+          if (large_query_ || lq_token_) {
+            // large query quota is accounted by worker, keep it on thread
+            process_request_in_place(*req, wait_end_time);
+          } else if (OB_FAIL(start_co_task(*task, *req, wait_end_time))) {
+            LOG_WARN("start coroutine fail, process request on thread", K(ret));
+            ret = OB_SUCCESS;
+            process_request_in_place(*req, wait_end_time);
+          }
+        } else {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_ERROR("got NULL request from tenant", K(tenant_), K(ret), K(req));
+        }
+      } else if (OB_ENTRY_NOT_EXIST == ret) {
+        // timeout while waiting for request from tenant request queue
+        ret = OB_SUCCESS;
+      }
+    }
+    tenant_->add_idle_time(wait_end_time - wait_start_time);
+  } while (suspended_co_cnt_ > 0);
+}
+
+ObThWorker::CoTask *ObThWorker::get_free_co_task()
+{
+  CoTask *task = nullptr;
+  for (int64_t i = 0; OB_ISNULL(task) && i < co_task_cnt_; i++) {
+    if (!co_tasks_[i].co_.is_runnable()) {
+      task = &co_tasks_[i];
+    }
+  }
+  return task;
+}
+
+int ObThWorker::start_co_task(CoTask &task, rpc::ObRequest &req, const int64_t start_time)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(task.co_.start(co_task_entry, &task))) {
+    LOG_WARN("start coroutine fail", K(ret), K(task.co_));
+  } else {
+    task.req_ = &req;
+    // level of the request is set on worker when it's fetched
+    task.req_ctx_ = lib::Worker::ReqCtx();
+    task.req_ctx_.curr_request_level_ = get_curr_request_level();
+    task.req_ctx_.rpc_stat_srv_ = &(tenant_->rpc_stat_info_->rpc_stat_srv_);
+    task.req_ctx_.compat_mode_ = tenant_->get_compat_mode();
+    task.flow_ = co_root_flow_;
+    task.trace_id_.reset();
+    task.default_wb_.reset();
+    task.wb_ = &task.default_wb_;
+    task.ash_stat_ = nullptr;
+    task.di_tenant_id_ = tenant_->id();
+    task.di_session_id_ = 0;
+    task.hold_latch_cnt_ = 0;
+    task.lock_wait_node_ = nullptr;
+    task.lock_wait_hold_key_ = 0;
+    task.need_wait_lock_ = false;
+    task.large_query_ = false;
+    task.query_start_time_ = start_time;
+    task.query_enqueue_time_ = req.get_enqueue_timestamp();
+    task.last_check_time_ = start_time;
+    task.can_retry_ = true;
+    task.need_retry_ = false;
+    run_co_task(task);
+  }
+  return ret;
+}
+
+void ObThWorker::run_co_task(CoTask &task)
+{
+  int ret = OB_SUCCESS;
+  const int64_t start_time = ObTimeUtility::current_time();
+  if (task.co_.is_suspended()) {
+    suspended_co_cnt_--;
+  }
+  cur_co_task_ = &task;
+  swap_co_task_ctx(task);
+  if (OB_FAIL(task.co_.resume())) {
+    LOG_ERROR("resume worker coroutine fail", K(ret), K(task.co_));
+  }
+  swap_co_task_ctx(task);
+  cur_co_task_ = nullptr;
+  const int64_t end_time = ObTimeUtility::current_time();
+  tenant_->add_worker_time(end_time - start_time);
+  if (task.co_.is_suspended()) {
+    suspended_co_cnt_++;
+  } else if (OB_NOT_NULL(task.req_)) {
+    // the coroutine failed to process the request
+    rpc::ObRequest *req = task.req_;
+    task.req_ = nullptr;
+    process_request_in_place(*req, end_time);
+  }
+}
+
+void ObThWorker::resume_co_tasks()
+{
+  for (int64_t i = 0; suspended_co_cnt_ > 0 && i < co_task_cnt_; i++) {
+    if (co_tasks_[i].co_.is_suspended()) {
+      run_co_task(co_tasks_[i]);
+    }
+  }
+}
+
+// Exchange request related states between the thread and the coroutine,
+// called in pairs around each resume.
+void ObThWorker::swap_co_task_ctx(CoTask &task)
+{
+  swap_req_ctx(task.req_ctx_);
+  lib::Flow *flow = lib::Flow::get_current();
+  lib::Flow::set_current(task.flow_);
+  task.flow_ = flow;
+  const ObCurTraceId::TraceId trace_id = *ObCurTraceId::get_trace_id();
+  ObCurTraceId::set(task.trace_id_);
+  task.trace_id_ = trace_id;
+  std::swap(ob_get_tsi_warning_buffer(), task.wb_);
+  ActiveSessionStat *ash_stat = &ObActiveSessionGuard::get_stat();
+  if (OB_ISNULL(task.ash_stat_)) {
+    ObActiveSessionGuard::setup_default_ash();
+  } else {
+    ObActiveSessionGuard::setup_ash(*task.ash_stat_);
+  }
+  task.ash_stat_ = ash_stat;
+  swap_di_session(task.di_tenant_id_, task.di_session_id_);
+  std::swap(get_hold_latch_cnt(), task.hold_latch_cnt_);
+  memtable::ObLockWaitMgr::swap_thread_ctx(task.lock_wait_node_, task.lock_wait_hold_key_);
+  std::swap(memtable::TLOCAL_NEED_WAIT_IN_LOCK_WAIT_MGR, task.need_wait_lock_);
+  std::swap(large_query_, task.large_query_);
+  std::swap(query_start_time_, task.query_start_time_);
+  std::swap(query_enqueue_time_, task.query_enqueue_time_);
+  std::swap(last_check_time_, task.last_check_time_);
+  std::swap(can_retry_, task.can_retry_);
+  std::swap(need_retry_, task.need_retry_);
+}
+
+// Switch the session and tenant which wait events and stats are
+// accounted to, the same as ObSessionStatEstGuard does.
+void ObThWorker::swap_di_session(uint64_t &tenant_id, uint64_t &session_id)
+{
+  ObSessionDIBuffer *buffer = nullptr;
+  if (lib::is_diagnose_info_enabled()
+      && OB_NOT_NULL(buffer = ObDITls<ObSessionDIBuffer>::get_instance())) {
+    const uint64_t curr_tenant_id = buffer->get_tenant_id();
+    const uint64_t curr_session_id = OB_ISNULL(buffer->get_curr_session())
+        ? 0 : buffer->get_curr_session()->session_id_;
+    if (0 < tenant_id) {
+      buffer->switch_tenant(tenant_id);
+    }
+    if (0 != session_id) {
+      buffer->switch_session(session_id);
+    } else {
+      buffer->reset_session();
+    }
+    tenant_id = curr_tenant_id;
+    session_id = curr_session_id;
+  }
+}
+
+void ObThWorker::co_task_entry(void *arg)
+{
+  int ret = OB_SUCCESS;
+  CoTask &task = *static_cast<CoTask*>(arg);
+  ObThWorker &worker = *task.worker_;
+  lib::ContextParam param;
+  init_req_context_param(param, worker.tenant_->id());
+  CREATE_WITH_TEMP_CONTEXT(param) {
+    rpc::ObRequest *req = task.req_;
+    task.req_ = nullptr;
+    worker.allocator_ = &CURRENT_CONTEXT->get_arena_allocator();
+    worker.process_request(*req);
+    worker.allocator_ = nullptr;
+  }
+  if (OB_FAIL(ret)) {
+    LOG_WARN("create context for request fail", K(ret));
+  }
+}
+
+bool ObThWorker::can_coro_yield() const
+{
+  // Not safe to yield with latches held or wait disabled, or in another
+  // tenant's scope, large query is accounted by worker so it's kept
+  // on the thread too. Session stats of multi-thread plan are kept in
+  // the thread and can't be switched.
+  ObSessionDIBuffer *di_buffer = nullptr;
+  return OB_NOT_NULL(cur_co_task_)
+      && lib::ObCoRoutine::current() == &cur_co_task_->co_
+      && 0 == get_hold_latch_cnt()
+      && !get_disable_wait_flag()
+      && !large_query_
+      && !lq_token_
+      && static_cast<share::ObTenantBase*>(tenant_) == MTL_CTX()
+      && !(lib::is_diagnose_info_enabled()
+           && OB_NOT_NULL(di_buffer = ObDITls<ObSessionDIBuffer>::get_instance())
+           && di_buffer->is_multi_thread_plan());
+}
+
+void ObThWorker::coro_yield()
+{
+  if (can_coro_yield()) {
+    cur_co_task_->co_.yield();
+  }
+}
@@ -19,6 +19,9 @@
 #include "rpc/ob_request.h"
 #include "lib/thread/threads.h"
 #include "lib/thread/ob_thread_name.h"
+#include "lib/coro/ob_co_routine.h"
+#include "lib/profile/ob_trace_id.h"
+#include "lib/oblog/ob_warning_buffer.h"
 #include "observer/omt/ob_worker_processor.h"
 #include "share/rc/ob_tenant_base.h"
 
@@ -26,6 +29,8 @@ namespace oceanbase
 {
 
 namespace rpc { namespace frame { class ObReqTranslator; } }
+namespace rpc { class ObLockWaitNode; }
+namespace common { struct ActiveSessionStat; }
 namespace omt
 {
 
@@ -35,6 +40,9 @@ class ObResourceGroup;
 
 static const int64_t WORKER_CHECK_PERIOD = 500L;
 static const int64_t REQUEST_WAIT_TIME = 10 * 1000L;
+// wait time for new request when some coroutines are suspended, they
+// poll their wait condition each time the worker resumes them.
+static const int64_t CO_POLL_WAIT_TIME = 100L;
 
 class ObThWorker
     : public lib::Worker, public lib::Threads
@@ -71,6 +79,10 @@ public:
   virtual int check_status() override;
   virtual int check_large_query_quota();
 
+  // coroutine relating
+  virtual bool can_coro_yield() const override;
+  virtual void coro_yield() override;
+
   // retry relating
   virtual bool can_retry() const;
   virtual void set_need_retry();
@@ -101,9 +113,58 @@ private:
   // ref: https://yuque.antfin-inc.com/xiaochu.yh/doc/sgl4x3#vhv1R
   virtual void disable_retry();
 
+  // A request running on coroutine, which has its own copy of the
+  // request related states of the worker and the thread.
+  struct CoTask
+  {
+    CoTask()
+      : worker_(nullptr), req_(nullptr), req_ctx_(), flow_(nullptr), trace_id_(),
+        default_wb_(), wb_(nullptr), ash_stat_(nullptr), di_tenant_id_(0), di_session_id_(0),
+        hold_latch_cnt_(0), lock_wait_node_(nullptr), lock_wait_hold_key_(0),
+        need_wait_lock_(false), large_query_(false), query_start_time_(0),
+        query_enqueue_time_(0), last_check_time_(0), can_retry_(true), need_retry_(false)
+    {}
+    lib::ObCoRoutine co_;
+    ObThWorker *worker_;
+    rpc::ObRequest *req_;
+    lib::Worker::ReqCtx req_ctx_;
+    lib::Flow *flow_;
+    common::ObCurTraceId::TraceId trace_id_;
+    // used until the request sets up the buffer of its session, the
+    // default buffer of the thread is shared by all coroutines.
+    common::ObWarningBuffer default_wb_;
+    common::ObWarningBuffer *wb_;
+    common::ActiveSessionStat *ash_stat_;
+    uint64_t di_tenant_id_;
+    uint64_t di_session_id_;
+    // latches held by the request, it may yield only if it holds none.
+    int64_t hold_latch_cnt_;
+    rpc::ObLockWaitNode *lock_wait_node_;
+    uint64_t lock_wait_hold_key_;
+    bool need_wait_lock_;
+    bool large_query_;
+    int64_t query_start_time_;
+    int64_t query_enqueue_time_;
+    int64_t last_check_time_;
+    bool can_retry_;
+    bool need_retry_;
+  };
+
   void set_th_worker_thread_name(uint64_t tenant_id);
   void wait_runnable();
   void process_request(rpc::ObRequest &req);
+  void process_request_in_place(rpc::ObRequest &req, const int64_t start_time);
+
+  int init_co_tasks();
+  void destroy_co_tasks();
+  void co_worker(int64_t &req_recv_timestamp);
+  CoTask *get_free_co_task();
+  int start_co_task(CoTask &task, rpc::ObRequest &req, const int64_t start_time);
+  void run_co_task(CoTask &task);
+  void resume_co_tasks();
+  void swap_co_task_ctx(CoTask &task);
+  static void swap_di_session(uint64_t &tenant_id, uint64_t &session_id);
+  static void co_task_entry(void *arg);
 
   void th_created();
   void th_destroy();
@@ -142,6 +203,17 @@ private:
   int64_t active_inactive_ts_;
   bool lq_token_;
   bool has_add_to_cgroup_;
+  // numa node this thread is bound to, -1 if not bound
+  int64_t numa_node_;
+
+  // Requests run on coroutines when _ob_worker_coroutine_cnt > 0, only
+  // for normal workers, i.e. level 0 and not belonging to any group.
+  lib::Flow *co_root_flow_;
+  CoTask *co_tasks_;
+  int64_t co_task_cnt_;
+  bool co_task_inited_;
+  CoTask *cur_co_task_;
+  int64_t suspended_co_cnt_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObThWorker);
@@ -142,7 +142,7 @@ int ObAllVirtualDumpTenantInfo::inner_get_next_row(common::ObNewRow *&row)
           break;
         case OB_APP_MIN_COLUMN_ID + 24:
           //req_queue_total_size
-          cells[i].set_int(t.req_queue_.size());
+          cells[i].set_int(t.req_queue_.size() + t.local_req_queue_.size());
           break;
         case OB_APP_MIN_COLUMN_ID + 25:
           //queue_0
@@ -161,8 +161,8 @@ int ObAllVirtualDumpTenantInfo::inner_get_next_row(common::ObNewRow *&row)
           cells[i].set_int(t.req_queue_.queue_size(3));
           break;
         case OB_APP_MIN_COLUMN_ID + 29:
-          //queue_4
-          cells[i].set_int(t.req_queue_.queue_size(4));
+          //queue_4, normal requests in local queue included
+          cells[i].set_int(t.req_queue_.queue_size(4) + t.local_req_queue_.size());
           break;
         case OB_APP_MIN_COLUMN_ID + 30:
           //queue_5
@@ -219,6 +219,8 @@ int ObKVGlobalCache::init(
                                  configs_,
                                  *mem_limit_getter))) {
     COMMON_LOG(WARN, "Fail to init insts, ", K(ret));
+  } else if (OB_FAIL(admission_sketch_.init(ADMISSION_SKETCH_COUNTER_NUM))) {
+    COMMON_LOG(WARN, "Fail to init admission sketch, ", K(ret));
   } else if (OB_FAIL(TG_START(lib::TGDefIDs::KVCacheWash))) {
     COMMON_LOG(WARN, "Fail to init wash timer, ", K(ret));
   } else if (OB_FAIL(TG_START(lib::TGDefIDs::KVCacheRep))) {
@@ -266,6 +268,7 @@ void ObKVGlobalCache::destroy()
     map_.destroy();
     store_.destroy();
     insts_.destroy();
+    admission_sketch_.destroy();
     for (int64_t i = 0; i < MAX_CACHE_NUM; ++i) {
       configs_[i].reset();
     }
@@ -329,6 +332,7 @@ int ObKVGlobalCache::put(
   pvalue = NULL;
   mb_handle = NULL;
   MBWrapper *mb_wrapper = NULL;
+  enum ObKVCachePolicy policy = LRU;
   if (OB_UNLIKELY(!inited_)) {
     ret = OB_NOT_INIT;
     COMMON_LOG(WARN, "The ObKVGlobalCache has not been inited, ", K(ret));
@@ -342,9 +346,13 @@ int ObKVGlobalCache::put(
     COMMON_LOG(WARN, "The inst is NULL, ", K(ret));
   } else if (!overwrite && (OB_SUCC(map_.get(cache_id, key, pvalue, mb_handle)))) {
     ret = OB_ENTRY_EXIST;
-  } else if (OB_FAIL(store.store(*inst_handle.get_inst(), key, value, kvpair, mb_wrapper))) {
+  } else if (FALSE_IT(policy = get_admission_policy(cache_id, key))) {
+  } else if (OB_FAIL(store.store(*inst_handle.get_inst(), key, value, kvpair, mb_wrapper, policy))) {
     COMMON_LOG(WARN, "Fail to store kvpair to store, ", K(ret));
   } else {
+    if (LFU == policy) {
+      inst_handle.get_inst()->status_.protected_put_cnt_.inc();
+    }
     mb_handle = mb_wrapper->get_mb_handle();
     pvalue = kvpair->value_;
     if (OB_FAIL(map_.put(*inst_handle.get_inst(), key, kvpair, mb_handle, overwrite))) {
@@ -372,9 +380,10 @@ int ObKVGlobalCache::alloc(
     const int64_t value_size,
     ObKVCachePair *&kvpair,
     ObKVMemBlockHandle *&mb_handle,
-    ObKVCacheInstHandle &inst_handle)
+    ObKVCacheInstHandle &inst_handle,
+    const enum ObKVCachePolicy policy)
 {
-  return alloc(store_, cache_id, tenant_id, key_size, value_size, kvpair, mb_handle, inst_handle);
+  return alloc(store_, cache_id, tenant_id, key_size, value_size, kvpair, mb_handle, inst_handle, policy);
 }
 
 int ObKVGlobalCache::alloc(
@@ -406,7 +415,8 @@ int ObKVGlobalCache::alloc(
     const int64_t value_size,
     ObKVCachePair *&kvpair,
     ObKVMemBlockHandle *&mb_handle,
-    ObKVCacheInstHandle &inst_handle)
+    ObKVCacheInstHandle &inst_handle,
+    const enum ObKVCachePolicy policy)
 {
   int ret = OB_SUCCESS;
   ObKVCacheInstKey inst_key(cache_id, tenant_id);
@@ -423,9 +433,12 @@ int ObKVGlobalCache::alloc(
     ret = OB_ERR_UNEXPECTED;
     COMMON_LOG(WARN, "The inst is NULL, ", K(ret));
   } else if (OB_FAIL(store.alloc_kvpair(*inst_handle.get_inst(),
-          key_size, value_size, kvpair, mb_wrapper))) {
+          key_size, value_size, kvpair, mb_wrapper, policy))) {
     COMMON_LOG(WARN, "Fail to store kvpair, ", K(ret));
   } else {
+    if (LFU == policy) {
+      inst_handle.get_inst()->status_.protected_put_cnt_.inc();
+    }
     mb_handle = mb_wrapper->get_mb_handle();
   }
   return ret;
@@ -446,12 +459,22 @@ int ObKVGlobalCache::get(
     if (OB_FAIL(map_.get(cache_id, key, pvalue, mb_handle))) {
       if (OB_ENTRY_NOT_EXIST != ret) {
         COMMON_LOG(WARN, "fail to get value from map, ", K(ret));
+      } else {
+        // a key missed repeatedly is likely evicted before reused, admit it as protected next time
+        admission_sketch_.increment(admission_hash(cache_id, key));
       }
     }
   }
   return ret;
 }
 
+void ObKVGlobalCache::prefetch(const uint64_t *hash_codes, const int64_t count)
+{
+  if (OB_LIKELY(inited_)) {
+    map_.prefetch(hash_codes, count);
+  }
+}
+
 int ObKVGlobalCache::erase(const int64_t cache_id, const ObIKVCacheKey &key)
 {
   int ret = OB_SUCCESS;
@@ -803,6 +826,76 @@ int ObKVGlobalCache::get_hold_size(const uint64_t tenant_id, const char *cache_n
   return ret;
 }
 
+int ObKVGlobalCache::set_priority_class(const uint64_t tenant_id, const char *cache_name,
+                                        const int64_t priority_class)
+{
+  int ret = OB_SUCCESS;
+  if (!inited_) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "not init", K(ret));
+  } else if (OB_INVALID_ID == tenant_id || NULL == cache_name
+             || !is_valid_cache_priority_class(priority_class)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid arguments", K(ret), K(tenant_id), KP(cache_name), K(priority_class));
+  } else if (OB_FAIL(insts_.set_priority_class(tenant_id, cache_name, priority_class))) {
+    COMMON_LOG(WARN, "set_priority_class failed", K(ret), K(tenant_id), KP(cache_name), K(priority_class));
+  }
+  return ret;
+}
+
+int ObKVGlobalCache::get_priority_class(const uint64_t tenant_id, const char *cache_name,
+                                        int64_t &priority_class)
+{
+  int ret = OB_SUCCESS;
+  if (!inited_) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "not init", K(ret));
+  } else if (OB_INVALID_ID == tenant_id || NULL == cache_name) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid arguments", K(ret), K(tenant_id), KP(cache_name));
+  } else if (OB_FAIL(insts_.get_priority_class(tenant_id, cache_name, priority_class))) {
+    if (OB_ENTRY_NOT_EXIST != ret) {
+      COMMON_LOG(WARN, "get_priority_class failed", K(ret), K(tenant_id), KP(cache_name));
+    }
+  }
+  return ret;
+}
+
+int ObKVGlobalCache::set_tenant_cache_qos(const uint64_t tenant_id, const char *cache_name,
+                                          const int64_t priority_class, const int64_t reserved_size)
+{
+  int ret = OB_SUCCESS;
+  int64_t cache_id = -1;
+  ObKVCacheInstHandle inst_handle;
+  if (!inited_) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "not init", K(ret));
+  } else if (OB_INVALID_ID == tenant_id || NULL == cache_name
+             || !is_valid_cache_priority_class(priority_class) || reserved_size < 0) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid arguments", K(ret), K(tenant_id), KP(cache_name), K(priority_class), K(reserved_size));
+  } else if (OB_FAIL(get_cache_id(cache_name, cache_id))) {
+    COMMON_LOG(WARN, "get_cache_id failed", K(ret), K(cache_name));
+  } else if (OB_FAIL(insts_.get_cache_inst(ObKVCacheInstKey(cache_id, tenant_id), inst_handle))) {
+    COMMON_LOG(WARN, "Fail to get cache inst, ", K(ret), K(tenant_id), K(cache_id));
+  } else if (OB_ISNULL(inst_handle.get_inst())) {
+    ret = OB_ERR_UNEXPECTED;
+    COMMON_LOG(WARN, "The inst is NULL, ", K(ret));
+  } else {
+    // refreshed with every tenant config change, only apply the qos config really changed
+    ObKVCacheStatus &status = inst_handle.get_inst()->status_;
+    const int64_t old_priority_class = status.get_priority_class();
+    const int64_t old_reserved_size = status.get_hold_size();
+    if (old_priority_class != priority_class || old_reserved_size != reserved_size) {
+      status.set_priority_class(priority_class);
+      status.set_hold_size(reserved_size);
+      COMMON_LOG(INFO, "set tenant cache qos", K(tenant_id), K(cache_name), K(old_priority_class),
+                 K(priority_class), K(old_reserved_size), K(reserved_size));
+    }
+  }
+  return ret;
+}
+
 int ObKVGlobalCache::get_avg_cache_item_size(const uint64_t tenant_id, const char *cache_name,
                                              int64_t &avg_cache_item_size)
 {
@@ -20,6 +20,7 @@
 #include "lib/utility/ob_macro_utils.h"
 #include "lib/allocator/ob_malloc.h"
 #include "lib/list/ob_list.h"
+#include "lib/hash_func/murmur_hash.h"
 #include "share/cache/ob_kvcache_struct.h"
 #include "share/cache/ob_kvcache_inst_map.h"
 #include "share/cache/ob_kvcache_map.h"
@@ -50,6 +51,13 @@ public:
   virtual int erase(const Key &key) = 0;
   virtual int alloc(const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
       ObKVCachePair *&kvpair, ObKVCacheHandle &handle, ObKVCacheInstHandle &inst_handle) = 0;
+  // alloc for a known key, so that the kvpair goes to the segment its admission asks for
+  virtual int alloc(const Key &key, const uint64_t tenant_id, const int64_t key_size, const int64_t value_size,
+      ObKVCachePair *&kvpair, ObKVCacheHandle &handle, ObKVCacheInstHandle &inst_handle)
+  {
+    UNUSED(key);
+    return alloc(tenant_id, key_size, value_size, kvpair, handle, inst_handle);
+  }
   virtual int put_kvpair(ObKVCacheInstHandle &inst_handle, ObKVCachePair *kvpair, ObKVCacheHandle &handle, bool overwrite = true);
 };
 
@@ -70,6 +78,8 @@ public:
     ObKVCacheHandle &handle,
     bool overwrite = true);
   virtual int get(const Key &key, const Value *&pvalue, ObKVCacheHandle &handle);
+  // prefetch the map bucket slots of a batch of key hashes and the head nodes they point to, ahead of gets
+  void prefetch(const uint64_t *hash_codes, const int64_t count) const;
   int get_iterator(ObKVCacheIterator &iter);
   virtual int erase(const Key &key);
   virtual int alloc(
@@ -79,6 +89,14 @@ public:
       ObKVCachePair *&kvpair,
       ObKVCacheHandle &handle,
       ObKVCacheInstHandle &inst_handle) override;
+  virtual int alloc(
+      const Key &key,
+      const uint64_t tenant_id,
+      const int64_t key_size,
+      const int64_t value_size,
+      ObKVCachePair *&kvpair,
+      ObKVCacheHandle &handle,
+      ObKVCacheInstHandle &inst_handle) override;
   int64_t size(const uint64_t tenant_id = OB_SYS_TENANT_ID) const;
   int64_t count(const uint64_t tenant_id = OB_SYS_TENANT_ID) const;
   int64_t get_hit_cnt(const uint64_t tenant_id = OB_SYS_TENANT_ID) const;
@@ -150,6 +168,12 @@ public:
 
   int set_hold_size(const uint64_t tenant_id, const char *cache_name, const int64_t hold_size);
   int get_hold_size(const uint64_t tenant_id, const char *cache_name, int64_t &hold_size);
+  int set_priority_class(const uint64_t tenant_id, const char *cache_name, const int64_t priority_class);
+  int get_priority_class(const uint64_t tenant_id, const char *cache_name, int64_t &priority_class);
+  // create the cache instance of the tenant if needed, then set its priority class and the
+  // memory reserved for it against wash
+  int set_tenant_cache_qos(const uint64_t tenant_id, const char *cache_name,
+                           const int64_t priority_class, const int64_t reserved_size);
   int get_avg_cache_item_size(const uint64_t tenant_id, const char *cache_name,
                               int64_t &avg_cache_item_size);
 
@@ -203,7 +227,8 @@ private:
       const int64_t value_size,
       ObKVCachePair *&kvpair,
       ObKVMemBlockHandle *&mb_handle,
-      ObKVCacheInstHandle &inst_handle);
+      ObKVCacheInstHandle &inst_handle,
+      const enum ObKVCachePolicy policy = LRU);
   int alloc(
       ObWorkingSet *working_set,
       const uint64_t tenant_id,
@@ -221,17 +246,30 @@ private:
       const int64_t value_size,
       ObKVCachePair *&kvpair,
       ObKVMemBlockHandle *&mb_handle,
-      ObKVCacheInstHandle &inst_handle);
+      ObKVCacheInstHandle &inst_handle,
+      const enum ObKVCachePolicy policy = LRU);
   int get(
     const int64_t cache_id,
     const ObIKVCacheKey &key,
     const ObIKVCacheValue *&pvalue,
     ObKVMemBlockHandle *&mb_handle);
   int erase(const int64_t cache_id, const ObIKVCacheKey &key);
+  void prefetch(const uint64_t *hash_codes, const int64_t count);
   void revert(ObKVMemBlockHandle *mb_handle);
   void wash();
   void replace_map();
   int get_cache_id(const char *cache_name, int64_t &cache_id);
+  inline uint64_t admission_hash(const int64_t cache_id, const ObIKVCacheKey &key) const
+  {
+    uint64_t hash_value = 0;
+    (void) key.hash(hash_value);
+    return common::murmurhash(&cache_id, sizeof(cache_id), hash_value);
+  }
+  inline enum ObKVCachePolicy get_admission_policy(const int64_t cache_id, const ObIKVCacheKey &key) const
+  {
+    return admission_sketch_.estimate(admission_hash(cache_id, key)) >= ADMIT_PROTECTED_FREQUENCY
+        ? LFU : LRU;
+  }
 private:
   static const int64_t DEFAULT_BUCKET_NUM = 10000000L;
   static const int64_t DEFAULT_MAX_CACHE_SIZE = 1024L * 1024L * 1024L * 1024L;  //1T
@@ -247,6 +285,9 @@ private:
   static const int64_t bucket_num_array_[MAX_BUCKET_NUM_LEVEL];
   static const int64_t PRINT_INTERVAL = 30 * 1000L * 1000L;
   static const int64_t MAP_WASH_CLEAN_INTERNAL = 10;
+  // keys missed at least this many times in the sketch window are put into the LFU segment directly
+  static const int64_t ADMIT_PROTECTED_FREQUENCY = 2;
+  static const int64_t ADMISSION_SKETCH_COUNTER_NUM = 1L << 21;
 private:
   class KVStoreWashTask: public ObTimerTask
   {
@@ -291,6 +332,8 @@ private:
   ObKVCacheInstMap insts_;
   // working set manager
   ObWorkingSetMgr ws_mgr_;
+  // admission filter, records misses of all caches
+  ObKVCacheFrequencySketch admission_sketch_;
   // cache configs
   ObKVCacheConfig configs_[MAX_CACHE_NUM];
   int64_t cache_num_;
@@ -615,6 +658,14 @@ int ObKVCache<Key, Value>::get(const Key &key, const Value *&pvalue, ObKVCacheHa
   return ret;
 }
 
+template <class Key, class Value>
+void ObKVCache<Key, Value>::prefetch(const uint64_t *hash_codes, const int64_t count) const
+{
+  if (OB_LIKELY(inited_)) {
+    ObKVGlobalCache::get_instance().prefetch(hash_codes, count);
+  }
+}
+
 template <class Key, class Value>
 int ObKVCache<Key, Value>::erase(const Key &key)
 {
@@ -655,6 +706,34 @@ int ObKVCache<Key, Value>::alloc(const uint64_t tenant_id, const int64_t key_siz
   return ret;
 }
 
+template <class Key, class Value>
+int ObKVCache<Key, Value>::alloc(const Key &key, const uint64_t tenant_id, const int64_t key_size,
+    const int64_t value_size, ObKVCachePair *&kvpair, ObKVCacheHandle &handle, ObKVCacheInstHandle &inst_handle)
+{
+  int ret = OB_SUCCESS;
+  handle.reset();
+  if (OB_UNLIKELY(!inited_)) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "The ObKVCache has not been inited, ", K(ret));
+  } else if (OB_FAIL(ObKVGlobalCache::get_instance().alloc(
+          cache_id_,
+          tenant_id,
+          key_size,
+          value_size,
+          kvpair,
+          handle.mb_handle_,
+          inst_handle,
+          ObKVGlobalCache::get_instance().get_admission_policy(cache_id_, key)))) {
+    COMMON_LOG(WARN, "failed to alloc", K(ret));
+  } else {
+#ifdef ENABLE_DEBUG_LOG
+    ObKVCacheHandleRefChecker::get_instance().handle_ref_inc(handle);
+#endif
+  }
+
+  return ret;
+}
+
 
 template <class Key, class Value>
 int64_t ObKVCache<Key, Value>::store_size(const uint64_t tenant_id) const
@@ -398,7 +398,7 @@ int ObKVCacheInstMap::refresh_score()
       }
       inst->status_.last_hit_cnt_ = total_hit_cnt;
       inst->status_.base_mb_score_ = inst->status_.base_mb_score_ * CACHE_SCORE_DECAY_FACTOR
-          + avg_hit * (double) (inst->status_.config_->priority_);
+          + avg_hit * (double) (inst->status_.config_->priority_) * inst->status_.get_priority_weight();
     }
   }
   return ret;
@@ -472,14 +472,20 @@ void ObKVCacheInstMap::print_tenant_cache_info(const uint64_t tenant_id)
           for (KVCacheInstMap::iterator iter = inst_map_.begin(); iter != inst_map_.end(); ++iter) {
             if (iter->second->tenant_id_ == tenant_id) {
               ret = databuff_printf(buf, BUFLEN, ctx_pos,
-              "[CACHE] tenant_id=%8ld | cache_name=%30s | cache_size=%12ld | cache_store_size=%12ld | cache_map_size=%12ld | kv_cnt=%8ld | hold_size=%12ld\n",
+              "[CACHE] tenant_id=%8ld | cache_name=%30s | cache_size=%12ld | cache_store_size=%12ld | cache_map_size=%12ld | kv_cnt=%8ld | hold_size=%12ld"
+              " | priority_class=%ld | lru_mb_cnt=%8ld | lfu_mb_cnt=%8ld | put_cnt=%12ld | protected_put_cnt=%12ld\n",
               iter->second->tenant_id_,
               iter->second->status_.config_->cache_name_,
               iter->second->status_.store_size_ + iter->second->node_allocator_.allocated(),
               iter->second->status_.store_size_,
               iter->second->node_allocator_.allocated(),
               iter->second->status_.kv_cnt_,
-              iter->second->status_.hold_size_);
+              iter->second->status_.hold_size_,
+              iter->second->status_.get_priority_class(),
+              iter->second->status_.lru_mb_cnt_,
+              iter->second->status_.lfu_mb_cnt_,
+              iter->second->status_.total_put_cnt_.value(),
+              iter->second->status_.protected_put_cnt_.value());
             }
           }
         }
@@ -608,6 +614,70 @@ int ObKVCacheInstMap::get_hold_size(const uint64_t tenant_id, const char *cache_
   return ret;
 }
 
+int ObKVCacheInstMap::set_priority_class(const uint64_t tenant_id, const char *cache_name,
+                                         const int64_t priority_class)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "not init", K(ret));
+  } else if (OB_INVALID_ID == tenant_id || NULL == cache_name
+             || !is_valid_cache_priority_class(priority_class)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid arguments", K(ret), K(tenant_id), KP(cache_name), K(priority_class));
+  } else {
+    DRWLock::RDLockGuard rd_guard(lock_);
+    bool find = false;
+    for (KVCacheInstMap::iterator iter = inst_map_.begin();
+         !find && OB_SUCC(ret) && iter != inst_map_.end(); ++iter) {
+      if (iter->first.tenant_id_ == tenant_id) {
+        const int64_t cache_id = iter->second->cache_id_;
+        if (0 == STRNCMP(configs_[cache_id].cache_name_, cache_name, MAX_CACHE_NAME_LENGTH)) {
+          iter->second->status_.set_priority_class(priority_class);
+          find = true;
+        }
+      }
+    }
+
+    if (!find) {
+      ret = OB_ENTRY_NOT_EXIST;
+      COMMON_LOG(WARN, "cache not exist", K(ret), K(tenant_id), K(cache_name));
+    }
+  }
+  return ret;
+}
+
+int ObKVCacheInstMap::get_priority_class(const uint64_t tenant_id, const char *cache_name,
+                                         int64_t &priority_class)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    COMMON_LOG(WARN, "not init", K(ret));
+  } else if (OB_INVALID_ID == tenant_id || NULL == cache_name) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "invalid arguments", K(ret), K(tenant_id), KP(cache_name));
+  } else {
+    DRWLock::RDLockGuard rd_guard(lock_);
+    bool find = false;
+    for (KVCacheInstMap::iterator iter = inst_map_.begin();
+         !find && OB_SUCC(ret) && iter != inst_map_.end(); ++iter) {
+      if (iter->first.tenant_id_ == tenant_id) {
+        const int64_t cache_id = iter->second->cache_id_;
+        if (0 == STRNCMP(configs_[cache_id].cache_name_, cache_name, MAX_CACHE_NAME_LENGTH)) {
+          priority_class = iter->second->status_.get_priority_class();
+          find = true;
+        }
+      }
+    }
+
+    if (!find) {
+      ret = OB_ENTRY_NOT_EXIST;
+    }
+  }
+  return ret;
+}
+
 int ObKVCacheInstMap::get_mb_list(const uint64_t tenant_id, ObTenantMBListHandle &list_handle, const bool create_list)
 {
   int ret = OB_SUCCESS;
@@ -153,6 +153,8 @@ public:
 
   int set_hold_size(const uint64_t tenant_id, const char *cache_name, const int64_t hold_size);
   int get_hold_size(const uint64_t tenant_id, const char *cache_name, int64_t &hold_size);
+  int set_priority_class(const uint64_t tenant_id, const char *cache_name, const int64_t priority_class);
+  int get_priority_class(const uint64_t tenant_id, const char *cache_name, int64_t &priority_class);
 
   int get_mb_list(const uint64_t tenant_id, ObTenantMBListHandle &list_handle, const bool create_list = true);
   int dec_mb_list_ref(ObTenantMBList *list);
@@ -238,6 +238,23 @@ int ObKVCacheMap::put(
   return ret;
 }
 
+void ObKVCacheMap::prefetch(const uint64_t *hash_codes, const int64_t count)
+{
+  if (OB_LIKELY(is_inited_) && OB_NOT_NULL(hash_codes)) {
+    // first pass touches the bucket slots, second pass the head nodes they point to,
+    // so the misses of all the keys are in flight together
+    for (int64_t i = 0; i < count; ++i) {
+      __builtin_prefetch(&get_bucket_node(hash_codes[i] % bucket_num_));
+    }
+    for (int64_t i = 0; i < count; ++i) {
+      Node *node = ATOMIC_LOAD(&get_bucket_node(hash_codes[i] % bucket_num_));
+      if (NULL != node) {
+        __builtin_prefetch(node);
+      }
+    }
+  }
+}
+
 int ObKVCacheMap::get(
     const int64_t cache_id,
     const ObIKVCacheKey &key,
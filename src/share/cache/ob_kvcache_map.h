@@ -53,6 +53,8 @@ public:
     const ObIKVCacheValue *&pvalue,
     ObKVMemBlockHandle *&out_handle);
   int erase(const int64_t cache_id, const ObIKVCacheKey &key);
+  // prefetch is only a hint, the node may be retired before it is read
+  void prefetch(const uint64_t *hash_codes, const int64_t count);
   void print_hazard_version_info();
 private:
   friend class ObKVCacheIterator;
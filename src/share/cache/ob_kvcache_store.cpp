@@ -240,7 +240,8 @@ void ObKVCacheStore::refresh_score()
         if (NULL != mb_handles_[i].inst_) {
           priority = mb_handles_[i].inst_->status_.config_->priority_;
           score = mb_handles_[i].score_;
-          score = score * CACHE_SCORE_DECAY_FACTOR + (double) (mb_handles_[i].recent_get_cnt_ * priority);
+          score = score * CACHE_SCORE_DECAY_FACTOR + (double) (mb_handles_[i].recent_get_cnt_ * priority)
+              * mb_handles_[i].inst_->status_.get_priority_weight();
           mb_handles_[i].score_ = score;
           ATOMIC_STORE(&mb_handles_[i].recent_get_cnt_, 0);
         }
@@ -573,7 +574,9 @@ int ObKVCacheStore::try_flush_washable_mb(
           if (FULL == ATOMIC_LOAD(&handle->status_) && 2 == get_handle_ref_cnt(handle)) {
             if (-1 == cache_id || cache_id == handle->inst_->cache_id_) {
               if (size_need_washed != block_size_ || size_need_washed == handle->mem_block_->get_align_size()) {
-                can_try_wash = true;
+                // sync wash keeps the reserved memory of every cache, only erasing cache flushes it
+                can_try_wash = INT64_MAX == size_need_washed || !handle->inst_->need_hold_cache()
+                    || ATOMIC_LOAD(&handle->inst_->status_.store_size_) > handle->inst_->status_.get_hold_size();
               }
             }
           }
@@ -854,6 +857,7 @@ bool ObKVCacheStore::compute_tenant_wash_size()
   TenantWashInfo *tenant_wash_info = NULL;
   WashMap::iterator wash_iter;
   int64_t global_cache_size = 0;
+  double weighted_global_cache_size = 0;
   int64_t sys_total_wash_size = lib::get_memory_used() - lib::get_memory_limit()
   + lib::ob_get_reserved_urgent_memory();
 
@@ -901,9 +905,18 @@ bool ObKVCacheStore::compute_tenant_wash_size()
       }
     } else {
       tenant_wash_info->cache_size_ += inst->status_.store_size_;
+      tenant_wash_info->priority_weight_ = MAX(tenant_wash_info->priority_weight_,
+                                               inst->status_.get_priority_weight());
       global_cache_size += inst->status_.store_size_;
     }
   }
+  for (wash_iter = tenant_wash_map_.begin(); OB_SUCC(ret) && wash_iter != tenant_wash_map_.end(); ++wash_iter) {
+    tenant_wash_info = wash_iter->second;
+    if (tenant_wash_info->priority_weight_ <= 0) {
+      tenant_wash_info->priority_weight_ = CACHE_PRIORITY_CLASS_WEIGHTS[KVCACHE_PRIORITY_NORMAL];
+    }
+    weighted_global_cache_size += static_cast<double>(tenant_wash_info->cache_size_) / tenant_wash_info->priority_weight_;
+  }
 
   //identify tenant_min_wash_size and tenant_max_wash_size
   for (wash_iter = tenant_wash_map_.begin(); OB_SUCC(ret) && wash_iter != tenant_wash_map_.end(); ++wash_iter) {
@@ -960,9 +973,13 @@ bool ObKVCacheStore::compute_tenant_wash_size()
         } else {
           tenant_wash_info->wash_size_ = 0;
         }
-        if (global_cache_size > 0) {
+        // the memory short across tenants is shared by cache size, scaled down for tenants of a
+        // higher priority class so that a neighbour flooding the cache pays most of it
+        if (weighted_global_cache_size > 0) {
           tenant_wash_info->wash_size_ += static_cast<int64_t>(static_cast<double>(sys_total_wash_size - tenant_max_wash_size)
-                * (static_cast<double>(tenant_wash_info->cache_size_) / static_cast<double>(global_cache_size)));
+                * (static_cast<double>(tenant_wash_info->cache_size_) / tenant_wash_info->priority_weight_
+                / weighted_global_cache_size));
+          tenant_wash_info->wash_size_ = MIN(tenant_wash_info->wash_size_, tenant_wash_info->cache_size_);
         }
       }
     }
@@ -1389,7 +1406,8 @@ ObKVCacheStore::TenantWashInfo::TenantWashInfo()
     upper_limit_(0),
     max_wash_size_(0),
     min_wash_size_(0),
-    wash_size_(0)
+    wash_size_(0),
+    priority_weight_(0)
 {
 }
 
@@ -1424,6 +1442,7 @@ void ObKVCacheStore::TenantWashInfo::reuse()
   max_wash_size_ = 0;
   min_wash_size_ = 0;
   wash_size_ = 0;
+  priority_weight_ = 0;
   wash_heap_.reset();
   for (int64_t i = 0 ; i < MAX_CACHE_NUM ; ++i) {
     cache_wash_heaps_[i].reset();
@@ -156,6 +156,8 @@ private:
     int64_t max_wash_size_;
     int64_t min_wash_size_;
     int64_t wash_size_;
+    // the highest priority weight among cache instances of the tenant
+    double priority_weight_;
     WashHeap wash_heap_;
     WashHeap cache_wash_heaps_[MAX_CACHE_NUM];
   };
@@ -11,6 +11,7 @@
  */
 
 #include "ob_kvcache_struct.h"
+#include "lib/allocator/ob_malloc.h"
 
 namespace oceanbase
 {
@@ -62,10 +63,12 @@ void ObKVCacheStatus::reset()
   lfu_mb_cnt_ = 0;
   total_put_cnt_.reset();
   total_hit_cnt_.reset();
+  protected_put_cnt_.reset();
   total_miss_cnt_ = 0;
   last_hit_cnt_ = 0;
   base_mb_score_ = 0;
   hold_size_ = 0;
+  priority_class_ = KVCACHE_PRIORITY_NORMAL;
   total_miss_cnt_ = 0;
 }
 
@@ -326,9 +329,117 @@ int ObKVMemBlockHandle::alloc(const int64_t key_size, const int64_t value_size,
 
 void ObKVMemBlockHandle::set_full(const double base_mb_score)
 {
-  score_ += base_mb_score;
+  score_ += (LRU == policy_) ? base_mb_score * PROBATION_BASE_SCORE_RATIO : base_mb_score;
   ATOMIC_STORE((uint32_t*)(&status_), FULL);
 }
+
+/*
+ * -----------------------------------------------------------ObKVCacheFrequencySketch-----------------------------------------------------
+ */
+ObKVCacheFrequencySketch::ObKVCacheFrequencySketch()
+  : table_(nullptr),
+    table_mask_(0),
+    sample_size_(0),
+    add_cnt_(0)
+{
+}
+
+ObKVCacheFrequencySketch::~ObKVCacheFrequencySketch()
+{
+  destroy();
+}
+
+int ObKVCacheFrequencySketch::init(const int64_t counter_cnt)
+{
+  int ret = OB_SUCCESS;
+  int64_t word_cnt = 1;
+  if (OB_NOT_NULL(table_)) {
+    ret = OB_INIT_TWICE;
+    COMMON_LOG(WARN, "The frequency sketch has been inited, ", K(ret));
+  } else if (OB_UNLIKELY(counter_cnt < COUNTERS_PER_WORD)) {
+    ret = OB_INVALID_ARGUMENT;
+    COMMON_LOG(WARN, "Invalid argument, ", K(ret), K(counter_cnt));
+  } else {
+    while (word_cnt * COUNTERS_PER_WORD < counter_cnt) {
+      word_cnt <<= 1;
+    }
+    ObMemAttr attr(OB_SERVER_TENANT_ID, "KVCacheSketch");
+    if (OB_ISNULL(table_ = static_cast<uint64_t *>(ob_malloc(word_cnt * sizeof(uint64_t), attr)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      COMMON_LOG(WARN, "Fail to allocate frequency sketch, ", K(ret), K(word_cnt));
+    } else {
+      MEMSET(table_, 0, word_cnt * sizeof(uint64_t));
+      table_mask_ = word_cnt - 1;
+      sample_size_ = word_cnt * COUNTERS_PER_WORD * SAMPLE_SIZE_FACTOR;
+      add_cnt_ = 0;
+    }
+  }
+  return ret;
+}
+
+void ObKVCacheFrequencySketch::destroy()
+{
+  if (OB_NOT_NULL(table_)) {
+    ob_free(table_);
+    table_ = nullptr;
+  }
+  table_mask_ = 0;
+  sample_size_ = 0;
+  add_cnt_ = 0;
+}
+
+uint64_t ObKVCacheFrequencySketch::hash_of_depth(const uint64_t hash, const int64_t depth)
+{
+  static const uint64_t SEEDS[SKETCH_DEPTH] = {
+    0xc3a5c85c97cb3127UL, 0xb492b66fbe98f273UL, 0x9ae16a3b2f90404fUL, 0xcbf29ce484222325UL };
+  uint64_t h = (hash + SEEDS[depth]) * SEEDS[depth];
+  return h ^ (h >> 32);
+}
+
+void ObKVCacheFrequencySketch::increment(const uint64_t hash)
+{
+  if (OB_NOT_NULL(table_)) {
+    bool added = false;
+    for (int64_t i = 0; i < SKETCH_DEPTH; ++i) {
+      const uint64_t h = hash_of_depth(hash, i);
+      uint64_t *word = &table_[h & table_mask_];
+      const int64_t offset = static_cast<int64_t>((h >> 40) & (COUNTERS_PER_WORD - 1)) << 2;
+      const uint64_t old_word = ATOMIC_LOAD(word);
+      if (((old_word >> offset) & MAX_COUNTER_VALUE) != MAX_COUNTER_VALUE) {
+        ATOMIC_STORE(word, old_word + (1UL << offset));
+        added = true;
+      }
+    }
+    if (added && ATOMIC_AAF(&add_cnt_, 1) == sample_size_) {
+      halve();
+    }
+  }
+}
+
+int64_t ObKVCacheFrequencySketch::estimate(const uint64_t hash) const
+{
+  int64_t frequency = 0;
+  if (OB_NOT_NULL(table_)) {
+    frequency = MAX_COUNTER_VALUE;
+    for (int64_t i = 0; i < SKETCH_DEPTH; ++i) {
+      const uint64_t h = hash_of_depth(hash, i);
+      const int64_t offset = static_cast<int64_t>((h >> 40) & (COUNTERS_PER_WORD - 1)) << 2;
+      const int64_t count = static_cast<int64_t>((ATOMIC_LOAD(&table_[h & table_mask_]) >> offset) & MAX_COUNTER_VALUE);
+      frequency = MIN(frequency, count);
+    }
+  }
+  return frequency;
+}
+
+void ObKVCacheFrequencySketch::halve()
+{
+  // only the thread reaching sample_size_ gets here, concurrent increments may be lost
+  for (int64_t i = 0; i <= table_mask_; ++i) {
+    ATOMIC_STORE(&table_[i], (ATOMIC_LOAD(&table_[i]) >> 1) & RESET_MASK);
+  }
+  ATOMIC_STORE(&add_cnt_, sample_size_ / 2);
+}
+
 }//end namespace common
 }//end namespace oceanbase
 
@@ -33,6 +33,9 @@ static const int64_t INVALID_CACHE_ID = -1;  // cache id must be in [0,MAX_CACHE
 static const int64_t MAX_TENANT_NUM_PER_SERVER = 1024;
 static const int32_t MAX_CACHE_NAME_LENGTH = 127;
 static const double CACHE_SCORE_DECAY_FACTOR = 0.9;
+// memblocks of the LRU (probation) segment only inherit part of the base score when they
+// become full, so blocks filled by a one-pass scan are washed before the protected LFU ones
+static const double PROBATION_BASE_SCORE_RATIO = 0.5;
 
 class ObIKVCacheKey
 {
@@ -77,6 +80,24 @@ enum ObKVCachePolicy
   MAX_POLICY = 2
 };
 
+// priority class of a cache instance. The memblocks of a higher class are washed later within
+// the tenant, and a tenant of a higher class takes a smaller share of the wash size when the
+// server runs short of memory across tenants.
+enum ObKVCachePriorityClass
+{
+  KVCACHE_PRIORITY_LOW = 0,
+  KVCACHE_PRIORITY_NORMAL = 1,
+  KVCACHE_PRIORITY_HIGH = 2,
+  KVCACHE_PRIORITY_MAX
+};
+
+static const double CACHE_PRIORITY_CLASS_WEIGHTS[KVCACHE_PRIORITY_MAX] = { 0.5, 1.0, 4.0 };
+
+inline bool is_valid_cache_priority_class(const int64_t priority_class)
+{
+  return priority_class >= KVCACHE_PRIORITY_LOW && priority_class < KVCACHE_PRIORITY_MAX;
+}
+
 class ObKVStoreMemBlock
 {
 public:
@@ -186,13 +207,19 @@ public:
   double get_hit_ratio() const;
   inline void set_hold_size(const int64_t hold_size) { ATOMIC_STORE(&hold_size_, hold_size); }
   inline int64_t get_hold_size() const { return ATOMIC_LOAD(&hold_size_); }
+  inline void set_priority_class(const int64_t priority_class) { ATOMIC_STORE(&priority_class_, priority_class); }
+  inline int64_t get_priority_class() const { return ATOMIC_LOAD(&priority_class_); }
+  inline double get_priority_weight() const { return CACHE_PRIORITY_CLASS_WEIGHTS[get_priority_class()]; }
   void reset();
   TO_STRING_KV(KP_(config), K_(kv_cnt), K_(store_size), K_(map_size), K_(lru_mb_cnt),
-      K_(lfu_mb_cnt), K_(base_mb_score), K_(hold_size));
+      K_(lfu_mb_cnt), K_(base_mb_score), K_(hold_size), K_(priority_class), "total_put_cnt", total_put_cnt_.value(),
+      "protected_put_cnt", protected_put_cnt_.value());
 
   const ObKVCacheConfig *config_;
   ObPCNonAtomicCounter total_put_cnt_;
   ObPCNonAtomicCounter total_hit_cnt_;
+  // puts admitted directly into the protected LFU segment by the frequency sketch
+  ObPCNonAtomicCounter protected_put_cnt_;
   int64_t kv_cnt_;
   int64_t store_size_;
   int64_t lru_mb_cnt_;
@@ -203,6 +230,7 @@ public:
   double base_mb_score_;
   // guarantee at least hold_size_ memory left in cache after wash
   int64_t hold_size_;
+  int64_t priority_class_;
 };
 
 struct ObKVCacheInfo
@@ -213,6 +241,39 @@ struct ObKVCacheInfo
   TO_STRING_KV(K_(inst_key), K_(status));
 };
 
+/*
+ * Approximate access frequency of recently missed keys, used as the admission filter of the
+ * kvcache. It is a count-min sketch of 4-bit counters packed 16 per word; every counter is
+ * halved once sample_size_ increments have been recorded, so the history fades out and the
+ * estimate reflects the recent window only. Updates are racy on purpose: a lost increment
+ * only makes the estimate a little lower.
+ */
+class ObKVCacheFrequencySketch
+{
+public:
+  ObKVCacheFrequencySketch();
+  virtual ~ObKVCacheFrequencySketch();
+  int init(const int64_t counter_cnt);
+  void destroy();
+  void increment(const uint64_t hash);
+  int64_t estimate(const uint64_t hash) const;
+  TO_STRING_KV(KP_(table), K_(table_mask), K_(sample_size), K_(add_cnt));
+private:
+  static const int64_t SKETCH_DEPTH = 4;
+  static const int64_t COUNTERS_PER_WORD = 16;
+  static const uint64_t MAX_COUNTER_VALUE = 15;
+  static const uint64_t RESET_MASK = 0x7777777777777777UL;
+  static const int64_t SAMPLE_SIZE_FACTOR = 10;
+  static inline uint64_t hash_of_depth(const uint64_t hash, const int64_t depth);
+  void halve();
+private:
+  uint64_t *table_;
+  int64_t table_mask_;
+  int64_t sample_size_;
+  int64_t add_cnt_;
+  DISALLOW_COPY_AND_ASSIGN(ObKVCacheFrequencySketch);
+};
+
 class ObIMBHandleAllocator
 {
 public:
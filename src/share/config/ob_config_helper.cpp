@@ -590,6 +590,11 @@ bool ObConfigUseLargePagesChecker::check(const ObConfigItem &t) const
   return is_valid;
 }
 
+bool ObConfigCtxLargePagesChecker::check(const ObConfigItem &t) const
+{
+  return '\0' == t.str()[0] || OB_SUCCESS == lib::ObLargePageHelper::check_ctx_param(t.str());
+}
+
 bool ObConfigAuditModeChecker::check(const ObConfigItem &t) const
 {
   ObString v_str(t.str());
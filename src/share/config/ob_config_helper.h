@@ -270,6 +270,17 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObConfigUseLargePagesChecker);
 };
 
+class ObConfigCtxLargePagesChecker
+  : public ObConfigChecker
+{
+public:
+  ObConfigCtxLargePagesChecker() {}
+  virtual ~ObConfigCtxLargePagesChecker() {}
+  bool check(const ObConfigItem &t) const;
+private:
+  DISALLOW_COPY_AND_ASSIGN(ObConfigCtxLargePagesChecker);
+};
+
 class ObConfigLogLevelChecker
   : public ObConfigChecker
 {
@@ -44,6 +44,9 @@ SQL_MONITOR_STATNAME_DEF(MEMORY_DUMP, sql_monitor_statname::CAPACITY, "memory du
 // GI
 SQL_MONITOR_STATNAME_DEF(FILTERED_GRANULE_COUNT, sql_monitor_statname::INT, "filtered granule count", "filtered granule count in GI op")
 SQL_MONITOR_STATNAME_DEF(TOTAL_GRANULE_COUNT, sql_monitor_statname::INT, "total granule count", "total granule count in GI op")
+// TABLE SCAN
+SQL_MONITOR_STATNAME_DEF(BLOCK_IO_WAIT_TIME, sql_monitor_statname::INT, "block io wait time", "time in us waiting for prefetched micro block io in table scan")
+SQL_MONITOR_STATNAME_DEF(MAX_PREFETCH_DEPTH, sql_monitor_statname::INT, "max prefetch depth", "max adaptive micro block prefetch depth in table scan")
 //end
 SQL_MONITOR_STATNAME_DEF(MONITOR_STATNAME_END, sql_monitor_statname::INVALID, "monitor end", "monitor stat name end")
 #endif
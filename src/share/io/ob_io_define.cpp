@@ -16,6 +16,7 @@
 #include "share/io/ob_io_define.h"
 #include "share/io/ob_io_struct.h"
 #include "share/io/ob_io_manager.h"
+#include "share/config/ob_server_config.h"
 #include "lib/time/ob_time_utility.h"
 
 using namespace oceanbase::lib;
@@ -104,6 +105,78 @@ ObIOCategory oceanbase::common::get_io_category_enum(const char *category_name)
   return io_category;
 }
 
+/******************             IOLatencyClass              **********************/
+static const int64_t USER_GET_MAX_SIZE = 16L * 1024L;
+
+const char *oceanbase::common::get_io_latency_class_name(const ObIOLatencyClass latency_class)
+{
+  const char *ret_name = "UNKNOWN";
+  switch (latency_class) {
+    case ObIOLatencyClass::LOG:
+      ret_name = "LOG";
+      break;
+    case ObIOLatencyClass::USER_GET:
+      ret_name = "GET";
+      break;
+    case ObIOLatencyClass::USER_SCAN:
+      ret_name = "SCAN";
+      break;
+    case ObIOLatencyClass::LARGE_QUERY:
+      ret_name = "LARGE";
+      break;
+    case ObIOLatencyClass::BACKGROUND:
+      ret_name = "BACKGROUND";
+      break;
+    case ObIOLatencyClass::PREWARM:
+      ret_name = "PREWARM";
+      break;
+    default:
+      break;
+  }
+  return ret_name;
+}
+
+ObIOLatencyClass oceanbase::common::get_io_latency_class(const ObIOCategory category,
+                                                          const ObIOMode mode,
+                                                          const int64_t size)
+{
+  ObIOLatencyClass latency_class = ObIOLatencyClass::BACKGROUND;
+  switch (category) {
+    case ObIOCategory::LOG_IO:
+      latency_class = ObIOLatencyClass::LOG;
+      break;
+    case ObIOCategory::USER_IO:
+      latency_class = (ObIOMode::READ == mode && size <= USER_GET_MAX_SIZE)
+          ? ObIOLatencyClass::USER_GET : ObIOLatencyClass::USER_SCAN;
+      break;
+    case ObIOCategory::LARGE_QUERY_IO:
+      latency_class = ObIOLatencyClass::LARGE_QUERY;
+      break;
+    case ObIOCategory::PREWARM_IO:
+      latency_class = ObIOLatencyClass::PREWARM;
+      break;
+    default:
+      // sys io and other
+      break;
+  }
+  return latency_class;
+}
+
+int64_t oceanbase::common::get_io_latency_target_us(const ObIOLatencyClass latency_class)
+{
+  static const int64_t LATENCY_TARGET_US[static_cast<int>(ObIOLatencyClass::MAX_CLASS)] = {
+    2L * 1000L,           // LOG
+    5L * 1000L,           // USER_GET
+    20L * 1000L,          // USER_SCAN
+    100L * 1000L,         // LARGE_QUERY
+    1000L * 1000L,        // BACKGROUND
+    1000L * 1000L,        // PREWARM
+  };
+  const int idx = static_cast<int>(latency_class);
+  return idx >= 0 && idx < static_cast<int>(ObIOLatencyClass::MAX_CLASS)
+      ? LATENCY_TARGET_US[idx] : LATENCY_TARGET_US[static_cast<int>(ObIOLatencyClass::BACKGROUND)];
+}
+
 /******************             IOFlag              **********************/
 ObIOFlag::ObIOFlag()
   : flag_(0)
@@ -496,6 +569,11 @@ ObIOMode ObIORequest::get_mode() const
   return io_info_.flag_.get_mode();
 }
 
+ObIOLatencyClass ObIORequest::get_latency_class() const
+{
+  return get_io_latency_class(get_category(), get_mode(), io_info_.size_);
+}
+
 int ObIORequest::alloc_io_buf()
 {
   int ret = OB_SUCCESS;
@@ -713,6 +791,8 @@ ObPhyQueue::ObPhyQueue()
     category_limitation_ts_(INT_MAX64),
     tenant_limitation_ts_(INT_MAX64),
     proportion_ts_(INT_MAX64),
+    deadline_ts_(INT_MAX64),
+    urgent_ts_(INT_MAX64),
     is_category_ready_(false),
     is_tenant_ready_(false),
     category_index_(-1),
@@ -720,6 +800,7 @@ ObPhyQueue::ObPhyQueue()
     category_limitation_pos_(-1),
     tenant_limitation_pos_(-1),
     proportion_pos_(-1),
+    deadline_pos_(-1),
     req_list_()
 {
 
@@ -756,12 +837,15 @@ void ObPhyQueue::destroy()
   category_limitation_ts_ = INT_MAX64;
   tenant_limitation_ts_ = INT_MAX64;
   proportion_ts_ = INT_MAX64;
+  deadline_ts_ = INT_MAX64;
+  urgent_ts_ = INT_MAX64;
   is_category_ready_ = false;
   is_tenant_ready_ = false;
   reservation_pos_ = -1;
   category_limitation_pos_ = -1;
   tenant_limitation_pos_ = -1;
   proportion_pos_ = -1;
+  deadline_pos_ = -1;
   category_index_ = -1;
 }
 
@@ -771,6 +855,21 @@ void ObPhyQueue::reset_time_info()
   category_limitation_ts_ = INT_MAX64;
   tenant_limitation_ts_ = INT_MAX64;
   proportion_ts_ = INT_MAX64;
+  deadline_ts_ = INT_MAX64;
+  urgent_ts_ = INT_MAX64;
+}
+
+void ObPhyQueue::update_deadline()
+{
+  deadline_ts_ = INT_MAX64;
+  urgent_ts_ = INT_MAX64;
+  // the deadline of phy queue is decided by its first request, which is the next to dispatch
+  const ObIORequest *first_req = req_list_.get_first();
+  if (!req_list_.is_empty() && OB_NOT_NULL(first_req) && first_req->time_log_.enqueue_ts_ > 0) {
+    const int64_t target_us = get_io_latency_target_us(first_req->get_latency_class());
+    deadline_ts_ = first_req->time_log_.enqueue_ts_ + target_us;
+    urgent_ts_ = deadline_ts_ - target_us / 2;
+  }
 }
 
 void ObPhyQueue::reset_queue_info()
@@ -781,6 +880,7 @@ void ObPhyQueue::reset_queue_info()
   category_limitation_pos_ = -1;
   tenant_limitation_pos_ = -1;
   proportion_pos_ = -1;
+  deadline_pos_ = -1;
 }
 
 /******************             IOHandle              **********************/
@@ -1220,7 +1320,8 @@ ObMClockQueue::ObMClockQueue()
     r_heap_(r_cmp_),
     cl_heap_(cl_cmp_),
     tl_heap_(tl_cmp_),
-    ready_heap_(p_cmp_)
+    ready_heap_(p_cmp_),
+    deadline_heap_(d_cmp_)
 {
 
 }
@@ -1260,6 +1361,7 @@ int ObMClockQueue::push_phyqueue(ObPhyQueue *phy_queue)
   } else if (OB_ISNULL(phy_queue)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("phy_queue is null", K(ret), KP(phy_queue));
+  } else if (FALSE_IT(phy_queue->update_deadline())) {
   } else if (OB_FAIL(r_heap_.push(phy_queue))) {
     LOG_WARN("push r heap failed", K(ret));
   } else if (OB_FAIL(cl_heap_.push(phy_queue))) {
@@ -1353,6 +1455,8 @@ int ObMClockQueue::remove_from_heap(ObPhyQueue *phy_queue)
   } else if (phy_queue->is_category_ready_ && phy_queue->is_tenant_ready_) {
     if (OB_FAIL(ready_heap_.remove(phy_queue))) {
       LOG_WARN("remove phy queue from ready heap failed", K(ret));
+    } else if (OB_FAIL(deadline_heap_.remove(phy_queue))) {
+      LOG_WARN("remove phy queue from deadline heap failed", K(ret));
     }
   }
   // ignore ret
@@ -1378,7 +1482,7 @@ int ObMClockQueue::pop_with_ready_queue(const int64_t current_ts, ObIORequest *&
       tmp_phy_queue->is_category_ready_ = true;
       if (tmp_phy_queue->tenant_limitation_ts_ <= current_ts) {
         tmp_phy_queue->is_tenant_ready_ = true;
-        if (OB_FAIL(ready_heap_.push(tmp_phy_queue))) {
+        if (OB_FAIL(push_ready_heap(tmp_phy_queue))) {
           LOG_WARN("push phy_queue from cl_heap to ready_heap failed", K(ret));
         }
       } else {
@@ -1405,13 +1509,13 @@ int ObMClockQueue::pop_with_ready_queue(const int64_t current_ts, ObIORequest *&
       LOG_WARN("remove PhyQueue from t_limitation queue failed", K(ret));
     } else {
       tmp_phy_queue->is_tenant_ready_ = true;
-      if (OB_FAIL(ready_heap_.push(tmp_phy_queue))) {
+      if (OB_FAIL(push_ready_heap(tmp_phy_queue))) {
         LOG_WARN("push phy_queue from tl_heap to ready_heap failed", K(ret));
       }
     }
   }
   if (OB_SUCC(ret) && !ready_heap_.empty()) {
-    tmp_phy_queue = ready_heap_.top();
+    tmp_phy_queue = choose_ready_queue(current_ts);
     if (OB_ISNULL(tmp_phy_queue)) {
       ret = OB_ERR_UNEXPECTED;
       LOG_WARN("phy_queue is null", K(ret));
@@ -1465,3 +1569,39 @@ int ObMClockQueue::pop_with_ready_queue(const int64_t current_ts, ObIORequest *&
   return ret;
 }
 
+int ObMClockQueue::push_ready_heap(ObPhyQueue *phy_queue)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(ready_heap_.push(phy_queue))) {
+    LOG_WARN("push ready heap failed", K(ret));
+  } else if (OB_FAIL(deadline_heap_.push(phy_queue))) {
+    LOG_WARN("push deadline heap failed", K(ret));
+    int tmp_ret = ready_heap_.remove(phy_queue);
+    if (OB_SUCCESS != tmp_ret) {
+      LOG_ERROR("remove queue from ready heap failed", K(tmp_ret));
+    }
+  }
+  return ret;
+}
+
+// Among the queues within category and tenant limitation, P schedule picks the one with min
+// proportion_ts. With deadline schedule enabled, the queue with the earliest deadline is picked
+// instead once it has consumed half of its target latency, so that a point get is not queued
+// behind compaction reads. The picked queue still advances its proportion clock, so the weights
+// of mclock are kept over time.
+ObPhyQueue *ObMClockQueue::choose_ready_queue(const int64_t current_ts)
+{
+  ObPhyQueue *phy_queue = ready_heap_.top();
+  if (GCONF._enable_io_deadline_schedule && !deadline_heap_.empty()) {
+    ObPhyQueue *urgent_queue = deadline_heap_.top();
+    if (OB_NOT_NULL(urgent_queue)
+        && urgent_queue != phy_queue
+        && urgent_queue->urgent_ts_ <= current_ts
+        && !urgent_queue->req_list_.is_empty()) {
+      LOG_DEBUG("dispatch urgent phy queue", KPC(urgent_queue), KPC(phy_queue), K(current_ts));
+      phy_queue = urgent_queue;
+    }
+  }
+  return phy_queue;
+}
+
@@ -52,6 +52,23 @@ enum class ObIOCategory : uint8_t
 const char *get_io_category_name(ObIOCategory category);
 ObIOCategory get_io_category_enum(const char *category_name);
 
+// latency class of io request, each class has a target latency from enqueue to device return,
+// used by deadline-aware dispatch and latency histograms.
+enum class ObIOLatencyClass : uint8_t
+{
+  LOG = 0,
+  USER_GET = 1,    // user read no larger than 16KB, mostly point get
+  USER_SCAN = 2,   // other user io
+  LARGE_QUERY = 3,
+  BACKGROUND = 4,  // sys io, such as compaction, migration and backup
+  PREWARM = 5,
+  MAX_CLASS
+};
+
+const char *get_io_latency_class_name(const ObIOLatencyClass latency_class);
+ObIOLatencyClass get_io_latency_class(const ObIOCategory category, const ObIOMode mode, const int64_t size);
+int64_t get_io_latency_target_us(const ObIOLatencyClass latency_class);
+
 struct ObIOFlag final
 {
 public:
@@ -219,6 +236,7 @@ public:
   const ObIOFlag &get_flag() const;
   ObIOCategory get_category() const;
   ObIOMode get_mode() const;
+  ObIOLatencyClass get_latency_class() const;
   void cancel();
   int alloc_io_buf();
   int prepare();
@@ -271,14 +289,19 @@ public:
   void destroy();
   void reset_time_info();
   void reset_queue_info();
+  void update_deadline();
 public:
   typedef common::ObDList<ObIORequest> IOReqList;
-  TO_STRING_KV(K_(reservation_ts), K_(category_limitation_ts), K_(tenant_limitation_ts));
+  TO_STRING_KV(K_(reservation_ts), K_(category_limitation_ts), K_(tenant_limitation_ts), K_(deadline_ts));
   bool is_inited_;
   int64_t reservation_ts_;
   int64_t category_limitation_ts_;
   int64_t tenant_limitation_ts_;
   int64_t proportion_ts_;
+  // enqueue_ts + target latency of the first request, INT64_MAX if queue is empty
+  int64_t deadline_ts_;
+  // deadline_ts_ - target latency / 2, the queue is urgent after this time
+  int64_t urgent_ts_;
   bool is_category_ready_;
   bool is_tenant_ready_;
   int category_index_;
@@ -286,6 +309,7 @@ public:
   int64_t category_limitation_pos_;
   int64_t tenant_limitation_pos_;
   int64_t proportion_pos_;
+  int64_t deadline_pos_;
   IOReqList req_list_;
 };
 
@@ -402,6 +426,8 @@ public:
   int remove_from_heap(ObPhyQueue *phy_queue);
 private:
   int pop_with_ready_queue(const int64_t current_ts, ObIORequest *&req, int64_t &deadline_ts);
+  int push_ready_heap(ObPhyQueue *phy_queue);
+  ObPhyQueue *choose_ready_queue(const int64_t current_ts);
 
   template<typename T, int64_t T::*member>
   struct HeapCompare {
@@ -416,10 +442,13 @@ private:
   HeapCompare<ObPhyQueue, &ObPhyQueue::category_limitation_ts_> cl_cmp_;
   HeapCompare<ObPhyQueue, &ObPhyQueue::tenant_limitation_ts_> tl_cmp_;
   HeapCompare<ObPhyQueue, &ObPhyQueue::proportion_ts_> p_cmp_;
+  HeapCompare<ObPhyQueue, &ObPhyQueue::deadline_ts_> d_cmp_;
   ObRemovableHeap<ObPhyQueue *, HeapCompare<ObPhyQueue, &ObPhyQueue::reservation_ts_>, &ObPhyQueue::reservation_pos_> r_heap_;
   ObRemovableHeap<ObPhyQueue *, HeapCompare<ObPhyQueue, &ObPhyQueue::category_limitation_ts_>, &ObPhyQueue::category_limitation_pos_> cl_heap_;
   ObRemovableHeap<ObPhyQueue *, HeapCompare<ObPhyQueue, &ObPhyQueue::tenant_limitation_ts_>, &ObPhyQueue::tenant_limitation_pos_> tl_heap_;
   ObRemovableHeap<ObPhyQueue *, HeapCompare<ObPhyQueue, &ObPhyQueue::proportion_ts_>, &ObPhyQueue::proportion_pos_> ready_heap_;
+  // the same phy queues as ready_heap_, ordered by deadline
+  ObRemovableHeap<ObPhyQueue *, HeapCompare<ObPhyQueue, &ObPhyQueue::deadline_ts_>, &ObPhyQueue::deadline_pos_> deadline_heap_;
 };
 
 
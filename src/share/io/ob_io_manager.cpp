@@ -833,6 +833,20 @@ void ObTenantIOManager::print_io_status()
         need_print_io_config = true;
       }
     }
+    for (int64_t i = 0; i < static_cast<int>(ObIOLatencyClass::MAX_CLASS); ++i) {
+      ObIOLatencyHistogram histogram;
+      const ObIOLatencyClass latency_class = static_cast<ObIOLatencyClass>(i);
+      io_usage_.get_latency_histogram(latency_class, histogram);
+      const int64_t count = histogram.get_count();
+      if (count > 0) {
+        snprintf(io_status, sizeof(io_status),
+            "class: %10s, count: %8ld, target: %8ld, p50: %8ld, p99: %8ld, p999: %8ld, deadline_miss: %8ld",
+            get_io_latency_class_name(latency_class), count, get_io_latency_target_us(latency_class),
+            histogram.get_percentile_us(0.5), histogram.get_percentile_us(0.99),
+            histogram.get_percentile_us(0.999), histogram.deadline_miss_count_);
+        LOG_INFO("[IO LATENCY]", K_(tenant_id), KCSTRING(io_status));
+      }
+    }
     if (need_print_io_config) {
       ObArray<int64_t> queue_count_array;
       int ret = OB_SUCCESS;
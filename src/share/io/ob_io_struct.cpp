@@ -14,6 +14,8 @@
 
 #include "share/io/ob_io_struct.h"
 
+#include <cmath>
+
 #include "lib/time/ob_time_utility.h"
 #include "lib/thread/ob_thread_name.h"
 #include "lib/thread/thread_mgr.h"
@@ -21,6 +23,8 @@
 #include "lib/objectpool/ob_concurrency_objpool.h"
 #include "lib/utility/ob_tracepoint.h"
 #include "lib/file/file_directory_utils.h"
+#include "lib/cpu/ob_cpu_topology.h"
+#include "share/config/ob_server_config.h"
 #include "share/io/ob_io_manager.h"
 #include "observer/ob_server.h"
 
@@ -422,6 +426,67 @@ void ObIOStatDiff::reset()
   last_ts_ = 0;
 }
 
+/******************             IOLatencyHistogram              **********************/
+
+ObIOLatencyHistogram::ObIOLatencyHistogram()
+{
+  reset();
+}
+
+ObIOLatencyHistogram::~ObIOLatencyHistogram()
+{
+
+}
+
+void ObIOLatencyHistogram::record(const int64_t rt_us, const bool is_deadline_missed)
+{
+  const int64_t idx = rt_us <= 0 ? 0 : min(BUCKET_CNT - 1, 64L - __builtin_clzll(static_cast<uint64_t>(rt_us)));
+  ATOMIC_INC(&buckets_[idx]);
+  if (is_deadline_missed) {
+    ATOMIC_INC(&deadline_miss_count_);
+  }
+}
+
+void ObIOLatencyHistogram::reset()
+{
+  MEMSET(buckets_, 0, sizeof(buckets_));
+  deadline_miss_count_ = 0;
+}
+
+int64_t ObIOLatencyHistogram::get_count() const
+{
+  int64_t count = 0;
+  for (int64_t i = 0; i < BUCKET_CNT; ++i) {
+    count += buckets_[i];
+  }
+  return count;
+}
+
+int64_t ObIOLatencyHistogram::get_percentile_us(const double percentile) const
+{
+  int64_t rt_us = 0;
+  const int64_t total_count = get_count();
+  if (total_count > 0) {
+    // nearest rank, p999 of 100 requests is the slowest one
+    const int64_t target_count = max(1L, static_cast<int64_t>(ceil(total_count * percentile)));
+    int64_t count = 0;
+    for (int64_t i = 0; i < BUCKET_CNT && count < target_count; ++i) {
+      count += buckets_[i];
+      rt_us = 1L << i;
+    }
+  }
+  return rt_us;
+}
+
+void ObIOLatencyHistogram::diff(const ObIOLatencyHistogram &new_histogram,
+                                const ObIOLatencyHistogram &last_histogram)
+{
+  for (int64_t i = 0; i < BUCKET_CNT; ++i) {
+    buckets_[i] = new_histogram.buckets_[i] - last_histogram.buckets_[i];
+  }
+  deadline_miss_count_ = new_histogram.deadline_miss_count_ - last_histogram.deadline_miss_count_;
+}
+
 /******************             IOUsage              **********************/
 ObIOUsage::ObIOUsage()
 {
@@ -439,6 +504,11 @@ void ObIOUsage::accumulate(const ObIORequest &req)
     const int64_t device_delay = get_io_interval(req.time_log_.return_ts_, req.time_log_.submit_ts_);
     io_stats_[static_cast<int>(req.get_category())][static_cast<int>(req.get_mode())]
       .accumulate(1, req.io_size_, device_delay);
+    // latency from entering scheduler to device return, the same as the deadline of dispatch
+    const int64_t begin_ts = req.time_log_.enqueue_ts_ > 0 ? req.time_log_.enqueue_ts_ : req.time_log_.submit_ts_;
+    const ObIOLatencyClass latency_class = req.get_latency_class();
+    const int64_t rt_us = get_io_interval(req.time_log_.return_ts_, begin_ts);
+    latency_histograms_[static_cast<int>(latency_class)].record(rt_us, rt_us > get_io_latency_target_us(latency_class));
   }
 }
 
@@ -475,6 +545,14 @@ bool ObIOUsage::is_request_doing(const ObIOCategory category) const
   return ATOMIC_LOAD(&doing_request_count_[static_cast<int>(category)]) > 0;
 }
 
+void ObIOUsage::get_latency_histogram(const ObIOLatencyClass latency_class, ObIOLatencyHistogram &histogram)
+{
+  const int idx = static_cast<int>(latency_class);
+  const ObIOLatencyHistogram new_histogram = latency_histograms_[idx]; // copy to prevent accumulating
+  histogram.diff(new_histogram, last_latency_histograms_[idx]);
+  last_latency_histograms_[idx] = new_histogram;
+}
+
 int64_t ObIOUsage::to_string(char* buf, const int64_t buf_len) const
 {
   int64_t pos = 0;
@@ -676,7 +754,8 @@ ObIOSender::ObIOSender(ObIAllocator &allocator)
     tg_id_(-1),
     io_queue_(nullptr),
     queue_cond_(),
-    sender_req_count_(0)
+    sender_req_count_(0),
+    numa_node_(-1)
 {
 
 }
@@ -769,6 +848,7 @@ void ObIOSender::destroy()
   is_inited_ = false;
   stop_submit_ = false;
   sender_req_count_ = 0;
+  numa_node_ = -1;
   LOG_INFO("io sender destroyed", KCSTRING(lbt()));
 }
 
@@ -798,7 +878,13 @@ void ObIOSender::run1()
     LOG_WARN("not init", K(ret), K(is_inited_));
   } else {
     set_thread_name("IO_SCHEDULE", thread_id);
-    LOG_INFO("io schedule thread started", K(thread_id));
+    if (numa_node_ >= 0) {
+      int tmp_ret = OB_SUCCESS;
+      if (OB_SUCCESS != (tmp_ret = ObNumaTopology::instance().bind_thread_to_node(numa_node_))) {
+        LOG_WARN("bind io schedule thread to numa node failed", K(tmp_ret), K(numa_node_));
+      }
+    }
+    LOG_INFO("io schedule thread started", K(thread_id), K(numa_node_));
     while (!has_set_stop() && !stop_submit_) {
       pop_and_submit();
     }
@@ -1102,7 +1188,8 @@ ObIOScheduler::ObIOScheduler(const ObIOConfig &io_config, ObIAllocator &allocato
     io_config_(io_config),
     allocator_(allocator),
     io_tuner_(*this),
-    schedule_media_id_(0)
+    schedule_media_id_(0),
+    numa_node_cnt_(0)
 {
 }
 
@@ -1123,6 +1210,10 @@ int ObIOScheduler::init(const int64_t queue_count, const int64_t queue_depth, co
   } else if (OB_FAIL(io_tuner_.init())) {
     LOG_WARN("init io tuner failed", K(ret));
   } else {
+    const int64_t node_cnt = ObNumaTopology::instance().get_node_count();
+    if (GCONF._enable_numa_aware_io_sender && node_cnt > 1 && queue_count >= node_cnt) {
+      numa_node_cnt_ = node_cnt;
+    }
     for (int64_t i = 0; OB_SUCC(ret) && i < queue_count; ++i) {
       void *buf = nullptr;
       ObIOSender *tmp_sender = nullptr;
@@ -1132,6 +1223,7 @@ int ObIOScheduler::init(const int64_t queue_count, const int64_t queue_depth, co
       } else if (FALSE_IT(tmp_sender = new (buf) ObIOSender(allocator_))) {
       } else if (OB_FAIL(tmp_sender->init(queue_depth))) {
         LOG_WARN("init io sender failed", K(ret), K(i), K(*tmp_sender), K(queue_depth));
+      } else if (FALSE_IT(tmp_sender->set_numa_node(numa_node_cnt_ > 0 ? i % numa_node_cnt_ : -1))) {
       } else if (OB_FAIL(senders_.push_back(tmp_sender))) {
         LOG_WARN("push back io sender failed", K(ret), K(i), K(*tmp_sender));
       }
@@ -1169,6 +1261,7 @@ void ObIOScheduler::destroy()
     }
   }
   senders_.destroy();
+  numa_node_cnt_ = 0;
   is_inited_ = false;
 }
 
@@ -1204,11 +1297,7 @@ int ObIOScheduler::schedule_request(ObIOClock &io_clock, ObIORequest &req)
     ret = OB_NOT_INIT;
     LOG_WARN("not init", K(ret), K(is_inited_));
   } else {
-    // push the requeust into sender queue, balance channel queue count by random twice
-    const int64_t idx1 = ObRandom::rand(0, senders_.count() - 1);
-    const int64_t idx2 = ObRandom::rand(0, senders_.count() - 1);
-    const int64_t sender_idx = senders_.at(idx1)->sender_req_count_ < senders_.at(idx2)->sender_req_count_ ? idx1 : idx2;
-    ObIOSender *sender = senders_.at(sender_idx);
+    ObIOSender *sender = choose_sender();
     if (req.io_info_.fd_.device_handle_->media_id_ != schedule_media_id_) {
       // direct submit
       if (OB_FAIL(sender->submit(req))) {
@@ -1224,6 +1313,25 @@ int ObIOScheduler::schedule_request(ObIOClock &io_clock, ObIORequest &req)
   return ret;
 }
 
+ObIOSender *ObIOScheduler::choose_sender()
+{
+  // push the requeust into sender queue, balance channel queue count by random twice
+  int64_t idx1 = 0;
+  int64_t idx2 = 0;
+  const int64_t node = numa_node_cnt_ > 0 ? ObNumaTopology::instance().get_current_node() : -1;
+  if (node >= 0 && node < numa_node_cnt_) {
+    // only choose among the senders of local numa node, they are node, node + cnt, node + 2 * cnt...
+    const int64_t local_sender_cnt = (senders_.count() - node + numa_node_cnt_ - 1) / numa_node_cnt_;
+    idx1 = node + ObRandom::rand(0, local_sender_cnt - 1) * numa_node_cnt_;
+    idx2 = node + ObRandom::rand(0, local_sender_cnt - 1) * numa_node_cnt_;
+  } else {
+    idx1 = ObRandom::rand(0, senders_.count() - 1);
+    idx2 = ObRandom::rand(0, senders_.count() - 1);
+  }
+  const int64_t sender_idx = senders_.at(idx1)->sender_req_count_ < senders_.at(idx2)->sender_req_count_ ? idx1 : idx2;
+  return senders_.at(sender_idx);
+}
+
 int ObIOScheduler::add_tenant_map(uint64_t tenant_id)
 {
   int ret = OB_SUCCESS;
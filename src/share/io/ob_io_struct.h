@@ -135,6 +135,26 @@ private:
   int64_t last_ts_;
 };
 
+// log2 latency histogram, bucket i (i > 0) counts the requests with latency in [2^(i-1), 2^i) us
+struct ObIOLatencyHistogram final
+{
+public:
+  static const int64_t BUCKET_CNT = 24; // the last bucket counts all latency >= 2^22 us
+  ObIOLatencyHistogram();
+  ~ObIOLatencyHistogram();
+  void record(const int64_t rt_us, const bool is_deadline_missed);
+  void reset();
+  int64_t get_count() const;
+  // return the upper bound of the bucket that percentile falls in, percentile in (0, 1]
+  int64_t get_percentile_us(const double percentile) const;
+  // this = new_histogram - last_histogram
+  void diff(const ObIOLatencyHistogram &new_histogram, const ObIOLatencyHistogram &last_histogram);
+  TO_STRING_KV("buckets", common::ObArrayWrap<int64_t>(buckets_, BUCKET_CNT), K(deadline_miss_count_));
+public:
+  int64_t buckets_[BUCKET_CNT];
+  int64_t deadline_miss_count_;
+};
+
 class ObIOUsage final
 {
 public:
@@ -147,6 +167,8 @@ public:
   void record_request_start(const ObIORequest &req);
   void record_request_finish(const ObIORequest &req);
   bool is_request_doing(const ObIOCategory category) const;
+  // latency histogram since last call, only called by the io status printer
+  void get_latency_histogram(const ObIOLatencyClass latency_class, ObIOLatencyHistogram &histogram);
   int64_t to_string(char* buf, const int64_t buf_len) const;
 private:
   ObIOStat io_stats_[static_cast<int>(ObIOCategory::MAX_CATEGORY)][static_cast<int>(ObIOMode::MAX_MODE)];
@@ -155,6 +177,8 @@ private:
   AvgItems avg_byte_;
   AvgItems avg_rt_us_;
   int64_t doing_request_count_[static_cast<int>(ObIOCategory::MAX_CATEGORY)];
+  ObIOLatencyHistogram latency_histograms_[static_cast<int>(ObIOLatencyClass::MAX_CLASS)];
+  ObIOLatencyHistogram last_latency_histograms_[static_cast<int>(ObIOLatencyClass::MAX_CLASS)];
 };
 
 class ObCpuUsage final
@@ -220,7 +244,9 @@ public:
   int remove_phy_queue(const uint64_t tenant_id);
   int notify();
   int32_t get_queue_count() const;
-  TO_STRING_KV(K(is_inited_), K(stop_submit_), KPC(io_queue_), K(tg_id_));
+  // must be set before start, -1 means not bound to any numa node
+  void set_numa_node(const int64_t numa_node) { numa_node_ = numa_node; }
+  TO_STRING_KV(K(is_inited_), K(stop_submit_), KPC(io_queue_), K(tg_id_), K(numa_node_));
 //private:
   void pop_and_submit();
   int64_t calc_wait_timeout(const int64_t queue_deadline);
@@ -234,6 +260,7 @@ public:
   ObThreadCond queue_cond_;
   hash::ObHashMap<uint64_t, ObIOCategoryQueues *> tenant_map_;
   int64_t sender_req_count_;
+  int64_t numa_node_;
 };
 
 
@@ -250,7 +277,9 @@ public:
   int schedule_request(ObIOClock &io_clock, ObIORequest &req);
   int add_tenant_map(uint64_t tenant_id);
   int remove_tenant_map(uint64_t tenant_id);
-  TO_STRING_KV(K(is_inited_), K(io_config_), K(senders_));
+  TO_STRING_KV(K(is_inited_), K(io_config_), K(senders_), K(numa_node_cnt_));
+private:
+  ObIOSender *choose_sender();
 private:
   friend class ObIOTuner;
   bool is_inited_;
@@ -259,6 +288,8 @@ private:
   ObSEArray<ObIOSender *, 1> senders_;
   ObIOTuner io_tuner_;
   int64_t schedule_media_id_;
+  // sender i is bound to numa node (i % numa_node_cnt_), 0 means numa unaware
+  int64_t numa_node_cnt_;
 };
 
 class ObDeviceChannel;
@@ -119,6 +119,8 @@ struct ObTableScanStatistic
   int64_t block_cache_hit_cnt_;
   int64_t block_cache_miss_cnt_;
   int64_t rowkey_prefix_;
+  int64_t block_io_wait_time_;
+  int64_t max_prefetch_depth_;
   ObTableScanStatistic()
     : access_row_cnt_(0),
       out_row_cnt_(0),
@@ -131,7 +133,9 @@ struct ObTableScanStatistic
       row_cache_miss_cnt_(0),
       block_cache_hit_cnt_(0),
       block_cache_miss_cnt_(0),
-      rowkey_prefix_(0)
+      rowkey_prefix_(0),
+      block_io_wait_time_(0),
+      max_prefetch_depth_(0)
   {}
   OB_INLINE void reset()
   {
@@ -147,6 +151,8 @@ struct ObTableScanStatistic
     block_cache_hit_cnt_ = 0;
     block_cache_miss_cnt_ = 0;
     rowkey_prefix_ = 0;
+    block_io_wait_time_ = 0;
+    max_prefetch_depth_ = 0;
   }
   OB_INLINE void reset_cache_stat()
   {
@@ -158,6 +164,8 @@ struct ObTableScanStatistic
     row_cache_miss_cnt_ = 0;
     block_cache_hit_cnt_ = 0;
     block_cache_miss_cnt_ = 0;
+    block_io_wait_time_ = 0;
+    max_prefetch_depth_ = 0;
   }
   TO_STRING_KV(
       K_(access_row_cnt),
@@ -169,7 +177,9 @@ struct ObTableScanStatistic
       K_(row_cache_miss_cnt),
       K_(fuse_row_cache_hit_cnt),
       K_(fuse_row_cache_miss_cnt),
-      K_(rowkey_prefix));
+      K_(rowkey_prefix),
+      K_(block_io_wait_time),
+      K_(max_prefetch_depth));
 };
 
 static const int64_t OB_DEFAULT_FILTER_EXPR_COUNT = 4;
@@ -0,0 +1,474 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#if defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#endif
+#endif
+#include "share/ob_io_uring.h"
+#include "share/ob_errno.h"
+#include "lib/time/ob_time_utility.h"
+#include "lib/atomic/ob_atomic.h"
+
+// IORING_OP_READ/IORING_OP_WRITE and IORING_REGISTER_PROBE need linux 5.6
+#if defined(IORING_FEAT_CUR_PERSONALITY)
+#define OB_HAS_IO_URING 1
+#endif
+
+#ifdef OB_HAS_IO_URING
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+#endif
+
+using namespace oceanbase::common;
+
+namespace oceanbase {
+namespace share {
+
+#ifdef OB_HAS_IO_URING
+static inline int sys_io_uring_setup(const uint32_t entries, struct io_uring_params *p)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+static inline int sys_io_uring_enter(const int fd, const uint32_t to_submit,
+                                     const uint32_t min_complete, const uint32_t flags)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+static inline int sys_io_uring_register(const int fd, const uint32_t opcode,
+                                        const void *arg, const uint32_t nr_args)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+#endif
+
+ObIOUring::ObIOUring()
+  : is_inited_(false),
+    ring_fd_(-1),
+    fixed_fd_(-1),
+    sq_entries_(0),
+    cq_entries_(0),
+    sq_ring_ptr_(nullptr),
+    sq_ring_size_(0),
+    sq_head_(nullptr),
+    sq_tail_(nullptr),
+    sq_mask_(nullptr),
+    sq_array_(nullptr),
+    sqes_(nullptr),
+    sqes_size_(0),
+    cq_ring_ptr_(nullptr),
+    cq_ring_size_(0),
+    cq_head_(nullptr),
+    cq_tail_(nullptr),
+    cq_mask_(nullptr),
+    cqes_(nullptr),
+    sq_lock_(),
+    submit_lock_(),
+    pending_cnt_(0),
+    timeout_armed_(false),
+    timeout_ts_()
+{
+}
+
+ObIOUring::~ObIOUring()
+{
+  destroy();
+}
+
+bool ObIOUring::is_supported()
+{
+#ifdef OB_HAS_IO_URING
+  return true;
+#else
+  return false;
+#endif
+}
+
+int ObIOUring::init(const uint32_t entries)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  struct io_uring_params params;
+  MEMSET(&params, 0, sizeof(params));
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    SHARE_LOG(WARN, "init twice", K(ret));
+  } else if (OB_UNLIKELY(0 == entries)) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "invalid argument", K(ret), K(entries));
+  } else if ((ring_fd_ = sys_io_uring_setup(entries, &params)) < 0) {
+    ret = OB_NOT_SUPPORTED;
+    SHARE_LOG(WARN, "io_uring_setup failed", K(ret), K(entries), K(errno), KERRMSG);
+  } else if (OB_FAIL(map_rings(&params))) {
+    SHARE_LOG(WARN, "map io_uring rings failed", K(ret), K(entries));
+  } else {
+    // make sure the kernel supports non-vectored read/write, which is introduced in linux 5.6
+    const int64_t probe_size = sizeof(struct io_uring_probe) + 256 * sizeof(struct io_uring_probe_op);
+    char probe_buf[probe_size];
+    MEMSET(probe_buf, 0, probe_size);
+    struct io_uring_probe *probe = reinterpret_cast<struct io_uring_probe *>(probe_buf);
+    if (0 != sys_io_uring_register(ring_fd_, IORING_REGISTER_PROBE, probe, 256)) {
+      ret = OB_NOT_SUPPORTED;
+      SHARE_LOG(WARN, "io_uring probe failed", K(ret), K(errno), KERRMSG);
+    } else if (probe->last_op < IORING_OP_WRITE
+               || 0 == (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED)
+               || 0 == (probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED)
+               || 0 == (probe->ops[IORING_OP_TIMEOUT].flags & IO_URING_OP_SUPPORTED)) {
+      ret = OB_NOT_SUPPORTED;
+      SHARE_LOG(WARN, "io_uring read/write op is not supported", K(ret), K(probe->last_op));
+    } else {
+      sq_entries_ = params.sq_entries;
+      cq_entries_ = params.cq_entries;
+      pending_cnt_ = 0;
+      timeout_armed_ = false;
+      is_inited_ = true;
+      SHARE_LOG(INFO, "io_uring init succ", K(*this), K(params.features));
+    }
+  }
+  if (OB_FAIL(ret)) {
+    destroy();
+  }
+#else
+  UNUSED(entries);
+  ret = OB_NOT_SUPPORTED;
+  SHARE_LOG(WARN, "io_uring is not supported by the build environment", K(ret));
+#endif
+  return ret;
+}
+
+int ObIOUring::map_rings(const void *params)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  const struct io_uring_params &p = *static_cast<const struct io_uring_params *>(params);
+  sq_ring_size_ = p.sq_off.array + p.sq_entries * sizeof(uint32_t);
+  cq_ring_size_ = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+  sqes_size_ = p.sq_entries * sizeof(struct io_uring_sqe);
+  const bool single_mmap = 0 != (p.features & IORING_FEAT_SINGLE_MMAP);
+  if (single_mmap) {
+    sq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    cq_ring_size_ = sq_ring_size_;
+  }
+  void *ptr = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (MAP_FAILED == ptr) {
+    ret = OB_ERR_SYS;
+    SHARE_LOG(WARN, "mmap sq ring failed", K(ret), K(errno), KERRMSG);
+  } else {
+    sq_ring_ptr_ = ptr;
+    if (single_mmap) {
+      cq_ring_ptr_ = sq_ring_ptr_;
+    } else if (MAP_FAILED == (ptr = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                                           MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING))) {
+      ret = OB_ERR_SYS;
+      SHARE_LOG(WARN, "mmap cq ring failed", K(ret), K(errno), KERRMSG);
+    } else {
+      cq_ring_ptr_ = ptr;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    if (MAP_FAILED == (ptr = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES))) {
+      ret = OB_ERR_SYS;
+      SHARE_LOG(WARN, "mmap sqes failed", K(ret), K(errno), KERRMSG);
+    } else {
+      char *sq = static_cast<char *>(sq_ring_ptr_);
+      char *cq = static_cast<char *>(cq_ring_ptr_);
+      sqes_ = ptr;
+      sq_head_ = reinterpret_cast<uint32_t *>(sq + p.sq_off.head);
+      sq_tail_ = reinterpret_cast<uint32_t *>(sq + p.sq_off.tail);
+      sq_mask_ = reinterpret_cast<uint32_t *>(sq + p.sq_off.ring_mask);
+      sq_array_ = reinterpret_cast<uint32_t *>(sq + p.sq_off.array);
+      cq_head_ = reinterpret_cast<uint32_t *>(cq + p.cq_off.head);
+      cq_tail_ = reinterpret_cast<uint32_t *>(cq + p.cq_off.tail);
+      cq_mask_ = reinterpret_cast<uint32_t *>(cq + p.cq_off.ring_mask);
+      cqes_ = cq + p.cq_off.cqes;
+    }
+  }
+#else
+  UNUSED(params);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+void ObIOUring::unmap_rings()
+{
+  if (nullptr != sqes_) {
+    ::munmap(sqes_, sqes_size_);
+    sqes_ = nullptr;
+  }
+  if (nullptr != cq_ring_ptr_ && cq_ring_ptr_ != sq_ring_ptr_) {
+    ::munmap(cq_ring_ptr_, cq_ring_size_);
+  }
+  cq_ring_ptr_ = nullptr;
+  if (nullptr != sq_ring_ptr_) {
+    ::munmap(sq_ring_ptr_, sq_ring_size_);
+    sq_ring_ptr_ = nullptr;
+  }
+  sq_head_ = nullptr;
+  sq_tail_ = nullptr;
+  sq_mask_ = nullptr;
+  sq_array_ = nullptr;
+  cq_head_ = nullptr;
+  cq_tail_ = nullptr;
+  cq_mask_ = nullptr;
+  cqes_ = nullptr;
+}
+
+void ObIOUring::destroy()
+{
+  unmap_rings();
+  if (ring_fd_ >= 0) {
+    ::close(ring_fd_);
+    ring_fd_ = -1;
+  }
+  fixed_fd_ = -1;
+  sq_entries_ = 0;
+  cq_entries_ = 0;
+  sq_ring_size_ = 0;
+  cq_ring_size_ = 0;
+  sqes_size_ = 0;
+  pending_cnt_ = 0;
+  timeout_armed_ = false;
+  is_inited_ = false;
+}
+
+int ObIOUring::register_file(const int fd)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    SHARE_LOG(WARN, "not init", K(ret));
+  } else if (OB_UNLIKELY(fd < 0 || fixed_fd_ >= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "invalid argument", K(ret), K(fd), K_(fixed_fd));
+  } else if (0 != sys_io_uring_register(ring_fd_, IORING_REGISTER_FILES, &fd, 1)) {
+    ret = OB_IO_ERROR;
+    SHARE_LOG(WARN, "register file to io_uring failed", K(ret), K(fd), K(errno), KERRMSG);
+  } else {
+    fixed_fd_ = fd;
+  }
+#else
+  UNUSED(fd);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int ObIOUring::push_sqe(const uint8_t opcode, const int fd, const void *buf, const size_t count,
+                        const int64_t offset, const uint64_t user_data)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  ObSpinLockGuard guard(sq_lock_);
+  // only submitters write sq tail, and kernel only moves sq head
+  const uint32_t tail = *sq_tail_;
+  const uint32_t head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+  if (tail - head >= sq_entries_) {
+    ret = OB_EAGAIN;
+  } else {
+    const uint32_t idx = tail & *sq_mask_;
+    struct io_uring_sqe *sqe = static_cast<struct io_uring_sqe *>(sqes_) + idx;
+    MEMSET(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    if (fd >= 0 && fd == fixed_fd_) {
+      sqe->fd = 0; // index in registered files
+      sqe->flags |= IOSQE_FIXED_FILE;
+    } else {
+      sqe->fd = fd;
+    }
+    sqe->addr = reinterpret_cast<uint64_t>(buf);
+    sqe->len = static_cast<uint32_t>(count);
+    sqe->off = static_cast<uint64_t>(offset);
+    sqe->user_data = user_data;
+    sq_array_[idx] = idx;
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    ATOMIC_INC(&pending_cnt_);
+  }
+#else
+  UNUSEDx(opcode, fd, buf, count, offset, user_data);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+// Submitters may arrive while another thread is inside io_uring_enter. They just leave their
+// sqes in the ring, and the thread holding submit_lock_ checks pending_cnt_ again after unlock,
+// so the sqes pushed before its unlock are submitted by itself or by the next lock holder.
+int ObIOUring::flush_pending()
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  while (OB_SUCC(ret) && ATOMIC_LOAD(&pending_cnt_) > 0 && OB_SUCCESS == submit_lock_.trylock()) {
+    const int64_t to_submit = ATOMIC_LOAD(&pending_cnt_);
+    int sys_ret = 0;
+    while ((sys_ret = sys_io_uring_enter(ring_fd_, static_cast<uint32_t>(to_submit), 0, 0)) < 0
+           && EINTR == errno);
+    if (sys_ret < 0) {
+      // the sqes stay in ring and will be submitted by the next flush
+      ret = (EAGAIN == errno || EBUSY == errno) ? OB_EAGAIN : OB_IO_ERROR;
+      SHARE_LOG(WARN, "io_uring_enter submit failed", K(ret), K(to_submit), K(errno), KERRMSG);
+    } else {
+      ATOMIC_SAF(&pending_cnt_, sys_ret);
+    }
+    submit_lock_.unlock();
+  }
+#endif
+  return ret;
+}
+
+int ObIOUring::submit_read(const int fd, void *buf, const size_t count, const int64_t offset, void *data)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    SHARE_LOG(WARN, "not init", K(ret));
+  } else if (OB_FAIL(push_sqe(IORING_OP_READ, fd, buf, count, offset, reinterpret_cast<uint64_t>(data)))) {
+    SHARE_LOG(WARN, "push read sqe failed", K(ret), K(fd), K(count), K(offset));
+  } else {
+    // the sqe is already in ring, a failed flush will be retried by later submit or reap
+    flush_pending();
+  }
+#else
+  UNUSEDx(fd, buf, count, offset, data);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int ObIOUring::submit_write(const int fd, const void *buf, const size_t count, const int64_t offset, void *data)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    SHARE_LOG(WARN, "not init", K(ret));
+  } else if (OB_FAIL(push_sqe(IORING_OP_WRITE, fd, buf, count, offset, reinterpret_cast<uint64_t>(data)))) {
+    SHARE_LOG(WARN, "push write sqe failed", K(ret), K(fd), K(count), K(offset));
+  } else {
+    flush_pending();
+  }
+#else
+  UNUSEDx(fd, buf, count, offset, data);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int64_t ObIOUring::peek_events(ObIOUringEvent *events, const int64_t max_cnt)
+{
+  int64_t cnt = 0;
+#ifdef OB_HAS_IO_URING
+  uint32_t head = *cq_head_;
+  const uint32_t tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+  while (head != tail && cnt < max_cnt) {
+    const struct io_uring_cqe *cqe = static_cast<const struct io_uring_cqe *>(cqes_) + (head & *cq_mask_);
+    if (TIMEOUT_USER_DATA == cqe->user_data) {
+      timeout_armed_ = false;
+    } else {
+      events[cnt].data_ = reinterpret_cast<void *>(cqe->user_data);
+      events[cnt].res_ = cqe->res;
+      ++cnt;
+    }
+    ++head;
+  }
+  __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+#else
+  UNUSEDx(events, max_cnt);
+#endif
+  return cnt;
+}
+
+int ObIOUring::wait_events(const struct timespec *timeout)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  // IORING_ENTER_EXT_ARG needs linux 5.11, use a timeout sqe to bound the waiting instead
+  if (!timeout_armed_ && nullptr != timeout) {
+    timeout_ts_.tv_sec = timeout->tv_sec;
+    timeout_ts_.tv_nsec = timeout->tv_nsec;
+    if (OB_FAIL(push_sqe(IORING_OP_TIMEOUT, -1, &timeout_ts_, 1, 0, TIMEOUT_USER_DATA))) {
+      SHARE_LOG(WARN, "push timeout sqe failed", K(ret));
+    } else {
+      timeout_armed_ = true;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    flush_pending(); // ignore ret
+    int sys_ret = 0;
+    if ((sys_ret = sys_io_uring_enter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS)) < 0 && EINTR != errno) {
+      ret = OB_IO_ERROR;
+      SHARE_LOG(WARN, "io_uring_enter wait failed", K(ret), K(errno), KERRMSG);
+    }
+  }
+#else
+  UNUSED(timeout);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int ObIOUring::reap(ObIOUringEvent *events,
+                    const int64_t max_cnt,
+                    const int64_t min_nr,
+                    const int64_t polling_us,
+                    const struct timespec *timeout,
+                    int64_t &complete_cnt)
+{
+  int ret = OB_SUCCESS;
+  complete_cnt = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    SHARE_LOG(WARN, "not init", K(ret));
+  } else if (OB_ISNULL(events) || OB_UNLIKELY(max_cnt <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "invalid argument", K(ret), KP(events), K(max_cnt));
+  } else {
+    // the sqes left by failed flush of submitters are submitted here
+    flush_pending();
+    complete_cnt = peek_events(events, max_cnt);
+    if (0 == complete_cnt && min_nr > 0 && polling_us > 0) {
+      const int64_t end_ts = ObTimeUtility::fast_current_time() + polling_us;
+      while (0 == complete_cnt && ObTimeUtility::fast_current_time() < end_ts) {
+        PAUSE();
+        complete_cnt = peek_events(events, max_cnt);
+      }
+    }
+    if (0 == complete_cnt && min_nr > 0) {
+      if (OB_FAIL(wait_events(timeout))) {
+        SHARE_LOG(WARN, "wait io_uring events failed", K(ret));
+      } else {
+        complete_cnt = peek_events(events, max_cnt);
+      }
+    }
+  }
+  return ret;
+}
+
+} /* namespace share */
+} /* namespace oceanbase */
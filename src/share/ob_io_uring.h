@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef SRC_SHARE_OB_IO_URING_H_
+#define SRC_SHARE_OB_IO_URING_H_
+
+#include <time.h>
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase {
+namespace share {
+
+struct ObIOUringEvent
+{
+  ObIOUringEvent() : data_(nullptr), res_(0) {}
+  TO_STRING_KV(KP_(data), K_(res));
+  void *data_;
+  int64_t res_; // complete bytes, or -errno when failed
+};
+
+/**
+ * A minimal io_uring ring driven by raw syscalls, so that no liburing dependency is needed.
+ *
+ * Submission: any thread can push sqes. After pushing, the thread which gets submit_lock_
+ * submits all pending sqes by one io_uring_enter, so concurrent submitters are batched.
+ * Completion: only one thread reaps the cq ring. It reads cqes from the shared ring without
+ * syscall, optionally spins for a while, and then waits in kernel with a timeout sqe.
+ */
+class ObIOUring final
+{
+public:
+  ObIOUring();
+  ~ObIOUring();
+  static bool is_supported();
+  int init(const uint32_t entries);
+  void destroy();
+  // register fd as fixed file, the sqes on this fd skip the fget/fput of kernel
+  int register_file(const int fd);
+  int submit_read(const int fd, void *buf, const size_t count, const int64_t offset, void *data);
+  int submit_write(const int fd, const void *buf, const size_t count, const int64_t offset, void *data);
+  // reap at most max_cnt events. if no event is completed, spin for polling_us first,
+  // and then wait in kernel at most timeout when min_nr > 0
+  int reap(ObIOUringEvent *events,
+           const int64_t max_cnt,
+           const int64_t min_nr,
+           const int64_t polling_us,
+           const struct timespec *timeout,
+           int64_t &complete_cnt);
+  bool is_inited() const { return is_inited_; }
+  TO_STRING_KV(K_(is_inited), K_(ring_fd), K_(sq_entries), K_(cq_entries), K_(fixed_fd),
+               K_(pending_cnt), K_(timeout_armed));
+
+private:
+  struct KernelTimespec
+  {
+    int64_t tv_sec;
+    long long tv_nsec;
+  };
+  static const uint64_t TIMEOUT_USER_DATA = UINT64_MAX;
+  int push_sqe(const uint8_t opcode, const int fd, const void *buf, const size_t count,
+               const int64_t offset, const uint64_t user_data);
+  int flush_pending();
+  int64_t peek_events(ObIOUringEvent *events, const int64_t max_cnt);
+  int wait_events(const struct timespec *timeout);
+  int map_rings(const void *params);
+  void unmap_rings();
+
+private:
+  bool is_inited_;
+  int ring_fd_;
+  int fixed_fd_;
+  uint32_t sq_entries_;
+  uint32_t cq_entries_;
+  // sq ring
+  void *sq_ring_ptr_;
+  int64_t sq_ring_size_;
+  uint32_t *sq_head_;
+  uint32_t *sq_tail_;
+  uint32_t *sq_mask_;
+  uint32_t *sq_array_;
+  void *sqes_; // struct io_uring_sqe array
+  int64_t sqes_size_;
+  // cq ring
+  void *cq_ring_ptr_;
+  int64_t cq_ring_size_;
+  uint32_t *cq_head_;
+  uint32_t *cq_tail_;
+  uint32_t *cq_mask_;
+  void *cqes_; // struct io_uring_cqe array
+  common::ObSpinLock sq_lock_;
+  common::ObSpinLock submit_lock_;
+  int64_t pending_cnt_;
+  // only accessed by the reaping thread
+  bool timeout_armed_;
+  KernelTimespec timeout_ts_;
+  DISALLOW_COPY_AND_ASSIGN(ObIOUring);
+};
+
+} /* namespace share */
+} /* namespace oceanbase */
+
+#endif /* SRC_SHARE_OB_IO_URING_H_ */
@@ -1008,11 +1008,15 @@ int ObLocalDevice::io_setup(
     common::ObIOContext *&io_context)
 {
   int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
   void *buf = nullptr;
 
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
     SHARE_LOG(WARN, "The ObLocalDevice has not been inited, ", K(ret));
+  } else if (GCONF._enable_io_uring
+             && OB_SUCCESS == (tmp_ret = io_uring_setup(max_events, io_context))) {
+    // use io_uring, fall back to libaio if io_uring is not available
   } else if (OB_ISNULL(buf = allocator_.alloc(sizeof(ObLocalIOContext)))) {
     ret = OB_ALLOCATE_MEMORY_FAILED;
     SHARE_LOG(WARN, "Fail to allocate memory, ", K(ret));
@@ -1038,6 +1042,7 @@ int ObLocalDevice::io_destroy(common::ObIOContext *io_context)
 {
   int ret = OB_SUCCESS;
   ObLocalIOContext *local_io_context = nullptr;
+  ObLocalIOUringContext *uring_context = nullptr;
 
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
@@ -1045,6 +1050,8 @@ int ObLocalDevice::io_destroy(common::ObIOContext *io_context)
   } else if (OB_ISNULL(io_context)) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid argument, ", KP(io_context));
+  } else if (nullptr != (uring_context = dynamic_cast<ObLocalIOUringContext*> (io_context))) {
+    ret = io_uring_destroy(uring_context);
   } else if (OB_ISNULL(local_io_context = dynamic_cast<ObLocalIOContext*> (io_context))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid io context pointer, ", K(ret), KP(io_context));
@@ -1136,6 +1143,7 @@ int ObLocalDevice::io_submit(
   int ret = OB_SUCCESS;
   ObLocalIOContext *local_io_context = nullptr;
   ObLocalIOCB *local_iocb = nullptr;
+  ObLocalIOUringContext *uring_context = nullptr;
   struct iocb *iocbp = nullptr;
 
   if (OB_UNLIKELY(!is_inited_)) {
@@ -1147,6 +1155,8 @@ int ObLocalDevice::io_submit(
   } else if (OB_ISNULL(local_iocb = dynamic_cast<ObLocalIOCB*> (iocb))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid iocb pointer, ", K(ret), KP(iocb));
+  } else if (nullptr != (uring_context = dynamic_cast<ObLocalIOUringContext*> (io_context))) {
+    ret = io_uring_submit(uring_context, local_iocb);
   } else if (OB_ISNULL(local_io_context = dynamic_cast<ObLocalIOContext*> (io_context))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid io context pointer, ", K(ret), KP(io_context));
@@ -1179,6 +1189,10 @@ int ObLocalDevice::io_cancel(
   } else if (OB_ISNULL(local_iocb = dynamic_cast<ObLocalIOCB*> (iocb))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid iocb pointer, ", K(ret), KP(iocb));
+  } else if (nullptr != dynamic_cast<ObLocalIOUringContext*> (io_context)) {
+    // same as the kernel without aio cancel support, the request returns by io_getevents
+    ret = OB_NOT_SUPPORTED;
+    SHARE_LOG(DEBUG, "io_uring doesn't support cancel", K(ret), KP(iocb));
   } else if (OB_ISNULL(local_io_context = dynamic_cast<ObLocalIOContext*> (io_context))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid io context pointer, ", K(ret), KP(io_context));
@@ -1201,6 +1215,7 @@ int ObLocalDevice::io_getevents(
   int ret = OB_SUCCESS;
   ObLocalIOContext *local_io_context = nullptr;
   ObLocalIOEvents *local_io_events = nullptr;
+  ObLocalIOUringContext *uring_context = nullptr;
 
   if (OB_UNLIKELY(!is_inited_)) {
     ret = OB_NOT_INIT;
@@ -1211,6 +1226,8 @@ int ObLocalDevice::io_getevents(
   } else if (OB_ISNULL(local_io_events = dynamic_cast<ObLocalIOEvents*> (events))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid io events pointer, ", K(ret), KP(events));
+  } else if (nullptr != (uring_context = dynamic_cast<ObLocalIOUringContext*> (io_context))) {
+    ret = io_uring_getevents(uring_context, min_nr, local_io_events, timeout);
   } else if (OB_ISNULL(local_io_context = dynamic_cast<ObLocalIOContext*> (io_context))) {
     ret = OB_INVALID_ARGUMENT;
     SHARE_LOG(WARN, "Invalid io context pointer, ", K(ret), KP(io_context));
@@ -1232,6 +1249,103 @@ int ObLocalDevice::io_getevents(
   return ret;
 }
 
+int ObLocalDevice::io_uring_setup(const uint32_t max_events, common::ObIOContext *&io_context)
+{
+  int ret = OB_SUCCESS;
+  void *buf = nullptr;
+  ObLocalIOUringContext *uring_context = nullptr;
+  // leave room for the timeout sqe of io_getevents
+  const uint32_t ring_entries = max_events * 2;
+  const int64_t alloc_size = sizeof(ObLocalIOUringContext) + max_events * sizeof(ObIOUringEvent);
+
+  if (OB_UNLIKELY(!ObIOUring::is_supported())) {
+    ret = OB_NOT_SUPPORTED;
+    SHARE_LOG(WARN, "io_uring is not supported, use libaio instead", K(ret));
+  } else if (OB_ISNULL(buf = allocator_.alloc(alloc_size))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    SHARE_LOG(WARN, "Fail to allocate memory, ", K(ret), K(alloc_size));
+  } else {
+    uring_context = new (buf) ObLocalIOUringContext();
+    uring_context->events_ = new (static_cast<char *>(buf) + sizeof(ObLocalIOUringContext))
+        ObIOUringEvent[max_events];
+    uring_context->max_event_cnt_ = max_events;
+    uring_context->polling_us_ = GCONF._io_uring_polling_time;
+    if (OB_FAIL(uring_context->ring_.init(ring_entries))) {
+      SHARE_LOG(WARN, "Fail to init io_uring, use libaio instead", K(ret), K(ring_entries));
+    } else if (block_fd_ > 0 && OB_SUCCESS != uring_context->ring_.register_file(block_fd_)) {
+      // ignore ret, the block file is still accessible without fixed file
+      SHARE_LOG(WARN, "Fail to register block file to io_uring", K(block_fd_));
+    }
+    if (OB_SUCC(ret)) {
+      io_context = uring_context;
+      SHARE_LOG(INFO, "Succeed to setup io_uring context", K(max_events), K(uring_context->ring_),
+                K(uring_context->polling_us_));
+    }
+  }
+
+  if (OB_FAIL(ret) && nullptr != buf) {
+    uring_context->~ObLocalIOUringContext();
+    allocator_.free(buf);
+  }
+  return ret;
+}
+
+int ObLocalDevice::io_uring_destroy(ObLocalIOUringContext *io_context)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(io_context)) {
+    ret = OB_INVALID_ARGUMENT;
+    SHARE_LOG(WARN, "Invalid argument, ", K(ret), KP(io_context));
+  } else {
+    io_context->~ObLocalIOUringContext();
+    allocator_.free(io_context);
+  }
+  return ret;
+}
+
+int ObLocalDevice::io_uring_submit(ObLocalIOUringContext *io_context, ObLocalIOCB *iocb)
+{
+  int ret = OB_SUCCESS;
+  const struct iocb &cb = iocb->iocb_;
+  if (IO_CMD_PREAD == cb.aio_lio_opcode) {
+    ret = io_context->ring_.submit_read(cb.aio_fildes, cb.u.c.buf, cb.u.c.nbytes, cb.u.c.offset, cb.data);
+  } else if (IO_CMD_PWRITE == cb.aio_lio_opcode) {
+    ret = io_context->ring_.submit_write(cb.aio_fildes, cb.u.c.buf, cb.u.c.nbytes, cb.u.c.offset, cb.data);
+  } else {
+    ret = OB_NOT_SUPPORTED;
+    SHARE_LOG(WARN, "Unsupported io opcode", K(ret), K(cb.aio_lio_opcode));
+  }
+  if (OB_FAIL(ret) && OB_EAGAIN != ret) {
+    SHARE_LOG(WARN, "Fail to submit io_uring request, ", K(ret), K(cb.aio_fildes), K(cb.u.c.nbytes));
+  }
+  return ret;
+}
+
+int ObLocalDevice::io_uring_getevents(
+    ObLocalIOUringContext *io_context,
+    int64_t min_nr,
+    ObLocalIOEvents *events,
+    struct timespec *timeout)
+{
+  int ret = OB_SUCCESS;
+  int64_t complete_cnt = 0;
+  const int64_t max_cnt = std::min(io_context->max_event_cnt_, events->max_event_cnt_);
+  if (OB_FAIL(io_context->ring_.reap(io_context->events_, max_cnt, min_nr,
+                                     io_context->polling_us_, timeout, complete_cnt))) {
+    SHARE_LOG(WARN, "Fail to get io_uring events, ", K(ret));
+  } else {
+    for (int64_t i = 0; i < complete_cnt; ++i) {
+      struct io_event &event = events->io_events_[i];
+      event.data = io_context->events_[i].data_;
+      event.obj = nullptr;
+      event.res = io_context->events_[i].res_;
+      event.res2 = 0;
+    }
+    events->complete_io_cnt_ = complete_cnt;
+  }
+  return ret;
+}
+
 common::ObIOCB* ObLocalDevice::alloc_iocb()
 {
   ObLocalIOCB *iocb = nullptr;
@@ -16,6 +16,7 @@
 #include <libaio.h>
 #include "lib/allocator/ob_fifo_allocator.h"
 #include "common/storage/ob_io_device.h"
+#include "share/ob_io_uring.h"
 
 namespace oceanbase {
 namespace share {
@@ -42,6 +43,20 @@ private:
   io_context_t io_context_;
 };
 
+// io context of io_uring backend, enabled by _enable_io_uring
+class ObLocalIOUringContext : public common::ObIOContext
+{
+public:
+  ObLocalIOUringContext() : ring_(), events_(nullptr), max_event_cnt_(0), polling_us_(0) {}
+  virtual ~ObLocalIOUringContext() {}
+private:
+  friend class ObLocalDevice;
+  ObIOUring ring_;
+  ObIOUringEvent *events_;
+  int64_t max_event_cnt_;
+  int64_t polling_us_;
+};
+
 class ObLocalIOEvents : public common::ObIOEvents
 {
 public:
@@ -191,6 +206,14 @@ private:
   static int pread_impl(const int64_t fd, void *buf, const int64_t size, const int64_t offset, int64_t &read_size);
   static int pwrite_impl(const int64_t fd, const void *buf, const int64_t size, const int64_t offset, int64_t &write_size);
   static int convert_sys_errno();
+  int io_uring_setup(const uint32_t max_events, common::ObIOContext *&io_context);
+  int io_uring_destroy(ObLocalIOUringContext *io_context);
+  int io_uring_submit(ObLocalIOUringContext *io_context, ObLocalIOCB *iocb);
+  int io_uring_getevents(
+    ObLocalIOUringContext *io_context,
+    int64_t min_nr,
+    ObLocalIOEvents *events,
+    struct timespec *timeout);
 private:
   static const int64_t DEFUALT_PRE_ALLOCATED_IOCB_COUNT = 32 * 512;// 32 thread * max_io_depth
 
@@ -211,6 +211,14 @@ DEF_CAP(cache_wash_threshold, OB_CLUSTER_PARAMETER, "4GB", "[0B,]",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_CAP(memory_chunk_cache_size, OB_CLUSTER_PARAMETER, "0M", "[0M,]", "the maximum size of memory cached by memory chunk cache. Range: [0M,], 0 stands for adaptive",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_CAP(_malloc_thread_cache_size, OB_CLUSTER_PARAMETER, "0", "[0,16M]",
+        "the maximum size of small objects cached by each thread in front of ob_malloc. "
+        "Range: [0, 16M], 0 stands for disabled",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_exec_page_cache, OB_CLUSTER_PARAMETER, "True",
+         "specifies whether tenant workers keep the pages of sql execution arenas for the next "
+         "query instead of giving them back to ob_malloc",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_TIME(autoinc_cache_refresh_interval, OB_CLUSTER_PARAMETER, "3600s", "[100ms,]",
          "auto-increment service cache refresh sync_value in this interval, "
          "with default 3600s. Range: [100ms, +∞)",
@@ -287,6 +295,22 @@ DEF_INT(_ob_max_thread_num, OB_CLUSTER_PARAMETER, "0", "[0,10000)",
          "ob max thread number "
          "upper limit of observer thread count. Range: [0, 10000), 0 means no limit.",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_ob_worker_coroutine_cnt, OB_CLUSTER_PARAMETER, "0", "[0,64]",
+        "the number of coroutines each normal tenant worker runs requests on. A request waiting "
+        "for transaction commit, gts or retry gives the worker to other coroutines instead of "
+        "blocking the thread. 0 means disable. Range: [0, 64]",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_CAP(_ob_worker_coroutine_stack_size, OB_CLUSTER_PARAMETER, "512K", "[256K, 20M]",
+        "the stack size of each worker coroutine. Range: [256K, 20M]",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_BOOL(_enable_tenant_worker_local_queue, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether normal priority requests are queued per tenant worker and stolen by "
+         "idle workers, instead of one queue shared by all workers of the tenant",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_numa_aware_tenant, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether to bind threads and memory of a tenant to one numa node chosen when "
+         "the tenant is created on this server. Tenants created before it's turned on are not bound",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_DBL(cpu_quota_concurrency, OB_TENANT_PARAMETER, "4", "[1,10]",
         "max allowed concurrency for 1 CPU quota. Range: [1,10]",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -372,6 +396,36 @@ DEF_BOOL(_px_message_compression, OB_TENANT_PARAMETER, "True",
         "Enable DTL send message with compression"
         "Value: True: enable compression False: disable compression",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_px_message_columnar_format, OB_TENANT_PARAMETER, "False",
+        "Enable DTL send datum row message between servers in columnar format, "
+        "all the servers should support it before enabling. "
+        "Value: True: enable columnar format False: disable columnar format",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(_px_message_columnar_compress_func, OB_TENANT_PARAMETER, "lz4_1.0",
+        common::ObConfigCompressFuncChecker,
+        "compressor used for DTL message in columnar format. "
+        "Values: none, lz4_1.0, snappy_1.0, zlib_1.0, zstd_1.0, zstd_1.3.8",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_px_local_channel_zero_copy, OB_TENANT_PARAMETER, "False",
+        "Enable DTL local channel write datum rows with pointers, "
+        "the receiver reads rows in the sent buffer without swizzling. "
+        "Value: True: enable False: disable",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_px_granule_largest_first, OB_TENANT_PARAMETER, "True",
+        "Enable PX partition granule tasks to be handed out in the order of estimated "
+        "partition size, the largest first, to reduce the tail of skewed partitions. "
+        "Value: True: enable False: disable",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_px_join_filter_range_in_list, OB_TENANT_PARAMETER, "True",
+        "Enable PX join filter to collect the min/max range of integer join keys "
+        "and an exact in-list of join key hash values besides the bloom filter. "
+        "Value: True: enable False: disable",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_px_adaptive_dop_rows_per_worker, OB_TENANT_PARAMETER, "0", "[0,)",
+        "when a PX DFO is about to be scheduled and its input DFOs have already finished, "
+        "shrink its worker count to the actual input rows divided by this value. "
+        "0 means disable adaptive dop",
+        ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_px_chunklist_count_ratio, OB_CLUSTER_PARAMETER, "1", "[1, 128]",
         "the ratio of the dtl buffer manager list. Range: [1, 128]",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -708,6 +762,22 @@ DEF_INT(bf_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "bf cache priority
 DEF_INT(bf_cache_miss_count_threshold, OB_CLUSTER_PARAMETER, "100", "[0,)", "bf cache miss count threshold, 0 means disable bf cache. Range:[0, )",
         ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(fuse_row_cache_priority, OB_CLUSTER_PARAMETER, "1", "[1,)", "fuse row cache priority. Range:[1, )", ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_kvcache_priority_class, OB_TENANT_PARAMETER, "1", "[0,2]",
+        "priority class of the tenant's kvcache, caches of a higher class are washed later "
+        "when memory is short. 0: low, 1: normal, 2: high. Range:[0, 2]",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_CAP(_index_block_cache_reserved_size, OB_TENANT_PARAMETER, "0M", "[0M,)",
+        "memory of the tenant's index block cache that is kept against wash. Range:[0M, )",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_CAP(_user_block_cache_reserved_size, OB_TENANT_PARAMETER, "0M", "[0M,)",
+        "memory of the tenant's user block cache that is kept against wash. Range:[0M, )",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_CAP(_user_row_cache_reserved_size, OB_TENANT_PARAMETER, "0M", "[0M,)",
+        "memory of the tenant's user row cache that is kept against wash. Range:[0M, )",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_CAP(_bf_cache_reserved_size, OB_TENANT_PARAMETER, "0M", "[0M,)",
+        "memory of the tenant's bloom filter cache that is kept against wash. Range:[0M, )",
+        ObParameterAttr(Section::CACHE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 //background limit config
 DEF_TIME(_data_storage_io_timeout, OB_CLUSTER_PARAMETER, "120s", "[5s,600s]",
@@ -741,6 +811,25 @@ DEF_STR(io_category_config, OB_TENANT_PARAMETER, "other: 100,100,100",
 DEF_INT(_large_query_io_percentage, OB_CLUSTER_PARAMETER, "0", "[0,100]",
         "the max percentage of io resource for big query. Range: [0,100] in integer. Especially, 0 means unlimited. The default value is 0.",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_io_deadline_schedule, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether io scheduler dispatches the request which is close to its target latency first, "
+         "among the requests within mclock limitation. "
+         "Value: True:turned on;  False: turned off",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_io_uring, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether the local device submits async io by io_uring instead of libaio, "
+         "fall back to libaio if io_uring is not supported by the kernel. "
+         "Value: True:turned on;  False: turned off",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_TIME(_io_uring_polling_time, OB_CLUSTER_PARAMETER, "0us", "[0us, 1ms]",
+         "the time that io channel busy polls the io_uring completion queue before waiting in kernel. "
+         "Range: [0us, 1ms]. 0 means no polling",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_BOOL(_enable_numa_aware_io_sender, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether io sender threads are bound to numa nodes, "
+         "and io requests are dispatched to the senders of the local numa node. "
+         "Value: True:turned on;  False: turned off",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 
 DEF_BOOL(_enable_parallel_minor_merge, OB_TENANT_PARAMETER, "True",
          "specifies whether enable parallel minor merge. "
@@ -1000,6 +1089,23 @@ DEF_BOOL(ob_enable_batched_multi_statement, OB_TENANT_PARAMETER, "False",
 DEF_BOOL(_enable_dist_data_access_service, OB_TENANT_PARAMETER, "True",
          "enable use das service",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_das_remote_task_batch_size, OB_TENANT_PARAMETER, "0", "[0, 1024]",
+        "the max number of remote DAS scan tasks merged into one RPC to the same server. "
+        "Remote DAS scan tasks of one operator are sent with asynchronous RPCs and executed "
+        "concurrently with local tasks. 0 means send and wait remote DAS tasks one by one. "
+        "All the servers should support batched DAS RPCs before enabling. "
+        "Range: [0, 1024]",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_das_group_scan_range_sort, OB_TENANT_PARAMETER, "False",
+         "Enable DAS group scan of batched nested loop join to sort and deduplicate the scan "
+         "ranges of a parameter batch by key, and restore the group order of the output rows. "
+         "Value: True: enable False: disable",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_vectorized_result_encoding, OB_TENANT_PARAMETER, "False",
+         "Enable MySQL result rows of vectorized plans to be encoded directly from the datums "
+         "of output expressions, without converting them to ObObj rows first. "
+         "Value: True: enable False: disable",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_INT(_bloom_filter_ratio, OB_CLUSTER_PARAMETER, "35", "[0, 100]",
         "the px bloom filter false-positive rate.the default value is 1, range: [0,100]",
@@ -1085,6 +1191,16 @@ DEF_STR_WITH_CHECKER(use_large_pages, OB_CLUSTER_PARAMETER, "false",
                      "used to manage the database's use of large pages, "
                      "values: false, true, only",
                      ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_STR_WITH_CHECKER(_ctx_large_pages, OB_CLUSTER_PARAMETER, "",
+                     common::ObConfigCtxLargePagesChecker,
+                     "large page policy of memory ctx, overrides use_large_pages for the listed ctx. "
+                     "format: CTX_NAME:policy[,CTX_NAME:policy], policy is one of false, true, only, pool. "
+                     "e.g. MEMSTORE_CTX_ID:pool,KVSTORE_CACHE_ID:true",
+                     ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_CAP(_large_page_pool_size, OB_CLUSTER_PARAMETER, "0", "[0M,)",
+        "size of huge page memory reserved when server starts for ctx with large page policy pool, "
+        "1GB pages are used if possible. 0 means no reservation. Range: [0, +∞)",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 
 DEF_STR(ob_ssl_invited_common_names, OB_TENANT_PARAMETER, "NONE",
         "when server use ssl, use it to control client identity with ssl subject common name. default NONE",
@@ -1257,6 +1373,20 @@ DEF_BOOL(_enable_new_sql_nio, OB_CLUSTER_PARAMETER, "false",
 "specifies whether SQL serial network is turned on. Turned on to support mysql_send_long_data"
 "The default value is FALSE. Value: TRUE: turned on FALSE: turned off",
 ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+DEF_CAP(_sql_pipeline_response_coalesce_size, OB_CLUSTER_PARAMETER, "0", "[0, 16M]",
+        "when the client pipelines requests on one connection, the responses of the requests which "
+        "have already been followed by another request are coalesced up to this size and written "
+        "to the socket together. Only works with the new sql nio. 0 means disable. Range: [0, 16M]",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_mysql_compress_protocol, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether the server advertises the mysql compressed protocol (zlib and zstd) "
+         "in handshake, so that clients connecting directly can use it. "
+         "The default value is FALSE. Value: TRUE: turned on FALSE: turned off",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_mysql_zstd_compress_level, OB_CLUSTER_PARAMETER, "0", "[0, 22]",
+        "the zstd compression level of the mysql compressed protocol. "
+        "0 means to use the level requested by the client. Range: [0, 22]",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 // query response time
 DEF_BOOL(query_response_time_stats, OB_TENANT_PARAMETER, "False",
     "Enable or disable QUERY_RESPONSE_TIME statistics collecting"
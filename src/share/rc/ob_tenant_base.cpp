@@ -13,6 +13,7 @@
 #define USING_LOG_PREFIX SHARE
 #include "lib/thread/thread_mgr.h"
 #include "lib/thread/threads.h"
+#include "lib/cpu/ob_cpu_topology.h"
 #include "share/rc/ob_tenant_base.h"
 #include "share/resource_manager/ob_cgroup_ctrl.h"
 #include "storage/ob_file_system_router.h"
@@ -42,6 +43,7 @@ ObTenantBase::ObTenantBase(const uint64_t id, bool enable_tenant_ctx_check)
     created_(false),
     mtl_init_ctx_(nullptr),
     tenant_role_value_(share::ObTenantRole::Role::PRIMARY_TENANT),
+    numa_node_(-1),
     cgroups_(nullptr),
     enable_tenant_ctx_check_(enable_tenant_ctx_check),
     thread_count_(0)
@@ -57,6 +59,7 @@ ObTenantBase &ObTenantBase::operator=(const ObTenantBase &ctx)
   id_ = ctx.id_;
   mtl_init_ctx_ = ctx.mtl_init_ctx_;
   tenant_role_value_ = ctx.tenant_role_value_;
+  numa_node_ = ctx.numa_node_;
 #define CONSTRUCT_MEMBER_TMP2(IDX) \
   m##IDX##_ = ctx.m##IDX##_;
 #define CONSTRUCT_MEMBER2(UNUSED, IDX) CONSTRUCT_MEMBER_TMP2(IDX)
@@ -270,6 +273,12 @@ int ObTenantBase::pre_run(lib::Threads *th)
   if (cgroup_ctrl != nullptr) {
     ret = cgroup_ctrl->add_thread_to_cgroup(static_cast<pid_t>(syscall(__NR_gettid)), id_);
   }
+  if (numa_node_ >= 0) {
+    int tmp_ret = ObNumaTopology::instance().bind_thread_to_node(numa_node_);
+    if (OB_SUCCESS != tmp_ret) {
+      LOG_WARN("bind tenant thread to numa node failed", K(tmp_ret), K_(id), K_(numa_node));
+    }
+  }
   ATOMIC_INC(&thread_count_);
   LOG_INFO("tenant thread pre_run", K(MTL_ID()), K(ret), K(thread_count_), KP(th));
   return ret;
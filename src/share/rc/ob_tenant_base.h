@@ -361,6 +361,11 @@ public:
     return ATOMIC_LOAD(&tenant_role_value_);
   }
 
+  // numa node which threads of tenant are bound to, -1 means no binding.
+  // must be set before tenant threads start.
+  void set_numa_node(const int64_t node) { numa_node_ = node; }
+  int64_t get_numa_node() const { return numa_node_; }
+
  /**
   * @description:
   *    Only when it is clear that it is a standby/restore tenant, it returns not primary tenant.
@@ -443,6 +448,7 @@ protected:
   bool created_;
   share::ObTenantModuleInitCtx *mtl_init_ctx_;
   share::ObTenantRole::Role tenant_role_value_;
+  int64_t numa_node_;
 
 private:
   common::hash::ObHashSet<int64_t> tg_set_;
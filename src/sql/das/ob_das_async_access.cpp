@@ -0,0 +1,58 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_DAS
+#include "sql/das/ob_das_async_access.h"
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+int ObDASAsyncAccessCB::process()
+{
+  ObThreadCondGuard guard(cond_);
+  int ret = OB_SUCCESS;
+  is_processed_ = true;
+  ret = cond_.broadcast();
+  return ret;
+}
+
+void ObDASAsyncAccessCB::on_invalid()
+{
+  ObThreadCondGuard guard(cond_);
+  int ret = OB_SUCCESS;
+  is_invalid_ = true;
+  ret = cond_.broadcast();
+  LOG_WARN("das async access callback invalid, check object serialization impl or oom",
+           K(trace_id_), K(ret));
+}
+
+void ObDASAsyncAccessCB::on_timeout()
+{
+  ObThreadCondGuard guard(cond_);
+  int ret = OB_SUCCESS;
+  is_timeout_ = true;
+  ret = cond_.broadcast();
+  LOG_WARN("das async access callback timeout, check timeout value, peer cpu load, "
+           "network packet drop rate", K(trace_id_), K(ret));
+}
+
+rpc::frame::ObReqTransport::AsyncCB *ObDASAsyncAccessCB::clone(
+    const rpc::frame::SPAlloc &alloc) const
+{
+  //callback的内存由执行线程管理, 等待所有callback返回后才会释放
+  UNUSED(alloc);
+  return const_cast<rpc::frame::ObReqTransport::AsyncCB *>(
+      static_cast<const rpc::frame::ObReqTransport::AsyncCB *const>(this));
+}
+}  // namespace sql
+}  // namespace oceanbase
@@ -0,0 +1,91 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OBDEV_SRC_SQL_DAS_OB_DAS_ASYNC_ACCESS_H_
+#define OBDEV_SRC_SQL_DAS_OB_DAS_ASYNC_ACCESS_H_
+#include "lib/lock/ob_thread_cond.h"
+#include "lib/profile/ob_trace_id.h"
+#include "sql/das/ob_das_rpc_proxy.h"
+namespace oceanbase
+{
+namespace sql
+{
+//异步发送DAS Task的callback, rpc线程解包完成后通过cond_唤醒等待结果的执行线程
+class ObDASAsyncAccessCB : public obrpc::ObDASRpcProxy::AsyncCB<obrpc::OB_DAS_SYNC_ACCESS>
+{
+public:
+  ObDASAsyncAccessCB(common::ObThreadCond &cond, const common::ObCurTraceId::TraceId &trace_id)
+    : is_processed_(false),
+      is_timeout_(false),
+      is_invalid_(false),
+      is_visited_(false),
+      cond_(cond),
+      trace_id_(trace_id)
+  { }
+  virtual ~ObDASAsyncAccessCB() { }
+  virtual int process() override;
+  virtual void on_invalid() override;
+  virtual void on_timeout() override;
+  virtual rpc::frame::ObReqTransport::AsyncCB *clone(const rpc::frame::SPAlloc &alloc) const override;
+  virtual void set_args(const Request &arg) override { UNUSED(arg); }
+  ObDASTaskResp &get_result() { return result_; }
+  const obrpc::ObRpcResultCode &get_ret_code() const { return rcode_; }
+  //以下状态只能在持有cond_时访问
+  bool is_finished() const { return is_processed_ || is_timeout_ || is_invalid_; }
+  bool is_processed() const { return is_processed_; }
+  bool is_timeout() const { return is_timeout_; }
+  bool is_invalid() const { return is_invalid_; }
+  void set_visited(bool value) { is_visited_ = value; }
+  bool is_visited() const { return is_visited_; }
+  TO_STRING_KV(K_(is_processed), K_(is_timeout), K_(is_invalid), K_(is_visited), K_(rcode));
+private:
+  bool is_processed_;
+  bool is_timeout_;
+  bool is_invalid_;
+  //是否已被执行线程处理过
+  bool is_visited_;
+  common::ObThreadCond &cond_;
+  common::ObCurTraceId::TraceId trace_id_;
+};
+
+//发往同一个server并且使用同一个快照的一批DAS Task, 合并为一次RPC发送
+struct ObDASRemoteTaskBatch
+{
+public:
+  ObDASRemoteTaskBatch()
+    : runner_svr_(),
+      snapshot_(nullptr),
+      task_ops_(),
+      task_size_(0),
+      cb_(nullptr)
+  { }
+  //空的批次总能放下一个task, 否则task数和序列化大小都不能超过上限
+  bool can_add_task(const int64_t task_size, const int64_t batch_size) const
+  {
+    const int64_t task_cnt = task_ops_.count();
+    return task_cnt <= 0
+        || (task_cnt < batch_size
+            && (task_cnt + 1) * das::OB_DAS_MAX_PACKET_SIZE <= das::OB_DAS_MAX_BATCH_PACKET_SIZE
+            && task_size_ + task_size <= das::OB_DAS_MAX_BATCH_PACKET_SIZE);
+  }
+  TO_STRING_KV(K_(runner_svr), "task_cnt", task_ops_.count(), K_(task_size), KPC_(cb));
+  common::ObAddr runner_svr_;
+  transaction::ObTxReadSnapshot *snapshot_;
+  common::ObSEArray<ObIDASTaskOp*, 8> task_ops_;
+  //task_ops_序列化后的总大小
+  int64_t task_size_;
+  //RPC发送成功后才会被设置, 为空表示这一批task没有发出
+  ObDASAsyncAccessCB *cb_;
+};
+}  // namespace sql
+}  // namespace oceanbase
+#endif /* OBDEV_SRC_SQL_DAS_OB_DAS_ASYNC_ACCESS_H_ */
@@ -58,6 +58,12 @@ const int64_t OB_DAS_MAX_PACKET_SIZE = 2 * 1024 * 1024l - 8 * 1024;
  * so OB_DAS_MAX_TOTAL_PACKET_SIZE was defined as:
  */
 const int64_t OB_DAS_MAX_TOTAL_PACKET_SIZE = 3 * OB_DAS_MAX_PACKET_SIZE;
+/**
+ * Every task of a batched remote DAS RPC may fill up to OB_DAS_MAX_PACKET_SIZE of result,
+ * so both the task count and the serialized task size of a batch are bounded by
+ * OB_DAS_MAX_BATCH_PACKET_SIZE to keep the request and the response well below the rpc limit.
+ */
+const int64_t OB_DAS_MAX_BATCH_PACKET_SIZE = 16 * OB_DAS_MAX_PACKET_SIZE;
 }  // namespace das
 
 enum ObDASOpType
@@ -13,6 +13,7 @@
 #define USING_LOG_PREFIX SQL_DAS
 #include "sql/das/ob_das_group_scan_op.h"
 #include "sql/engine/ob_exec_context.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 namespace oceanbase
 {
 using namespace common;
@@ -24,6 +25,9 @@ ObDASGroupScanOp::ObDASGroupScanOp(ObIAllocator &op_alloc)
     group_lookup_op_(NULL),
     iter_(),
     result_iter_(&iter_),
+    sort_iter_(),
+    sort_result_(&sort_iter_),
+    need_sort_ranges_(false),
     is_exec_remote_(false),
     cur_group_idx_(0),
     group_size_(0)
@@ -38,10 +42,22 @@ ObDASGroupScanOp::~ObDASGroupScanOp()
   }
 }
 
+int ObDASGroupScanOp::sort_scan_ranges()
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(sort_iter_.sort_ranges(scan_param_.key_ranges_,
+                                     scan_rtdef_->scan_flag_.is_reverse_scan()))) {
+    LOG_WARN("sort group scan ranges failed", K(ret), K(scan_param_.key_ranges_));
+  }
+  return ret;
+}
+
 int ObDASGroupScanOp::rescan()
 {
   int &ret = errcode_;
-  if (OB_FAIL(ObDASScanOp::rescan())) {
+  if (need_sort_ranges_ && OB_FAIL(sort_scan_ranges())) {
+    LOG_WARN("sort scan ranges failed", K(ret));
+  } else if (OB_FAIL(ObDASScanOp::rescan())) {
     LOG_WARN("rescan the table iterator failed", K(ret));
   } else {
     iter_.init_group_range(cur_group_idx_, group_size_);
@@ -73,6 +89,9 @@ int ObDASGroupScanOp::release_op()
   group_lookup_op_ = NULL;
   iter_.reset();
   result_iter_ = &iter_;
+  sort_iter_.reset();
+  sort_result_ = &sort_iter_;
+  need_sort_ranges_ = false;
   return ret;
 }
 
@@ -82,14 +101,25 @@ int ObDASGroupScanOp::open_op()
   int64_t max_size = scan_rtdef_->eval_ctx_->is_vectorized()
                      ? scan_rtdef_->eval_ctx_->max_batch_size_
                      :1;
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+  need_sort_ranges_ = tenant_config.is_valid() && tenant_config->_enable_das_group_scan_range_sort;
   iter_.init_group_range(cur_group_idx_, group_size_);
-  if (OB_FAIL(iter_.init_row_store(scan_ctdef_->result_output_,
-                                   *scan_rtdef_->eval_ctx_,
-                                   scan_rtdef_->stmt_allocator_,
-                                   max_size,
-                                   scan_ctdef_->group_id_expr_,
-                                   &this->get_scan_result(),
-                                   scan_rtdef_->need_check_output_datum_))) {
+  if (need_sort_ranges_ && !sort_iter_.is_inited()
+      && OB_FAIL(sort_iter_.init(scan_ctdef_->result_output_,
+                                 *scan_rtdef_->eval_ctx_,
+                                 max_size,
+                                 scan_ctdef_->group_id_expr_,
+                                 &result_))) {
+    LOG_WARN("fail to init sort iter", K(ret));
+  } else if (need_sort_ranges_ && OB_FAIL(sort_scan_ranges())) {
+    LOG_WARN("sort scan ranges failed", K(ret));
+  } else if (OB_FAIL(iter_.init_row_store(scan_ctdef_->result_output_,
+                                          *scan_rtdef_->eval_ctx_,
+                                          scan_rtdef_->stmt_allocator_,
+                                          max_size,
+                                          scan_ctdef_->group_id_expr_,
+                                          &this->get_scan_result(),
+                                          scan_rtdef_->need_check_output_datum_))) {
     LOG_WARN("fail to init iter", K(ret));
   } else if (OB_FAIL(ObDASScanOp::open_op())) {
     LOG_WARN("fail to open op", K(ret));
@@ -162,6 +192,9 @@ ObNewRowIterator *ObDASGroupScanOp::get_storage_scan_iter()
   } else { // has lookup
     if (NULL == group_lookup_op_ || NULL == group_lookup_op_->get_rowkey_iter()) {
       iter = NULL;
+    } else if (need_sort_ranges_) {
+      // the input of rowkey iter is sort_iter_, the storage iter is still result_
+      iter = result_;
     } else {
       iter = static_cast<ObGroupScanIter *>(group_lookup_op_->get_rowkey_iter())->get_iter();
     }
@@ -173,7 +206,8 @@ int ObDASGroupScanOp::fill_task_result(ObIDASTaskResult &task_result, bool &has_
 {
   int ret = OB_SUCCESS;
   if (NULL == group_lookup_op_) {
-    result_iter_ = result_;
+    // remote server output rows in group order, local server needn't sort again
+    result_iter_ = need_sort_ranges_ ? sort_result_ : result_;
   } else {
     result_iter_ = group_lookup_op_;
     set_is_exec_remote(true);
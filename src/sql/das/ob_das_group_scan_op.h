@@ -73,9 +73,12 @@ public:
   int fill_task_result(ObIDASTaskResult &task_result, bool &has_more) override;
   void set_is_exec_remote(bool v) { is_exec_remote_ = v; }
   virtual bool need_all_output() override { return is_exec_remote_; }
-  TO_STRING_KV(K(iter_), KP(group_lookup_op_), K(group_size_), K(cur_group_idx_));
+  TO_STRING_KV(K(iter_), KP(group_lookup_op_), K(group_size_), K(cur_group_idx_),
+               K(need_sort_ranges_), K(sort_iter_));
 private:
-  common::ObNewRowIterator *&get_scan_result() { return result_; }
+  common::ObNewRowIterator *&get_scan_result()
+  { return need_sort_ranges_ ? sort_result_ : result_; }
+  int sort_scan_ranges();
   ObNewRowIterator *get_output_result_iter() override
   {
     return result_iter_;
@@ -104,6 +107,12 @@ private:
   //      remote server: result_iter_ is group_lookup_op_ and indicate the group_lookup_op is exec remote
   //                     which will not need switch iter when lookup, and output the result of all group
   ObNewRowIterator *result_iter_;
+  // 开启 range 排序时, 存储层的输出先经过 sort_iter_ 恢复 group 顺序,
+  // 再作为 iter_ 的输入: result_ -> sort_iter_ -> iter_,
+  // sort_result_ 固定指向 sort_iter_, 供 iter_ 持有其地址
+  ObGroupSortedScanIter sort_iter_;
+  ObNewRowIterator *sort_result_;
+  bool need_sort_ranges_;
   bool is_exec_remote_;
   int64_t cur_group_idx_;
   int64_t group_size_;
@@ -19,6 +19,7 @@
 #include "sql/das/ob_das_utils.h"
 #include "storage/tx/ob_trans_service.h"
 #include "sql/engine/ob_exec_context.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 namespace oceanbase
 {
 using namespace common;
@@ -211,12 +212,27 @@ bool ObDASRef::is_all_local_task() const
   return bret;
 }
 
+int64_t ObDASRef::get_remote_task_batch_size() const
+{
+  int64_t batch_size = 0;
+  if (!execute_directly_ && get_das_task_cnt() > 1) {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+    if (tenant_config.is_valid()) {
+      batch_size = tenant_config->_das_remote_task_batch_size;
+    }
+  }
+  return batch_size;
+}
+
 int ObDASRef::execute_all_task()
 {
   int ret = OB_SUCCESS;
-  bool DAS_TASK_AGGREGATION = false;
-  if (DAS_TASK_AGGREGATION) {
-    // TODO(roland.qk): DAS task aggregation.
+  const int64_t batch_size = get_remote_task_batch_size();
+  if (batch_size > 0) {
+    //DAS task aggregation: 发往同一个server的远程task合并发送, 多个RPC同时在途
+    if (OB_FAIL(MTL(ObDataAccessService*)->execute_das_tasks(*this, batch_size))) {
+      LOG_WARN("execute das tasks failed", K(ret));
+    }
   } else {
     DASTaskIter task_iter = begin_task_iter();
     while (OB_SUCC(ret) && !task_iter.is_end()) {
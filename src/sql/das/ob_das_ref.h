@@ -94,6 +94,7 @@ public:
 private:
   DISABLE_COPY_ASSIGN(ObDASRef);
   int create_task_map();
+  int64_t get_remote_task_batch_size() const;
 private:
   typedef common::ObObjNode<ObIDASTaskOp*> DasOpNode;
   //declare das allocator
@@ -40,11 +40,17 @@ int ObDASSyncAccessP::before_process()
   ObDASTaskResp &task_resp = result_;
   ObIDASTaskResult *task_result = nullptr;
   ObMemAttr mem_attr;
-  mem_attr.tenant_id_ = task.get_task_op()->get_tenant_id();
-  mem_attr.label_ = "DASRpcPCtx";
-  exec_ctx_.get_allocator().set_attr(mem_attr);
   ObDASTaskFactory *das_factory = ObDASSyncAccessP::get_das_factory();
-  if (OB_ISNULL(das_factory)) {
+  if (OB_UNLIKELY(task.get_task_ops().empty())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("das task arg is empty", K(ret), K(task));
+  } else {
+    mem_attr.tenant_id_ = task.get_task_ops().at(0)->get_tenant_id();
+    mem_attr.label_ = "DASRpcPCtx";
+    exec_ctx_.get_allocator().set_attr(mem_attr);
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_ISNULL(das_factory)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("das factory is not inited", K(ret));
   } else if (OB_FAIL(ObDASSyncRpcProcessor::before_process())) {
@@ -52,14 +58,19 @@ int ObDASSyncAccessP::before_process()
   } else if (das_remote_info_.need_calc_udf_ &&
       OB_FAIL(GCTX.schema_service_->get_tenant_schema_guard(MTL_ID(), schema_guard_))) {
     LOG_WARN("fail to get schema guard", K(ret));
-  } else if (OB_FAIL(das_factory->create_das_task_result(task.get_task_op()->get_type(),
-                                                         task_result))) {
-    LOG_WARN("create das task result failed", K(ret), K(task));
-  } else if (OB_FAIL(task_result->init(*task.get_task_op()))) {
-    LOG_WARN("init task result failed", K(ret), KPC(task_result), KPC(task.get_task_op()));
-  } else if (OB_FAIL(task_resp.add_op_result(task_result))) {
-    LOG_WARN("failed to add das op result", K(ret), K(*task_result));
-  } else {
+  }
+  //合并发送的每个task都对应一个task result, 顺序与task op一致
+  for (int64_t i = 0; OB_SUCC(ret) && i < task.get_task_ops().count(); ++i) {
+    ObIDASTaskOp *task_op = task.get_task_ops().at(i);
+    if (OB_FAIL(das_factory->create_das_task_result(task_op->get_type(), task_result))) {
+      LOG_WARN("create das task result failed", K(ret), K(task));
+    } else if (OB_FAIL(task_result->init(*task_op))) {
+      LOG_WARN("init task result failed", K(ret), KPC(task_result), KPC(task_op));
+    } else if (OB_FAIL(task_resp.add_op_result(task_result))) {
+      LOG_WARN("failed to add das op result", K(ret), K(*task_result));
+    }
+  }
+  if (OB_SUCC(ret)) {
     exec_ctx_.get_sql_ctx()->schema_guard_ = &schema_guard_;
   }
   return ret;
@@ -72,26 +83,43 @@ int ObDASSyncAccessP::process()
   FLTSpanGuard(das_rpc_process);
   ObDASTaskArg &task = arg_;
   ObDASTaskResp &task_resp = result_;
-  ObIDASTaskOp *task_op = task.get_task_op();
-  ObIDASTaskResult *task_result = task_resp.get_op_result();
-  bool has_more = false;
+  common::ObIArray<ObIDASTaskOp*> &task_ops = task.get_task_ops();
+  common::ObIArray<ObIDASTaskResult*> &task_results = task_resp.get_op_results();
+  const bool is_batched = task_ops.count() > 1;
+  int64_t started_cnt = 0;
   ObDASOpType task_type = DAS_OP_INVALID;
   //regardless of the success of the task execution, the fllowing meta info must be set
-  task_result->set_task_id(task_op->get_task_id());
   task_resp.set_ctrl_svr(task.get_ctrl_svr());
   task_resp.set_runner_svr(task.get_runner_svr());
-  if (OB_ISNULL(task_op) || OB_ISNULL(task_result)) {
+  if (OB_UNLIKELY(task_ops.empty() || task_ops.count() != task_results.count())) {
     ret = OB_ERR_UNEXPECTED;
-    LOG_WARN("task op is nullptr", K(ret), K(task_op), K(task_result));
-  } else if (OB_FAIL(task_op->start_das_task())) {
-    LOG_WARN("start das task failed", K(ret));
-  } else if (OB_FAIL(task_op->fill_task_result(*task_result, has_more))) {
-    LOG_WARN("fill task result to controller failed", K(ret));
-  } else if (OB_UNLIKELY(has_more) && OB_FAIL(task_op->fill_extra_result())) {
-    LOG_WARN("fill extra result to controller failed", KR(ret));
-  } else {
-    task_type = task_op->get_type();
-    task_resp.set_has_more(has_more);
+    LOG_WARN("task op count mismatch", K(ret), K(task_ops.count()), K(task_results.count()));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < task_ops.count(); ++i) {
+    ObIDASTaskOp *task_op = task_ops.at(i);
+    ObIDASTaskResult *task_result = task_results.at(i);
+    bool has_more = false;
+    if (OB_ISNULL(task_op) || OB_ISNULL(task_result)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("task op is nullptr", K(ret), K(task_op), K(task_result));
+    } else if (FALSE_IT(task_result->set_task_id(task_op->get_task_id()))) {
+    } else if (FALSE_IT(++started_cnt)) {
+    } else if (OB_FAIL(task_op->start_das_task())) {
+      LOG_WARN("start das task failed", K(ret));
+    } else if (OB_FAIL(task_op->fill_task_result(*task_result, has_more))) {
+      LOG_WARN("fill task result to controller failed", K(ret));
+    } else if (OB_UNLIKELY(has_more) && OB_FAIL(task_op->fill_extra_result())) {
+      LOG_WARN("fill extra result to controller failed", KR(ret));
+    } else if (!is_batched) {
+      task_resp.set_has_more(has_more);
+    } else if (OB_FAIL(task_resp.set_op_has_more(i, has_more))) {
+      LOG_WARN("set op has more failed", K(ret), K(i));
+    }
+    if (OB_NOT_NULL(task_op)) {
+      task_type = task_op->get_type();
+    }
+  }
+  if (OB_SUCC(ret)) {
     ObWarningBuffer *wb = ob_get_tsi_warning_buffer();
     if (wb != nullptr) {
       //ignore the errcode of storing warning msg
@@ -99,14 +127,18 @@ int ObDASSyncAccessP::process()
     }
   }
   //因为end_task还有可能失败，需要通过RPC将end_task的返回值带回到scheduler上
-  if (OB_NOT_NULL(task_op)) {
-    int tmp_ret = task_op->end_das_task();
-    if (OB_SUCCESS != tmp_ret) {
-      LOG_WARN("end das task failed", K(ret), K(tmp_ret), K(task));
+  if (started_cnt > 0) {
+    ObIDASTaskOp *task_op = task_ops.at(0);
+    for (int64_t i = 0; i < started_cnt; ++i) {
+      int tmp_ret = task_ops.at(i)->end_das_task();
+      if (OB_SUCCESS != tmp_ret) {
+        LOG_WARN("end das task failed", K(ret), K(tmp_ret), K(task));
+      }
+      ret = COVER_SUCC(tmp_ret);
     }
-    ret = COVER_SUCC(tmp_ret);
+    //合并发送的task共享同一个事务上下文, 只需要收集一次事务执行结果
     if (OB_NOT_NULL(task_op->get_trans_desc())) {
-      tmp_ret = MTL(transaction::ObTransService*)
+      int tmp_ret = MTL(transaction::ObTransService*)
         ->get_tx_exec_result(*task_op->get_trans_desc(),
                             task_resp.get_trans_result());
       if (OB_SUCCESS != tmp_ret) {
@@ -118,14 +150,14 @@ int ObDASSyncAccessP::process()
       ret = GSCHEMASERVICE.is_schema_error_need_retry(NULL, task_op->get_tenant_id()) ?
             OB_ERR_REMOTE_SCHEMA_NOT_FULL : OB_ERR_WAIT_REMOTE_SCHEMA_REFRESH;
     }
-    task_resp.set_err_code(ret);
-    if (OB_SUCCESS != ret) {
-      task_resp.store_err_msg(ob_get_tsi_err_msg(ret));
-      LOG_WARN("process das sync access task failed", K(ret),
-              K(task.get_ctrl_svr()), K(task.get_runner_svr()));
-    }
   }
-  LOG_DEBUG("process das sync access task", K(ret), K(task), KPC(task_result), K(has_more));
+  task_resp.set_err_code(ret);
+  if (OB_SUCCESS != ret) {
+    task_resp.store_err_msg(ob_get_tsi_err_msg(ret));
+    LOG_WARN("process das sync access task failed", K(ret),
+            K(task.get_ctrl_svr()), K(task.get_runner_svr()));
+  }
+  LOG_DEBUG("process das sync access task", K(ret), K(task), K(task_resp));
   NG_TRACE_EXT(das_rpc_process_end, OB_ID(type), task_type);
   return OB_SUCCESS;
 }
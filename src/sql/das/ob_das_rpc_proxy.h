@@ -27,6 +27,27 @@ public:
   virtual ~ObDASRpcProxy() {}
   //stream rpc interface
   RPC_S(@PR5 remote_sync_access, obrpc::OB_DAS_SYNC_ACCESS, (sql::ObDASTaskArg), sql::ObDASTaskResp);
+  // async rpc for das task, it shares the pcode and the processor with remote_sync_access,
+  // so that the remote server needs no change to serve pipelined das tasks
+  int remote_async_access(const sql::ObDASTaskArg &args,
+                          AsyncCB<obrpc::OB_DAS_SYNC_ACCESS> *cb,
+                          const ObRpcOpts &opts = ObRpcOpts())
+  {
+    int ret = common::OB_SUCCESS;
+    ObRpcOpts newopts = opts;
+    if (newopts.pr_ == ORPR_UNDEF) {
+      newopts.pr_ = ORPR5;
+    }
+    if (mock_proxy_) {
+      mock_proxy_->set_server(dst_);
+      ret = mock_proxy_->remote_async_access(args, cb, newopts);
+    } else {
+      newopts.ssl_invited_nodes_ = GCONF._ob_ssl_invited_nodes.get_value_string();
+      newopts.local_addr_ = GCTX.self_addr();
+      ret = rpc_post<ObRpc<obrpc::OB_DAS_SYNC_ACCESS>>(args, cb, newopts);
+    }
+    return ret;
+  }
   // sync rpc for das task result
   RPC_S(@PR5 sync_fetch_das_result, obrpc::OB_DAS_SYNC_FETCH_RESULT, (sql::ObDASDataFetchReq), sql::ObDASDataFetchRes);
   // async rpc to erase das task result
@@ -302,9 +302,6 @@ OB_DEF_SERIALIZE_SIZE(ObDASTaskArg)
 
 int ObDASTaskArg::add_task_op(ObIDASTaskOp *task_op)
 {
-  // we currently only support single task per ObDASTaskArg.
-  // TODO(roland.qk):remove this assert check after we enable DAS task aggregation.
-  OB_ASSERT(task_ops_.count() == 0);
   return task_ops_.push_back(task_op);
 }
 
@@ -373,7 +370,8 @@ OB_DEF_SERIALIZE(ObDASTaskResp)
   }
   LST_DO_CODE(OB_UNIS_ENCODE,
               rcode_,
-              trans_result_);
+              trans_result_,
+              op_has_more_);
   return ret;
 }
 
@@ -401,7 +399,8 @@ OB_DEF_DESERIALIZE(ObDASTaskResp)
   }
   LST_DO_CODE(OB_UNIS_DECODE,
               rcode_,
-              trans_result_);
+              trans_result_,
+              op_has_more_);
   return ret;
 }
 
@@ -418,18 +417,32 @@ OB_DEF_SERIALIZE_SIZE(ObDASTaskResp)
   }
   LST_DO_CODE(OB_UNIS_ADD_LEN,
               rcode_,
-              trans_result_);
+              trans_result_,
+              op_has_more_);
   return len;
 }
 
 int ObDASTaskResp::add_op_result(ObIDASTaskResult *op_result)
 {
-  // we currently only support single task per ObDASTaskResp.
-  // TODO(roland.qk):remove this assert check after we enable DAS task aggregation.
-  OB_ASSERT(op_results_.count() == 0);
   return op_results_.push_back(op_result);
 }
 
+int ObDASTaskResp::set_op_has_more(int64_t idx, bool has_more)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(idx < 0 || idx >= op_results_.count())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid op result index", K(ret), K(idx), K(op_results_.count()));
+  } else if (op_has_more_.count() < op_results_.count()
+             && OB_FAIL(op_has_more_.prepare_allocate(op_results_.count()))) {
+    LOG_WARN("prepare allocate has more flags failed", K(ret), K(op_results_.count()));
+  } else {
+    op_has_more_.at(idx) = has_more;
+    has_more_ = has_more_ || has_more;
+  }
+  return ret;
+}
+
 ObIDASTaskResult *ObDASTaskResp::get_op_result()
 {
   OB_ASSERT(op_results_.count() == 1);
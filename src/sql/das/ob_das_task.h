@@ -278,6 +278,8 @@ public:
 
   int add_task_op(ObIDASTaskOp *task_op);
   ObIDASTaskOp *get_task_op();
+  //同一个server上的多个DAS Task可以合并到一个ObDASTaskArg中, 通过一次RPC发送
+  common::ObIArray<ObIDASTaskOp*> &get_task_ops() { return task_ops_; }
   void set_remote_info(ObDASRemoteInfo *remote_info) { remote_info_ = remote_info; }
   ObDASRemoteInfo *get_remote_info() { return remote_info_; }
   common::ObAddr &get_runner_svr() { return runner_svr_; }
@@ -306,6 +308,13 @@ public:
   ObDASTaskResp();
   int add_op_result(ObIDASTaskResult *op_result);
   ObIDASTaskResult *get_op_result();
+  common::ObIArray<ObIDASTaskResult*> &get_op_results() { return op_results_; }
+  //合并发送的多个DAS Task, 每个task是否还有剩余结果需要单独记录
+  int set_op_has_more(int64_t idx, bool has_more);
+  bool op_has_more(int64_t idx) const
+  {
+    return idx < op_has_more_.count() ? op_has_more_.at(idx) : has_more_;
+  }
   void set_err_code(int err_code) { rcode_.rcode_ = err_code; }
   int get_err_code() const { return rcode_.rcode_; }
   const obrpc::ObRpcResultCode &get_rcode() const { return rcode_; }
@@ -322,6 +331,7 @@ public:
                K_(ctrl_svr),
                K_(runner_svr),
                K_(op_results),
+               K_(op_has_more),
                K_(rcode),
                K_(trans_result));
 private:
@@ -331,6 +341,7 @@ private:
   common::ObSEArray<ObIDASTaskResult*, 2> op_results_;  // 对应operation的结果信息，这是一个接口类，具体的定义由DML Service解析
   obrpc::ObRpcResultCode rcode_; //返回的错误信息
   transaction::ObTxExecResult trans_result_;
+  common::ObSEArray<bool, 2> op_has_more_; //与op_results_一一对应, 为空时以has_more_为准
 };
 
 template <typename T>
@@ -295,7 +295,6 @@ int ObDataAccessService::do_remote_das_task(ObDASRef &das_ref, ObDASTaskArg &tas
   uint64_t tenant_id = session->get_rpc_tenant_id();
   ObIDASTaskOp *task_op = task_arg.get_task_op();
   ObIDASTaskResult *op_result = nullptr;
-  ObDASExtraData *extra_result = nullptr;
   ObDASRemoteInfo remote_info;
   remote_info.exec_ctx_ = &das_ref.get_exec_ctx();
   remote_info.frame_info_ = das_ref.get_expr_frame_info();
@@ -307,7 +306,7 @@ int ObDataAccessService::do_remote_das_task(ObDASRef &das_ref, ObDASTaskArg &tas
 
   LOG_DEBUG("begin to do remote das task", K(task_arg));
   SMART_VAR(ObDASTaskResp, task_resp) {
-    if (OB_FAIL(collect_das_task_info(task_arg, remote_info))) {
+    if (OB_FAIL(collect_das_task_info(*task_op, remote_info))) {
       LOG_WARN("collect das task info failed", K(ret));
     } else if (OB_FAIL(das_ref.get_das_factory().create_das_task_result(task_op->get_type(), op_result))) {
       LOG_WARN("create das task result failed", K(ret));
@@ -327,55 +326,334 @@ int ObDataAccessService::do_remote_das_task(ObDASRef &das_ref, ObDASTaskArg &tas
       // RPC fail, add task's LSID to trans_result
       // indicate some transaction participant may touched
       session->get_trans_result().add_touched_ls(task_op->get_ls_id());
+    } else if (OB_FAIL(process_remote_task_resp(das_ref, task_arg.get_task_ops(), task_resp))) {
+      LOG_WARN("process remote das task response failed", K(ret), K(task_arg));
+    }
+  }
+  NG_TRACE_EXT(do_remote_das_task_end, Y(ret), OB_ID(addr), task_arg.get_runner_svr());
+  return ret;
+}
+
+int ObDataAccessService::process_remote_task_resp(ObDASRef &das_ref,
+                                                  ObIArray<ObIDASTaskOp*> &task_ops,
+                                                  ObDASTaskResp &task_resp)
+{
+  int ret = OB_SUCCESS;
+  ObSQLSessionInfo *session = das_ref.get_exec_ctx().get_my_session();
+  ObIArray<ObIDASTaskResult*> &op_results = task_resp.get_op_results();
+  ObDASUtils::log_user_error_and_warn(task_resp.get_rcode());
+  if (OB_FAIL(task_resp.get_err_code())) {
+    LOG_WARN("error occurring in remote das task", K(ret), K(task_resp));
+  } else if (OB_UNLIKELY(task_ops.count() != op_results.count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("das task result count mismatch", K(ret), K(task_ops.count()), K(op_results.count()));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < task_ops.count(); ++i) {
+    ObIDASTaskOp *task_op = task_ops.at(i);
+    ObIDASTaskResult *op_result = op_results.at(i);
+    ObDASExtraData *extra_result = nullptr;
+    if (OB_FAIL(task_op->decode_task_result(op_result))) {
+      LOG_WARN("decode das task result failed", K(ret));
+    } else if (task_resp.op_has_more(i)
+                && OB_FAIL(setup_extra_result(das_ref, task_resp,
+                task_op, extra_result))) {
+      LOG_WARN("setup extra result failed", KR(ret));
+    } else if (task_resp.op_has_more(i) && OB_FAIL(op_result->link_extra_result(*extra_result))) {
+      LOG_WARN("link extra result failed", K(ret));
+    }
+  }
+  if (OB_NOT_NULL(session->get_tx_desc())) {
+    int tmp_ret = MTL(transaction::ObTransService*)
+      ->add_tx_exec_result(*session->get_tx_desc(),
+                            task_resp.get_trans_result());
+    if (tmp_ret != OB_SUCCESS) {
+      LOG_WARN("merge response partition failed", K(ret), K(tmp_ret), K(task_resp));
+    }
+    ret = COVER_SUCC(tmp_ret);
+  }
+  return ret;
+}
+
+int ObDataAccessService::execute_das_tasks(ObDASRef &das_ref, const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  ObArenaAllocator allocator("DASAsyncRpc", OB_MALLOC_NORMAL_BLOCK_SIZE, MTL_ID());
+  ObSEArray<ObDASRemoteTaskBatch*, 4> batches;
+  ObSEArray<ObIDASTaskOp*, 8> other_tasks;
+  ObThreadCond cond;
+  //无法通过集群版本区分对端是否支持合并的RPC, 因此_das_remote_task_batch_size默认为0,
+  //此时每个task单独发送, 全部server升级后再打开
+  if (OB_FAIL(cond.init(ObWaitEventIds::DEFAULT_COND_WAIT))) {
+    LOG_WARN("init thread cond failed", K(ret));
+  }
+  DASTaskIter task_iter = das_ref.begin_task_iter();
+  for (; OB_SUCC(ret) && !task_iter.is_end(); ++task_iter) {
+    ObIDASTaskOp *task_op = *task_iter;
+    //只有只读的scan task可以并发执行, DML task仍然按顺序逐个执行
+    if (DAS_OP_TABLE_SCAN == task_op->get_type()
+        && task_op->get_tablet_loc()->server_ != ctrl_addr_) {
+      if (OB_FAIL(add_remote_task_to_batch(allocator, batches, *task_op,
+                                           task_op->get_serialize_size(), batch_size))) {
+        LOG_WARN("add remote task to batch failed", K(ret));
+      }
+    } else if (OB_FAIL(other_tasks.push_back(task_op))) {
+      LOG_WARN("store das task failed", K(ret));
+    }
+  }
+  //先发出所有远程task, 再执行本地task, 用本地执行掩盖RPC的等待时间
+  for (int64_t i = 0; OB_SUCC(ret) && i < batches.count(); ++i) {
+    if (OB_FAIL(launch_remote_task_batch(das_ref, allocator, cond, *batches.at(i)))) {
+      LOG_WARN("launch remote task batch failed", K(ret), KPC(batches.at(i)));
+    }
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < other_tasks.count(); ++i) {
+    if (OB_FAIL(execute_das_task(das_ref, *other_tasks.at(i)))) {
+      LOG_WARN("execute das task failed", K(ret));
+    }
+  }
+  //不论执行成功与否, 都要等已发出的RPC全部返回后才能释放callback
+  int wait_ret = wait_remote_task_batches(das_ref, cond, batches);
+  ret = COVER_SUCC(wait_ret);
+  //合并发送的task失败后, 按单个task走原有的重试流程
+  for (int64_t i = 0; OB_SUCC(ret) && i < batches.count(); ++i) {
+    ObIArray<ObIDASTaskOp*> &task_ops = batches.at(i)->task_ops_;
+    for (int64_t j = 0; OB_SUCC(ret) && j < task_ops.count(); ++j) {
+      ObIDASTaskOp &task_op = *task_ops.at(j);
+      if (OB_FAIL(task_op.errcode_)
+          && GCONF._enable_partition_level_retry && task_op.can_part_retry()) {
+        int tmp_ret = retry_das_task(das_ref, task_op);
+        if (OB_SUCCESS == tmp_ret) {
+          ret = OB_SUCCESS;
+        } else {
+          LOG_WARN("failed to retry das task", K(tmp_ret));
+        }
+      }
+    }
+  }
+  for (int64_t i = 0; i < batches.count(); ++i) {
+    if (OB_NOT_NULL(batches.at(i)->cb_)) {
+      batches.at(i)->cb_->~ObDASAsyncAccessCB();
+      batches.at(i)->cb_ = nullptr;
+    }
+    batches.at(i)->~ObDASRemoteTaskBatch();
+  }
+  return ret;
+}
+
+int ObDataAccessService::add_remote_task_to_batch(ObIAllocator &allocator,
+                                                  ObIArray<ObDASRemoteTaskBatch*> &batches,
+                                                  ObIDASTaskOp &task_op,
+                                                  const int64_t task_size,
+                                                  const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  ObDASRemoteTaskBatch *batch = nullptr;
+  const ObAddr &runner_svr = task_op.get_tablet_loc()->server_;
+  //同一个server上未满的批次从后往前找, 满了就新开一批, 使每个server上可以同时有多个RPC在途
+  for (int64_t i = batches.count() - 1; OB_ISNULL(batch) && i >= 0; --i) {
+    ObDASRemoteTaskBatch *cur = batches.at(i);
+    if (cur->runner_svr_ == runner_svr
+        && cur->snapshot_ == task_op.get_snapshot()
+        && cur->can_add_task(task_size, batch_size)) {
+      batch = cur;
+    }
+  }
+  if (OB_ISNULL(batch)) {
+    void *buf = allocator.alloc(sizeof(ObDASRemoteTaskBatch));
+    if (OB_ISNULL(buf)) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate remote task batch failed", K(ret));
     } else {
-      ObDASUtils::log_user_error_and_warn(task_resp.get_rcode());
-      if (OB_FAIL(task_resp.get_err_code())) {
-        LOG_WARN("error occurring in remote das task", K(ret), K(task_arg));
-      } else if (OB_FAIL(task_op->decode_task_result(op_result))) {
-        LOG_WARN("decode das task result failed", K(ret));
-      } else if (task_resp.has_more()
-                  && OB_FAIL(setup_extra_result(das_ref, task_resp,
-                  task_op, extra_result))) {
-        LOG_WARN("setup extra result failed", KR(ret));
-      } else if (task_resp.has_more() && OB_FAIL(op_result->link_extra_result(*extra_result))) {
-        LOG_WARN("link extra result failed", K(ret));
+      batch = new (buf) ObDASRemoteTaskBatch();
+      batch->runner_svr_ = runner_svr;
+      batch->snapshot_ = task_op.get_snapshot();
+      if (OB_FAIL(batches.push_back(batch))) {
+        LOG_WARN("store remote task batch failed", K(ret));
+        batch->~ObDASRemoteTaskBatch();
+        batch = nullptr;
       }
-      if (OB_NOT_NULL(session->get_tx_desc())) {
-        int tmp_ret = MTL(transaction::ObTransService*)
-          ->add_tx_exec_result(*session->get_tx_desc(),
-                                task_resp.get_trans_result());
-        if (tmp_ret != OB_SUCCESS) {
-          LOG_WARN("merge response partition failed", K(ret), K(tmp_ret), K(task_resp));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(batch->task_ops_.push_back(&task_op))) {
+    LOG_WARN("store remote task failed", K(ret));
+  } else {
+    batch->task_size_ += task_size;
+  }
+  return ret;
+}
+
+int ObDataAccessService::launch_remote_task_batch(ObDASRef &das_ref,
+                                                  ObIAllocator &allocator,
+                                                  ObThreadCond &cond,
+                                                  ObDASRemoteTaskBatch &batch)
+{
+  int ret = OB_SUCCESS;
+  ObSQLSessionInfo *session = das_ref.get_exec_ctx().get_my_session();
+  ObPhysicalPlanCtx *plan_ctx = das_ref.get_exec_ctx().get_physical_plan_ctx();
+  int64_t timeout = plan_ctx->get_timeout_timestamp() - ObTimeUtility::current_time();
+  uint64_t tenant_id = session->get_rpc_tenant_id();
+  ObCurTraceId::TraceId *trace_id = ObCurTraceId::get_trace_id();
+  ObDASAsyncAccessCB *cb = nullptr;
+  ObDASTaskArg task_arg;
+  ObDASRemoteInfo remote_info;
+  remote_info.exec_ctx_ = &das_ref.get_exec_ctx();
+  remote_info.frame_info_ = das_ref.get_expr_frame_info();
+  remote_info.trans_desc_ = session->get_tx_desc();
+  remote_info.snapshot_ = *batch.snapshot_;
+  remote_info.need_tx_ = (remote_info.trans_desc_ != nullptr);
+  task_arg.set_timeout_ts(session->get_query_timeout_ts());
+  task_arg.set_ctrl_svr(ctrl_addr_);
+  task_arg.get_runner_svr() = batch.runner_svr_;
+  task_arg.set_remote_info(&remote_info);
+  ObDASRemoteInfo::get_remote_info() = &remote_info;
+  void *buf = nullptr;
+  if (OB_UNLIKELY(timeout <= 0)) {
+    ret = OB_TIMEOUT;
+    LOG_WARN("das is timeout", K(ret), K(plan_ctx->get_timeout_timestamp()), K(timeout));
+  } else if (OB_ISNULL(trace_id)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("fail to get trace id", K(ret));
+  } else if (OB_ISNULL(buf = allocator.alloc(sizeof(ObDASAsyncAccessCB)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("allocate das async callback failed", K(ret));
+  } else {
+    cb = new (buf) ObDASAsyncAccessCB(cond, *trace_id);
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < batch.task_ops_.count(); ++i) {
+    ObIDASTaskOp *task_op = batch.task_ops_.at(i);
+    ObIDASTaskResult *op_result = nullptr;
+    if (OB_FAIL(task_arg.add_task_op(task_op))) {
+      LOG_WARN("failed to add das task op", K(ret), KPC(task_op));
+    } else if (OB_FAIL(collect_das_task_info(*task_op, remote_info))) {
+      LOG_WARN("collect das task info failed", K(ret));
+    } else if (OB_FAIL(das_ref.get_das_factory().create_das_task_result(task_op->get_type(),
+                                                                        op_result))) {
+      LOG_WARN("create das task result failed", K(ret));
+    } else if (OB_FAIL(op_result->init(*task_op))) {
+      LOG_WARN("init task result failed", K(ret));
+    } else if (OB_FAIL(cb->get_result().add_op_result(op_result))) {
+      LOG_WARN("failed to add op result", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(das_rpc_proxy_
+                     .to(batch.runner_svr_)
+                     .by(tenant_id)
+                     .timeout(timeout)
+                     .remote_async_access(task_arg, cb))) {
+    LOG_WARN("rpc remote async access failed", K(ret), K(task_arg));
+    // RPC fail, add task's LSID to trans_result
+    // indicate some transaction participant may touched
+    for (int64_t i = 0; i < batch.task_ops_.count(); ++i) {
+      session->get_trans_result().add_touched_ls(batch.task_ops_.at(i)->get_ls_id());
+    }
+  } else {
+    batch.cb_ = cb;
+    LOG_DEBUG("launch remote das task batch", K(batch), K(task_arg));
+  }
+  if (OB_FAIL(ret) && OB_NOT_NULL(cb)) {
+    cb->~ObDASAsyncAccessCB();
+    cb = nullptr;
+  }
+  return ret;
+}
+
+int ObDataAccessService::wait_remote_task_batches(ObDASRef &das_ref,
+                                                  ObThreadCond &cond,
+                                                  ObIArray<ObDASRemoteTaskBatch*> &batches)
+{
+  int ret = OB_SUCCESS;
+  int64_t wait_cnt = 0;
+  ObSEArray<ObDASRemoteTaskBatch*, 4> finished_batches;
+  for (int64_t i = 0; i < batches.count(); ++i) {
+    if (OB_NOT_NULL(batches.at(i)->cb_)) {
+      ++wait_cnt;
+    }
+  }
+  //RPC的超时时间不超过语句的超时时间, 这里总能等到所有callback返回
+  while (wait_cnt > 0) {
+    finished_batches.reuse();
+    {
+      ObThreadCondGuard guard(cond);
+      for (int64_t i = 0; i < batches.count(); ++i) {
+        ObDASAsyncAccessCB *cb = batches.at(i)->cb_;
+        if (OB_NOT_NULL(cb) && !cb->is_visited() && cb->is_finished()) {
+          cb->set_visited(true);
+          //push_back失败时在下一轮重新收集
+          if (OB_SUCCESS != finished_batches.push_back(batches.at(i))) {
+            cb->set_visited(false);
+          }
         }
-        ret = COVER_SUCC(tmp_ret);
+      }
+      if (finished_batches.empty()) {
+        cond.wait_us(500);
       }
     }
+    //结果的解析在cond之外进行, 先返回的批次先处理, 不阻塞rpc线程
+    for (int64_t i = 0; i < finished_batches.count(); ++i) {
+      int tmp_ret = process_remote_task_batch(das_ref, *finished_batches.at(i));
+      if (OB_SUCCESS != tmp_ret) {
+        LOG_WARN("process remote task batch failed", K(tmp_ret), KPC(finished_batches.at(i)));
+      }
+      --wait_cnt;
+    }
   }
-  NG_TRACE_EXT(do_remote_das_task_end, Y(ret), OB_ID(addr), task_arg.get_runner_svr());
   return ret;
 }
 
-int ObDataAccessService::collect_das_task_info(ObDASTaskArg &task_arg, ObDASRemoteInfo &remote_info)
+int ObDataAccessService::process_remote_task_batch(ObDASRef &das_ref, ObDASRemoteTaskBatch &batch)
 {
   int ret = OB_SUCCESS;
-  ObIDASTaskOp *task_op = task_arg.get_task_op();
-  if (task_op->get_ctdef() != nullptr) {
-    remote_info.has_expr_ |= task_op->get_ctdef()->has_expr();
-    remote_info.need_calc_expr_ |= task_op->get_ctdef()->has_pdfilter_or_calc_expr();
-    remote_info.need_calc_udf_ |= task_op->get_ctdef()->has_pl_udf();
-    if (OB_FAIL(add_var_to_array_no_dup(remote_info.ctdefs_, task_op->get_ctdef()))) {
+  ObDASAsyncAccessCB &cb = *batch.cb_;
+  ObSQLSessionInfo *session = das_ref.get_exec_ctx().get_my_session();
+  bool is_rpc_fail = true;
+  if (cb.is_timeout()) {
+    ret = OB_TIMEOUT;
+    LOG_WARN("remote das task batch is timeout", K(ret), K(batch));
+  } else if (cb.is_invalid()) {
+    ret = OB_RPC_PACKET_INVALID;
+    LOG_WARN("remote das task batch response is invalid", K(ret), K(batch));
+  } else if (OB_FAIL(cb.get_ret_code().rcode_)) {
+    LOG_WARN("rpc remote async access failed", K(ret), K(batch));
+  } else {
+    is_rpc_fail = false;
+    if (OB_FAIL(process_remote_task_resp(das_ref, batch.task_ops_, cb.get_result()))) {
+      LOG_WARN("process remote das task response failed", K(ret), K(batch));
+    }
+  }
+  for (int64_t i = 0; i < batch.task_ops_.count(); ++i) {
+    ObIDASTaskOp *task_op = batch.task_ops_.at(i);
+    if (is_rpc_fail) {
+      // RPC fail, add task's LSID to trans_result
+      // indicate some transaction participant may touched
+      session->get_trans_result().add_touched_ls(task_op->get_ls_id());
+    }
+    task_op->errcode_ = ret;
+  }
+  return ret;
+}
+
+int ObDataAccessService::collect_das_task_info(ObIDASTaskOp &task_op, ObDASRemoteInfo &remote_info)
+{
+  int ret = OB_SUCCESS;
+  if (task_op.get_ctdef() != nullptr) {
+    remote_info.has_expr_ |= task_op.get_ctdef()->has_expr();
+    remote_info.need_calc_expr_ |= task_op.get_ctdef()->has_pdfilter_or_calc_expr();
+    remote_info.need_calc_udf_ |= task_op.get_ctdef()->has_pl_udf();
+    if (OB_FAIL(add_var_to_array_no_dup(remote_info.ctdefs_, task_op.get_ctdef()))) {
       LOG_WARN("store remote ctdef failed", K(ret));
     }
   }
-  if (OB_SUCC(ret) && task_op->get_rtdef() != nullptr) {
-    if (OB_FAIL(add_var_to_array_no_dup(remote_info.rtdefs_, task_op->get_rtdef()))) {
+  if (OB_SUCC(ret) && task_op.get_rtdef() != nullptr) {
+    if (OB_FAIL(add_var_to_array_no_dup(remote_info.rtdefs_, task_op.get_rtdef()))) {
       LOG_WARN("store remote rtdef failed", K(ret));
     }
   }
   if (OB_SUCC(ret)) {
-    if (OB_FAIL(append_array_no_dup(remote_info.ctdefs_, task_op->get_related_ctdefs()))) {
+    if (OB_FAIL(append_array_no_dup(remote_info.ctdefs_, task_op.get_related_ctdefs()))) {
       LOG_WARN("append task op related ctdefs to remote info failed", K(ret));
-    } else if (OB_FAIL(append_array_no_dup(remote_info.rtdefs_, task_op->get_related_rtdefs()))) {
+    } else if (OB_FAIL(append_array_no_dup(remote_info.rtdefs_, task_op.get_related_rtdefs()))) {
       LOG_WARN("append task op related rtdefs to remote info failed", K(ret));
     }
   }
@@ -16,6 +16,7 @@
 #include "sql/das/ob_das_rpc_proxy.h"
 #include "sql/das/ob_das_id_cache.h"
 #include "sql/das/ob_das_task_result.h"
+#include "sql/das/ob_das_async_access.h"
 namespace oceanbase
 {
 namespace sql
@@ -39,6 +40,8 @@ public:
            const common::ObAddr &self_addr);
   //开启DAS Task分区相关的事务控制，并执行task对应的op
   int execute_das_task(ObDASRef &das_ref, ObIDASTaskOp &task_op);
+  //执行das_ref中的所有task: 远程scan task按server合并后异步发送, 等待结果的同时执行其它task
+  int execute_das_tasks(ObDASRef &das_ref, const int64_t batch_size);
   //关闭DAS Task的执行流程，并释放task持有的资源，并结束相关的事务控制
   int end_das_task(ObDASRef &das_ref, ObIDASTaskOp &task_op);
   int get_das_task_id(int64_t &das_id);
@@ -53,11 +56,27 @@ private:
   int retry_das_task(ObDASRef &das_ref, ObIDASTaskOp &task_op);
   int do_local_das_task(ObDASRef &das_ref, ObDASTaskArg &task_arg);
   int do_remote_das_task(ObDASRef &das_ref, ObDASTaskArg &das_task);
+  static int add_remote_task_to_batch(common::ObIAllocator &allocator,
+                                      common::ObIArray<ObDASRemoteTaskBatch*> &batches,
+                                      ObIDASTaskOp &task_op,
+                                      const int64_t task_size,
+                                      const int64_t batch_size);
+  int launch_remote_task_batch(ObDASRef &das_ref,
+                               common::ObIAllocator &allocator,
+                               common::ObThreadCond &cond,
+                               ObDASRemoteTaskBatch &batch);
+  int wait_remote_task_batches(ObDASRef &das_ref,
+                               common::ObThreadCond &cond,
+                               common::ObIArray<ObDASRemoteTaskBatch*> &batches);
+  int process_remote_task_batch(ObDASRef &das_ref, ObDASRemoteTaskBatch &batch);
+  int process_remote_task_resp(ObDASRef &das_ref,
+                               common::ObIArray<ObIDASTaskOp*> &task_ops,
+                               ObDASTaskResp &task_resp);
   int setup_extra_result(ObDASRef &das_ref,
                          ObDASTaskResp &task_resp,
                          ObIDASTaskOp *task_op,
                          ObDASExtraData *&extra_result);
-  int collect_das_task_info(ObDASTaskArg &task_arg, ObDASRemoteInfo &remote_info);
+  int collect_das_task_info(ObIDASTaskOp &task_op, ObDASRemoteInfo &remote_info);
   bool can_fast_fail(const ObIDASTaskOp &task_op) const;
 private:
   obrpc::ObDASRpcProxy das_rpc_proxy_;
@@ -13,6 +13,7 @@
 #define USING_LOG_PREFIX SQL_DAS
 #include "sql/das/ob_das_group_scan_op.h"
 #include "sql/engine/ob_exec_context.h"
+#include "sql/engine/ob_sql_mem_mgr_processor.h"
 namespace oceanbase
 {
 using namespace common;
@@ -313,5 +314,321 @@ int ObGroupScanIter::switch_scan_group()
 
 OB_SERIALIZE_MEMBER(ObGroupScanIter, cur_group_idx_, group_size_);
 
+ObGroupSortedScanIter::ObGroupSortedScanIter()
+  : ObNewRowIterator(),
+    inited_(false),
+    is_sorted_(false),
+    is_loaded_(false),
+    exprs_(NULL),
+    eval_ctx_(NULL),
+    max_size_(1),
+    group_id_expr_(NULL),
+    iter_(NULL),
+    datum_store_(),
+    iter_age_(),
+    out_ranges_(),
+    uniq_spans_(),
+    range_idxs_(),
+    sorted_ranges_(),
+    out_range_idx_(0),
+    out_row_idx_(0)
+{
+}
+
+int ObGroupSortedScanIter::init(const common::ObIArray<ObExpr *> &exprs,
+                                ObEvalCtx &eval_ctx,
+                                int64_t max_size,
+                                ObExpr *group_id_expr,
+                                ObNewRowIterator **iter)
+{
+  int ret = OB_SUCCESS;
+  int64_t sort_area_size = 0;
+  if (inited_) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_ISNULL(group_id_expr) || OB_ISNULL(iter) || max_size <= 0) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(group_id_expr), KP(iter), K(max_size));
+  } else if (OB_FAIL(ObSqlWorkareaUtil::get_workarea_size(SORT_WORK_AREA, MTL_ID(), sort_area_size))) {
+    LOG_WARN("failed to get workarea size", K(ret));
+  } else if (OB_FAIL(datum_store_.init(sort_area_size,
+                                       MTL_ID(),
+                                       ObCtxIds::WORK_AREA,
+                                       "DASGroupSort"))) {
+    LOG_WARN("init datum store failed", K(ret));
+  } else {
+    datum_store_.set_iteration_age(&iter_age_);
+    exprs_ = &exprs;
+    eval_ctx_ = &eval_ctx;
+    max_size_ = max_size;
+    group_id_expr_ = group_id_expr;
+    iter_ = iter;
+    inited_ = true;
+  }
+  return ret;
+}
+
+// 1. 按 key 对 range 排序, 若已有序且没有重复的 range, 则不做任何改写, 直接透传存储层的输出
+// 2. 否则相同的 range 只保留一个, 其 group_idx_ 改写为去重后的序号, 存储层据此标记输出行,
+//    同时记录每个原始 range 的 group 和对应的去重后 range, 用于输出时恢复原始顺序
+int ObGroupSortedScanIter::sort_ranges(ObIArray<ObNewRange> &ranges, bool is_reverse)
+{
+  int ret = OB_SUCCESS;
+  const int64_t range_cnt = ranges.count();
+  bool need_sort = false;
+  reuse();
+  out_ranges_.reuse();
+  uniq_spans_.reuse();
+  sorted_ranges_.reuse();
+  if (!inited_) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (range_cnt <= 1) {
+    // do nothing
+  } else if (OB_FAIL(range_idxs_.prepare_allocate(range_cnt))) {
+    LOG_WARN("prepare allocate range idx failed", K(ret), K(range_cnt));
+  } else {
+    for (int64_t i = 0; i < range_cnt; ++i) {
+      range_idxs_.at(i) = i;
+    }
+    std::sort(&range_idxs_.at(0), &range_idxs_.at(0) + range_cnt, RangeCmp(ranges, is_reverse));
+    for (int64_t i = 1; !need_sort && i < range_cnt; ++i) {
+      need_sort = range_idxs_.at(i) != i
+                  || ranges.at(range_idxs_.at(i)).equal2(ranges.at(range_idxs_.at(i - 1)));
+    }
+  }
+  if (OB_SUCC(ret) && need_sort) {
+    if (OB_FAIL(out_ranges_.prepare_allocate(range_cnt))) {
+      LOG_WARN("prepare allocate output range failed", K(ret), K(range_cnt));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < range_cnt; ++i) {
+      const int64_t range_idx = range_idxs_.at(i);
+      const ObNewRange &range = ranges.at(range_idx);
+      if (sorted_ranges_.empty() || !range.equal2(sorted_ranges_.at(sorted_ranges_.count() - 1))) {
+        if (OB_FAIL(sorted_ranges_.push_back(range))) {
+          LOG_WARN("store sorted range failed", K(ret));
+        } else {
+          sorted_ranges_.at(sorted_ranges_.count() - 1).group_idx_ = sorted_ranges_.count() - 1;
+        }
+      }
+      if (OB_SUCC(ret)) {
+        out_ranges_.at(range_idx).group_idx_ = range.get_group_idx();
+        out_ranges_.at(range_idx).uniq_idx_ = sorted_ranges_.count() - 1;
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(uniq_spans_.prepare_allocate(sorted_ranges_.count()))) {
+      LOG_WARN("prepare allocate row span failed", K(ret), K(sorted_ranges_.count()));
+    } else {
+      for (int64_t i = 0; i < uniq_spans_.count(); ++i) {
+        uniq_spans_.at(i) = RowSpan();
+      }
+      if (OB_FAIL(ranges.assign(sorted_ranges_))) {
+        LOG_WARN("assign sorted ranges failed", K(ret));
+      } else {
+        is_sorted_ = true;
+      }
+    }
+    LOG_DEBUG("sort group scan ranges", K(ret), K(range_cnt), K(ranges), K(out_ranges_));
+  }
+  return ret;
+}
+
+int ObGroupSortedScanIter::add_stored_row()
+{
+  int ret = OB_SUCCESS;
+  ObDatum *datum_uniq_idx = NULL;
+  int64_t uniq_idx = 0;
+  if (OB_FAIL(group_id_expr_->eval(*eval_ctx_, datum_uniq_idx))) {
+    LOG_WARN("fail to eval group id", K(ret));
+  } else if (FALSE_IT(uniq_idx = datum_uniq_idx->get_int())) {
+  } else if (OB_UNLIKELY(uniq_idx < 0 || uniq_idx >= uniq_spans_.count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("invalid range idx of scan row", K(ret), K(uniq_idx), K(*this));
+  } else {
+    RowSpan &span = uniq_spans_.at(uniq_idx);
+    if (0 == span.count_) {
+      span.begin_ = datum_store_.get_row_cnt();
+    } else if (OB_UNLIKELY(span.begin_ + span.count_ != datum_store_.get_row_cnt())) {
+      // 存储层按 range 顺序输出, 同一 range 的行必然连续
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("rows of one range are not continuous", K(ret), K(uniq_idx), K(span), K(*this));
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(datum_store_.add_row(*exprs_, eval_ctx_))) {
+      LOG_WARN("add row to datum store failed", K(ret));
+    } else {
+      ++span.count_;
+    }
+  }
+  return ret;
+}
+
+int ObGroupSortedScanIter::load_rows(bool is_vectorized)
+{
+  int ret = OB_SUCCESS;
+  bool iter_end = false;
+  while (OB_SUCC(ret) && !iter_end) {
+    int64_t count = 0;
+    reset_expr_datum_ptr();
+    if (!is_vectorized) {
+      if (OB_FAIL(get_iter()->get_next_row())) {
+        if (OB_ITER_END != ret) {
+          LOG_WARN("fail to get next row", K(ret));
+        }
+      } else {
+        count = 1;
+      }
+    } else if (OB_FAIL(get_iter()->get_next_rows(count, max_size_))) {
+      if (OB_ITER_END != ret) {
+        LOG_WARN("fail to get next rows", K(ret));
+      }
+    }
+    if (OB_ITER_END == ret) {
+      ret = OB_SUCCESS;
+      iter_end = true;
+    }
+    if (OB_FAIL(ret) || 0 == count) {
+    } else if (!is_vectorized) {
+      ret = add_stored_row();
+    } else {
+      ObEvalCtx::BatchInfoScopeGuard batch_info_guard(*eval_ctx_);
+      batch_info_guard.set_batch_size(count);
+      for (int64_t i = 0; OB_SUCC(ret) && i < count; ++i) {
+        batch_info_guard.set_batch_idx(i);
+        ret = add_stored_row();
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(datum_store_.finish_add_row())) {
+    LOG_WARN("finish add row failed", K(ret));
+  } else {
+    is_loaded_ = true;
+    out_range_idx_ = 0;
+    out_row_idx_ = 0;
+  }
+  LOG_DEBUG("load sorted group scan rows", K(ret), K(*this));
+  return ret;
+}
+
+int ObGroupSortedScanIter::next_output_row(int64_t &row_id, int64_t &group_idx)
+{
+  int ret = OB_ITER_END;
+  while (OB_ITER_END == ret && out_range_idx_ < out_ranges_.count()) {
+    const OutputRange &out_range = out_ranges_.at(out_range_idx_);
+    const RowSpan &span = uniq_spans_.at(out_range.uniq_idx_);
+    if (out_row_idx_ < span.count_) {
+      row_id = span.begin_ + out_row_idx_;
+      group_idx = out_range.group_idx_;
+      ++out_row_idx_;
+      ret = OB_SUCCESS;
+    } else {
+      ++out_range_idx_;
+      out_row_idx_ = 0;
+    }
+  }
+  return ret;
+}
+
+int ObGroupSortedScanIter::get_next_row()
+{
+  int ret = OB_SUCCESS;
+  const ObRADatumStore::StoredRow *row = NULL;
+  int64_t row_id = 0;
+  int64_t group_idx = 0;
+  if (!is_sorted_) {
+    ret = get_iter()->get_next_row();
+  } else if (!is_loaded_ && OB_FAIL(load_rows(false))) {
+    LOG_WARN("load rows failed", K(ret));
+  } else if (OB_FAIL(next_output_row(row_id, group_idx))) {
+    if (OB_ITER_END != ret) {
+      LOG_WARN("get next output row failed", K(ret));
+    }
+  } else if (OB_FAIL(datum_store_.get_row(row_id, row))) {
+    LOG_WARN("get stored row failed", K(ret), K(row_id));
+  } else if (OB_FAIL(row->to_expr(*exprs_, *eval_ctx_))) {
+    LOG_WARN("stored row to expr failed", K(ret));
+  } else {
+    group_id_expr_->locate_datum_for_write(*eval_ctx_).set_int(group_idx);
+  }
+  return ret;
+}
+
+int ObGroupSortedScanIter::get_next_rows(int64_t &count, int64_t capacity)
+{
+  int ret = OB_SUCCESS;
+  count = 0;
+  if (!is_sorted_) {
+    ret = get_iter()->get_next_rows(count, capacity);
+  } else if (!is_loaded_ && OB_FAIL(load_rows(true))) {
+    LOG_WARN("load rows failed", K(ret));
+  } else {
+    const int64_t batch_size = std::min(capacity, max_size_);
+    const ObRADatumStore::StoredRow *row = NULL;
+    int64_t row_id = 0;
+    int64_t group_idx = 0;
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(*eval_ctx_);
+    batch_info_guard.set_batch_size(batch_size);
+    iter_age_.inc();
+    while (OB_SUCC(ret) && count < batch_size) {
+      if (OB_FAIL(next_output_row(row_id, group_idx))) {
+        if (OB_ITER_END != ret) {
+          LOG_WARN("get next output row failed", K(ret));
+        }
+      } else if (OB_FAIL(datum_store_.get_row(row_id, row))) {
+        LOG_WARN("get stored row failed", K(ret), K(row_id));
+      } else {
+        batch_info_guard.set_batch_idx(count);
+        if (OB_FAIL(row->to_expr(*exprs_, *eval_ctx_))) {
+          LOG_WARN("stored row to expr failed", K(ret));
+        } else {
+          group_id_expr_->locate_datum_for_write(*eval_ctx_).set_int(group_idx);
+          ++count;
+        }
+      }
+    }
+    if (OB_ITER_END == ret && count > 0) {
+      ret = OB_SUCCESS;
+    }
+  }
+  return ret;
+}
+
+void ObGroupSortedScanIter::reset_expr_datum_ptr()
+{
+  FOREACH_CNT(e, *exprs_) {
+    (*e)->locate_datums_for_update(*eval_ctx_, max_size_);
+    ObEvalInfo &info = (*e)->get_eval_info(*eval_ctx_);
+    info.point_to_frame_ = true;
+  }
+}
+
+void ObGroupSortedScanIter::reuse()
+{
+  is_sorted_ = false;
+  is_loaded_ = false;
+  datum_store_.reuse();
+  out_range_idx_ = 0;
+  out_row_idx_ = 0;
+}
+
+void ObGroupSortedScanIter::reset()
+{
+  reuse();
+  out_ranges_.reset();
+  uniq_spans_.reset();
+  range_idxs_.reset();
+  sorted_ranges_.reset();
+  datum_store_.reset();
+  inited_ = false;
+  exprs_ = NULL;
+  eval_ctx_ = NULL;
+  max_size_ = 1;
+  group_id_expr_ = NULL;
+  iter_ = NULL;
+}
+
+
 }  // namespace sql
 }  // namespace oceanbase
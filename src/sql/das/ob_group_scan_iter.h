@@ -14,6 +14,7 @@
 #define OBDEV_SRC_SQL_DAS_OB_GROUP_SCAN_ITER_H_
 #include "common/row/ob_row_iterator.h"
 #include "sql/engine/basic/ob_chunk_datum_store.h"
+#include "sql/engine/basic/ob_ra_datum_store.h"
 namespace oceanbase
 {
 namespace sql
@@ -130,6 +131,100 @@ private:
   // hold the address of result iter point
   ObNewRowIterator **iter_;
 };
+
+// 批量 rescan (NLJ batch) 时, 一个 batch 内各 group 的 range 按 key 排序并去重,
+// 存储层按 key 顺序做一次多 range 扫描, 相同的 key 只扫描一次.
+// 扫描结果在本 iter 中物化, 再按原始 range 顺序(即 group 顺序)输出并改写 group id,
+// 因此上层 ObGroupScanIter 看到的输出与不排序时完全一致.
+class ObGroupSortedScanIter : public ObNewRowIterator
+{
+public:
+  ObGroupSortedScanIter();
+  virtual ~ObGroupSortedScanIter() { reset(); }
+  int init(const common::ObIArray<ObExpr *> &exprs,
+           ObEvalCtx &eval_ctx,
+           int64_t max_size,
+           ObExpr *group_id_expr,
+           ObNewRowIterator **iter);
+  // 必须在 ranges 下发给存储层之前调用, 原地改写 ranges,
+  // 排序后 range 的 group_idx_ 被改写为去重后的 range 序号
+  int sort_ranges(common::ObIArray<common::ObNewRange> &ranges, bool is_reverse);
+  virtual int get_next_row(ObNewRow *&row) { UNUSED(row); return common::OB_NOT_IMPLEMENT; }
+  virtual int get_next_row() override;
+  virtual int get_next_rows(int64_t &count, int64_t capacity) override;
+  // 每次 rescan 前调用, 释放上一批物化的数据
+  void reuse();
+  virtual void reset() override;
+  bool is_inited() const { return inited_; }
+  bool is_sorted() const { return is_sorted_; }
+  ObNewRowIterator *&get_iter() { return *iter_; }
+
+  TO_STRING_KV(K_(inited),
+               K_(is_sorted),
+               K_(is_loaded),
+               K_(max_size),
+               "range_cnt", out_ranges_.count(),
+               "uniq_range_cnt", uniq_spans_.count(),
+               "row_cnt", datum_store_.get_row_cnt(),
+               K_(out_range_idx),
+               K_(out_row_idx));
+private:
+  struct OutputRange
+  {
+    OutputRange() : group_idx_(0), uniq_idx_(0) {}
+    TO_STRING_KV(K_(group_idx), K_(uniq_idx));
+    int64_t group_idx_;
+    int64_t uniq_idx_;
+  };
+  struct RowSpan
+  {
+    RowSpan() : begin_(0), count_(0) {}
+    TO_STRING_KV(K_(begin), K_(count));
+    int64_t begin_;
+    int64_t count_;
+  };
+  struct RangeCmp
+  {
+    RangeCmp(const common::ObIArray<common::ObNewRange> &ranges, bool is_reverse)
+      : ranges_(ranges), is_reverse_(is_reverse) {}
+    bool operator()(int64_t l, int64_t r) const
+    {
+      int cmp = ranges_.at(l).compare_with_startkey2(ranges_.at(r));
+      if (0 == cmp) {
+        cmp = ranges_.at(l).compare_with_endkey2(ranges_.at(r));
+      }
+      cmp = is_reverse_ ? -cmp : cmp;
+      return cmp < 0 || (0 == cmp && l < r);
+    }
+    const common::ObIArray<common::ObNewRange> &ranges_;
+    bool is_reverse_;
+  };
+  int load_rows(bool is_vectorized);
+  int add_stored_row();
+  int next_output_row(int64_t &row_id, int64_t &group_idx);
+  void reset_expr_datum_ptr();
+private:
+  bool inited_;
+  bool is_sorted_;
+  bool is_loaded_;
+  const common::ObIArray<ObExpr *> *exprs_;
+  ObEvalCtx *eval_ctx_;
+  int64_t max_size_;
+  ObExpr *group_id_expr_;
+  ObNewRowIterator **iter_;
+  // 按存储层输出顺序(即排序去重后的 range 顺序)保存的行, 超过 sort 工作区大小时落盘
+  ObRADatumStore datum_store_;
+  // 一个 batch 内读出的行在下一个 batch 前都不能被换出
+  ObRADatumStore::IterationAge iter_age_;
+  // 原始 range 顺序, 每个原始 range 对应的 group 和去重后的 range
+  common::ObSEArray<OutputRange, 16> out_ranges_;
+  // 每个去重后的 range 在 datum_store_ 中的行区间
+  common::ObSEArray<RowSpan, 16> uniq_spans_;
+  common::ObSEArray<int64_t, 16> range_idxs_;
+  common::ObSEArray<common::ObNewRange, 16> sorted_ranges_;
+  int64_t out_range_idx_;
+  int64_t out_row_idx_;
+};
 }  // namespace sql
 }  // namespace oceanbase
 #endif /* OBDEV_SRC_SQL_DAS_OB_DAS_BATCH_SCAN_OP_H_ */
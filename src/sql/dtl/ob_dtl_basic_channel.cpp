@@ -42,7 +42,7 @@ namespace sql {
 namespace dtl {
 SendMsgResponse::SendMsgResponse()
     : inited_(false), ret_(OB_SUCCESS), in_process_(false), finish_(true), is_block_(false),
-    cond_(), ch_id_(-1)
+    columnar_supported_(false), cond_(), ch_id_(-1)
 {
 }
 
@@ -1109,6 +1109,10 @@ int ObDtlBasicChannel::switch_buffer(const int64_t min_size, const bool is_eof,
     // write_buffer_ is nullptr, do nothing.
   }
   if (OB_SUCC(ret)) {
+    const bool swizzled_rows = CHUNK_DATUM_WRITER == msg_writer_->type() && write_swizzled_rows();
+    if (CHUNK_DATUM_WRITER == msg_writer_->type()) {
+      datum_msg_writer_.set_unswizzling(!swizzled_rows);
+    }
     if (OB_ISNULL(write_buffer_ = alloc_buf(std::max(send_buffer_size_, min_size)))) {
       ret = OB_ALLOCATE_MEMORY_FAILED;
       LOG_WARN("alloc buffer failed", K(ret));
@@ -1122,6 +1126,9 @@ int ObDtlBasicChannel::switch_buffer(const int64_t min_size, const bool is_eof,
         write_buffer_->set_sqc_id(dfc_->get_sender_sqc_info().sqc_id_);
         write_buffer_->set_dfo_id(dfc_->get_sender_sqc_info().dfo_id_);
       }
+      if (swizzled_rows) {
+        write_buffer_->add_flag(DTL_SWIZZLED_ROWS);
+      }
       write_buffer_->timeout_ts() = timeout_ts;
       msg_writer_->write_msg_type(write_buffer_);
       write_buffer_->set_data_msg(is_data_msg_);
@@ -1255,7 +1262,8 @@ int ObDtlRowMsgWriter::serialize()
 //-----------------start ObDtlDatumMsgWrite-------------
 ObDtlDatumMsgWriter::ObDtlDatumMsgWriter() :
   type_(CHUNK_DATUM_WRITER), write_buffer_(nullptr), block_(nullptr),
-  register_block_ptr_(NULL), register_block_buf_ptr_(NULL), write_ret_(OB_SUCCESS)
+  register_block_ptr_(NULL), register_block_buf_ptr_(NULL), write_ret_(OB_SUCCESS),
+  unswizzling_(true)
 {}
 
 ObDtlDatumMsgWriter::~ObDtlDatumMsgWriter()
@@ -1284,6 +1292,7 @@ int ObDtlDatumMsgWriter::init(ObDtlLinkedBuffer *buffer, uint64_t tenant_id)
         register_block_buf_ptr_->set_block(block_);
         register_block_buf_ptr_->set_data_size(block_->data_size());
         register_block_buf_ptr_->set_capacity(block_->blk_size_);
+        register_block_buf_ptr_->set_unswizzling(unswizzling_);
       }
     }
   }
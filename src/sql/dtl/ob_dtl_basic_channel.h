@@ -250,6 +250,9 @@ public:
   {
     buffer->msg_type() = ObDtlMsgType::PX_DATUM_ROW;
   }
+  // rows are written with pointers if not unswizzling, the buffer must be read in place
+  void set_unswizzling(const bool unswizzling) { unswizzling_ = unswizzling; }
+  bool is_unswizzling() const { return unswizzling_; }
 private:
   DtlWriterType type_;
   ObDtlLinkedBuffer *write_buffer_;
@@ -257,6 +260,7 @@ private:
   ObChunkDatumStore::Block** register_block_ptr_;
   ObChunkDatumStore::BlockBufferWrap* register_block_buf_ptr_;
   int write_ret_;
+  bool unswizzling_;
 };
 
 OB_INLINE int ObDtlDatumMsgWriter::write(
@@ -266,7 +270,7 @@ OB_INLINE int ObDtlDatumMsgWriter::write(
   const ObPxNewRow &px_row = static_cast<const ObPxNewRow&>(msg);
   const ObIArray<ObExpr *> *row = px_row.get_exprs();
   if (nullptr != row) {
-    if (OB_FAIL(block_->append_row(*row, eval_ctx, block_->get_buffer(), 0, nullptr, true))) {
+    if (OB_FAIL(block_->append_row(*row, eval_ctx, block_->get_buffer(), 0, nullptr, unswizzling_))) {
       if (OB_BUF_NOT_ENOUGH != ret) {
         SQL_DTL_LOG(WARN, "failed to add row", K(ret));
       } else {
@@ -301,6 +305,9 @@ public:
   int wait();
   int is_block() { return is_block_; }
   void reset_block() { is_block_ = false; }
+  // the peer reported in a response that it decodes columnar buffers, kept for the channel
+  void set_columnar_supported() { columnar_supported_ = true; }
+  bool is_columnar_supported() const { return columnar_supported_; }
   void set_id(uint64_t id) { ch_id_ = id; }
   uint64_t get_id() { return ch_id_; }
 
@@ -313,6 +320,7 @@ private:
   bool in_process_;
   bool finish_;
   bool is_block_;
+  bool columnar_supported_;
   common::ObThreadCond cond_;
   uint64_t ch_id_;
 };
@@ -415,6 +423,12 @@ protected:
   int wait_unblocking();
   int switch_buffer(const int64_t min_size, const bool is_eof,
       const int64_t timeout_ts);
+  // local channel hands the buffer to the receiver in the same process, rows can keep pointers
+  bool write_swizzled_rows()
+  {
+    return local_zero_copy_ && DtlChannelType::LOCAL_CHANNEL == get_channel_type()
+        && !use_interm_result() && nullptr == bc_service_;
+  }
   int write_msg(const ObDtlMsg &msg, int64_t timeout_ts,
       ObEvalCtx *eval_ctx, bool is_eof);
   int inner_write_msg(const ObDtlMsg &msg, int64_t timeout_ts, ObEvalCtx *eval_ctx, bool is_eof);
@@ -45,6 +45,9 @@ ObDtlChannel::ObDtlChannel(uint64_t id, const common::ObAddr &peer)
       ignore_error_(false),
       loop_idx_(OB_INVALID_INDEX_INT64),
       compressor_type_(common::ObCompressorType::NONE_COMPRESSOR),
+      use_columnar_format_(false),
+      columnar_compressor_type_(common::ObCompressorType::NONE_COMPRESSOR),
+      local_zero_copy_(false),
       owner_mod_(DTLChannelOwner::INVALID_OWNER),
       thread_id_(0),
       prev_link_(nullptr),
@@ -232,6 +232,13 @@ public:
   OB_INLINE ObDtlChannelWatcher *get_msg_watcher() { return msg_watcher_; }
 
   void set_compression_type(const common::ObCompressorType &type) { compressor_type_ = type; }
+  void set_columnar_format(const bool use_columnar_format,
+                           const common::ObCompressorType &type)
+  {
+    use_columnar_format_ = use_columnar_format;
+    columnar_compressor_type_ = type;
+  }
+  void set_local_zero_copy(const bool local_zero_copy) { local_zero_copy_ = local_zero_copy; }
 
   void set_batch_id(int64_t batch_id) { batch_id_ = batch_id; }
   int64_t get_batch_id() { return batch_id_; }
@@ -278,6 +285,11 @@ protected:
   int64_t loop_idx_;
 
   common::ObCompressorType compressor_type_;
+  // send datum row buffers in columnar format, compressed by columnar_compressor_type_
+  bool use_columnar_format_;
+  common::ObCompressorType columnar_compressor_type_;
+  // write swizzled rows for local channel, receiver reads them without swizzling
+  bool local_zero_copy_;
 
   DTLChannelOwner owner_mod_;
   int64_t thread_id_;
@@ -0,0 +1,446 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_DTL
+
+#include "ob_dtl_columnar_codec.h"
+#include "lib/allocator/ob_malloc.h"
+#include "sql/engine/basic/ob_chunk_datum_store.h"
+
+using namespace oceanbase::common;
+
+namespace oceanbase {
+namespace sql {
+namespace dtl {
+
+typedef ObChunkDatumStore::StoredRow StoredRow;
+typedef ObChunkDatumStore::Block Block;
+
+STATIC_ASSERT(ObDtlColumnarHeader::BLOCK_HEAD_SIZE == sizeof(Block), "block head size mismatch");
+
+static inline int write_bytes(char *buf, const int64_t buf_len, int64_t &pos,
+                              const void *src, const int64_t len)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(pos + len > buf_len)) {
+    ret = OB_BUF_NOT_ENOUGH;
+  } else {
+    MEMCPY(buf + pos, src, len);
+    pos += len;
+  }
+  return ret;
+}
+
+static inline const char *read_bytes(const char *buf, const int64_t buf_len, int64_t &pos,
+                                     const int64_t len)
+{
+  const char *ptr = nullptr;
+  if (OB_LIKELY(len >= 0 && pos + len <= buf_len)) {
+    ptr = buf + pos;
+    pos += len;
+  }
+  return ptr;
+}
+
+ObDtlColumnarCodec::ObDtlColumnarCodec()
+  : tenant_id_(OB_SERVER_TENANT_ID),
+    columnar_buf_(nullptr), columnar_buf_size_(0),
+    compress_buf_(nullptr), compress_buf_size_(0),
+    row_offsets_()
+{
+}
+
+void ObDtlColumnarCodec::destroy()
+{
+  if (nullptr != columnar_buf_) {
+    ob_free(columnar_buf_);
+    columnar_buf_ = nullptr;
+  }
+  if (nullptr != compress_buf_) {
+    ob_free(compress_buf_);
+    compress_buf_ = nullptr;
+  }
+  columnar_buf_size_ = 0;
+  compress_buf_size_ = 0;
+  row_offsets_.reset();
+}
+
+int ObDtlColumnarCodec::prepare_buf(char *&buf, int64_t &buf_size, const int64_t need_size)
+{
+  int ret = OB_SUCCESS;
+  if (buf_size < need_size) {
+    if (nullptr != buf) {
+      ob_free(buf);
+      buf = nullptr;
+      buf_size = 0;
+    }
+    ObMemAttr attr(tenant_id_, "DtlColumnar");
+    if (OB_ISNULL(buf = static_cast<char *>(ob_malloc(need_size, attr)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc columnar buffer", K(ret), K(need_size));
+    } else {
+      buf_size = need_size;
+    }
+  }
+  return ret;
+}
+
+// Record the offset of each row and check the rows are laid out by
+// ObChunkDatumStore::StoredRow::build with unswizzling, so that they can be rebuilt from columns.
+int ObDtlColumnarCodec::collect_rows(const char *block,
+                                     const int64_t pos,
+                                     const int64_t row_cnt,
+                                     int64_t &col_cnt)
+{
+  int ret = OB_SUCCESS;
+  int64_t offset = sizeof(Block);
+  col_cnt = -1;
+  row_offsets_.reuse();
+  for (int64_t i = 0; OB_SUCC(ret) && i < row_cnt; ++i) {
+    const StoredRow *sr = reinterpret_cast<const StoredRow *>(block + offset);
+    int64_t row_size = 0;
+    if (OB_UNLIKELY(offset + static_cast<int64_t>(sizeof(StoredRow)) > pos)) {
+      ret = OB_NOT_SUPPORTED;
+    } else if (col_cnt < 0) {
+      col_cnt = sr->cnt_;
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_UNLIKELY(col_cnt != sr->cnt_ || 0 == col_cnt)) {
+      ret = OB_NOT_SUPPORTED;
+    } else if (FALSE_IT(row_size = sizeof(StoredRow) + sizeof(ObDatum) * col_cnt)) {
+    } else if (OB_UNLIKELY(offset + row_size > pos)) {
+      ret = OB_NOT_SUPPORTED;
+    } else {
+      const ObDatum *cells = sr->cells();
+      for (int64_t j = 0; OB_SUCC(ret) && j < col_cnt; ++j) {
+        if (cells[j].is_null()) {
+        } else if (OB_UNLIKELY(reinterpret_cast<int64_t>(cells[j].ptr_) != row_size)) {
+          ret = OB_NOT_SUPPORTED;
+        } else {
+          row_size += cells[j].len_;
+        }
+      }
+      if (OB_FAIL(ret)) {
+      } else if (OB_UNLIKELY(row_size != sr->row_size_ || offset + row_size > pos)) {
+        ret = OB_NOT_SUPPORTED;
+      } else if (OB_FAIL(row_offsets_.push_back(static_cast<int32_t>(offset)))) {
+        LOG_WARN("failed to push back row offset", K(ret));
+      } else {
+        offset += row_size;
+      }
+    }
+  }
+  if (OB_SUCC(ret) && OB_UNLIKELY(offset != pos)) {
+    ret = OB_NOT_SUPPORTED;
+  }
+  return ret;
+}
+
+int ObDtlColumnarCodec::encode_columns(const char *block,
+                                       const int64_t col_cnt,
+                                       char *buf,
+                                       const int64_t buf_len,
+                                       int64_t &pos)
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_cnt = row_offsets_.count();
+  const int64_t bitmap_size = (row_cnt + 7) / 8;
+  for (int64_t col = 0; OB_SUCC(ret) && col < col_cnt; ++col) {
+    uint8_t flag = FIXED_PACK;
+    uint32_t fixed_pack = 0;
+    int64_t not_null_cnt = 0;
+    int64_t data_len = 0;
+    for (int64_t i = 0; i < row_cnt; ++i) {
+      const ObDatum &datum = reinterpret_cast<const StoredRow *>(block + row_offsets_.at(i))->cells()[col];
+      if (datum.is_null()) {
+        flag |= HAS_NULL;
+      } else {
+        if (0 == not_null_cnt) {
+          fixed_pack = datum.pack_;
+        } else if (fixed_pack != datum.pack_) {
+          flag &= ~FIXED_PACK;
+        }
+        ++not_null_cnt;
+        data_len += datum.len_;
+      }
+    }
+    if (OB_FAIL(write_bytes(buf, buf_len, pos, &flag, sizeof(flag)))) {
+    } else if (flag & HAS_NULL) {
+      if (OB_UNLIKELY(pos + bitmap_size > buf_len)) {
+        ret = OB_BUF_NOT_ENOUGH;
+      } else {
+        uint8_t *bitmap = reinterpret_cast<uint8_t *>(buf + pos);
+        MEMSET(bitmap, 0, bitmap_size);
+        for (int64_t i = 0; i < row_cnt; ++i) {
+          if (reinterpret_cast<const StoredRow *>(block + row_offsets_.at(i))->cells()[col].is_null()) {
+            bitmap[i >> 3] |= static_cast<uint8_t>(1 << (i & 7));
+          }
+        }
+        pos += bitmap_size;
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (flag & FIXED_PACK) {
+      ret = write_bytes(buf, buf_len, pos, &fixed_pack, sizeof(fixed_pack));
+    } else {
+      for (int64_t i = 0; OB_SUCC(ret) && i < row_cnt; ++i) {
+        const ObDatum &datum = reinterpret_cast<const StoredRow *>(block + row_offsets_.at(i))->cells()[col];
+        if (!datum.is_null()) {
+          ret = write_bytes(buf, buf_len, pos, &datum.pack_, sizeof(datum.pack_));
+        }
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(write_bytes(buf, buf_len, pos, &data_len, sizeof(data_len)))) {
+    } else {
+      for (int64_t i = 0; OB_SUCC(ret) && i < row_cnt; ++i) {
+        const char *row = block + row_offsets_.at(i);
+        const ObDatum &datum = reinterpret_cast<const StoredRow *>(row)->cells()[col];
+        if (!datum.is_null()) {
+          ret = write_bytes(buf, buf_len, pos, row + reinterpret_cast<int64_t>(datum.ptr_), datum.len_);
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObDtlColumnarCodec::encode(ObDtlLinkedBuffer &src,
+                               const ObCompressorType compressor_type,
+                               ObDtlLinkedBuffer &dst)
+{
+  int ret = OB_SUCCESS;
+  ObDtlColumnarHeader header;
+  const char *block = src.buf();
+  int64_t row_cnt = 0;
+  int64_t col_cnt = 0;
+  if (!src.is_data_msg() || PX_DATUM_ROW != src.msg_type() || src.use_interm_result()
+      || src.is_batch_info_valid() || src.pos() <= ObDtlColumnarHeader::BLOCK_HEAD_SIZE
+      || NULL == block || compressor_type >= MAX_COMPRESSOR) {
+    ret = OB_NOT_SUPPORTED;
+  } else if (0 == (row_cnt = reinterpret_cast<const Block *>(block)->rows_)) {
+    ret = OB_NOT_SUPPORTED;
+  } else if (OB_FAIL(collect_rows(block, src.pos(), row_cnt, col_cnt))) {
+    if (OB_NOT_SUPPORTED != ret) {
+      LOG_WARN("failed to collect rows", K(ret));
+    }
+  } else {
+    // packs and null bitmap of a column never take more space than the datums of the rows
+    const int64_t columnar_cap = src.pos() + col_cnt * (sizeof(uint8_t) + sizeof(uint32_t) + sizeof(int64_t));
+    int64_t columnar_size = 0;
+    tenant_id_ = src.tenant_id();
+    if (OB_FAIL(prepare_buf(columnar_buf_, columnar_buf_size_, sizeof(header) + columnar_cap))) {
+      LOG_WARN("failed to prepare columnar buffer", K(ret));
+    } else if (OB_FAIL(encode_columns(block, col_cnt, columnar_buf_ + sizeof(header),
+                                      columnar_cap, columnar_size))) {
+      LOG_WARN("failed to encode columns", K(ret), K(row_cnt), K(col_cnt));
+    } else {
+      header.compressor_type_ = static_cast<int16_t>(compressor_type);
+      header.row_cnt_ = static_cast<int32_t>(row_cnt);
+      header.col_cnt_ = static_cast<int32_t>(col_cnt);
+      header.raw_size_ = src.size();
+      header.raw_pos_ = src.pos();
+      header.columnar_size_ = columnar_size;
+      MEMCPY(header.block_head_, block, sizeof(header.block_head_));
+    }
+
+    char *out = nullptr;
+    if (OB_FAIL(ret)) {
+    } else if (!ObCompressorPool::need_compress(compressor_type)) {
+      out = columnar_buf_;
+      header.compressor_type_ = NONE_COMPRESSOR;
+      header.data_size_ = columnar_size;
+    } else {
+      ObCompressor *compressor = nullptr;
+      int64_t overflow_size = 0;
+      if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(compressor_type, compressor))) {
+        LOG_WARN("failed to get compressor", K(ret), K(compressor_type));
+      } else if (OB_FAIL(compressor->get_max_overflow_size(columnar_size, overflow_size))) {
+        LOG_WARN("failed to get max overflow size", K(ret), K(columnar_size));
+      } else if (OB_FAIL(prepare_buf(compress_buf_, compress_buf_size_,
+                                     sizeof(header) + columnar_size + overflow_size))) {
+        LOG_WARN("failed to prepare compress buffer", K(ret));
+      } else if (OB_FAIL(compressor->compress(columnar_buf_ + sizeof(header), columnar_size,
+                                              compress_buf_ + sizeof(header),
+                                              compress_buf_size_ - sizeof(header),
+                                              header.data_size_))) {
+        LOG_WARN("failed to compress columnar buffer", K(ret), K(columnar_size));
+      } else {
+        out = compress_buf_;
+      }
+    }
+
+    if (OB_FAIL(ret)) {
+    } else if (static_cast<int64_t>(sizeof(header)) + header.data_size_ >= src.pos()) {
+      // not worth it
+      ret = OB_NOT_SUPPORTED;
+    } else {
+      const int64_t size = sizeof(header) + header.data_size_;
+      MEMCPY(out, &header, sizeof(header));
+      dst.shallow_copy(src);
+      dst.set_buf(out);
+      dst.set_size(size);
+      dst.set_pos(size);
+      dst.add_flag(DTL_COLUMNAR_FORMAT);
+      if (OB_FAIL(dst.push_batch_id(src.get_batch_id(), 0))) {
+        LOG_WARN("failed to set batch id", K(ret));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObDtlColumnarCodec::decode(ObDtlLinkedBuffer &buffer, ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  ObDtlColumnarHeader header;
+  const char *columnar = nullptr;
+  char *row_block = nullptr;
+  ObSEArray<ColumnCursor, 16> cursors;
+  if (OB_UNLIKELY(!is_columnar(buffer) || buffer.size() < static_cast<int64_t>(sizeof(header)))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid columnar buffer", K(ret), K(buffer));
+  } else if (FALSE_IT(MEMCPY(&header, buffer.buf(), sizeof(header)))) {
+  } else if (OB_UNLIKELY(!header.is_valid()
+                         || static_cast<int64_t>(sizeof(header)) + header.data_size_ > buffer.size())) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("invalid columnar header", K(ret), K(header), K(buffer.size()));
+  } else if (OB_ISNULL(row_block = static_cast<char *>(allocator.alloc(header.raw_size_)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc row block", K(ret), K(header));
+  } else if (!ObCompressorPool::need_compress(static_cast<ObCompressorType>(header.compressor_type_))) {
+    columnar = buffer.buf() + sizeof(header);
+  } else {
+    ObCompressor *compressor = nullptr;
+    char *decompress_buf = nullptr;
+    int64_t decompress_size = 0;
+    if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(
+                static_cast<ObCompressorType>(header.compressor_type_), compressor))) {
+      LOG_WARN("failed to get compressor", K(ret), K(header));
+    } else if (OB_ISNULL(decompress_buf = static_cast<char *>(allocator.alloc(header.columnar_size_)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("failed to alloc decompress buffer", K(ret), K(header));
+    } else if (OB_FAIL(compressor->decompress(buffer.buf() + sizeof(header), header.data_size_,
+                                              decompress_buf, header.columnar_size_,
+                                              decompress_size))) {
+      LOG_WARN("failed to decompress columnar buffer", K(ret), K(header));
+    } else if (OB_UNLIKELY(decompress_size != header.columnar_size_)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("unexpected decompress size", K(ret), K(decompress_size), K(header));
+    } else {
+      columnar = decompress_buf;
+    }
+  }
+
+  // locate the columns
+  const int64_t row_cnt = header.row_cnt_;
+  const int64_t col_cnt = header.col_cnt_;
+  const int64_t bitmap_size = (row_cnt + 7) / 8;
+  int64_t pos = 0;
+  for (int64_t col = 0; OB_SUCC(ret) && col < col_cnt; ++col) {
+    ColumnCursor cursor;
+    const char *ptr = nullptr;
+    int64_t data_len = 0;
+    MEMSET(&cursor, 0, sizeof(cursor));
+    if (OB_ISNULL(ptr = read_bytes(columnar, header.columnar_size_, pos, sizeof(uint8_t)))) {
+      ret = OB_INVALID_DATA;
+    } else if (FALSE_IT(cursor.flag_ = *reinterpret_cast<const uint8_t *>(ptr))) {
+    } else if ((cursor.flag_ & HAS_NULL)
+               && OB_ISNULL(cursor.null_bitmap_ = reinterpret_cast<const uint8_t *>(
+                            read_bytes(columnar, header.columnar_size_, pos, bitmap_size)))) {
+      ret = OB_INVALID_DATA;
+    } else {
+      int64_t pack_cnt = 1;
+      if (!(cursor.flag_ & FIXED_PACK)) {
+        pack_cnt = row_cnt;
+        if (cursor.flag_ & HAS_NULL) {
+          for (int64_t i = 0; i < bitmap_size; ++i) {
+            pack_cnt -= __builtin_popcount(cursor.null_bitmap_[i]);
+          }
+        }
+      }
+      if (OB_ISNULL(cursor.packs_ = reinterpret_cast<const uint32_t *>(
+                    read_bytes(columnar, header.columnar_size_, pos, sizeof(uint32_t) * pack_cnt)))) {
+        ret = OB_INVALID_DATA;
+      } else if (OB_ISNULL(ptr = read_bytes(columnar, header.columnar_size_, pos, sizeof(data_len)))) {
+        ret = OB_INVALID_DATA;
+      } else if (FALSE_IT(MEMCPY(&data_len, ptr, sizeof(data_len)))) {
+      } else if (OB_ISNULL(cursor.data_ = read_bytes(columnar, header.columnar_size_, pos, data_len))) {
+        ret = OB_INVALID_DATA;
+      } else {
+        cursor.data_end_ = cursor.data_ + data_len;
+        ret = cursors.push_back(cursor);
+      }
+    }
+    if (OB_INVALID_DATA == ret) {
+      LOG_WARN("invalid columnar data", K(ret), K(col), K(pos), K(header));
+    }
+  }
+
+  // rebuild the rows
+  int64_t offset = sizeof(Block);
+  if (OB_SUCC(ret)) {
+    MEMCPY(row_block, header.block_head_, sizeof(header.block_head_));
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < row_cnt; ++i) {
+    StoredRow *sr = reinterpret_cast<StoredRow *>(row_block + offset);
+    int64_t row_size = sizeof(StoredRow) + sizeof(ObDatum) * col_cnt;
+    if (OB_UNLIKELY(offset + row_size > header.raw_pos_)) {
+      ret = OB_INVALID_DATA;
+      LOG_WARN("row block overflow", K(ret), K(i), K(offset), K(header));
+    } else {
+      sr->cnt_ = static_cast<uint32_t>(col_cnt);
+      ObDatum *cells = sr->cells();
+      for (int64_t col = 0; OB_SUCC(ret) && col < col_cnt; ++col) {
+        ColumnCursor &cursor = cursors.at(col);
+        ObDatum *datum = new (&cells[col]) ObDatum();
+        if ((cursor.flag_ & HAS_NULL) && (cursor.null_bitmap_[i >> 3] & (1 << (i & 7)))) {
+          datum->set_null();
+        } else {
+          datum->pack_ = *cursor.packs_;
+          if (!(cursor.flag_ & FIXED_PACK)) {
+            ++cursor.packs_;
+          }
+          if (OB_UNLIKELY(cursor.data_ + datum->len_ > cursor.data_end_
+                          || offset + row_size + datum->len_ > header.raw_pos_)) {
+            ret = OB_INVALID_DATA;
+            LOG_WARN("column data overflow", K(ret), K(i), K(col), K(header));
+          } else {
+            MEMCPY(row_block + offset + row_size, cursor.data_, datum->len_);
+            datum->ptr_ = reinterpret_cast<const char *>(row_size);
+            cursor.data_ += datum->len_;
+            row_size += datum->len_;
+          }
+        }
+      }
+      if (OB_SUCC(ret)) {
+        sr->row_size_ = static_cast<uint32_t>(row_size);
+        offset += row_size;
+      }
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_UNLIKELY(offset != header.raw_pos_)) {
+    ret = OB_INVALID_DATA;
+    LOG_WARN("unexpected row block size", K(ret), K(offset), K(header));
+  } else {
+    buffer.set_buf(row_block);
+    buffer.set_size(header.raw_size_);
+    buffer.set_pos(header.raw_pos_);
+    buffer.remove_flag(DTL_COLUMNAR_FORMAT);
+  }
+  return ret;
+}
+
+}  // dtl
+}  // sql
+}  // oceanbase
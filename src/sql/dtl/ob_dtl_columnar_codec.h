@@ -0,0 +1,124 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OB_DTL_COLUMNAR_CODEC_H
+#define OB_DTL_COLUMNAR_CODEC_H
+
+#include "lib/compress/ob_compressor_pool.h"
+#include "lib/container/ob_se_array.h"
+#include "lib/allocator/ob_allocator.h"
+#include "sql/dtl/ob_dtl_linked_buffer.h"
+
+namespace oceanbase {
+namespace sql {
+namespace dtl {
+
+/*
+ * Columnar wire format of a PX_DATUM_ROW buffer sent by rpc channel.
+ *
+ * The rows of a ObChunkDatumStore::Block are transposed to columns before sending, the whole
+ * columnar body is then compressed by the compressor of the channel:
+ *
+ *  | ObDtlColumnarHeader | compressed body |
+ *
+ *  body := column1 | column2 | ... | columnN
+ *  column := flag(uint8) | [null bitmap] | pack(uint32) or packs(uint32 x not null rows) |
+ *            data length(int64) | data of not null datums
+ *
+ * A column with the same ObDatumDesc for all not null datums (fixed length types) keeps only
+ * one pack. The receiver rebuilds the row block from the columns, so that the receive operators
+ * read the same block as before.
+ */
+struct ObDtlColumnarHeader
+{
+  static const int32_t MAGIC = 0x44544C43; // "DTLC"
+  static const int32_t VERSION = 1;
+  static const int64_t BLOCK_HEAD_SIZE = 16;
+  ObDtlColumnarHeader()
+    : magic_(MAGIC), version_(VERSION), compressor_type_(0), row_cnt_(0), col_cnt_(0),
+      raw_size_(0), raw_pos_(0), columnar_size_(0), data_size_(0)
+  {
+    MEMSET(block_head_, 0, sizeof(block_head_));
+  }
+  bool is_valid() const
+  {
+    return MAGIC == magic_ && VERSION == version_ && row_cnt_ > 0 && col_cnt_ > 0
+        && raw_pos_ > BLOCK_HEAD_SIZE && raw_size_ >= raw_pos_ && data_size_ > 0;
+  }
+  TO_STRING_KV(K_(magic), K_(version), K_(compressor_type), K_(row_cnt), K_(col_cnt),
+               K_(raw_size), K_(raw_pos), K_(columnar_size), K_(data_size));
+
+  int32_t magic_;
+  int16_t version_;
+  int16_t compressor_type_;
+  int32_t row_cnt_;
+  int32_t col_cnt_;
+  // size_ and pos_ of the linked buffer before encoding
+  int64_t raw_size_;
+  int64_t raw_pos_;
+  // size of the body before and after compression
+  int64_t columnar_size_;
+  int64_t data_size_;
+  // ObChunkDatumStore::Block header, kept as it is
+  char block_head_[BLOCK_HEAD_SIZE];
+};
+
+class ObDtlColumnarCodec
+{
+public:
+  ObDtlColumnarCodec();
+  ~ObDtlColumnarCodec() { destroy(); }
+  void destroy();
+
+  // Encode the rows of %src into %dst, %dst shares the memory of the codec and is valid until
+  // the next encode. Return OB_NOT_SUPPORTED if the buffer is not a row block the codec
+  // understands or the encoded buffer is not smaller, the caller should send %src as it is.
+  int encode(ObDtlLinkedBuffer &src,
+             const common::ObCompressorType compressor_type,
+             ObDtlLinkedBuffer &dst);
+  // Decode a buffer encoded by encode() in place, the row block is allocated from %allocator.
+  static int decode(ObDtlLinkedBuffer &buffer, common::ObIAllocator &allocator);
+  static bool is_columnar(const ObDtlLinkedBuffer &buffer)
+  {
+    return buffer.has_flag(DTL_COLUMNAR_FORMAT);
+  }
+private:
+  static const uint8_t HAS_NULL = 1;
+  static const uint8_t FIXED_PACK = 2;
+  struct ColumnCursor
+  {
+    uint8_t flag_;
+    const uint8_t *null_bitmap_;
+    const uint32_t *packs_;
+    const char *data_;
+    const char *data_end_;
+    TO_STRING_KV(K_(flag), KP_(null_bitmap), KP_(packs), KP_(data), KP_(data_end));
+  };
+  int prepare_buf(char *&buf, int64_t &buf_size, const int64_t need_size);
+  int collect_rows(const char *block, const int64_t pos, const int64_t row_cnt, int64_t &col_cnt);
+  int encode_columns(const char *block, const int64_t col_cnt,
+                     char *buf, const int64_t buf_len, int64_t &pos);
+private:
+  uint64_t tenant_id_;
+  char *columnar_buf_;
+  int64_t columnar_buf_size_;
+  char *compress_buf_;
+  int64_t compress_buf_size_;
+  common::ObSEArray<int32_t, 256> row_offsets_;
+  DISALLOW_COPY_AND_ASSIGN(ObDtlColumnarCodec);
+};
+
+}  // dtl
+}  // sql
+}  // oceanbase
+
+#endif /* OB_DTL_COLUMNAR_CODEC_H */
@@ -19,6 +19,7 @@
 #include "ob_dtl_channel_loop.h"
 #include "ob_dtl_utils.h"
 #include "observer/omt/ob_tenant_config_mgr.h"
+#include "lib/compress/ob_compressor_pool.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::omt;
@@ -62,6 +63,20 @@ int ObDtlFlowControl::init(uint64_t tenant_id, int64_t chan_cnt)
     if (tenant_config.is_valid() && true == tenant_config->_px_message_compression) {
       compressor_type_ = ObCompressorType::LZ4_COMPRESSOR;
     }
+    // rpc channels switch to the columnar format only after the peer reports it can decode it
+    if (tenant_config.is_valid() && true == tenant_config->_px_message_columnar_format) {
+      int tmp_ret = OB_SUCCESS;
+      const char *compress_func = tenant_config->_px_message_columnar_compress_func.str();
+      if (OB_SUCCESS != (tmp_ret = ObCompressorPool::get_instance().get_compressor_type(
+                         compress_func, columnar_compressor_type_))) {
+        LOG_WARN("invalid columnar compress func, use lz4 instead", K(tmp_ret), K(compress_func));
+        columnar_compressor_type_ = ObCompressorType::LZ4_COMPRESSOR;
+      }
+      use_columnar_format_ = true;
+    }
+    if (tenant_config.is_valid()) {
+      local_zero_copy_ = tenant_config->_px_local_channel_zero_copy;
+    }
     is_init_ = true;
     tenant_id_ = tenant_id;
     timeout_ts_ = 0;
@@ -22,6 +22,9 @@ namespace sql {
 namespace dtl {
 
 #define DTL_BROADCAST (1ULL)
+#define DTL_COLUMNAR_FORMAT (1ULL << 1)
+// rows of the datum block keep pointers into this buffer, only for local channel
+#define DTL_SWIZZLED_ROWS (1ULL << 2)
 
 struct ObDtlMsgHeader;
 class ObDtlChannel;
@@ -58,6 +58,10 @@ int ObDtlRpcChannel::SendMsgCB::process()
   const ObDtlRpcDataResponse &resp = result_;
   // if request queue is full or serialize faild, then rcode is set, and rpc process is not called
   int tmp_ret = OB_SUCCESS != rcode_.rcode_ ? rcode_.rcode_ : resp.recode_;
+  if (OB_SUCCESS == rcode_.rcode_ && resp.columnar_supported_) {
+    // visible to the sender after it waits for this response
+    response_.set_columnar_supported();
+  }
   int ret = response_.on_finish(resp.is_block_, tmp_ret);
   if (OB_FAIL(ret)) {
     LOG_WARN("set finish failed", K_(trace_id), K(ret));
@@ -168,7 +172,7 @@ ObDtlRpcChannel::ObDtlRpcChannel(
     const uint64_t tenant_id,
     const uint64_t id,
     const ObAddr &peer)
-    : ObDtlBasicChannel(tenant_id, id, peer), recv_mock_eof_cnt_(0)
+    : ObDtlBasicChannel(tenant_id, id, peer), recv_mock_eof_cnt_(0), columnar_codec_()
 {}
 
 ObDtlRpcChannel::ObDtlRpcChannel(
@@ -176,7 +180,7 @@ ObDtlRpcChannel::ObDtlRpcChannel(
     const uint64_t id,
     const ObAddr &peer,
     const int64_t hash_val)
-    : ObDtlBasicChannel(tenant_id, id, peer, hash_val), recv_mock_eof_cnt_(0)
+    : ObDtlBasicChannel(tenant_id, id, peer, hash_val), recv_mock_eof_cnt_(0), columnar_codec_()
 {}
 
 ObDtlRpcChannel::~ObDtlRpcChannel()
@@ -196,6 +200,7 @@ int ObDtlRpcChannel::init()
 
 void ObDtlRpcChannel::destroy()
 {
+  columnar_codec_.destroy();
 }
 
 int ObDtlRpcChannel::feedup(ObDtlLinkedBuffer *&buffer)
@@ -305,6 +310,21 @@ int ObDtlRpcChannel::send_message(ObDtlLinkedBuffer *&buf)
     // we wait first message return and retry until peer setup.
     int64_t timeout_us = buf->timeout_ts() - ObTimeUtility::current_time();
     SendMsgCB cb(msg_response_, *cur_trace_id);
+    // the columnar buffer is compressed by itself, skip the compression of rpc for it
+    ObDtlLinkedBuffer columnar_buf;
+    ObDtlLinkedBuffer *send_buf = buf;
+    ObCompressorType rpc_compressor_type = compressor_type_;
+    // the first message is always in row format, the columnar format is used after the peer
+    // reports that it decodes it, which keeps the channel to a server before it working
+    if (use_columnar_format_ && msg_response_.is_columnar_supported()) {
+      int tmp_ret = columnar_codec_.encode(*buf, columnar_compressor_type_, columnar_buf);
+      if (OB_SUCCESS == tmp_ret) {
+        send_buf = &columnar_buf;
+        rpc_compressor_type = ObCompressorType::NONE_COMPRESSOR;
+      } else if (OB_NOT_SUPPORTED != tmp_ret) {
+        LOG_WARN("failed to encode columnar buffer, send it in row format", K(tmp_ret), KPC(buf));
+      }
+    }
     if (timeout_us <= 0) {
       ret = OB_TIMEOUT;
       LOG_WARN("send dtl message timeout", K(ret), K(peer_),
@@ -312,8 +332,8 @@ int ObDtlRpcChannel::send_message(ObDtlLinkedBuffer *&buf)
     } else if (OB_FAIL(msg_response_.start())) {
       LOG_WARN("start message process fail", K(ret));
     } else if (OB_FAIL(DTL.get_rpc_proxy().to(peer_).timeout(timeout_us)
-        .compressed(compressor_type_)
-        .ap_send_message(ObDtlSendArgs{peer_id_, *buf}, &cb))) {
+        .compressed(rpc_compressor_type)
+        .ap_send_message(ObDtlSendArgs{peer_id_, *send_buf}, &cb))) {
       LOG_WARN("send message failed", K_(peer), K(ret));
       int tmp_ret = msg_response_.on_start_fail();
       if (OB_SUCCESS != tmp_ret) {
@@ -25,6 +25,7 @@
 #include "observer/ob_server_struct.h"
 #include "sql/dtl/ob_dtl_rpc_proxy.h"
 #include "sql/dtl/ob_dtl_basic_channel.h"
+#include "sql/dtl/ob_dtl_columnar_codec.h"
 
 namespace oceanbase {
 
@@ -101,6 +102,7 @@ public:
 
 private:
   int64_t recv_mock_eof_cnt_;
+  ObDtlColumnarCodec columnar_codec_;
 };
 
 }  // dtl
@@ -18,6 +18,7 @@
 #include "sql/dtl/ob_dtl_flow_control.h"
 #include "sql/engine/basic/ob_chunk_row_store.h"
 #include "sql/dtl/ob_dtl_fc_server.h"
+#include "sql/dtl/ob_dtl_columnar_codec.h"
 #include "ob_dtl_interm_result_manager.h"
 using namespace oceanbase::common;
 
@@ -39,8 +40,14 @@ int ObDtlSendMessageP::process_msg(ObDtlRpcDataResponse &response, ObDtlSendArgs
 {
   int ret = OB_SUCCESS;
   ObDtlChannel *chan = nullptr;
+  // the row block decoded from columnar format is copied by channel or buffer cache below
+  ObArenaAllocator allocator("DtlColumnar", OB_MALLOC_NORMAL_BLOCK_SIZE, arg.buffer_.tenant_id());
   response.is_block_ = false;
-  if (arg.buffer_.is_data_msg() && arg.buffer_.use_interm_result()) {
+  response.columnar_supported_ = true;
+  if (ObDtlColumnarCodec::is_columnar(arg.buffer_)
+      && OB_FAIL(ObDtlColumnarCodec::decode(arg.buffer_, allocator))) {
+    LOG_WARN("failed to decode columnar buffer", K(ret), KP(arg.chid_), K(arg.buffer_));
+  } else if (arg.buffer_.is_data_msg() && arg.buffer_.use_interm_result()) {
     if (OB_FAIL(ObDTLIntermResultManager::process_interm_result(&arg.buffer_, arg.chid_))) {
       LOG_WARN("fail to process internal result", K(ret));
     }
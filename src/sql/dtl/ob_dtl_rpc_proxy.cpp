@@ -16,7 +16,7 @@ namespace oceanbase {
 namespace sql {
 namespace dtl {
 
-OB_SERIALIZE_MEMBER(ObDtlRpcDataResponse, is_block_, recode_);
+OB_SERIALIZE_MEMBER(ObDtlRpcDataResponse, is_block_, recode_, columnar_supported_);
 OB_SERIALIZE_MEMBER(ObDtlRpcChanArgs, chid_, peer_);
 OB_SERIALIZE_MEMBER(ObDtlSendArgs, chid_, buffer_);
 OB_SERIALIZE_MEMBER(ObDtlBCSendArgs, args_, bc_buffer_);
@@ -28,12 +28,14 @@ class ObDtlRpcDataResponse
 {
   OB_UNIS_VERSION(1);
 public:
-  ObDtlRpcDataResponse() : is_block_(false), recode_(OB_SUCCESS) {}
-  TO_STRING_KV(K_(is_block));
+  ObDtlRpcDataResponse() : is_block_(false), recode_(OB_SUCCESS), columnar_supported_(false) {}
+  TO_STRING_KV(K_(is_block), K_(columnar_supported));
 
 public:
   bool is_block_;
   int recode_;
+  // the receiver decodes columnar buffers, servers without it never set it
+  bool columnar_supported_;
 };
 
 class ObDtlBCRpcDataResponse
@@ -290,7 +290,9 @@ int ObChunkDatumStore::BlockBufferWrap::append_row(
       ObDatum &in_datum = static_cast<ObDatum&>(exprs.at(i)->locate_expr_datum(*ctx));
       ObDatum *datum = new (&sr->cells()[i])ObDatum();
       // Attension : can't print dst datum after deep_copy_unswizzling
-      if (OB_FAIL(deep_copy_unswizzling(in_datum, datum, head(), max_size, pos))) {
+      if (OB_FAIL(unswizzling_
+                  ? deep_copy_unswizzling(in_datum, datum, head(), max_size, pos)
+                  : datum->deep_copy(in_datum, head(), max_size, pos))) {
         if (OB_BUF_NOT_ENOUGH != ret) {
           LOG_WARN("failed to copy datum", K(ret), K(i), K(pos),
             K(max_size), K(in_datum));
@@ -114,6 +114,10 @@ int ObExprJoinFilter::eval_bloom_filter(const ObExpr &expr, ObEvalCtx &ctx,
           if (OB_FAIL(expr.args_[i]->eval(ctx, datum))) {
             LOG_WARN("failed to eval datum", K(ret));
           } else {
+            if (is_match && !datum->is_null()
+                && can_use_range(*bloom_filter_ptr_, *expr.args_[i], i)) {
+              is_match = bloom_filter_ptr_->range_might_contain(i, datum->get_int());
+            }
             if (OB_ISNULL(expr.inner_functions_)) {
               // for compatibility
               hash_func.hash_func_ = expr.args_[i]->basic_funcs_->murmur_hash_;
@@ -123,12 +127,15 @@ int ObExprJoinFilter::eval_bloom_filter(const ObExpr &expr, ObEvalCtx &ctx,
             hash_val = hash_func.hash_func_(*datum, hash_val);
           }
         }
-        if (OB_SUCC(ret)) {
-          if (OB_FAIL(bloom_filter_ptr_->might_contain(hash_val, is_match))) {
-            LOG_WARN("fail to check filter might contain value", K(ret), K(hash_val));
-          } else {
-            join_filter_ctx->check_count_++;
-          }
+        if (OB_FAIL(ret) || !is_match) {
+        } else if (bloom_filter_ptr_->is_in_list_valid()) {
+          // build 端 distinct 值较少时用精确的 in-list 代替 bloom filter
+          is_match = bloom_filter_ptr_->in_list_contain(hash_val);
+          join_filter_ctx->check_count_++;
+        } else if (OB_FAIL(bloom_filter_ptr_->might_contain(hash_val, is_match))) {
+          LOG_WARN("fail to check filter might contain value", K(ret), K(hash_val));
+        } else {
+          join_filter_ctx->check_count_++;
         }
       }
     }
@@ -229,19 +236,46 @@ int ObExprJoinFilter::eval_bloom_filter_batch(
             }
           }
         }
-        if (OB_FAIL(ObBitVector::flip_foreach(skip, batch_size,
+        const bool use_in_list = bloom_filter_ptr_->is_in_list_valid();
+        int64_t range_args[ObPxBloomFilter::MAX_RANGE_KEY_COUNT];
+        int64_t range_arg_cnt = 0;
+        for (int64_t i = 0; i < expr.arg_cnt_ && i < ObPxBloomFilter::MAX_RANGE_KEY_COUNT; ++i) {
+          if (can_use_range(*bloom_filter_ptr_, *expr.args_[i], i)) {
+            range_args[range_arg_cnt++] = i;
+          }
+        }
+        auto range_match = [&](int64_t idx) __attribute__((always_inline)) {
+          bool match = true;
+          for (int64_t k = 0; match && k < range_arg_cnt; ++k) {
+            const ObExpr *arg = expr.args_[range_args[k]];
+            const ObDatum &datum =
+                arg->locate_batch_datums(ctx)[arg->is_batch_result() ? idx : 0];
+            if (!datum.is_null()) {
+              match = bloom_filter_ptr_->range_might_contain(range_args[k], datum.get_int());
+            }
+          }
+          return match;
+        };
+        auto set_result = [&](int64_t idx, bool match) __attribute__((always_inline)) {
+          ++join_filter_ctx->check_count_;
+          ++join_filter_ctx->total_count_;
+          join_filter_ctx->filter_count_ += !match;
+          eval_flags.set(idx);
+          results[idx].set_int(match);
+          return OB_SUCCESS;
+        };
+        if (OB_FAIL(ret)) {
+        } else if (use_in_list) {
+          if (OB_FAIL(ObBitVector::flip_foreach(skip, batch_size,
               [&](int64_t idx) __attribute__((always_inline)) {
-                bloom_filter_ptr_->prefetch_bits_block(hash_values[idx]); return OB_SUCCESS;
+                return set_result(idx, range_match(idx)
+                                       && bloom_filter_ptr_->in_list_contain(hash_values[idx]));
               }))) {
-        } else if (OB_FAIL(ObBitVector::flip_foreach(skip, batch_size,
-            [&](int64_t idx) __attribute__((always_inline)) {
-              ret = bloom_filter_ptr_->might_contain(hash_values[idx], is_match);
-              ++join_filter_ctx->check_count_;
-              ++join_filter_ctx->total_count_;
-              join_filter_ctx->filter_count_ += !is_match;
-              eval_flags.set(idx);
-              results[idx].set_int(is_match);
-              return ret;
+            LOG_WARN("failed to check in list", K(ret));
+          }
+        } else if (OB_FAIL(bloom_filter_ptr_->might_contain_batch(hash_values, skip, batch_size,
+            [&](int64_t idx, bool match) __attribute__((always_inline)) {
+              return set_result(idx, match && range_match(idx));
             }))) {
           LOG_WARN("failed to process prefetch block", K(ret));
         }
@@ -56,6 +56,13 @@ public:
   // hard code seed, 32 bit max prime number
   static const int64_t JOIN_FILTER_SEED = 4294967279;
 private:
+  // build 端维护了第 idx 个 key 的 range, 且 probe 端 key 的类型可以直接按整数比较
+  static inline bool can_use_range(const ObPxBloomFilter &filter, const ObExpr &arg, int64_t idx)
+  {
+    return filter.has_range(idx)
+           && (filter.is_range_unsigned(idx) ? ob_is_uint_tc(arg.datum_meta_.type_)
+                                             : ob_is_int_tc(arg.datum_meta_.type_));
+  }
   static const int64_t CHECK_TIMES = 127;
   DISALLOW_COPY_AND_ASSIGN(ObExprJoinFilter);
 };
@@ -132,6 +132,50 @@ ObJoinFilterSpec::ObJoinFilterSpec(common::ObIAllocator &alloc, const ObPhyOpera
 
 }
 
+void ObJoinFilterSpec::get_range_key_mask(int64_t &key_mask, int64_t &unsigned_mask) const
+{
+  key_mask = 0;
+  unsigned_mask = 0;
+  if (!is_partition_filter()) {
+    for (int64_t i = 0; i < join_keys_.count() && i < ObPxBloomFilter::MAX_RANGE_KEY_COUNT; ++i) {
+      const ObExpr *key = join_keys_.at(i);
+      if (OB_ISNULL(key)) {
+      } else if (ob_is_int_tc(key->datum_meta_.type_)) {
+        key_mask |= (1L << i);
+      } else if (ob_is_uint_tc(key->datum_meta_.type_)) {
+        key_mask |= (1L << i);
+        unsigned_mask |= (1L << i);
+      }
+    }
+  }
+  return;
+}
+
+int ObJoinFilterSpec::init_runtime_filter(ObExecContext &ctx, ObPxBloomFilter &filter) const
+{
+  int ret = OB_SUCCESS;
+  bool enable = false;
+  if (OB_ISNULL(ctx.get_my_session())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session is null", K(ret));
+  } else {
+    ObTenantConfigGuard tenant_config(TENANT_CONF(ctx.get_my_session()->get_effective_tenant_id()));
+    if (tenant_config.is_valid()) {
+      enable = tenant_config->_enable_px_join_filter_range_in_list;
+    }
+  }
+  if (OB_SUCC(ret) && enable) {
+    int64_t key_mask = 0;
+    int64_t unsigned_mask = 0;
+    get_range_key_mask(key_mask, unsigned_mask);
+    filter.init_range(key_mask, unsigned_mask);
+    if (OB_FAIL(filter.init_in_list(ctx.get_allocator()))) {
+      LOG_WARN("fail to init in list", K(ret));
+    }
+  }
+  return ret;
+}
+
 //------------------------------------------ ObJoinFilterOp --------------------------------
 int ObJoinFilterOp::destroy_filter()
 {
@@ -221,6 +265,8 @@ int ObJoinFilterOp::inner_open()
                                                                ctx_.get_allocator(),
                                                                filter_create_))) {
         LOG_WARN("fail to init px bloom filter", K(ret));
+      } else if (OB_FAIL(MY_SPEC.init_runtime_filter(ctx_, *filter_create_))) {
+        LOG_WARN("fail to init runtime filter", K(ret));
       } else {
         LOG_TRACE("join filter buffer length",
           K(filter_len),
@@ -579,6 +625,48 @@ int ObJoinFilterOp::insert_by_row()
     /*do nothing*/
   } else if (OB_FAIL(filter_create_->put(hash_value))) {
     LOG_WARN("fail to put  hash value to px bloom filter", K(ret));
+  } else if (OB_FAIL(update_range_by_row())) {
+    LOG_WARN("fail to update filter range", K(ret));
+  }
+  return ret;
+}
+
+int ObJoinFilterOp::update_range_by_row()
+{
+  int ret = OB_SUCCESS;
+  ObDatum *datum = NULL;
+  for (int64_t i = 0; OB_SUCC(ret) && i < MY_SPEC.join_keys_.count(); ++i) {
+    if (!filter_create_->has_range(i)) {
+    } else if (OB_FAIL(MY_SPEC.join_keys_.at(i)->eval(eval_ctx_, datum))) {
+      LOG_WARN("failed to eval datum", K(ret));
+    } else if (!datum->is_null()) {
+      // null 不会与任何值相等, 不计入 range
+      filter_create_->update_range(i, datum->get_int());
+    }
+  }
+  return ret;
+}
+
+int ObJoinFilterOp::update_range_by_batch(const ObBatchRows *child_brs)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < MY_SPEC.join_keys_.count(); ++i) {
+    if (filter_create_->has_range(i)) {
+      // join key 已在计算 hash 时求值
+      ObExpr *expr = MY_SPEC.join_keys_.at(i);
+      ObDatum *datums = expr->locate_batch_datums(eval_ctx_);
+      const bool is_batch_result = expr->is_batch_result();
+      for (int64_t j = 0; j < child_brs->size_; ++j) {
+        if (child_brs->skip_->at(j)) {
+          continue;
+        } else {
+          const ObDatum &datum = datums[is_batch_result ? j : 0];
+          if (!datum.is_null()) {
+            filter_create_->update_range(i, datum.get_int());
+          }
+        }
+      }
+    }
   }
   return ret;
 }
@@ -620,21 +708,28 @@ int ObJoinFilterOp::insert_by_row_batch(const ObBatchRows *child_brs)
         }
       }
     }
-    for (int64_t i = 0; OB_SUCC(ret) && i < child_brs->size_; ++i) {
-      if (MY_SPEC.is_partition_filter()) {
-        ObDatum &datum = MY_SPEC.calc_tablet_id_expr_->locate_expr_datum(eval_ctx_, i);
-        if (ObExprCalcPartitionId::NONE_PARTITION_ID == datum.get_int()) {
-          continue;
-        }
+    if (OB_FAIL(ret)) {
+    } else if (!MY_SPEC.is_partition_filter()) {
+      if (OB_FAIL(filter_create_->put_batch(batch_hash_values_, *child_brs->skip_,
+                                            child_brs->size_))) {
+        LOG_WARN("fail to put hash values to px bloom filter", K(ret));
       }
-      if (OB_SUCC(ret)) {
+    } else {
+      for (int64_t i = 0; OB_SUCC(ret) && i < child_brs->size_; ++i) {
         if (child_brs->skip_->at(i)) {
           continue;
+        }
+        ObDatum &datum = MY_SPEC.calc_tablet_id_expr_->locate_expr_datum(eval_ctx_, i);
+        if (ObExprCalcPartitionId::NONE_PARTITION_ID == datum.get_int()) {
+          continue;
         } else if (OB_FAIL(filter_create_->put(batch_hash_values_[i]))) {
           LOG_WARN("fail to put  hash value to px bloom filter", K(ret));
         }
       }
     }
+    if (OB_SUCC(ret) && OB_FAIL(update_range_by_batch(child_brs))) {
+      LOG_WARN("fail to update filter range", K(ret));
+    }
   }
   return ret;
 }
@@ -114,6 +114,10 @@ public:
   inline bool is_shared_join_filter() const
   { return filter_type_ == JoinFilterType::SHARED_JOIN_FILTER ||
            filter_type_ == JoinFilterType::SHARED_PARTITION_JOIN_FILTER; }
+  // 整数类型的 join key 维护 min/max range, 返回 key 位图和其中无符号 key 的位图
+  void get_range_key_mask(int64_t &key_mask, int64_t &unsigned_mask) const;
+  // 初始化 filter 的 range 和 in-list, 由租户配置项控制是否开启
+  int init_runtime_filter(ObExecContext &ctx, ObPxBloomFilter &filter) const;
 
   JoinFilterMode mode_;
   int64_t filter_id_;
@@ -150,6 +154,8 @@ private:
 
   int insert_by_row();
   int insert_by_row_batch(const ObBatchRows *child_brs);
+  int update_range_by_row();
+  int update_range_by_batch(const ObBatchRows *child_brs);
   int check_contain_row(bool &match);
   int calc_hash_value(uint64_t &hash_value, bool &ignore);
   int calc_hash_value(uint64_t &hash_value);
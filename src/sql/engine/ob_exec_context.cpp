@@ -17,6 +17,7 @@
 #include "common/ob_smart_call.h"
 #include "sql/session/ob_sql_session_info.h"
 #include "sql/engine/ob_physical_plan_ctx.h"
+#include "sql/engine/ob_exec_page_allocator.h"
 #include "sql/engine/px/ob_px_util.h"
 #include "sql/executor/ob_task_executor_ctx.h"
 #include "sql/monitor/ob_phy_plan_monitor_info.h"
@@ -65,7 +66,8 @@ void ObOpKitStore::destroy()
 }
 
 ObExecContext::ObExecContext(ObIAllocator &allocator)
-  : allocator_(allocator),
+  : sche_allocator_(ObExecPageAllocator::get_instance(), OB_MALLOC_NORMAL_BLOCK_SIZE, true),
+    allocator_(allocator),
     phy_op_size_(0),
     phy_op_ctx_store_(NULL),
     phy_op_input_store_(NULL),
@@ -103,6 +105,8 @@ ObExecContext::ObExecContext(ObIAllocator &allocator)
     frames_(NULL),
     frame_cnt_(0),
     op_kit_store_(),
+    eval_res_allocator_(ObExecPageAllocator::get_instance(), OB_MALLOC_NORMAL_BLOCK_SIZE, true),
+    eval_tmp_allocator_(ObExecPageAllocator::get_instance(), OB_MALLOC_NORMAL_BLOCK_SIZE, true),
     convert_allocator_(nullptr),
     pwj_map_(nullptr),
     calc_type_(CALC_NORMAL),
@@ -124,6 +128,10 @@ ObExecContext::ObExecContext(ObIAllocator &allocator)
     register_op_id_(OB_INVALID_ID),
     tmp_alloc_used_(false)
 {
+  // pages of these arenas are recycled by the worker when the query ends
+  sche_allocator_.set_label(ObModIds::OB_MODULE_PAGE_ALLOCATOR);
+  eval_res_allocator_.set_label(ObModIds::OB_MODULE_PAGE_ALLOCATOR);
+  eval_tmp_allocator_.set_label(ObModIds::OB_MODULE_PAGE_ALLOCATOR);
 }
 
 ObExecContext::~ObExecContext()
@@ -0,0 +1,203 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_ENG
+
+#include "sql/engine/ob_exec_page_allocator.h"
+#include "lib/allocator/ob_malloc.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace sql
+{
+
+namespace
+{
+// put before every page to find the tenant ctx and size of it on free
+struct PageHeader
+{
+  uint64_t tenant_id_;
+  uint32_t ctx_id_;
+  uint32_t size_;
+  union {
+    PageHeader *next_;
+    char padding_[16];
+  };
+  char data_[0];
+};
+
+enum PageClass
+{
+  NORMAL_PAGE = 0,
+  MIDDLE_PAGE = 1,
+  PAGE_CLASS_CNT = 2
+};
+
+OB_INLINE int64_t class_of(const int64_t size)
+{
+  return OB_MALLOC_NORMAL_BLOCK_SIZE == size ? NORMAL_PAGE :
+      (OB_MALLOC_MIDDLE_BLOCK_SIZE == size ? MIDDLE_PAGE : -1);
+}
+
+bool cache_enabled = true;
+// bytes cached by all threads
+int64_t total_cached_size = 0;
+
+struct PageCache
+{
+  PageCache()
+    : tenant_id_(OB_INVALID_TENANT_ID), ctx_id_(0), lists_(), cnts_(), size_(0)
+  {}
+  ~PageCache() { flush(); }
+  void push(const int64_t cls, PageHeader *page)
+  {
+    page->next_ = lists_[cls];
+    lists_[cls] = page;
+    cnts_[cls]++;
+    size_ += page->size_;
+    IGNORE_RETURN ATOMIC_AAF(&total_cached_size, static_cast<int64_t>(page->size_));
+  }
+  PageHeader *pop(const int64_t cls)
+  {
+    PageHeader *page = lists_[cls];
+    if (nullptr != page) {
+      lists_[cls] = page->next_;
+      cnts_[cls]--;
+      size_ -= page->size_;
+      IGNORE_RETURN ATOMIC_AAF(&total_cached_size, -static_cast<int64_t>(page->size_));
+    }
+    return page;
+  }
+  void flush()
+  {
+    for (int64_t i = 0; i < PAGE_CLASS_CNT; i++) {
+      PageHeader *page = nullptr;
+      while (nullptr != (page = pop(i))) {
+        ob_free(page);
+      }
+    }
+  }
+  // tenant of the worker thread, pages of other tenants are not cached
+  uint64_t tenant_id_;
+  // ctx of cached pages, valid only if size_ > 0
+  uint64_t ctx_id_;
+  PageHeader *lists_[PAGE_CLASS_CNT];
+  int64_t cnts_[PAGE_CLASS_CNT];
+  int64_t size_;
+};
+
+const int64_t MAX_CACHED_PAGES[PAGE_CLASS_CNT] = {
+  ObExecPageAllocator::MAX_CACHED_NORMAL_PAGES,
+  ObExecPageAllocator::MAX_CACHED_MIDDLE_PAGES
+};
+
+thread_local PageCache page_cache;
+} // end anonymous namespace
+
+ObExecPageAllocator &ObExecPageAllocator::get_instance()
+{
+  static ObExecPageAllocator instance;
+  return instance;
+}
+
+void ObExecPageAllocator::set_enabled(const bool enabled)
+{
+  ATOMIC_STORE(&cache_enabled, enabled);
+}
+
+bool ObExecPageAllocator::is_enabled()
+{
+  return ATOMIC_LOAD(&cache_enabled);
+}
+
+void ObExecPageAllocator::set_thread_tenant(const uint64_t tenant_id)
+{
+  PageCache &cache = page_cache;
+  if (cache.tenant_id_ != tenant_id) {
+    cache.flush();
+    cache.tenant_id_ = tenant_id;
+  }
+}
+
+void *ObExecPageAllocator::alloc(const int64_t size, const ObMemAttr &attr)
+{
+  void *ptr = nullptr;
+  PageHeader *page = nullptr;
+  const int64_t cls = class_of(size);
+  PageCache &cache = page_cache;
+  if (cls >= 0 && cache.size_ > 0 && cache.tenant_id_ == attr.tenant_id_) {
+    if (cache.ctx_id_ == attr.ctx_id_) {
+      page = cache.pop(cls);
+    } else {
+      // worker switched to another ctx of its tenant
+      cache.flush();
+    }
+  }
+  if (OB_ISNULL(page)) {
+    if (OB_NOT_NULL(page = static_cast<PageHeader*>(ob_malloc(sizeof(PageHeader) + size, attr)))) {
+      page->tenant_id_ = attr.tenant_id_;
+      page->ctx_id_ = static_cast<uint32_t>(attr.ctx_id_);
+      page->size_ = static_cast<uint32_t>(size);
+    }
+  }
+  if (OB_NOT_NULL(page)) {
+    ptr = page->data_;
+  }
+  return ptr;
+}
+
+void ObExecPageAllocator::free(void *ptr)
+{
+  if (OB_NOT_NULL(ptr)) {
+    PageHeader *page = reinterpret_cast<PageHeader*>(static_cast<char*>(ptr) - sizeof(PageHeader));
+    // tenant workers flush the cache before they leave their tenant, so
+    // cached pages never outlive the tenant memory.
+    PageCache &cache = page_cache;
+    const int64_t cls = page->tenant_id_ == cache.tenant_id_ ? class_of(page->size_) : -1;
+    bool cached = false;
+    if (cls < 0) {
+      // not cacheable
+    } else if (!is_enabled()) {
+      cache.flush();
+    } else {
+      if (0 == cache.size_) {
+        cache.ctx_id_ = page->ctx_id_;
+      }
+      if (cache.ctx_id_ == page->ctx_id_ && cache.cnts_[cls] < MAX_CACHED_PAGES[cls]) {
+        cache.push(cls, page);
+        cached = true;
+      }
+    }
+    if (!cached) {
+      ob_free(page);
+    }
+  }
+}
+
+void ObExecPageAllocator::flush()
+{
+  page_cache.flush();
+}
+
+int64_t ObExecPageAllocator::get_cached_size()
+{
+  return page_cache.size_;
+}
+
+int64_t ObExecPageAllocator::get_total_cached_size()
+{
+  return ATOMIC_LOAD(&total_cached_size);
+}
+
+} // end namespace sql
+} // end namespace oceanbase
@@ -0,0 +1,68 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SQL_ENGINE_OB_EXEC_PAGE_ALLOCATOR_H_
+#define OCEANBASE_SQL_ENGINE_OB_EXEC_PAGE_ALLOCATOR_H_
+
+#include "lib/allocator/ob_allocator.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+
+// Page allocator of the arenas in ObExecContext.
+//
+// Pages of the normal and middle arena page size are kept in per-thread
+// free lists when an arena is reset, so a worker running short queries
+// one after another reuses the pages of the previous query instead of
+// going through ob_malloc for each of them. Pages of other sizes, which
+// arenas use for big allocations, go to ob_malloc directly.
+//
+// Only tenant workers cache pages, and only pages of one ctx of their
+// own tenant, which they set with set_thread_tenant(). Pages of other
+// tenants, e.g. allocated under MTL_SWITCH, go back to ob_malloc. The
+// cache is flushed when the worker stops working for its tenant, when a
+// page of another ctx of the tenant is requested and on thread exit.
+class ObExecPageAllocator : public common::ObIAllocator
+{
+public:
+  static const int64_t MAX_CACHED_NORMAL_PAGES = 32;
+  static const int64_t MAX_CACHED_MIDDLE_PAGES = 4;
+public:
+  static ObExecPageAllocator &get_instance();
+  static void set_enabled(const bool enabled);
+  static bool is_enabled();
+  // tenant of pages cached by current thread, OB_INVALID_TENANT_ID
+  // disables caching on the thread.
+  static void set_thread_tenant(const uint64_t tenant_id);
+  virtual void *alloc(const int64_t size) override
+  {
+    return alloc(size, common::default_memattr);
+  }
+  virtual void *alloc(const int64_t size, const common::ObMemAttr &attr) override;
+  virtual void free(void *ptr) override;
+  // give back pages cached by current thread
+  static void flush();
+  // bytes of pages cached by current thread
+  static int64_t get_cached_size();
+  // bytes of pages cached by all threads
+  static int64_t get_total_cached_size();
+private:
+  ObExecPageAllocator() {}
+  DISALLOW_COPY_AND_ASSIGN(ObExecPageAllocator);
+};
+
+} // end namespace sql
+} // end namespace oceanbase
+
+#endif /* OCEANBASE_SQL_ENGINE_OB_EXEC_PAGE_ALLOCATOR_H_ */
@@ -359,6 +359,8 @@ int ObPxTransmitOp::init_channel(ObPxTransmitOpInput &trans_input)
         ch->set_interm_result(use_interm_result);
         ch->set_batch_id(px_batch_id);
         ch->set_compression_type(dfc_.get_compressor_type());
+        ch->set_columnar_format(dfc_.use_columnar_format(), dfc_.get_columnar_compressor_type());
+        ch->set_local_zero_copy(dfc_.use_local_zero_copy());
         ch->set_operator_owner();
         ch->set_thread_id(thread_id);
       }
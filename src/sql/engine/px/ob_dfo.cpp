@@ -130,6 +130,7 @@ int ObPxSqcMeta::assign(const ObPxSqcMeta &other)
     recieve_use_interm_result_ = other.recieve_use_interm_result_;
     ignore_vtable_error_ = other.ignore_vtable_error_;
     server_not_alive_ = other.server_not_alive_;
+    output_rows_ = other.output_rows_;
   }
   return ret;
 }
@@ -158,7 +158,8 @@ public:
               ignore_vtable_error_(false),
               access_table_location_keys_(),
               access_table_location_indexes_(),
-              server_not_alive_(false)
+              server_not_alive_(false),
+              output_rows_(-1)
   {}
   ~ObPxSqcMeta() = default;
   int assign(const ObPxSqcMeta &other);
@@ -229,6 +230,8 @@ public:
   bool is_ignore_vtable_error() { return ignore_vtable_error_; }
   void set_server_not_alive() { server_not_alive_ = true; }
   bool is_server_not_alive() { return server_not_alive_; }
+  void set_output_rows(int64_t rows) { output_rows_ = rows; }
+  int64_t get_output_rows() const { return output_rows_; }
   ObPxTransmitDataChannelMsg &get_transmit_channel_msg() { return transmit_channel_; }
   ObPxReceiveDataChannelMsg &get_receive_channel_msg() { return receive_channel_; }
   common::ObIArray<ObPxReceiveDataChannelMsg>& get_serial_receive_channels()
@@ -269,7 +272,8 @@ public:
                K_(task_count), K_(max_task_count), K_(min_task_count),
                K_(thread_inited), K_(thread_finish), K_(px_int_id),
                K_(is_fulltree), K_(is_rpc_worker), K_(transmit_use_interm_result),
-               K_(recieve_use_interm_result), K(temp_table_ctx_), K_(server_not_alive));
+               K_(recieve_use_interm_result), K(temp_table_ctx_), K_(server_not_alive),
+               K_(output_rows));
 private:
   uint64_t execution_id_;
   uint64_t qc_id_;
@@ -323,6 +327,8 @@ private:
   ObSEArray<ObSqcTableLocationKey, 2> access_table_location_keys_;
   ObSEArray<ObSqcTableLocationIndex, 2> access_table_location_indexes_;
   bool server_not_alive_;
+  // No need to serialize, transmit 发送的行数，由 sqc finish 消息带回，-1 表示未上报
+  int64_t output_rows_;
 };
 
 class ObDfo
@@ -376,7 +382,8 @@ public:
     use_filter_ch_map_(),
     total_task_cnt_(0),
     ignore_vtable_error_(false),
-    pkey_table_loc_id_(0)
+    pkey_table_loc_id_(0),
+    adaptive_dop_(0)
   {
   }
 
@@ -546,6 +553,8 @@ public:
   bool is_ignore_vtable_error() { return ignore_vtable_error_; }
   void set_pkey_table_loc_id(int64_t id) { pkey_table_loc_id_ = id; }
   int64_t get_pkey_table_loc_id() { return pkey_table_loc_id_; };
+  void set_adaptive_dop(int64_t dop) { adaptive_dop_ = dop; }
+  int64_t get_adaptive_dop() const { return adaptive_dop_; }
   TO_STRING_KV(K_(execution_id),
                K_(dfo_id),
                K_(is_active),
@@ -568,7 +577,8 @@ public:
                K_(dist_method),
                K_(px_bloom_filter_mode),
                K_(px_bf_id),
-               K_(pkey_table_loc_id));
+               K_(pkey_table_loc_id),
+               K_(adaptive_dop));
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObDfo);
@@ -636,6 +646,8 @@ private:
   int64_t total_task_cnt_;      // the task total count of dfo start worker
   bool ignore_vtable_error_;
   int64_t pkey_table_loc_id_; // record pkey table loc id for child dfo
+  // 根据 child dfo 实际输出行数调整后的并发度，0 表示不调整
+  int64_t adaptive_dop_;
 };
 
 
@@ -729,7 +741,8 @@ public:
       temp_table_id_(common::OB_INVALID_ID),
       interm_result_ids_(),
       tx_desc_(NULL),
-      is_use_local_thread_(false)
+      is_use_local_thread_(false),
+      output_rows_(0)
   {}
   ~ObPxTask() = default;
   ObPxTask &operator=(const ObPxTask &other)
@@ -755,6 +768,7 @@ public:
     interm_result_ids_.assign(other.interm_result_ids_);
     tx_desc_ = other.tx_desc_;
     is_use_local_thread_ = other.is_use_local_thread_;
+    output_rows_ = other.output_rows_;
     return *this;
   }
 public:
@@ -777,7 +791,8 @@ public:
                K_(temp_table_id),
                K_(interm_result_ids),
                K_(tx_desc),
-               K_(is_use_local_thread));
+               K_(is_use_local_thread),
+               K_(output_rows));
   dtl::ObDtlChannelInfo &get_sqc_channel_info() { return sqc_ch_info_; }
   dtl::ObDtlChannelInfo &get_task_channel_info() { return task_ch_info_; }
   void set_task_channel(dtl::ObDtlChannel *ch) { task_channel_ = ch; }
@@ -814,6 +829,8 @@ public:
   bool is_fulltree() const { return is_fulltree_; }
   inline void set_affected_rows(int64_t v) { affected_rows_ = v; }
   int64_t get_affected_rows() { return affected_rows_; }
+  inline void set_output_rows(int64_t v) { output_rows_ = v; }
+  int64_t get_output_rows() const { return output_rows_; }
   transaction::ObTxDesc *&get_tx_desc() { return tx_desc_; }
   void set_use_local_thread(bool flag) { is_use_local_thread_ = flag; }
   bool is_use_local_thread() { return is_use_local_thread_; }
@@ -844,6 +861,7 @@ public:
   common::ObSEArray<uint64_t, 8> interm_result_ids_;  //返回每个task生成的结果集
   transaction::ObTxDesc *tx_desc_; // transcation information
   bool is_use_local_thread_;
+  int64_t output_rows_; // task 的 transmit 算子实际发送的行数
 };
 
 class ObPxRpcInitTaskArgs
@@ -22,6 +22,7 @@
 #include "sql/engine/px/ob_px_rpc_processor.h"
 #include "sql/engine/px/ob_px_sqc_async_proxy.h"
 #include "share/ob_server_blacklist.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 using namespace oceanbase::common;
 using namespace oceanbase::share;
@@ -1351,6 +1352,88 @@ int ObParallelDfoScheduler::try_schedule_next_dfo(ObExecContext &ctx) const
   return ret;
 }
 
+// 优化器估算的行数偏差较大时（如谓词过滤后只剩很少的行），按 dop 分配的 worker
+// 大多空转。child 自身不含 scan 时，它的输入全部来自已执行完成的 dfo，
+// 这些 dfo 实际发送的行数即是 child 输入规模的采样，据此收缩 parent 的 worker 数。
+int ObParallelDfoScheduler::adjust_dop_by_child_rows(ObExecContext &exec_ctx,
+                                                     const ObDfo &child,
+                                                     ObDfo &parent) const
+{
+  int ret = OB_SUCCESS;
+  int64_t rows_per_worker = 0;
+  ObSQLSessionInfo *session = exec_ctx.get_my_session();
+  if (OB_ISNULL(session)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session is null", K(ret));
+  } else {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(session->get_effective_tenant_id()));
+    if (tenant_config.is_valid()) {
+      rows_per_worker = tenant_config->_px_adaptive_dop_rows_per_worker;
+    }
+  }
+  if (OB_FAIL(ret) || rows_per_worker <= 0) {
+    // adaptive dop disabled
+  } else if (1 != parent.get_child_count()
+             || child.has_scan_op()
+             || child.has_temp_table_scan()
+             || !child.has_child_dfo()) {
+    // parent 还有其它输入，或 child 自己读盘，无法用已完成 dfo 的行数估算输入规模
+  } else {
+    int64_t dop = 0;
+    if (OB_FAIL(calc_adaptive_dop(child, rows_per_worker, dop))) {
+      LOG_WARN("fail calc adaptive dop", K(ret));
+    } else if (dop > 0 && dop < child.get_assigned_worker_count()) {
+      parent.set_adaptive_dop(dop);
+      LOG_TRACE("shrink dfo dop by actual input rows", K(rows_per_worker), K(dop),
+                "planned", child.get_assigned_worker_count(),
+                "dfo_id", parent.get_dfo_id());
+    }
+  }
+  return ret;
+}
+
+// 仅当 child 的所有输入 dfo 都已结束，且每个 sqc 都上报了发送行数时才给出 dop，
+// 否则 dop 为 0。sqc 初始化失败或低版本 server 上的 sqc 不会上报行数，
+// 按 0 行累加会把并发度错误地收缩到 1。
+int ObParallelDfoScheduler::calc_adaptive_dop(const ObDfo &child,
+                                              int64_t rows_per_worker,
+                                              int64_t &dop)
+{
+  int ret = OB_SUCCESS;
+  bool all_reported = true;
+  int64_t input_rows = 0;
+  dop = 0;
+  for (int64_t i = 0; OB_SUCC(ret) && all_reported && i < child.get_child_count(); ++i) {
+    ObDfo *input_dfo = NULL;
+    ObSEArray<const ObPxSqcMeta *, 16> sqcs;
+    if (OB_FAIL(child.get_child_dfo(i, input_dfo))) {
+      LOG_WARN("fail get child dfo", K(i), K(ret));
+    } else if (OB_ISNULL(input_dfo)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("child dfo is null", K(i), K(ret));
+    } else if (!input_dfo->is_thread_finish()) {
+      all_reported = false;
+    } else if (OB_FAIL(input_dfo->get_sqcs(sqcs))) {
+      LOG_WARN("fail get sqcs", K(i), K(ret));
+    } else {
+      for (int64_t j = 0; all_reported && j < sqcs.count(); ++j) {
+        const ObPxSqcMeta *sqc = sqcs.at(j);
+        if (OB_ISNULL(sqc) || !sqc->is_thread_finish() || sqc->get_output_rows() < 0) {
+          all_reported = false;
+        } else {
+          input_rows += sqc->get_output_rows();
+        }
+      }
+    }
+  }
+  if (OB_SUCC(ret) && all_reported && rows_per_worker > 0) {
+    dop = std::max(static_cast<int64_t>(1),
+                   (input_rows + rows_per_worker - 1) / rows_per_worker);
+  }
+  LOG_TRACE("calc adaptive dop", K(ret), K(all_reported), K(input_rows), K(rows_per_worker), K(dop));
+  return ret;
+}
+
 int ObParallelDfoScheduler::schedule_pair(ObExecContext &exec_ctx,
                                                   ObDfo &child,
                                                   ObDfo &parent) const
@@ -1437,6 +1520,8 @@ int ObParallelDfoScheduler::schedule_pair(ObExecContext &exec_ctx,
                   child, parent))) {
             LOG_WARN("fail alloc addr by data distribution", K(parent), K(child), K(ret));
           }
+        } else if (OB_FAIL(adjust_dop_by_child_rows(exec_ctx, child, parent))) {
+          LOG_WARN("fail adjust dop by child rows", K(parent), K(child), K(ret));
         } else if (OB_FAIL(ObPXServerAddrUtil::alloc_by_random_distribution(exec_ctx, child, parent))) {
           LOG_WARN("fail alloc addr by data distribution", K(parent), K(child), K(ret));
         }
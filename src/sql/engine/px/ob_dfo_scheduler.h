@@ -118,6 +118,13 @@ private:
     int schedule_pair(ObExecContext &exec_ctx,
                       ObDfo &child,
                       ObDfo &parent) const;
+    /* parent 调度前，若 child 的输入 dfo 均已执行完成，
+     * 按实际行数收缩 parent 的并发度，只减不增
+     */
+    int adjust_dop_by_child_rows(ObExecContext &exec_ctx,
+                                 const ObDfo &child,
+                                 ObDfo &parent) const;
+    static int calc_adaptive_dop(const ObDfo &child, int64_t rows_per_worker, int64_t &dop);
     int wait_for_dfo_finish(ObDfoMgr &dfo_mgr) const;
   private:
     ObPxMsgProc &proc_;
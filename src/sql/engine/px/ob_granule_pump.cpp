@@ -21,6 +21,7 @@
 #include "share/schema/ob_part_mgr_util.h"
 #include "sql/engine/dml/ob_table_modify_op.h"
 #include "sql/engine/ob_engine_op_traits.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase
 {
@@ -197,6 +198,43 @@ int ObGITaskSet::set_block_order(bool desc)
   return ret;
 }
 
+// Hand out the partitions in the order of estimated size, largest first. The workers fetch
+// from the shared pool, so the small partitions fill the tail after the large ones are
+// taken, instead of a worker starting a large partition when the others are finishing.
+int ObGITaskSet::set_largest_first_order(const ObIArray<ObDASTabletLoc*> &tablets,
+                                         const ObIArray<int64_t> &size_each_partitions)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(tablets.count() != size_each_partitions.count())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid partitions size", K(ret), K(tablets.count()), K(size_each_partitions.count()));
+  } else if (gi_task_set_.count() > 1) {
+    // the ranges of a partition are adjacent and in the order of %tablets
+    int64_t tablet_pos = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < gi_task_set_.count(); ++i) {
+      ObGITaskInfo &task = gi_task_set_.at(i);
+      int64_t j = tablet_pos;
+      while (j < tablets.count() && tablets.at(j) != task.tablet_loc_) {
+        ++j;
+      }
+      if (OB_UNLIKELY(j >= tablets.count())) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("tablet of task not found", K(ret), K(i), K(tablet_pos), K(task));
+      } else {
+        tablet_pos = j;
+        task.partition_size_ = size_each_partitions.at(j);
+      }
+    }
+    if (OB_SUCC(ret)) {
+      // stable, the ranges of the same partition keep adjacent
+      auto compare_fun = [](const ObGITaskInfo &a, const ObGITaskInfo &b) -> bool { return a.partition_size_ > b.partition_size_; };
+      std::stable_sort(gi_task_set_.begin(), gi_task_set_.end(), compare_fun);
+    }
+    LOG_TRACE("largest first task info", K(ret), K(size_each_partitions), K(gi_task_set_));
+  }
+  return ret;
+}
+
 int ObGITaskSet::construct_taskset(ObIArray<ObDASTabletLoc*> &taskset_tablets,
                                    ObIArray<ObNewRange> &taskset_ranges,
                                    ObIArray<int64_t> &taskset_idxs,
@@ -588,6 +626,10 @@ int ObGranulePump::add_new_gi_task(ObGranulePumpArgs &args)
     splitter_type_ = GIT_RANDOM;
     ObRandomGranuleSplitter splitter;
     bool partition_granule = args.force_partition_granule();
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+    if (tenant_config.is_valid()) {
+      splitter.set_largest_first_order(tenant_config->_px_granule_largest_first);
+    }
     // TODO: randomize GI
     // if (!(args.asc_order() || args.desc_order() || ObGITaskSet::GI_RANDOM_NONE != random_type)) {
     //   random_type = ObGITaskSet::GI_RANDOM_TASK;
@@ -651,7 +693,8 @@ int ObGranuleSplitter::split_gi_task(ObGranulePumpArgs &args,
                                      const common::ObIArray<ObDASTabletLoc*> &tablets,
                                      bool partition_granule,
                                      ObGITaskSet &task_set,
-                                     ObGITaskSet::ObGIRandomType random_type)
+                                     ObGITaskSet::ObGIRandomType random_type,
+                                     bool largest_first /* = false */)
 {
   int ret = OB_SUCCESS;
   ObSEArray<ObNewRange, 16> ranges;
@@ -690,6 +733,20 @@ int ObGranuleSplitter::split_gi_task(ObGranulePumpArgs &args,
                                                  K(taskset_ranges),
                                                  K(taskset_idxs),
                                                  K(random_type));
+  } else if (largest_first && partition_granule && tablets.count() > 1) {
+    // block granule tasks are split by size already, only partition granule tasks are skewed
+    ObSEArray<int64_t, 16> size_each_partitions;
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCCESS != (tmp_ret = ObGranuleUtil::get_partitions_size(args.ctx_->get_allocator(),
+                                                                    tsc,
+                                                                    ranges,
+                                                                    tablets,
+                                                                    size_each_partitions))) {
+      // keep the partition order
+      LOG_WARN("failed to get partitions size", K(tmp_ret));
+    } else if (OB_FAIL(task_set.set_largest_first_order(tablets, size_each_partitions))) {
+      LOG_WARN("failed to set largest first order", K(ret));
+    }
   }
   return ret;
 }
@@ -824,6 +881,11 @@ int ObRandomGranuleSplitter::split_granule(ObGranulePumpArgs &args,
       uint64_t op_id = tsc->get_id();
       ObGITaskSet total_task_set;
       ObGITaskArray &taskset_array = gi_task_array_result.at(idx).taskset_array_;
+      // the workers fetch tasks from the shared pool, order the tasks by size if no order required
+      const bool largest_first = largest_first_order_
+                                 && !is_virtual_table(scan_key_id)
+                                 && ObGITaskSet::GI_RANDOM_NONE == random_type
+                                 && !args.asc_order() && !args.desc_order();
       partition_granule = is_virtual_table(scan_key_id) || partition_granule;
       if (OB_FAIL(split_gi_task(args,
                                          tsc,
@@ -832,7 +894,8 @@ int ObRandomGranuleSplitter::split_granule(ObGranulePumpArgs &args,
                                          tablet_arrays.at(idx),
                                          partition_granule,
                                          total_task_set,
-                                         random_type))) {
+                                         random_type,
+                                         largest_first))) {
         LOG_WARN("failed to init granule iter pump", K(ret), K(idx), K(tablet_arrays));
       } else if (OB_FAIL(total_task_set.set_block_order(args.desc_order()))) {
         LOG_WARN("fail set block order", K(ret));
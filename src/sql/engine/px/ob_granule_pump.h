@@ -94,17 +94,20 @@ class ObGITaskSet {
 public:
   struct ObGITaskInfo
   {
-    ObGITaskInfo() : tablet_loc_(nullptr), range_(), idx_(0), hash_value_(0) {}
+    ObGITaskInfo() : tablet_loc_(nullptr), range_(), idx_(0), hash_value_(0), partition_size_(0) {}
     ObGITaskInfo(ObDASTabletLoc *tablet_loc, common::ObNewRange range, int64_t idx) :
-        tablet_loc_(tablet_loc), range_(range), idx_(idx), hash_value_(0) {}
+        tablet_loc_(tablet_loc), range_(range), idx_(idx), hash_value_(0), partition_size_(0) {}
     TO_STRING_KV(KPC(tablet_loc_),
                  K(range_),
                  K(idx_),
-                 K(hash_value_));
+                 K(hash_value_),
+                 K(partition_size_));
     ObDASTabletLoc *tablet_loc_;
     common::ObNewRange range_;
     int64_t idx_;
     uint64_t hash_value_;
+    // estimated size of the partition, only set for the largest first order
+    int64_t partition_size_;
   };
 
   enum ObGIRandomType
@@ -122,6 +125,8 @@ public:
   int assign(const ObGITaskSet &other);
   int set_pw_affi_partition_order(bool asc);
   int set_block_order(bool asc);
+  int set_largest_first_order(const common::ObIArray<ObDASTabletLoc*> &tablets,
+                              const common::ObIArray<int64_t> &size_each_partitions);
   int construct_taskset(common::ObIArray<ObDASTabletLoc*> &taskset_tablets,
                         common::ObIArray<ObNewRange> &taskset_ranges,
                         common::ObIArray<int64_t> &taskset_idxs,
@@ -182,7 +187,8 @@ protected :
                     const common::ObIArray<ObDASTabletLoc*> &tablets,
                     bool partition_granule,
                     ObGITaskSet &task_set,
-                    ObGITaskSet::ObGIRandomType random_type);
+                    ObGITaskSet::ObGIRandomType random_type,
+                    bool largest_first = false);
 
 public :
   ObSEArray<ObPxTabletInfo, 8> partitions_info_;
@@ -191,14 +197,16 @@ public :
 class ObRandomGranuleSplitter : public ObGranuleSplitter
 {
 public :
-  ObRandomGranuleSplitter() = default;
+  ObRandomGranuleSplitter() : largest_first_order_(false) {}
   virtual ~ObRandomGranuleSplitter() = default;
   int split_granule(ObGranulePumpArgs &args,
                     common::ObIArray<const ObTableScanSpec *> &scan_ops,
                     GITaskArrayMap &gi_task_array_result,
                     ObGITaskSet::ObGIRandomType random_type,
                     bool partition_granule = true);
+  void set_largest_first_order(bool largest_first) { largest_first_order_ = largest_first; }
 private:
+  bool largest_first_order_;
 };
 
 class ObAccessAllGranuleSplitter : public ObGranuleSplitter
@@ -184,7 +184,6 @@ int ObGranuleUtil::split_block_granule(ObIAllocator &allocator,
   //  5. calculate task ranges for each partition, and get the result
 
   int ret = OB_SUCCESS;
-  ObAccessService *access_service = MTL(ObAccessService *);
   // 1. check the validity of input parameters
   if (input_ranges.count() < 1 || tablets.count() < 1 || parallelism < 1 || tablet_size < 1) {
     ret = OB_INVALID_ARGUMENT;
@@ -199,38 +198,17 @@ int ObGranuleUtil::split_block_granule(ObIAllocator &allocator,
   ObSEArray<ObStoreRange, 16> input_store_ranges;
   bool need_convert_new_range = true;//only rowid range need extra convert.
   if (OB_SUCC(ret)) {
-    for (int i = 0; i < tablets.count() && OB_SUCC(ret); i++) {
-      const ObDASTabletLoc &tablet = *tablets.at(i);
-      int64_t partition_size = 0;
-      // get partition size from storage
-      if (need_convert_new_range &&
-          OB_FAIL(convert_new_range_to_store_range(allocator,
-                                                   tsc,
-                                                   tablet.tablet_id_,
-                                                   input_ranges,
-                                                   input_store_ranges,
-                                                   need_convert_new_range))) {
-        LOG_WARN("failed to convert new range to store range", K(ret));
-      } else if (OB_FAIL(access_service->get_multi_ranges_cost(tablet.ls_id_,
-                                                               tablet.tablet_id_,
-                                                               input_store_ranges,
-                                                               partition_size))) {
-        LOG_WARN("failed to get multi ranges cost", K(ret), K(tablet));
-      } else {
-        // B to MB
-        partition_size = partition_size / 1024 / 1024;
-      }
-
-      if (OB_SUCC(ret)) {
-        if (partition_size == 0) {
-          empty_partition_cnt++;
-        }
-        if (OB_FAIL(size_each_partitions.push_back(partition_size))) {
-          LOG_WARN("failed to push partition size", K(ret));
-        } else {
-          total_size += partition_size;
-        }
+    if (OB_FAIL(get_partitions_size(allocator, tsc, input_ranges, tablets, size_each_partitions))) {
+      LOG_WARN("failed to get partitions size", K(ret));
+    }
+    for (int i = 0; i < size_each_partitions.count() && OB_SUCC(ret); i++) {
+      // B to MB
+      int64_t &partition_size = size_each_partitions.at(i);
+      partition_size = partition_size / 1024 / 1024;
+      if (partition_size == 0) {
+        empty_partition_cnt++;
       }
+      total_size += partition_size;
     }
   }
 
@@ -305,6 +283,44 @@ int ObGranuleUtil::split_block_granule(ObIAllocator &allocator,
   return ret;
 }
 
+int ObGranuleUtil::get_partitions_size(ObIAllocator &allocator,
+                                       const ObTableScanSpec *tsc,
+                                       const ObIArray<common::ObNewRange> &input_ranges,
+                                       const ObIArray<ObDASTabletLoc*> &tablets,
+                                       ObIArray<int64_t> &size_each_partitions)
+{
+  int ret = OB_SUCCESS;
+  ObAccessService *access_service = MTL(ObAccessService *);
+  ObSEArray<ObStoreRange, 16> input_store_ranges;
+  bool need_convert_new_range = true;//only rowid range need extra convert.
+  if (OB_ISNULL(access_service)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("access service is null", K(ret));
+  }
+  for (int i = 0; i < tablets.count() && OB_SUCC(ret); i++) {
+    const ObDASTabletLoc &tablet = *tablets.at(i);
+    int64_t partition_size = 0;
+    // get partition size from storage
+    if (need_convert_new_range &&
+        OB_FAIL(convert_new_range_to_store_range(allocator,
+                                                 tsc,
+                                                 tablet.tablet_id_,
+                                                 input_ranges,
+                                                 input_store_ranges,
+                                                 need_convert_new_range))) {
+      LOG_WARN("failed to convert new range to store range", K(ret));
+    } else if (OB_FAIL(access_service->get_multi_ranges_cost(tablet.ls_id_,
+                                                             tablet.tablet_id_,
+                                                             input_store_ranges,
+                                                             partition_size))) {
+      LOG_WARN("failed to get multi ranges cost", K(ret), K(tablet));
+    } else if (OB_FAIL(size_each_partitions.push_back(partition_size))) {
+      LOG_WARN("failed to push partition size", K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObGranuleUtil::compute_total_task_count(const ObParallelBlockRangeTaskParams &params,
                                       int64_t total_size,
                                       int64_t &total_task_count)
@@ -197,6 +197,15 @@ public:
   static int remove_empty_range(const common::ObIArray<common::ObNewRange> &in_ranges,
                                 common::ObIArray<common::ObNewRange> &ranges,
                                 bool &only_empty_range);
+  /**
+   * estimate the size in bytes of the ranges in each partition from the index blocks
+   * size_each_partitions       OUT the estimated size, in the order of tablets
+   */
+  static int get_partitions_size(common::ObIAllocator &allocator,
+                                 const ObTableScanSpec *tsc,
+                                 const common::ObIArray<common::ObNewRange> &input_ranges,
+                                 const common::ObIArray<ObDASTabletLoc*> &tablets,
+                                 common::ObIArray<int64_t> &size_each_partitions);
 public:
   /**
    * split tasks by block granule method
@@ -37,10 +37,12 @@ using namespace obrpc;
 
 ObPxBloomFilter::ObPxBloomFilter() : data_length_(0), bits_count_(0), fpp_(0.0),
     hash_func_count_(0), is_inited_(false), bits_array_length_(0),
-    bits_array_(NULL), true_count_(0), begin_idx_(0), end_idx_(0), allocator_(),
+    bits_array_(NULL), true_count_(0), begin_idx_(0), end_idx_(0),
+    range_key_mask_(0), range_unsigned_mask_(0), in_list_slots_(NULL),
+    in_list_count_(0), in_list_valid_(false), allocator_(),
     px_bf_recieve_count_(0), px_bf_recieve_size_(0), px_bf_merge_filter_count_(0)
 {
-
+  reset_range();
 }
 
 int ObPxBloomFilter::init(int64_t data_length, ObIAllocator &allocator, double fpp /*= 0.01 */)
@@ -93,12 +95,21 @@ int ObPxBloomFilter::init(ObPxBloomFilter *filter)
     bits_array_ = filter->bits_array_;
     true_count_ = filter->true_count_;
     might_contain_ = filter->might_contain_;
+    range_key_mask_ = filter->range_key_mask_;
+    range_unsigned_mask_ = filter->range_unsigned_mask_;
+    MEMCPY(range_min_, filter->range_min_, sizeof(range_min_));
+    MEMCPY(range_max_, filter->range_max_, sizeof(range_max_));
+    in_list_slots_ = filter->in_list_slots_;
+    in_list_count_ = filter->in_list_count_;
+    in_list_valid_ = filter->in_list_valid_;
   }
   return ret;
 }
 void ObPxBloomFilter::reset_filter()
 {
   MEMSET(bits_array_, 0, bits_array_length_ * sizeof(int64_t));
+  reset_range();
+  reset_in_list();
   px_bf_recieve_count_ = 0;
   px_bf_recieve_size_ = 0;
 }
@@ -144,6 +155,9 @@ int ObPxBloomFilter::put(uint64_t hash)
     (void)set(block_begin + 1, 1L << (hash_high >> 8));
     (void)set(block_begin + 2, 1L << (hash_high >> 16));
     (void)set(block_begin + 3, 1L << (hash_high >> 24));
+    if (in_list_valid_) {
+      put_in_list(hash);
+    }
   }
   return ret;
 }
@@ -158,6 +172,30 @@ int ObPxBloomFilter::put_batch(ObPxBFHashArray &hash_val_array)
   return ret;
 }
 
+int ObPxBloomFilter::put_batch(const uint64_t *hash_values, const ObBitVector &skip,
+                               const int64_t batch_size)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited_) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("the px bloom filter is not inited", K(ret));
+  } else {
+    for (int64_t i = 0; i < batch_size && i < BATCH_PREFETCH_DISTANCE; ++i) {
+      prefetch_bits_block(hash_values[i]);
+    }
+    if (OB_FAIL(ObBitVector::flip_foreach(skip, batch_size,
+        [&](int64_t idx) __attribute__((always_inline)) {
+          if (idx + BATCH_PREFETCH_DISTANCE < batch_size) {
+            prefetch_bits_block(hash_values[idx + BATCH_PREFETCH_DISTANCE]);
+          }
+          return put(hash_values[idx]);
+        }))) {
+      LOG_WARN("fail to put hash values to px bloom filter", K(ret), K(batch_size));
+    }
+  }
+  return ret;
+}
+
 int ObPxBloomFilter::might_contain_nonsimd(uint64_t hash, bool &is_match)
 {
   int ret = OB_SUCCESS;
@@ -203,10 +241,155 @@ int ObPxBloomFilter::merge_filter(ObPxBloomFilter *filter)
         new_v = old_v | filter->bits_array_[i];
       } while(ATOMIC_CAS(&bits_array_[i + filter->begin_idx_], old_v, new_v) != old_v);
     }
+    merge_range(*filter);
+    merge_in_list(*filter);
   }
   return ret;
 }
 
+int ObPxBloomFilter::init_in_list(ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(in_list_slots_ = static_cast<uint64_t *>(
+      allocator.alloc(IN_LIST_SLOT_COUNT * sizeof(uint64_t))))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("fail to alloc in list slots", K(ret));
+  } else {
+    reset_in_list();
+  }
+  return ret;
+}
+
+void ObPxBloomFilter::reset_in_list()
+{
+  if (OB_NOT_NULL(in_list_slots_)) {
+    MEMSET(in_list_slots_, 0, IN_LIST_SLOT_COUNT * sizeof(uint64_t));
+    in_list_count_ = 0;
+    in_list_valid_ = true;
+  }
+}
+
+// 多个 worker 共享一个 filter 时会并发插入, 槽位用 CAS 抢占;
+// distinct 值超过 MAX_IN_LIST_COUNT 后 in-list 失效, 只用 bloom filter 过滤.
+void ObPxBloomFilter::put_in_list(uint64_t hash)
+{
+  const uint64_t value = (0 == hash) ? 1 : hash;
+  const int64_t mask = IN_LIST_SLOT_COUNT - 1;
+  int64_t pos = static_cast<int64_t>(value & mask);
+  bool done = false;
+  while (!done && ATOMIC_LOAD(&in_list_valid_)) {
+    uint64_t cur = ATOMIC_LOAD(&in_list_slots_[pos]);
+    if (cur == value) {
+      done = true;
+    } else if (0 == cur) {
+      if (ATOMIC_BCAS(&in_list_slots_[pos], 0, value)) {
+        done = true;
+        if (ATOMIC_AAF(&in_list_count_, 1) > MAX_IN_LIST_COUNT) {
+          ATOMIC_STORE(&in_list_valid_, false);
+        }
+      }
+    } else {
+      pos = (pos + 1) & mask;
+    }
+  }
+}
+
+bool ObPxBloomFilter::in_list_contain(uint64_t hash) const
+{
+  const uint64_t value = (0 == hash) ? 1 : hash;
+  const int64_t mask = IN_LIST_SLOT_COUNT - 1;
+  int64_t pos = static_cast<int64_t>(value & mask);
+  bool found = false;
+  bool end = false;
+  // in-list 有效时至少一半槽位为空, 探测一定能结束
+  while (!found && !end) {
+    if (in_list_slots_[pos] == value) {
+      found = true;
+    } else if (0 == in_list_slots_[pos]) {
+      end = true;
+    } else {
+      pos = (pos + 1) & mask;
+    }
+  }
+  return found;
+}
+
+void ObPxBloomFilter::merge_in_list(const ObPxBloomFilter &filter)
+{
+  if (!ATOMIC_LOAD(&in_list_valid_)) {
+  } else if (!filter.in_list_valid_ || OB_ISNULL(filter.in_list_slots_)) {
+    ATOMIC_STORE(&in_list_valid_, false);
+  } else {
+    for (int64_t i = 0; i < IN_LIST_SLOT_COUNT && ATOMIC_LOAD(&in_list_valid_); ++i) {
+      if (0 != filter.in_list_slots_[i]) {
+        put_in_list(filter.in_list_slots_[i]);
+      }
+    }
+  }
+}
+
+void ObPxBloomFilter::init_range(int64_t key_mask, int64_t unsigned_mask)
+{
+  range_key_mask_ = key_mask;
+  range_unsigned_mask_ = unsigned_mask & key_mask;
+  reset_range();
+}
+
+// 空 range 表示为 min > max, 合并时直接取并集即可
+void ObPxBloomFilter::reset_range()
+{
+  for (int64_t i = 0; i < MAX_RANGE_KEY_COUNT; ++i) {
+    if (is_range_unsigned(i)) {
+      range_min_[i] = static_cast<int64_t>(UINT64_MAX);
+      range_max_[i] = 0;
+    } else {
+      range_min_[i] = INT64_MAX;
+      range_max_[i] = INT64_MIN;
+    }
+  }
+}
+
+void ObPxBloomFilter::update_range(int64_t key_idx, int64_t value)
+{
+  const bool is_unsigned = is_range_unsigned(key_idx);
+  int64_t old_v = ATOMIC_LOAD(&range_min_[key_idx]);
+  while (range_less(value, old_v, is_unsigned)
+         && !ATOMIC_BCAS(&range_min_[key_idx], old_v, value)) {
+    old_v = ATOMIC_LOAD(&range_min_[key_idx]);
+  }
+  old_v = ATOMIC_LOAD(&range_max_[key_idx]);
+  while (range_less(old_v, value, is_unsigned)
+         && !ATOMIC_BCAS(&range_max_[key_idx], old_v, value)) {
+    old_v = ATOMIC_LOAD(&range_max_[key_idx]);
+  }
+}
+
+bool ObPxBloomFilter::range_might_contain(int64_t key_idx, int64_t value) const
+{
+  const bool is_unsigned = is_range_unsigned(key_idx);
+  return !range_less(value, range_min_[key_idx], is_unsigned)
+         && !range_less(range_max_[key_idx], value, is_unsigned);
+}
+
+// 只保留双方都维护了 range 且符号一致的 key, 老版本发来的 filter 不带 range, 合并后 range 失效
+void ObPxBloomFilter::merge_range(const ObPxBloomFilter &filter)
+{
+  int64_t old_mask = 0;
+  int64_t new_mask = 0;
+  do {
+    old_mask = ATOMIC_LOAD(&range_key_mask_);
+    new_mask = old_mask & filter.range_key_mask_
+               & ~(range_unsigned_mask_ ^ filter.range_unsigned_mask_);
+  } while (old_mask != new_mask && !ATOMIC_BCAS(&range_key_mask_, old_mask, new_mask));
+  for (int64_t i = 0; i < MAX_RANGE_KEY_COUNT; ++i) {
+    if (has_range(i)
+        && !range_less(filter.range_max_[i], filter.range_min_[i], is_range_unsigned(i))) {
+      update_range(i, filter.range_min_[i]);
+      update_range(i, filter.range_max_[i]);
+    }
+  }
+}
+
 bool ObPxBloomFilter::check_ready()
 {
   return px_bf_recieve_count_ > 0 &&
@@ -320,6 +503,22 @@ OB_DEF_SERIALIZE(ObPxBloomFilter)
       LOG_WARN("fail to encode bits data", K(ret), K(bits_array_[i]));
     }
   }
+  LST_DO_CODE(OB_UNIS_ENCODE, range_key_mask_, range_unsigned_mask_);
+  for (int64_t i = 0; OB_SUCC(ret) && i < MAX_RANGE_KEY_COUNT; ++i) {
+    if (has_range(i)) {
+      LST_DO_CODE(OB_UNIS_ENCODE, range_min_[i], range_max_[i]);
+    }
+  }
+  const bool in_list_valid = in_list_valid_ && OB_NOT_NULL(in_list_slots_);
+  OB_UNIS_ENCODE(in_list_valid);
+  if (OB_SUCC(ret) && in_list_valid) {
+    OB_UNIS_ENCODE(in_list_count_);
+    for (int64_t i = 0; OB_SUCC(ret) && i < IN_LIST_SLOT_COUNT; ++i) {
+      if (0 != in_list_slots_[i]) {
+        OB_UNIS_ENCODE(in_list_slots_[i]);
+      }
+    }
+  }
   return ret;
 }
 
@@ -358,6 +557,32 @@ OB_DEF_DESERIALIZE(ObPxBloomFilter)
                        : &ObPxBloomFilter::might_contain_nonsimd;
     }
   }
+  // 老版本序列化的 filter 不带 range 和 in-list, 保持默认的失效状态
+  LST_DO_CODE(OB_UNIS_DECODE, range_key_mask_, range_unsigned_mask_);
+  if (OB_SUCC(ret)) {
+    reset_range();
+  }
+  for (int64_t i = 0; OB_SUCC(ret) && i < MAX_RANGE_KEY_COUNT; ++i) {
+    if (has_range(i)) {
+      LST_DO_CODE(OB_UNIS_DECODE, range_min_[i], range_max_[i]);
+    }
+  }
+  bool in_list_valid = false;
+  int64_t in_list_count = 0;
+  OB_UNIS_DECODE(in_list_valid);
+  if (OB_FAIL(ret) || !in_list_valid) {
+  } else if (OB_FAIL(init_in_list(allocator_))) {
+    LOG_WARN("fail to init in list", K(ret));
+  } else {
+    OB_UNIS_DECODE(in_list_count);
+    for (int64_t i = 0; OB_SUCC(ret) && i < in_list_count; ++i) {
+      uint64_t value = 0;
+      OB_UNIS_DECODE(value);
+      if (OB_SUCC(ret)) {
+        put_in_list(value);
+      }
+    }
+  }
   return ret;
 }
 
@@ -377,6 +602,22 @@ OB_DEF_SERIALIZE_SIZE(ObPxBloomFilter)
   for (int i = begin_idx_; i <= end_idx_; ++i) {
     len += serialization::encoded_length(bits_array_[i]);
   }
+  LST_DO_CODE(OB_UNIS_ADD_LEN, range_key_mask_, range_unsigned_mask_);
+  for (int64_t i = 0; i < MAX_RANGE_KEY_COUNT; ++i) {
+    if (has_range(i)) {
+      LST_DO_CODE(OB_UNIS_ADD_LEN, range_min_[i], range_max_[i]);
+    }
+  }
+  const bool in_list_valid = in_list_valid_ && OB_NOT_NULL(in_list_slots_);
+  OB_UNIS_ADD_LEN(in_list_valid);
+  if (in_list_valid) {
+    OB_UNIS_ADD_LEN(in_list_count_);
+    for (int64_t i = 0; i < IN_LIST_SLOT_COUNT; ++i) {
+      if (0 != in_list_slots_[i]) {
+        OB_UNIS_ADD_LEN(in_list_slots_[i]);
+      }
+    }
+  }
   return len;
 }
 
@@ -19,6 +19,7 @@
 #include "lib/lock/ob_spin_lock.h"
 #include "share/config/ob_server_config.h"
 #include "observer/ob_server_struct.h"
+#include "sql/engine/ob_bit_vector.h"
 #ifndef __SQL_ENG_PX_BLOOM_FILTER_H__
 #define __SQL_ENG_PX_BLOOM_FILTER_H__
 
@@ -66,6 +67,13 @@ public:
   }
   int put(uint64_t hash);
   int put_batch(ObPxBFHashArray &hash_val_array);
+  // 批量插入/探测: 每个 hash 值对应的 4 个 bit 位于同一个 32 字节的 block 内,
+  // 处理第 i 行时预取第 i + BATCH_PREFETCH_DISTANCE 行的 block, 用访存并行掩盖 cache miss.
+  // skip 中置位的行不处理; 探测结果通过 op(idx, is_match) 返回.
+  int put_batch(const uint64_t *hash_values, const ObBitVector &skip, const int64_t batch_size);
+  template <typename OP>
+  int might_contain_batch(const uint64_t *hash_values, const ObBitVector &skip,
+                          const int64_t batch_size, OP op);
   int merge_filter(ObPxBloomFilter *filter);
   int64_t get_value_true_count() const { return true_count_; };
   void dump_filter();      //for debug
@@ -89,8 +97,28 @@ public:
   typedef int (ObPxBloomFilter::*GetFunc)(uint64_t hash, bool &is_match);
   int generate_receive_count_array();
   void reset();
+  // 除 bloom filter 外, 同时收集 join key 的 min/max range 和精确的 in-list.
+  // range 按 join key 逐列维护, 仅支持整数类型的 key;
+  // in-list 记录 join key 组合的 hash 值, build 端 distinct 值不超过 MAX_IN_LIST_COUNT 时有效.
+  int init_in_list(common::ObIAllocator &allocator);
+  void init_range(int64_t key_mask, int64_t unsigned_mask);
+  void update_range(int64_t key_idx, int64_t value);
+  inline bool has_range(int64_t key_idx) const
+  { return key_idx < MAX_RANGE_KEY_COUNT && 0 != (range_key_mask_ & (1L << key_idx)); }
+  inline bool is_range_unsigned(int64_t key_idx) const
+  { return 0 != (range_unsigned_mask_ & (1L << key_idx)); }
+  bool range_might_contain(int64_t key_idx, int64_t value) const;
+  inline bool is_in_list_valid() const { return in_list_valid_; }
+  bool in_list_contain(uint64_t hash) const;
   TO_STRING_KV(K_(data_length), K_(bits_count), K_(fpp), K_(hash_func_count), K_(is_inited),
-      K_(bits_array_length), K_(true_count));
+      K_(bits_array_length), K_(true_count), K_(range_key_mask), K_(range_unsigned_mask),
+      K_(in_list_valid), K_(in_list_count));
+public:
+  static const int64_t BATCH_PREFETCH_DISTANCE = 16;
+  static const int64_t MAX_RANGE_KEY_COUNT = 8;
+  static const int64_t MAX_IN_LIST_COUNT = 1024;
+  // 开放寻址 hash 表, 装载因子不超过 0.5
+  static const int64_t IN_LIST_SLOT_COUNT = MAX_IN_LIST_COUNT * 2;
 private:
   bool get(uint64_t pos, uint64_t index) { return (bits_array_[pos] & index) != 0; }
   bool set(uint64_t block_begin, uint64_t index);
@@ -98,6 +126,13 @@ private:
   void calc_num_of_bits();
   int might_contain_nonsimd(uint64_t hash, bool &is_match);
   int might_contain_simd(uint64_t hash, bool &is_match);
+  void put_in_list(uint64_t hash);
+  void merge_in_list(const ObPxBloomFilter &filter);
+  void merge_range(const ObPxBloomFilter &filter);
+  void reset_range();
+  void reset_in_list();
+  static inline bool range_less(int64_t l, int64_t r, bool is_unsigned)
+  { return is_unsigned ? static_cast<uint64_t>(l) < static_cast<uint64_t>(r) : l < r; }
 
 private:
   int64_t data_length_;          //原始数据长度
@@ -111,6 +146,13 @@ private:
   int64_t begin_idx_;            // join filter begin position
   int64_t end_idx_;              // join filter end position
   GetFunc might_contain_;       // function pointer for might contain
+  int64_t range_key_mask_;       // 第 i 位表示第 i 个 join key 维护了 range
+  int64_t range_unsigned_mask_;  // 第 i 位表示第 i 个 join key 为无符号整数
+  int64_t range_min_[MAX_RANGE_KEY_COUNT];
+  int64_t range_max_[MAX_RANGE_KEY_COUNT];
+  uint64_t *in_list_slots_;      // 0 表示空槽位, hash 值为 0 时按 1 存储
+  int64_t in_list_count_;
+  bool in_list_valid_;
 private:
   common::ObArenaAllocator allocator_;
 public:
@@ -122,6 +164,29 @@ public:
 DISALLOW_COPY_AND_ASSIGN(ObPxBloomFilter);
 };
 
+template <typename OP>
+int ObPxBloomFilter::might_contain_batch(const uint64_t *hash_values, const ObBitVector &skip,
+                                         const int64_t batch_size, OP op)
+{
+  // block 下标总是落在 bits_array_ 内, 对未计算 hash 的 skip 行做预取也是安全的
+  for (int64_t i = 0; i < batch_size && i < BATCH_PREFETCH_DISTANCE; ++i) {
+    prefetch_bits_block(hash_values[i]);
+  }
+  return ObBitVector::flip_foreach(skip, batch_size,
+    [&](int64_t idx) __attribute__((always_inline)) {
+      int ret = common::OB_SUCCESS;
+      bool is_match = true;
+      if (idx + BATCH_PREFETCH_DISTANCE < batch_size) {
+        prefetch_bits_block(hash_values[idx + BATCH_PREFETCH_DISTANCE]);
+      }
+      if (OB_FAIL(might_contain(hash_values[idx], is_match))) {
+      } else {
+        ret = op(idx, is_match);
+      }
+      return ret;
+    });
+}
+
 struct ObPxBFStaticInfo
 {
   OB_UNIS_VERSION(1);
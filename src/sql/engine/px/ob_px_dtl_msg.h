@@ -378,7 +378,8 @@ public:
         sqc_affected_rows_(0),
         dml_row_info_(),
         temp_table_id_(common::OB_INVALID_ID),
-        interm_result_ids_() {}
+        interm_result_ids_(),
+        sqc_output_rows_(-1) {}
   virtual ~ObPxFinishSqcResultMsg() = default;
   const transaction::ObTxExecResult &get_trans_result() const { return trans_result_; }
   transaction::ObTxExecResult &get_trans_result() { return trans_result_; }
@@ -390,8 +391,9 @@ public:
     trans_result_.reset();
     task_monitor_info_array_.reset();
     dml_row_info_.reset();
+    sqc_output_rows_ = -1;
   }
-  TO_STRING_KV(K_(dfo_id), K_(sqc_id), K_(rc), K_(sqc_affected_rows));
+  TO_STRING_KV(K_(dfo_id), K_(sqc_id), K_(rc), K_(sqc_affected_rows), K_(sqc_output_rows));
 public:
   int64_t dfo_id_;
   int64_t sqc_id_;
@@ -402,6 +404,8 @@ public:
   ObPxDmlRowInfo dml_row_info_; // SQC存在DML算子时, 需要统计行 信息
   uint64_t temp_table_id_;
   ObSEArray<uint64_t, 8> interm_result_ids_;
+  // 一个 sqc 所有 task 的 transmit 算子发送的行数，-1 表示未统计（低版本 sqc 或 mock 的 finish 消息）
+  int64_t sqc_output_rows_;
 };
 
 class ObPxFinishTaskResultMsg
@@ -190,7 +190,8 @@ int ObReceiveRowReader::add_buffer(dtl::ObDtlLinkedBuffer &buf, bool &transferre
     if (dtl::PX_DATUM_ROW == buf.msg_type()) {
       auto block = reinterpret_cast<ObChunkDatumStore::Block *>(buf.buf());
       rows = block->rows_;
-      if (rows > 0 && OB_FAIL(block->swizzling(NULL))) {
+      // rows sent by local channel already point into the buffer, read them in place
+      if (rows > 0 && !buf.has_flag(DTL_SWIZZLED_ROWS) && OB_FAIL(block->swizzling(NULL))) {
         LOG_WARN("block swizzling failed", K(ret));
       }
     } else {
@@ -383,6 +383,7 @@ int ObPxSQCProxy::report(int end_ret) const
   ObPxSqcMeta &sqc = sqc_arg.sqc_;
   ObPxFinishSqcResultMsg finish_msg;
   int64_t affected_rows = 0;
+  int64_t output_rows = 0;
   // 任意一个 task 失败，则意味着全部 task 失败
   // 第一版暂不支持重试
   int sqc_ret = OB_SUCCESS;
@@ -396,6 +397,7 @@ int ObPxSQCProxy::report(int end_ret) const
     ObPxTask &task = tasks.at(i);
     update_error_code(sqc_ret, task.get_result());
     affected_rows += task.get_affected_rows();
+    output_rows += task.get_output_rows();
     finish_msg.dml_row_info_.add_px_dml_row_info(task.dml_row_info_);
     finish_msg.temp_table_id_ = task.temp_table_id_;
     if (OB_NOT_NULL(session)) {
@@ -417,6 +419,7 @@ int ObPxSQCProxy::report(int end_ret) const
     sqc_ret = ret;
   }
   finish_msg.sqc_affected_rows_ = affected_rows;
+  finish_msg.sqc_output_rows_ = output_rows;
   finish_msg.sqc_id_ = sqc.get_sqc_id();
   finish_msg.dfo_id_ = sqc.get_dfo_id();
   finish_msg.rc_ = sqc_ret;
@@ -231,6 +231,8 @@ int ObPxSubCoord::init_px_bloom_filter_advance(ObExecContext *ctx, ObOpSpec *roo
                                                                ctx->get_allocator(),
                                                                filter_use))) {
         LOG_WARN("fail to init px bloom filter", K(ret));
+      } else if (OB_FAIL(filter_op->init_runtime_filter(*ctx, *filter_use))) {
+        LOG_WARN("fail to init runtime filter", K(ret));
       } else if (OB_FAIL(filter_use->generate_receive_count_array())) {
         LOG_WARN("fail to generate receive count array", K(ret));
       } else if (OB_FAIL(ObPxBloomFilterManager::instance().set_px_bloom_filter(bf_key, filter_use))) {
@@ -360,6 +362,8 @@ int ObPxSubCoord::setup_op_input(ObExecContext &ctx,
       } else if (OB_FAIL(ObPxBloomFilterManager::init_px_bloom_filter(filter_len,
           ctx.get_allocator(), filter_create))) {
         LOG_WARN("fail to init px bloom filter", K(ret));
+      } else if (OB_FAIL(filter_spec->init_runtime_filter(ctx, *filter_create))) {
+        LOG_WARN("fail to init runtime filter", K(ret));
       } else {
         filter_input->share_info_.filter_ptr_ = reinterpret_cast<uint64_t>(filter_create);
       }
@@ -303,7 +303,12 @@ int ObPxTaskProcess::execute(ObOpSpec &root_spec)
       // 需要将对应的affected row存储到sqc task中
       arg_.sqc_task_ptr_->set_affected_rows(ctx.get_physical_plan_ctx()->get_affected_rows());
       arg_.sqc_task_ptr_->dml_row_info_.set_px_dml_row_info(*ctx.get_physical_plan_ctx());
-      LOG_TRACE("the affected row from sqc task", K(arg_.sqc_task_ptr_->get_affected_rows()));
+      // transmit 从 child 拉取的行数即为本 task 向上游发送的行数，QC 据此调整后续 dfo 的并发度
+      if (OB_NOT_NULL(root->get_child())) {
+        arg_.sqc_task_ptr_->set_output_rows(root->get_child()->get_monitor_info().output_row_count_);
+      }
+      LOG_TRACE("the affected row from sqc task", K(arg_.sqc_task_ptr_->get_affected_rows()),
+                K(arg_.sqc_task_ptr_->get_output_rows()));
     }
     // record ret code
     if (OB_FAIL(ret)) {
@@ -527,6 +527,10 @@ int ObPXServerAddrUtil::alloc_by_random_distribution(ObExecContext &exec_ctx,
     LOG_WARN("fail get location addrs", K(ret));
   } else {
     int64_t parallel = child.get_assigned_worker_count();
+    if (parent.get_adaptive_dop() > 0 && parent.get_adaptive_dop() < parallel) {
+      // 调度器已按 child 实际输入行数收缩了并发度
+      parallel = parent.get_adaptive_dop();
+    }
     if (0 >= parallel) {
       parallel = 1;
     }
@@ -24,6 +24,7 @@
 #include "observer/ob_server_struct.h"
 #include "observer/ob_server.h"
 #include "observer/virtual_table/ob_virtual_data_access_service.h"
+#include "share/diagnosis/ob_sql_monitor_statname.h"
 
 namespace oceanbase
 {
@@ -1658,8 +1659,10 @@ int ObTableScanOp::inner_get_next_row()
     ObTableScanParam &scan_param = DAS_SCAN_OP(*das_ref_.begin_task_iter())->get_scan_param();
     ObTableScanStat &table_scan_stat = GET_PHY_PLAN_CTX(ctx_)->get_table_scan_stat();
     fill_table_scan_stat(scan_param.main_table_scan_stat_, table_scan_stat);
+    fill_prefetch_monitor_info(scan_param.main_table_scan_stat_);
     if (MY_SPEC.should_scan_index() && scan_param.scan_flag_.index_back_) {
       fill_table_scan_stat(scan_param.idx_table_scan_stat_, table_scan_stat);
+      fill_prefetch_monitor_info(scan_param.idx_table_scan_stat_);
     }
     scan_param.main_table_scan_stat_.reset_cache_stat();
     scan_param.idx_table_scan_stat_.reset_cache_stat();
@@ -1745,8 +1748,10 @@ int ObTableScanOp::inner_get_next_batch(const int64_t max_row_cnt)
     ObTableScanParam &scan_param = DAS_SCAN_OP(*das_ref_.begin_task_iter())->get_scan_param();
     ObTableScanStat &table_scan_stat = GET_PHY_PLAN_CTX(ctx_)->get_table_scan_stat();
     fill_table_scan_stat(scan_param.main_table_scan_stat_, table_scan_stat);
+    fill_prefetch_monitor_info(scan_param.main_table_scan_stat_);
     if (MY_SPEC.should_scan_index() && scan_param.scan_flag_.index_back_) {
       fill_table_scan_stat(scan_param.idx_table_scan_stat_, table_scan_stat);
+      fill_prefetch_monitor_info(scan_param.idx_table_scan_stat_);
     }
     scan_param.main_table_scan_stat_.reset_cache_stat();
     scan_param.idx_table_scan_stat_.reset_cache_stat();
@@ -2078,6 +2083,14 @@ OB_INLINE void ObTableScanOp::fill_table_scan_stat(const ObTableScanStatistic &s
   scan_stat.row_cache_miss_cnt_ += statistic.row_cache_miss_cnt_;
 }
 
+void ObTableScanOp::fill_prefetch_monitor_info(const ObTableScanStatistic &statistic)
+{
+  op_monitor_info_.otherstat_1_id_ = ObSqlMonitorStatIds::BLOCK_IO_WAIT_TIME;
+  op_monitor_info_.otherstat_1_value_ += statistic.block_io_wait_time_;
+  op_monitor_info_.otherstat_2_id_ = ObSqlMonitorStatIds::MAX_PREFETCH_DEPTH;
+  op_monitor_info_.otherstat_2_value_ = MAX(op_monitor_info_.otherstat_2_value_, statistic.max_prefetch_depth_);
+}
+
 void ObTableScanOp::set_cache_stat(const ObPlanStat &plan_stat)
 {
   const int64_t TRY_USE_CACHE_INTERVAL = 15;
@@ -396,6 +396,7 @@ protected:
   //int extract_scan_ranges();
   void fill_table_scan_stat(const ObTableScanStatistic &statistic,
                             ObTableScanStat &scan_stat) const;
+  void fill_prefetch_monitor_info(const ObTableScanStatistic &statistic);
   void set_cache_stat(const ObPlanStat &plan_stat);
 
 protected:
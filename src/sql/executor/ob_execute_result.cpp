@@ -85,6 +85,24 @@ int ObExecuteResult::get_next_row(ObExecContext &ctx, const common::ObNewRow *&r
   return ret;
 }
 
+ObOperator *ObExecuteResult::get_vectorized_root() const
+{
+  return (NULL != static_engine_root_ && static_engine_root_->get_spec().is_vectorized())
+      ? static_engine_root_ : NULL;
+}
+
+int ObExecuteResult::get_next_batch_row_idx(int64_t &idx)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(get_vectorized_root())) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("root operator is not vectorized", K(ret), KP(static_engine_root_));
+  } else if (OB_SUCC(br_it_.get_next_row())) {
+    idx = br_it_.cur_idx();
+  }
+  return ret;
+}
+
 int ObExecuteResult::close(ObExecContext &ctx)
 {
   int ret = OB_SUCCESS;
@@ -34,6 +34,13 @@ public:
   virtual int open(ObExecContext &ctx) = 0;
   virtual int get_next_row(ObExecContext &ctx, const common::ObNewRow *&row) = 0;
   virtual int close(ObExecContext &ctx) = 0;
+  // 向量化输出时返回根算子, 调用者可直接从 output expr 的 batch datum 上读取结果行
+  virtual ObOperator *get_vectorized_root() const { return NULL; }
+  virtual int get_next_batch_row_idx(int64_t &idx)
+  {
+    UNUSED(idx);
+    return common::OB_NOT_SUPPORTED;
+  }
 };
 
 class ObExecuteResult : public ObIExecuteResult
@@ -49,6 +56,9 @@ public:
   virtual int open(ObExecContext &ctx) override;
   virtual int get_next_row(ObExecContext &ctx, const common::ObNewRow *&row) override;
   virtual int close(ObExecContext &ctx) override;
+  virtual ObOperator *get_vectorized_root() const override;
+  // 返回下一行在当前 batch 中的下标, 不做 datum 到 ObObj 的转换
+  virtual int get_next_batch_row_idx(int64_t &idx) override;
 
   inline int get_err_code() { return err_code_; }
 
@@ -361,6 +361,35 @@ OB_INLINE int ObResultSet::inner_get_next_row(const common::ObNewRow *&row)
   return ret;
 }
 
+ObOperator *ObResultSet::get_vectorized_root() const
+{
+  ObOperator *root = NULL;
+  if (NULL != cache_obj_guard_.get_cache_obj() && NULL != exec_result_) {
+    root = exec_result_->get_vectorized_root();
+  }
+  return root;
+}
+
+int ObResultSet::get_next_batch_row_idx(int64_t &idx)
+{
+  LinkExecCtxGuard link_guard(my_session_, get_exec_context());
+  int &ret = errcode_;
+  ObPhysicalPlan* physical_plan_ = static_cast<ObPhysicalPlan*>(cache_obj_guard_.get_cache_obj());
+  if (OB_ISNULL(physical_plan_) || OB_ISNULL(exec_result_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("plan or exec result is null", K(ret), KP(physical_plan_), KP(exec_result_));
+  } else if (OB_FAIL(exec_result_->get_next_batch_row_idx(idx))) {
+    if (OB_ITER_END != ret) {
+      LOG_WARN("get next batch row from exec result failed", K(ret));
+      // marked last execute status
+      physical_plan_->set_is_last_exec_succ(false);
+    }
+  } else {
+    return_rows_++;
+  }
+  return ret;
+}
+
 // 触发本错误的条件： A、B两个SQL，同时修改了某几行数据（修改内容有交集）。
 // 微观上，修改操作要先读出符合条件的行，然后再更新。在读的时候，会记录一个版本号，
 // 更新的时候，会检查版本号是否有变化。如果有变化，则说明在读之后、写之前，数据被其它
@@ -117,6 +117,12 @@ public:
   /// get the next result row
   /// @return OB_ITER_END when no more data available
   int get_next_row(const common::ObNewRow *&row);
+  /// root operator of the plan if its output is vectorized, NULL otherwise
+  ObOperator *get_vectorized_root() const;
+  /// get index of the next result row in the current batch of the vectorized root operator,
+  /// the row is not converted to ObNewRow, can be mixed with get_next_row()
+  /// @return OB_ITER_END when no more data available
+  int get_next_batch_row_idx(int64_t &idx);
   /// close the result set after get all the rows
   int close();
   /// get number of rows affected by INSERT/UPDATE/DELETE
@@ -163,6 +163,10 @@ int ObIndexTreePrefetcher::lookup_in_cache(ObSSTableReadHandle &read_handle)
     } else if (OB_UNLIKELY(read_handle.row_handle_.row_value_->get_start_log_ts() != sstable_->get_key().get_start_scn().get_val_for_tx())) {
       ++access_ctx_->table_store_stat_.row_cache_miss_cnt_;
       ret = OB_SUCCESS;
+    } else if (!read_handle.row_handle_.row_value_->contain_columns(iter_param_->get_read_info()->get_columns_index())) {
+      ++access_ctx_->table_store_stat_.row_cache_miss_cnt_;
+      read_handle.need_full_row_cache_ = true;
+      read_handle.row_handle_.reset();
     } else {
       found = true;
       read_handle.row_state_ = ObSSTableRowState::IN_ROW_CACHE;
@@ -383,9 +387,7 @@ int ObIndexTreePrefetcher::prefetch_block_data(
 
 void ObIndexTreeMultiPassPrefetcher::reset()
 {
-  for (int64_t i = 0; i < DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT; i++) {
-    micro_data_handles_[i].reset();
-  }
+  reset_micro_data_ring();
   for (int16_t level = 0; level < tree_handles_.count(); level++) {
     tree_handles_.at(level).reset();
   }
@@ -395,12 +397,17 @@ void ObIndexTreeMultiPassPrefetcher::reset()
   is_row_lock_checked_ = false;
   cur_range_fetch_idx_ = 0;
   cur_range_prefetch_idx_ = 0;
+  row_cache_prefetch_idx_ = 0;
   max_range_prefetching_cnt_ = 0;
   cur_micro_data_fetch_idx_ = -1;
   micro_data_prefetch_idx_ = 0;
   row_lock_check_version_ = transaction::ObTransVersion::INVALID_TRANS_VERSION;
   agg_row_store_ = nullptr;
   max_micro_handle_cnt_ = 0;
+  max_prefetch_depth_ = 0;
+  expected_micro_handle_cnt_ = 0;
+  is_io_bound_ = false;
+  reset_adaptive_window();
   iter_type_ = 0;
   cur_level_ = 0;
   index_tree_height_ = 0;
@@ -420,11 +427,14 @@ void ObIndexTreeMultiPassPrefetcher::reuse()
   is_row_lock_checked_ = false;
   cur_range_fetch_idx_ = 0;
   cur_range_prefetch_idx_ = 0;
+  row_cache_prefetch_idx_ = 0;
   cur_micro_data_fetch_idx_ = -1;
   micro_data_prefetch_idx_ = 0;
   row_lock_check_version_ = transaction::ObTransVersion::INVALID_TRANS_VERSION;
   agg_row_store_ = nullptr;
   prefetch_depth_ = 1;
+  // keep max_prefetch_depth_ learned by previous rounds, the device and cache state rarely change between rescans
+  reset_adaptive_window();
   total_micro_data_cnt_ = 0;
   for (int64_t i = 0; i < tree_handles_.count(); i++) {
     tree_handles_.at(i).reuse();
@@ -453,6 +463,7 @@ int ObIndexTreeMultiPassPrefetcher::init(
     tree_handles_.set_allocator(access_ctx.stmt_allocator_);
     read_handles_.set_allocator(access_ctx.stmt_allocator_);
     max_micro_handle_cnt_ = DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
+    max_prefetch_depth_ = max_micro_handle_cnt_;
     index_read_info_ = iter_param.get_full_read_info()->get_index_read_info();
     bool is_multi_range = false;
     if (OB_FAIL(init_basic_info(iter_type, sstable, access_ctx, query_range, is_multi_range))) {
@@ -492,7 +503,7 @@ int ObIndexTreeMultiPassPrefetcher::switch_context(
   } else {
     if (!is_rescan_) {
       is_rescan_ = true;
-      for (int64_t i = 0; i < DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT; i++) {
+      for (int64_t i = 0; i < max_micro_handle_cnt_; i++) {
         micro_data_handles_[i].reset();
       }
       for (int16_t level = 0; level < tree_handles_.count(); level++) {
@@ -595,7 +606,7 @@ int ObIndexTreeMultiPassPrefetcher::prefetch()
     ret = OB_NOT_INIT;
     LOG_WARN("ObIndexTreeMultiPassPrefetcher not init", K(ret));
   } else if (is_prefetch_end_) {
-  } else if (micro_data_prefetch_idx_ - cur_micro_data_fetch_idx_ >= max_micro_handle_cnt_ / 2) {
+  } else if (micro_data_prefetch_idx_ - cur_micro_data_fetch_idx_ >= prefetch_refill_threshold()) {
     // continue current prefetch
   } else if (OB_FAIL(prefetch_index_tree())) {
     if (OB_LIKELY(OB_ITER_END == ret)) {
@@ -652,7 +663,9 @@ int ObIndexTreeMultiPassPrefetcher::try_add_query_range(ObIndexTreeLevelHandle &
   } else if (0 == cur_range_prefetch_idx_ || tree_handle.reach_scanner_end()) {
     tree_handle.fetch_idx_ = tree_handle.prefetch_idx_ = 0;
     ObSSTableReadHandle &read_handle = read_handles_[cur_range_prefetch_idx_ % max_range_prefetching_cnt_];
-    if (OB_FAIL(prepare_read_handle(tree_handle, read_handle))) {
+    if (OB_FAIL(prefetch_row_cache())) {
+      LOG_WARN("Fail to prefetch row cache", K(ret));
+    } else if (OB_FAIL(prepare_read_handle(tree_handle, read_handle))) {
       LOG_WARN("Fail to prepare read handle", K(ret));
     } else if (read_handle.is_get_) {
       // get
@@ -701,6 +714,28 @@ int ObIndexTreeMultiPassPrefetcher::try_add_query_range(ObIndexTreeLevelHandle &
   return ret;
 }
 
+// probe row cache for a batch of rowkeys at once in multi get, instead of missing the cpu cache
+// in every single lookup_in_cache
+int ObIndexTreeMultiPassPrefetcher::prefetch_row_cache()
+{
+  int ret = OB_SUCCESS;
+  if (ObStoreRowIterator::IteratorMultiGet == iter_type_
+      && cur_range_prefetch_idx_ >= row_cache_prefetch_idx_
+      && access_ctx_->enable_get_row_cache()
+      && !sstable_->get_meta().is_empty()) {
+    const int64_t prefetch_cnt = MIN(rowkeys_->count() - cur_range_prefetch_idx_,
+                                     ObRowCache::MAX_PREFETCH_ROW_CNT);
+    if (OB_FAIL(ObStorageCacheSuite::get_instance().get_row_cache().prefetch_rows(
+                MTL_ID(), iter_param_->tablet_id_, *rowkeys_, cur_range_prefetch_idx_, prefetch_cnt,
+                index_read_info_->get_datum_utils(), data_version_, sstable_->get_key().table_type_))) {
+      LOG_WARN("Fail to prefetch rows in row cache", K(ret), K_(cur_range_prefetch_idx), K(prefetch_cnt));
+    } else {
+      row_cache_prefetch_idx_ = static_cast<int32_t>(cur_range_prefetch_idx_ + prefetch_cnt);
+    }
+  }
+  return ret;
+}
+
 int ObIndexTreeMultiPassPrefetcher::prefetch_micro_data()
 {
   int ret = OB_SUCCESS;
@@ -709,12 +744,15 @@ int ObIndexTreeMultiPassPrefetcher::prefetch_micro_data()
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("Unexpected prefetch status", K(ret), K_(cur_level), K_(index_tree_height),
              K_(micro_data_prefetch_idx), K_(cur_micro_data_fetch_idx), K_(max_micro_handle_cnt));
+  } else if (OB_UNLIKELY(expected_micro_handle_cnt_ > max_micro_handle_cnt_) &&
+             OB_FAIL(expand_micro_data_ring())) {
+    LOG_WARN("Fail to expand data block ring", K(ret), K_(expected_micro_handle_cnt), K_(max_micro_handle_cnt));
   } else if (micro_data_prefetch_idx_ - cur_micro_data_fetch_idx_ == max_micro_handle_cnt_) {
     // DataBlock ring buf full
   } else {
     int64_t prefetched_cnt = 0;
     int64_t prefetch_micro_idx = 0;
-    prefetch_depth_ = min(max_micro_handle_cnt_, 2 * prefetch_depth_);
+    prefetch_depth_ = min(max_prefetch_depth_, 2 * prefetch_depth_);
     int64_t prefetch_depth = min(static_cast<int64_t>(prefetch_depth_),
                                    max_micro_handle_cnt_ - (micro_data_prefetch_idx_ - cur_micro_data_fetch_idx_));
     while (OB_SUCC(ret) && prefetched_cnt < prefetch_depth) {
@@ -780,6 +818,120 @@ int ObIndexTreeMultiPassPrefetcher::prefetch_micro_data()
   return ret;
 }
 
+/*
+ * Adjust the upper bound of prefetch depth by the io latency observed by the consumer.
+ * If all data blocks of the last window hit the block cache, deep prefetch only holds cache
+ * handles and index tree cursors ahead of use, so shrink it. If the consumer still waits for
+ * io of prefetched blocks, more blocks should be in flight to keep the device busy: with depth D,
+ * consume time C and io wait W per block, the io latency is about D * (C + W), so D * (C + W) / C
+ * blocks are needed to hide it at the measured consumption rate. The data block ring is grown
+ * beyond DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT at the next prefetch if the depth does not fit in it.
+ */
+void ObIndexTreeMultiPassPrefetcher::adjust_prefetch_depth(
+    const int64_t fetch_time,
+    const bool is_block_io,
+    const int64_t io_wait_time)
+{
+  if (adaptive_block_cnt_ >= ADAPTIVE_PREFETCH_WINDOW) {
+    if (0 == adaptive_io_block_cnt_) {
+      max_prefetch_depth_ = max(MIN_SCAN_PREFETCH_DEPTH, max_prefetch_depth_ / 2);
+      is_io_bound_ = false;
+    } else if (adaptive_io_wait_time_ / adaptive_io_block_cnt_ > ADAPTIVE_IO_WAIT_THRESHOLD_US) {
+      // the window covers consumption and io wait of adaptive_block_cnt_ blocks
+      const int64_t window_time = max(fetch_time - adaptive_window_begin_time_, adaptive_io_wait_time_);
+      const int64_t consume_time = max(1L, (window_time - adaptive_io_wait_time_) / adaptive_block_cnt_);
+      const int64_t io_wait_time_per_block = adaptive_io_wait_time_ / adaptive_block_cnt_;
+      const int64_t depth = min(static_cast<int64_t>(MAX_SCAN_MICRO_DATA_HANDLE_CNT),
+                                max_prefetch_depth_ + (max_prefetch_depth_ * io_wait_time_per_block + consume_time - 1) / consume_time);
+      if (depth > max_micro_handle_cnt_) {
+        // grow the ring at least twice to bound the times of relocation
+        expected_micro_handle_cnt_ = static_cast<int32_t>(
+            min(static_cast<int64_t>(MAX_SCAN_MICRO_DATA_HANDLE_CNT), max(depth, 2L * max_micro_handle_cnt_)));
+      }
+      max_prefetch_depth_ = static_cast<int32_t>(depth);
+      is_io_bound_ = depth >= max_micro_handle_cnt_;
+    }
+    if (OB_NOT_NULL(access_ctx_)) {
+      access_ctx_->table_store_stat_.max_prefetch_depth_ =
+          max(access_ctx_->table_store_stat_.max_prefetch_depth_, static_cast<int64_t>(max_prefetch_depth_));
+    }
+    LOG_DEBUG("[INDEX BLOCK] adjust prefetch depth", K_(max_prefetch_depth), K_(is_io_bound),
+              K_(expected_micro_handle_cnt), K_(adaptive_block_cnt), K_(adaptive_io_block_cnt),
+              K_(adaptive_io_wait_time), K(fetch_time), K_(adaptive_window_begin_time));
+    reset_adaptive_window();
+  }
+  if (0 == adaptive_block_cnt_) {
+    adaptive_window_begin_time_ = fetch_time;
+  }
+  ++adaptive_block_cnt_;
+  if (is_block_io) {
+    ++adaptive_io_block_cnt_;
+    adaptive_io_wait_time_ += io_wait_time;
+    if (OB_NOT_NULL(access_ctx_)) {
+      access_ctx_->table_store_stat_.block_io_wait_time_ += io_wait_time;
+    }
+  }
+}
+
+/*
+ * Move the data block ring to a larger one allocated from stmt_allocator_.
+ * Prefetched entries keep their logical index, handles are copied to hold the same cache and io
+ * references, so block data opened by the consumer stays valid. Only the scanner adjusts the
+ * prefetch depth, the getters keeping pointers to the current handle never grow the ring.
+ */
+int ObIndexTreeMultiPassPrefetcher::expand_micro_data_ring()
+{
+  int ret = OB_SUCCESS;
+  const int64_t new_cnt = expected_micro_handle_cnt_;
+  void *info_buf = nullptr;
+  void *handle_buf = nullptr;
+  expected_micro_handle_cnt_ = 0;
+  if (OB_ISNULL(access_ctx_) || OB_ISNULL(access_ctx_->stmt_allocator_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected null access context", K(ret), KP_(access_ctx));
+  } else if (OB_ISNULL(info_buf = access_ctx_->stmt_allocator_->alloc(sizeof(ObMicroIndexInfo) * new_cnt)) ||
+             OB_ISNULL(handle_buf = access_ctx_->stmt_allocator_->alloc(sizeof(ObMicroBlockDataHandle) * new_cnt))) {
+    // keep prefetching with the current ring
+    LOG_WARN("Fail to allocate data block ring", K(new_cnt));
+    if (nullptr != info_buf) {
+      access_ctx_->stmt_allocator_->free(info_buf);
+    }
+  } else {
+    ObMicroIndexInfo *infos = new (info_buf) ObMicroIndexInfo[new_cnt];
+    ObMicroBlockDataHandle *handles = new (handle_buf) ObMicroBlockDataHandle[new_cnt];
+    for (int64_t idx = max(cur_micro_data_fetch_idx_, 0L); idx < micro_data_prefetch_idx_; idx++) {
+      infos[idx % new_cnt] = micro_data_infos_[idx % max_micro_handle_cnt_];
+      handles[idx % new_cnt] = micro_data_handles_[idx % max_micro_handle_cnt_];
+    }
+    reset_micro_data_ring();
+    micro_data_infos_ = infos;
+    micro_data_handles_ = handles;
+    max_micro_handle_cnt_ = static_cast<int32_t>(new_cnt);
+    LOG_DEBUG("[INDEX BLOCK] expand data block ring", K_(max_micro_handle_cnt),
+              K_(cur_micro_data_fetch_idx), K_(micro_data_prefetch_idx));
+  }
+  return ret;
+}
+
+void ObIndexTreeMultiPassPrefetcher::reset_micro_data_ring()
+{
+  for (int64_t i = 0; i < max_micro_handle_cnt_; i++) {
+    micro_data_handles_[i].reset();
+  }
+  if (micro_data_handles_ != default_micro_data_handles_) {
+    for (int64_t i = 0; i < max_micro_handle_cnt_; i++) {
+      micro_data_handles_[i].~ObMicroBlockDataHandle();
+      micro_data_infos_[i].~ObMicroIndexInfo();
+    }
+    if (OB_NOT_NULL(access_ctx_) && OB_NOT_NULL(access_ctx_->stmt_allocator_)) {
+      access_ctx_->stmt_allocator_->free(micro_data_handles_);
+      access_ctx_->stmt_allocator_->free(micro_data_infos_);
+    }
+    micro_data_infos_ = default_micro_data_infos_;
+    micro_data_handles_ = default_micro_data_handles_;
+  }
+}
+
 // drill down to get next valid index micro block
 int ObIndexTreeMultiPassPrefetcher::drill_down()
 {
@@ -44,6 +44,7 @@ public:
   ObSSTableReadHandle() :
       is_get_(false),
       is_bf_contain_(false),
+      need_full_row_cache_(false),
       row_state_(0),
       range_idx_(-1),
       micro_begin_idx_(-1),
@@ -58,6 +59,7 @@ public:
   {
     is_get_ = false;
     is_bf_contain_ = false;
+    need_full_row_cache_ = false;
     row_state_ = 0;
     range_idx_ = -1;
     micro_begin_idx_ = -1;
@@ -69,6 +71,7 @@ public:
   {
     is_get_ = false;
     is_bf_contain_ = false;
+    need_full_row_cache_ = false;
     row_state_ = 0;
     range_idx_ = -1;
     micro_begin_idx_ = -1;
@@ -90,12 +93,14 @@ public:
     }
     return ret;
   }
-  TO_STRING_KV(K_(is_get), K_(is_bf_contain), K_(row_state), K_(range_idx),
+  TO_STRING_KV(K_(is_get), K_(is_bf_contain), K_(need_full_row_cache), K_(row_state), K_(range_idx),
                K_(micro_begin_idx), K_(micro_end_idx), KP_(query_range));
 
 public:
   bool is_get_;
   bool is_bf_contain_;
+  // a partial row in row cache misses the requested columns, put the full row this time
+  bool need_full_row_cache_;
   int8_t row_state_;    // possible states: NOT_EXIST, IN_ROW_CACHE, IN_BLOCK
   int32_t range_idx_;
   int64_t micro_begin_idx_;
@@ -200,6 +205,7 @@ public:
       is_row_lock_checked_(false),
       cur_range_fetch_idx_(0),
       cur_range_prefetch_idx_(0),
+      row_cache_prefetch_idx_(0),
       cur_micro_data_fetch_idx_(-1),
       micro_data_prefetch_idx_(0),
       row_lock_check_version_(transaction::ObTransVersion::INVALID_TRANS_VERSION),
@@ -211,11 +217,20 @@ public:
       prefetch_depth_(1),
       max_range_prefetching_cnt_(0),
       max_micro_handle_cnt_(0),
+      max_prefetch_depth_(0),
+      expected_micro_handle_cnt_(0),
+      is_io_bound_(false),
+      adaptive_block_cnt_(0),
+      adaptive_io_block_cnt_(0),
+      adaptive_io_wait_time_(0),
+      adaptive_window_begin_time_(0),
       total_micro_data_cnt_(0),
       query_range_(nullptr),
       border_rowkey_(),
       read_handles_(),
-      tree_handles_()
+      tree_handles_(),
+      micro_data_infos_(default_micro_data_infos_),
+      micro_data_handles_(default_micro_data_handles_)
   {}
   virtual ~ObIndexTreeMultiPassPrefetcher()
   {}
@@ -255,6 +270,9 @@ public:
          cur_micro_data_fetch_idx_ > current_read_handle().micro_end_idx_);
 
   }
+  // feedback from the consumer of each prefetched data block, used to adapt the prefetch depth,
+  // fetch_time is the time the consumer starts to wait for the block
+  void adjust_prefetch_depth(const int64_t fetch_time, const bool is_block_io, const int64_t io_wait_time);
   int refresh_blockscan_checker(const int64_t start_micro_idx, const blocksstable::ObDatumRowkey &rowkey);
   int check_blockscan(bool &can_blockscan);
   int check_row_lock(
@@ -264,7 +282,8 @@ public:
                        K_(is_prefetch_end), K_(cur_range_fetch_idx), K_(cur_range_prefetch_idx), K_(max_range_prefetching_cnt),
                        K_(cur_micro_data_fetch_idx), K_(micro_data_prefetch_idx), K_(max_micro_handle_cnt),
                        K_(iter_type), K_(cur_level), K_(index_tree_height), K_(prefetch_depth),
-                       K_(total_micro_data_cnt), KP_(query_range), K_(tree_handles), K_(border_rowkey));
+                       K_(max_prefetch_depth), K_(expected_micro_handle_cnt), K_(is_io_bound), K_(adaptive_block_cnt),
+                       K_(adaptive_io_block_cnt), K_(adaptive_io_wait_time), K_(total_micro_data_cnt), KP_(query_range), K_(tree_handles), K_(border_rowkey));
 private:
   int init_basic_info(
       const int iter_type,
@@ -274,7 +293,10 @@ private:
       bool &is_multi_range);
   struct ObIndexTreeLevelHandle;
   int prefetch_index_tree();
+  int prefetch_row_cache();
   int prefetch_micro_data();
+  int expand_micro_data_ring();
+  void reset_micro_data_ring();
   int try_add_query_range(ObIndexTreeLevelHandle &tree_handle);
   int drill_down();
   int prepare_read_handle(
@@ -285,6 +307,18 @@ private:
       const int64_t end_pos,
       const blocksstable::ObDatumRowkey &border_rowkey,
       bool is_reverse);
+  OB_INLINE int64_t prefetch_refill_threshold() const
+  {
+    // io bound scan keeps the data block ring as full as possible
+    return is_io_bound_ ? max_micro_handle_cnt_ : max_prefetch_depth_ / 2;
+  }
+  OB_INLINE void reset_adaptive_window()
+  {
+    adaptive_block_cnt_ = 0;
+    adaptive_io_block_cnt_ = 0;
+    adaptive_io_wait_time_ = 0;
+    adaptive_window_begin_time_ = 0;
+  }
   OB_INLINE void clean_blockscan_check_info()
   {
     can_blockscan_ = false;
@@ -296,7 +330,14 @@ private:
 
   static const int32_t DEFAULT_SCAN_RANGE_PREFETCH_CNT = 4;
   static const int32_t DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT = 32;
+  // upper bound of the data block ring grown by an io bound scan
+  static const int32_t MAX_SCAN_MICRO_DATA_HANDLE_CNT = 128;
   static const int32_t INDEX_TREE_PREFETCH_DEPTH = 3;
+  static const int32_t MIN_SCAN_PREFETCH_DEPTH = 4;
+  // count of consumed data blocks between two adjustments of max_prefetch_depth_
+  static const int32_t ADAPTIVE_PREFETCH_WINDOW = 16;
+  // average io wait of the consumer above which the scan is regarded as io bound
+  static const int64_t ADAPTIVE_IO_WAIT_THRESHOLD_US = 100;
   struct ObIndexBlockReadHandle {
     ObIndexBlockReadHandle() :
         end_prefetched_row_idx_(-1),
@@ -446,6 +487,8 @@ public:
   bool is_row_lock_checked_;
   int32_t cur_range_fetch_idx_;
   int32_t cur_range_prefetch_idx_;
+  // rowkeys before it have had their row cache buckets prefetched
+  int32_t row_cache_prefetch_idx_;
   int64_t cur_micro_data_fetch_idx_;
   int64_t micro_data_prefetch_idx_;
   int64_t row_lock_check_version_;
@@ -458,6 +501,16 @@ private:
   int16_t prefetch_depth_;
   int32_t max_range_prefetching_cnt_;
   int32_t max_micro_handle_cnt_;
+  // adaptive upper bound of prefetch_depth_, in [MIN_SCAN_PREFETCH_DEPTH, MAX_SCAN_MICRO_DATA_HANDLE_CNT],
+  // prefetching is still limited by the free entries of the data block ring
+  int32_t max_prefetch_depth_;
+  // size of the data block ring wanted by adjust_prefetch_depth, applied at the next prefetch
+  int32_t expected_micro_handle_cnt_;
+  bool is_io_bound_;
+  int32_t adaptive_block_cnt_;
+  int32_t adaptive_io_block_cnt_;
+  int64_t adaptive_io_wait_time_;
+  int64_t adaptive_window_begin_time_;
   int64_t total_micro_data_cnt_;
   union {
     const common::ObIArray<blocksstable::ObDatumRowkey> *rowkeys_; // for multi get/multi exist/single exist
@@ -468,8 +521,11 @@ private:
   blocksstable::ObDatumRowkey border_rowkey_;
   ReadHandleArray read_handles_;
   IndexTreeLevelHandleArray tree_handles_;
-  ObMicroIndexInfo micro_data_infos_[DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT];
-  ObMicroBlockDataHandle micro_data_handles_[DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT];
+  // data block ring of max_micro_handle_cnt_ entries, the default ones or a larger ring from stmt_allocator_
+  ObMicroIndexInfo *micro_data_infos_;
+  ObMicroBlockDataHandle *micro_data_handles_;
+  ObMicroIndexInfo default_micro_data_infos_[DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT];
+  ObMicroBlockDataHandle default_micro_data_handles_[DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT];
 };
 
 }
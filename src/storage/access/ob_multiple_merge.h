@@ -197,6 +197,9 @@ OB_INLINE int ObMultipleMerge::update_and_report_scan_stat()
     access_ctx_->table_scan_stat_->block_cache_miss_cnt_ += access_ctx_->table_store_stat_.block_cache_miss_cnt_;
     access_ctx_->table_scan_stat_->row_cache_hit_cnt_ += access_ctx_->table_store_stat_.row_cache_hit_cnt_;
     access_ctx_->table_scan_stat_->row_cache_miss_cnt_ += access_ctx_->table_store_stat_.row_cache_miss_cnt_;
+    access_ctx_->table_scan_stat_->block_io_wait_time_ += access_ctx_->table_store_stat_.block_io_wait_time_;
+    access_ctx_->table_scan_stat_->max_prefetch_depth_ = MAX(access_ctx_->table_scan_stat_->max_prefetch_depth_,
+                                                             access_ctx_->table_store_stat_.max_prefetch_depth_);
   }
   return report_table_store_stat();
 }
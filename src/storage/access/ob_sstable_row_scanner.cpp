@@ -167,8 +167,12 @@ int ObSSTableRowScanner::open_cur_data_block(ObSSTableReadHandle &read_handle)
     if (OB_SUCC(ret)) {
       bool can_blockscan = false;
       ObMicroBlockData block_data;
+      const bool is_block_io = ObSSTableMicroBlockState::IN_BLOCK_IO == micro_handle.block_state_;
+      const int64_t fetch_time = ObTimeUtility::current_time();
       if (OB_FAIL(micro_handle.get_data_block_data(macro_block_reader_, block_data))) {
         LOG_WARN("Fail to get block data", K(ret), K(micro_handle));
+      } else if (FALSE_IT(prefetcher_.adjust_prefetch_depth(
+                  fetch_time, is_block_io, is_block_io ? ObTimeUtility::current_time() - fetch_time : 0))) {
       } else if (OB_FAIL(micro_scanner_->open(
                   micro_handle.macro_block_id_,
                   block_data,
@@ -45,6 +45,8 @@ public:
   OB_INLINE int semi_copy(ObDatumRowkey &dest, common::ObIAllocator &allocator) const;
   int murmurhash(const uint64_t seed, const ObStorageDatumUtils &datum_utils, uint64_t &hash) const;
   OB_INLINE int hash(const ObStorageDatumUtils &datum_utils, uint64_t &hash) const { return murmurhash(hash, datum_utils, hash); }
+  // hash of the datums without seed, calculated once and kept in hash_ which is passed on by copies
+  OB_INLINE int get_hash(const ObStorageDatumUtils &datum_utils, uint64_t &hash) const;
   static int ext_safe_compare(const ObStorageDatum &left, const ObStorageDatum &right, const common::ObCmpFunc &cmp_func, int &cmp_ret);
 
   OB_INLINE void set_max_rowkey() { *this = MAX_ROWKEY; store_rowkey_.set_max(); }
@@ -200,6 +202,19 @@ OB_INLINE int ObDatumRowkey::deep_copy(ObDatumRowkey &dest, char *buf, const int
   return ret;
 }
 
+OB_INLINE int ObDatumRowkey::get_hash(const ObStorageDatumUtils &datum_utils, uint64_t &hash) const
+{
+  int ret = common::OB_SUCCESS;
+  if (0 != hash_) {
+  } else if (OB_FAIL(murmurhash(0, datum_utils, hash_))) {
+    STORAGE_LOG(WARN, "Failed to calc hash value for datum rowkey", K(ret), K(*this));
+  }
+  if (OB_SUCC(ret)) {
+    hash = hash_;
+  }
+  return ret;
+}
+
 OB_INLINE int ObDatumRowkey::deep_copy(ObDatumRowkey &dest, common::ObIAllocator &allocator) const
 {
   int ret = OB_SUCCESS;
@@ -573,6 +573,7 @@ int ObIMicroBlockCache::ObIMicroBlockIOCallback::process_block(
       if (OB_UNLIKELY(OB_SUCCESS == (ret = cache_->get(key, micro_block, handle)))) {
         // entry exist, no need to put
       } else if (OB_FAIL(cache_->alloc(
+          key,
           tenant_id_,
           sizeof(ObMicroBlockCacheKey),
           value_size,
@@ -245,6 +245,7 @@ int ObMicroBlockRowGetter::get_block_row(
               read_handle.micro_handle_->macro_block_id_,
               *read_handle.rowkey_,
               block_data,
+              read_handle.need_full_row_cache_,
               store_row))) {
     if (OB_ITER_END != ret) {
       LOG_WARN("fail to get block row", K(ret), K(*read_handle.rowkey_));
@@ -312,10 +313,9 @@ int ObMicroBlockRowGetter::project_cache_row(const ObRowCacheValue &value, ObDat
     row.row_flag_ = value.get_flag();
     row.count_ = read_info->get_request_count();
     ObStorageDatum *const datums = value.get_datums();
-    const int64_t column_cnt = value.get_column_cnt();
     for (int64_t i = 0; OB_SUCC(ret) && i < request_cnt; i++) {
-      if (cols_index.at(i) < column_cnt && cols_index.at(i) >= 0) {
-        row.storage_datums_[i] = datums[cols_index.at(i)];
+      if (value.has_column(cols_index.at(i))) {
+        row.storage_datums_[i] = datums[value.get_datum_idx(cols_index.at(i))];
       } else {
         // new added col
         row.storage_datums_[i].set_nop();
@@ -329,9 +329,14 @@ int ObMicroBlockRowGetter::inner_get_row(
     const MacroBlockId &macro_id,
     const ObDatumRowkey &rowkey,
     const ObMicroBlockData &block_data,
+    const bool need_full_row_cache,
     const ObDatumRow *&row)
 {
   int ret = OB_SUCCESS;
+  // when few of the columns are requested, read and cache only the projected columns instead
+  // of the full row, unless a cached projection has just failed to cover the request
+  const ObTableReadInfo *read_info = read_info_;
+  bool put_partial_row = false;
   if (IS_NOT_INIT) {
     ret = OB_NOT_INIT;
     LOG_WARN("not init", K(ret));
@@ -341,9 +346,18 @@ int ObMicroBlockRowGetter::inner_get_row(
   } else if (OB_FAIL(prepare_reader(block_data.get_store_type()))) {
     LOG_WARN("failed to prepare reader", K(ret), K(macro_id));
   } else {
-    if (OB_FAIL(row_.reserve(read_info_->get_request_count()))) {
-      LOG_WARN("fail to reserve memory for datum row", K(ret), K(read_info_->get_request_count()));
-    } else if (OB_FAIL(reader_->get_row(block_data, rowkey, *read_info_, row_))) {
+    if (!context_->use_fuse_row_cache_
+        && !need_full_row_cache
+        && context_->enable_put_row_cache()
+        && param_->read_with_same_schema()
+        && nullptr != param_->get_read_info()
+        && param_->get_read_info()->get_request_count() * 2 <= read_info_->get_request_count()) {
+      read_info = param_->get_read_info();
+      put_partial_row = true;
+    }
+    if (OB_FAIL(row_.reserve(read_info->get_request_count()))) {
+      LOG_WARN("fail to reserve memory for datum row", K(ret), K(read_info->get_request_count()));
+    } else if (OB_FAIL(reader_->get_row(block_data, rowkey, *read_info, row_))) {
       if (OB_BEYOND_THE_RANGE == ret) {
         if (OB_FAIL(get_not_exist_row(rowkey, row))) {
           LOG_WARN("Fail to get not exist row", K(ret), K(rowkey), K(macro_id));
@@ -363,6 +377,10 @@ int ObMicroBlockRowGetter::inner_get_row(
   if (OB_FAIL(ret)) {
   } else if (context_->use_fuse_row_cache_) {
     // fuse row cache bypass the row cache
+  } else if (put_partial_row) {
+    if (OB_FAIL(put_partial_row_cache(rowkey, *row))) {
+      LOG_WARN("fail to put partial row cache", K(ret), K(rowkey), KPC(row));
+    }
   } else if (context_->enable_put_row_cache() && param_->read_with_same_schema()) {
     ObRowCacheValue row_cache_value;
     if (OB_FAIL(row_cache_value.init(sstable_->get_key().get_start_scn().get_val_for_tx(), row_))) {
@@ -391,6 +409,35 @@ int ObMicroBlockRowGetter::inner_get_row(
   return ret;
 }
 
+int ObMicroBlockRowGetter::put_partial_row_cache(const ObDatumRowkey &rowkey, const ObDatumRow &row)
+{
+  int ret = OB_SUCCESS;
+  ObRowCacheValue row_cache_value;
+  if (row.row_flag_.is_not_exist()) {
+    // a not exist row holds no column, it covers the columns of any later request
+    row_cache_value.init_not_exist(sstable_->get_key().get_start_scn().get_val_for_tx());
+  } else if (OB_FAIL(row_cache_value.init_partial(sstable_->get_key().get_start_scn().get_val_for_tx(),
+                                                  row,
+                                                  param_->get_read_info()->get_columns_index(),
+                                                  read_info_->get_request_count()))) {
+    LOG_WARN("fail to init partial row cache value", K(ret), K(row));
+  }
+  if (OB_SUCC(ret)) {
+    //put row cache, ignore fail
+    ObRowCacheKey row_cache_key(
+        MTL_ID(),
+        param_->tablet_id_,
+        rowkey,
+        read_info_->get_datum_utils(),
+        sstable_->is_major_sstable() ? sstable_->get_snapshot_version() : sstable_->get_key().get_end_scn().get_val_for_tx(),
+        sstable_->get_key().table_type_);
+    if (OB_SUCCESS == OB_STORE_CACHE.get_row_cache().put_row(row_cache_key, row_cache_value)) {
+      context_->table_store_stat_.row_cache_put_cnt_++;
+    }
+  }
+  return ret;
+}
+
 // TODO: remove this later if no store row needed to return in multi-scan if not found
 int ObMicroBlockRowGetter::get_not_exist_row(const ObDatumRowkey &rowkey, const ObDatumRow *&row)
 {
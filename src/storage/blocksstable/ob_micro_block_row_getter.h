@@ -78,7 +78,9 @@ private:
       const MacroBlockId &macro_id,
       const ObDatumRowkey &rowkey,
       const ObMicroBlockData &block_data,
+      const bool need_full_row_cache,
       const ObDatumRow *&row);
+  int put_partial_row_cache(const ObDatumRowkey &rowkey, const ObDatumRow &row);
 private:
   const ObTableReadInfo *read_info_;
   ObDatumRow row_;
@@ -60,11 +60,14 @@ int ObRowCacheKey::hash(uint64_t &hash_val) const
   hash_val = common::murmurhash(&tablet_id_, sizeof(tablet_id_), hash_val);
   hash_val = common::murmurhash(&data_version_, sizeof(data_version_), hash_val);
   if (rowkey_.is_valid()) {
+    uint64_t rowkey_hash = 0;
     if (OB_ISNULL(datum_utils_)) {
       ret = OB_ERR_UNEXPECTED;
       STORAGE_LOG(WARN, "Unexpected error for null datum utils", K(ret), K(*this));
-    } else if (OB_FAIL(rowkey_.hash(*datum_utils_, hash_val))) {
+    } else if (OB_FAIL(rowkey_.get_hash(*datum_utils_, rowkey_hash))) {
       STORAGE_LOG(WARN, "Failed to calc hash value for datum rowkey", K(ret), K(rowkey_));
+    } else {
+      hash_val = common::murmurhash(&rowkey_hash, sizeof(rowkey_hash), hash_val);
     }
   }
   return ret;
@@ -150,8 +153,9 @@ ObRowCacheValue::ObRowCacheValue()
     size_(0),
     column_cnt_(0),
     start_log_ts_(0),
-    block_id_()
-
+    block_id_(),
+    column_bitmap_(nullptr),
+    cols_index_(nullptr)
 {
 }
 
@@ -174,6 +178,56 @@ int ObRowCacheValue::init(const int64_t start_log_ts,
   return ret;
 }
 
+int ObRowCacheValue::init_partial(const int64_t start_log_ts,
+                                  const ObDatumRow &row,
+                                  const common::ObIArray<int32_t> &cols_index,
+                                  const int64_t column_cnt)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(column_cnt <= 0 || row.get_column_count() != cols_index.count())) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "Invalid argument to init partial row cache value", K(ret), K(column_cnt),
+                K(row.get_column_count()), K(cols_index.count()));
+  } else {
+    datums_ = row.storage_datums_;
+    column_cnt_ = column_cnt;
+    start_log_ts_ = start_log_ts;
+    flag_ = row.row_flag_;
+    cols_index_ = &cols_index;
+    // duplicated columns are counted twice, which only leaves some slack in the buffer
+    size_ = sizeof(uint64_t) * get_bitmap_word_cnt(column_cnt_);
+    for (int64_t i = 0; i < cols_index.count(); ++i) {
+      const int64_t col_idx = cols_index.at(i);
+      if (col_idx >= 0 && col_idx < column_cnt_) {
+        size_ += sizeof(ObStorageDatum) + datums_[i].get_deep_copy_size();
+      }
+    }
+  }
+  return ret;
+}
+
+void ObRowCacheValue::init_not_exist(const int64_t start_log_ts)
+{
+  set_row_not_exist();
+  column_cnt_ = 0;
+  start_log_ts_ = start_log_ts;
+  flag_.set_flag(ObDmlFlag::DF_NOT_EXIST);
+  column_bitmap_ = nullptr;
+  cols_index_ = nullptr;
+}
+
+bool ObRowCacheValue::contain_columns(const common::ObIArray<int32_t> &cols_index) const
+{
+  bool contain = true;
+  if (is_partial_row()) {
+    for (int64_t i = 0; contain && i < cols_index.count(); ++i) {
+      const int64_t col_idx = cols_index.at(i);
+      contain = col_idx < 0 || col_idx >= column_cnt_ || has_column(col_idx);
+    }
+  }
+  return contain;
+}
+
 int64_t ObRowCacheValue::size() const
 {
   return sizeof(*this) + size_;
@@ -191,7 +245,15 @@ int ObRowCacheValue::deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue
   } else {
     ObRowCacheValue *pvalue = new (buf) ObRowCacheValue();
     if (NULL == datums_) {
+      // a not exist row keeps the meta checked by the readers
       pvalue->datums_ = NULL;
+      pvalue->start_log_ts_ = start_log_ts_;
+      pvalue->flag_ = flag_;
+      pvalue->block_id_ = block_id_;
+    } else if (nullptr != cols_index_) {
+      if (OB_FAIL(deep_copy_partial(buf, buf_len, *pvalue))) {
+        STORAGE_LOG(WARN, "Failed to deep copy partial row", K(ret));
+      }
     } else {
       pvalue->size_ = size_;
       pvalue->datums_ = new (buf + sizeof(*this)) ObStorageDatum [column_cnt_];
@@ -210,6 +272,41 @@ int ObRowCacheValue::deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue
   }
   return ret;
 }
+
+int ObRowCacheValue::deep_copy_partial(char *buf, const int64_t buf_len, ObRowCacheValue &value) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t word_cnt = get_bitmap_word_cnt(column_cnt_);
+  int64_t datum_cnt = 0;
+  value.size_ = size_;
+  value.column_cnt_ = column_cnt_;
+  value.start_log_ts_ = start_log_ts_;
+  value.flag_ = flag_;
+  value.block_id_ = block_id_;
+  value.column_bitmap_ = reinterpret_cast<uint64_t *>(buf + sizeof(*this));
+  MEMSET(value.column_bitmap_, 0, sizeof(uint64_t) * word_cnt);
+  for (int64_t i = 0; i < cols_index_->count(); ++i) {
+    const int64_t col_idx = cols_index_->at(i);
+    if (col_idx >= 0 && col_idx < column_cnt_) {
+      value.column_bitmap_[col_idx >> 6] |= (1UL << (col_idx & 63));
+    }
+  }
+  for (int64_t i = 0; i < word_cnt; ++i) {
+    datum_cnt += common::ob_popcount64(value.column_bitmap_[i]);
+  }
+  int64_t pos = sizeof(*this) + sizeof(uint64_t) * word_cnt;
+  value.datums_ = new (buf + pos) ObStorageDatum [datum_cnt];
+  pos += sizeof(ObStorageDatum) * datum_cnt;
+  for (int64_t i = 0; OB_SUCC(ret) && i < cols_index_->count(); ++i) {
+    const int64_t col_idx = cols_index_->at(i);
+    if (col_idx >= 0 && col_idx < column_cnt_) {
+      if (OB_FAIL(value.datums_[value.get_datum_idx(col_idx)].deep_copy(datums_[i], buf, buf_len, pos))) {
+        STORAGE_LOG(WARN, "Failed to deep copy datum", K(ret), K(i), K(col_idx));
+      }
+    }
+  }
+  return ret;
+}
 /**
  * -----------------------------------------------------ObRowCache------------------------------------------------------
  */
@@ -247,6 +344,42 @@ int ObRowCache::get_row(const ObRowCacheKey &key, ObRowValueHandle &handle)
 }
 
 
+int ObRowCache::prefetch_rows(const uint64_t tenant_id,
+                              const ObTabletID &tablet_id,
+                              const common::ObIArray<ObDatumRowkey> &rowkeys,
+                              const int64_t start_idx,
+                              const int64_t count,
+                              const ObStorageDatumUtils &datum_utils,
+                              const int64_t data_version,
+                              const storage::ObITable::TableType table_type)
+{
+  int ret = OB_SUCCESS;
+  uint64_t hash_codes[MAX_PREFETCH_ROW_CNT];
+  const int64_t prefetch_cnt = MIN(MIN(count, MAX_PREFETCH_ROW_CNT), rowkeys.count() - start_idx);
+  if (OB_UNLIKELY(start_idx < 0 || count < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    STORAGE_LOG(WARN, "invalid argument", K(ret), K(start_idx), K(count), K(rowkeys.count()));
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < prefetch_cnt; ++i) {
+      const ObDatumRowkey &rowkey = rowkeys.at(start_idx + i);
+      uint64_t rowkey_hash = 0;
+      // the rowkey hash is kept in the rowkey, so the key of the following get_row is not hashed again
+      if (OB_FAIL(rowkey.get_hash(datum_utils, rowkey_hash))) {
+        STORAGE_LOG(WARN, "Failed to hash rowkey", K(ret), K(rowkey));
+      } else {
+        ObRowCacheKey key(tenant_id, tablet_id, rowkey, datum_utils, data_version, table_type);
+        if (OB_FAIL(key.hash(hash_codes[i]))) {
+          STORAGE_LOG(WARN, "Failed to hash row cache key", K(ret), K(key));
+        }
+      }
+    }
+    if (OB_SUCC(ret)) {
+      prefetch(hash_codes, prefetch_cnt);
+    }
+  }
+  return ret;
+}
+
 int ObRowCache::put_row(const ObRowCacheKey &key, const ObRowCacheValue &value)
 {
   int ret = OB_SUCCESS;
@@ -14,6 +14,7 @@
 #define OCEANBASE_STORAGE_BLOCKSSTABLE_ROW_CACHE_H_
 #include "ob_block_sstable_struct.h"
 #include "lib/container/ob_vector.h"
+#include "lib/utility/ob_bits_utils.h"
 #include "share/cache/ob_kv_storecache.h"
 #include "storage/ob_i_store.h"
 #include "storage/ob_i_table.h"
@@ -57,6 +58,9 @@ private:
   DISALLOW_COPY_AND_ASSIGN(ObRowCacheKey);
 };
 
+// A row cache value holds either the full row or a projected subset of its columns.
+// A partial row keeps a bitmap of the stored column indexes, and its datums are laid out
+// in ascending column index order, so the datum of a column is found by the rank of its bit.
 class ObRowCacheValue : public common::ObIKVCacheValue
 {
 public:
@@ -64,6 +68,13 @@ public:
   virtual ~ObRowCacheValue();
   int init(const int64_t start_log_ts,
            const ObDatumRow &row);
+  // row is projected by cols_index, column_cnt is the column count of the full row
+  int init_partial(const int64_t start_log_ts,
+                   const ObDatumRow &row,
+                   const common::ObIArray<int32_t> &cols_index,
+                   const int64_t column_cnt);
+  // not exist row, which projects to any columns
+  void init_not_exist(const int64_t start_log_ts);
   virtual int64_t size() const;
   virtual int deep_copy(char *buf, const int64_t buf_len, ObIKVCacheValue *&value) const;
   inline void set_row_not_exist() { datums_ = nullptr; size_ = 0; }
@@ -75,7 +86,34 @@ public:
   inline ObDmlRowFlag get_flag() const { return flag_; }
   inline MacroBlockId get_block_id() const { return block_id_; }
   inline bool is_valid() const { return (NULL == datums_ && 0 == size_) || (NULL != datums_ && size_ > 0); }
-  TO_STRING_KV(KP_(datums), K_(size), K_(flag), K_(size), K_(column_cnt), K_(start_log_ts), K_(block_id));
+  inline bool is_partial_row() const { return nullptr != column_bitmap_; }
+  // whether all the columns in cols_index can be projected from this row, columns out of the
+  // full row are new added ones and always read as nop
+  bool contain_columns(const common::ObIArray<int32_t> &cols_index) const;
+  inline bool has_column(const int64_t col_idx) const
+  {
+    return col_idx >= 0 && col_idx < column_cnt_
+        && (!is_partial_row() || 0 != (column_bitmap_[col_idx >> 6] & (1UL << (col_idx & 63))));
+  }
+  // position in datums_ of a column contained in the row
+  inline int64_t get_datum_idx(const int64_t col_idx) const
+  {
+    int64_t datum_idx = col_idx;
+    if (is_partial_row()) {
+      datum_idx = 0;
+      const int64_t word_idx = col_idx >> 6;
+      for (int64_t i = 0; i < word_idx; ++i) {
+        datum_idx += common::ob_popcount64(column_bitmap_[i]);
+      }
+      datum_idx += common::ob_popcount64(column_bitmap_[word_idx] & ((1UL << (col_idx & 63)) - 1));
+    }
+    return datum_idx;
+  }
+  TO_STRING_KV(KP_(datums), K_(size), K_(flag), K_(size), K_(column_cnt), K_(start_log_ts), K_(block_id),
+               KP_(column_bitmap));
+private:
+  static inline int64_t get_bitmap_word_cnt(const int64_t column_cnt) { return (column_cnt + 63) >> 6; }
+  int deep_copy_partial(char *buf, const int64_t buf_len, ObRowCacheValue &value) const;
 private:
   ObStorageDatum *datums_;
   ObDmlRowFlag flag_;
@@ -83,6 +121,9 @@ private:
   int64_t column_cnt_;
   int64_t start_log_ts_;
   MacroBlockId block_id_;
+  uint64_t *column_bitmap_;
+  // only set on the value to put, datums_ is then in the order of cols_index_
+  const common::ObIArray<int32_t> *cols_index_;
 };
 
 
@@ -104,6 +145,17 @@ public:
   virtual ~ObRowCache();
   int get_row(const ObRowCacheKey &key, ObRowValueHandle &handle);
   int put_row(const ObRowCacheKey &key, const ObRowCacheValue &value);
+  // probe the map buckets of rowkeys[start_idx, start_idx + count) of one sstable, so that the
+  // following get_row of each of them does not stall on cache misses one after another
+  int prefetch_rows(const uint64_t tenant_id,
+                    const ObTabletID &tablet_id,
+                    const common::ObIArray<ObDatumRowkey> &rowkeys,
+                    const int64_t start_idx,
+                    const int64_t count,
+                    const ObStorageDatumUtils &datum_utils,
+                    const int64_t data_version,
+                    const storage::ObITable::TableType table_type);
+  static const int64_t MAX_PREFETCH_ROW_CNT = 32;
   DISALLOW_COPY_AND_ASSIGN(ObRowCache);
 };
 
@@ -556,8 +556,12 @@ ObPartitionMicroMergeIter::ObPartitionMicroMergeIter()
     curr_micro_block_(nullptr),
     micro_block_opened_(false),
     macro_reader_(),
-    need_reuse_micro_block_(true)
+    need_reuse_micro_block_(true),
+    compressor_type_(ObCompressorType::INVALID_COMPRESSOR),
+    encrypt_id_(0),
+    master_key_id_(0)
 {
+  MEMSET(encrypt_key_, 0, sizeof(encrypt_key_));
 }
 
 ObPartitionMicroMergeIter::~ObPartitionMicroMergeIter()
@@ -575,6 +579,10 @@ void ObPartitionMicroMergeIter::reset()
   curr_micro_block_ = nullptr;
   micro_block_opened_ = false;
   need_reuse_micro_block_ = true;
+  compressor_type_ = ObCompressorType::INVALID_COMPRESSOR;
+  encrypt_id_ = 0;
+  master_key_id_ = 0;
+  MEMSET(encrypt_key_, 0, sizeof(encrypt_key_));
   ObPartitionMacroMergeIter::reset();
 }
 
@@ -610,6 +618,8 @@ int ObPartitionMicroMergeIter::inner_init(const ObMergeParameter &merge_param)
 
   if (OB_FAIL(ObPartitionMacroMergeIter::inner_init(merge_param))) {
     STORAGE_LOG(WARN, "Failed to do macro merge iter init", K(ret));
+  } else if (OB_FAIL(init_block_store_info(*merge_param.merge_schema_))) {
+    LOG_WARN("Failed to init block store info", K(ret));
   } else if (OB_ISNULL(buf = stmt_allocator_.alloc(sizeof(ObMicroBlockRowScanner)))) {
     ret = OB_ALLOCATE_MEMORY_FAILED;
     LOG_WARN("Failed to alloc memory for multi version micro block scanner", K(ret));
@@ -626,19 +636,62 @@ int ObPartitionMicroMergeIter::inner_init(const ObMergeParameter &merge_param)
   return ret;
 }
 
+// same as the compression and encryption ObDataStoreDesc::init picks for major merge
+int ObPartitionMicroMergeIter::init_block_store_info(const ObMergeSchema &merge_schema)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(merge_schema.get_encryption_id(encrypt_id_))) {
+    LOG_WARN("Failed to get encrypt id from merge schema", K(ret));
+  } else {
+    if (merge_schema.need_encrypt() && merge_schema.get_encrypt_key_len() > 0) {
+      master_key_id_ = merge_schema.get_master_key_id();
+      MEMCPY(encrypt_key_, merge_schema.get_encrypt_key().ptr(),
+             MIN(sizeof(encrypt_key_), merge_schema.get_encrypt_key().length()));
+    }
+    compressor_type_ = merge_schema.get_compressor_type();
+  }
+  return ret;
+}
+
 // check before open each macro block
+// micro blocks written by an older schema version can still be copied without re-encoding as long
+// as the stored column layout is unchanged, the macro block writer only rebuilds their header and
+// column checksums (see ObMacroBlockWriter::build_micro_block_desc_with_rewrite)
 void ObPartitionMicroMergeIter::check_need_reuse_micro_block()
 {
-  if (curr_block_desc_.schema_version_ <= 0 || curr_block_desc_.schema_version_ != schema_version_) {
+  if (curr_block_desc_.schema_version_ <= 0 || curr_block_desc_.schema_version_ > schema_version_) {
     need_reuse_micro_block_ = false;
   } else if (row_store_type_ != curr_block_desc_.row_store_type_) {
     // all micro block should be rewrite if row store type change.
     need_reuse_micro_block_ = false;
-  } else {
+  } else if (curr_block_desc_.schema_version_ == schema_version_) {
     need_reuse_micro_block_ = true;
+  } else if (!curr_block_desc_.is_valid_with_macro_meta()) {
+    need_reuse_micro_block_ = false;
+  } else {
+    need_reuse_micro_block_ = can_reuse_older_micro_block(curr_block_desc_.macro_meta_->val_);
   }
 }
 
+// reused micro blocks are copied as they are, while the macro block they go to is described
+// with the compression and encryption of the new schema
+bool ObPartitionMicroMergeIter::can_reuse_older_micro_block(const ObDataBlockMetaVal &meta_val) const
+{
+  bool bret = false;
+  if (OB_ISNULL(column_ids_) || meta_val.column_count_ != column_ids_->count()) {
+    // column count changed since the macro block was written, rows must be decoded and rewritten
+  } else if (meta_val.compressor_type_ != compressor_type_) {
+    // compress func changed
+  } else if (meta_val.encrypt_id_ != encrypt_id_
+      || meta_val.master_key_id_ != master_key_id_
+      || 0 != MEMCMP(meta_val.encrypt_key_, encrypt_key_, sizeof(encrypt_key_))) {
+    // encryption changed
+  } else {
+    bret = true;
+  }
+  return bret;
+}
+
 int ObPartitionMicroMergeIter::next_range()
 {
   int ret = OB_SUCCESS;
@@ -209,7 +209,9 @@ private:
 
   virtual int next_range() override;
   virtual int open_curr_micro_block();
+  int init_block_store_info(const share::schema::ObMergeSchema &merge_schema);
   void check_need_reuse_micro_block();
+  bool can_reuse_older_micro_block(const blocksstable::ObDataBlockMetaVal &meta_val) const;
 private:
   ObIndexBlockMicroIterator micro_block_iter_;
   blocksstable::ObIMicroBlockRowScanner *micro_row_scanner_;
@@ -217,6 +219,11 @@ private:
   bool micro_block_opened_;
   blocksstable::ObMacroBlockReader macro_reader_;
   bool need_reuse_micro_block_;
+  // compression and encryption of the micro blocks written by this merge
+  common::ObCompressorType compressor_type_;
+  int64_t encrypt_id_;
+  int64_t master_key_id_;
+  char encrypt_key_[share::OB_MAX_TABLESPACE_ENCRYPT_KEY_LENGTH];
 };
 
 class ObPartitionMinorRowMergeIter : public ObPartitionMergeIter
@@ -32,6 +32,7 @@ ObMvccEngine::ObMvccEngine()
       kv_builder_(NULL),
       query_engine_(NULL),
       engine_allocator_(NULL),
+      row_allocator_(),
       memtable_(NULL)
 {
 }
@@ -59,6 +60,7 @@ int ObMvccEngine::init(
     ret = OB_INVALID_ARGUMENT;
   } else {
     engine_allocator_ = allocator;
+    row_allocator_.init(allocator);
     kv_builder_ = kv_builder;
     query_engine_ = query_engine;
     memtable_ = memtable;
@@ -76,6 +78,7 @@ void ObMvccEngine::destroy()
   kv_builder_ = NULL;
   query_engine_ = NULL;
   engine_allocator_ = NULL;
+  row_allocator_.reset();
   memtable_ = NULL;
 }
 
@@ -279,7 +282,7 @@ int ObMvccEngine::create_kv(
         ret = OB_ALLOCATE_MEMORY_FAILED;
       } else if (OB_FAIL(stored_key->encode(tmp_key))) {
         TRANS_LOG(WARN, "key encode fail", K(ret));
-      } else if (NULL == (value = (ObMvccRow *)engine_allocator_->alloc(sizeof(*value)))) {
+      } else if (NULL == (value = (ObMvccRow *)row_allocator_.alloc_row())) {
         TRANS_LOG(WARN, "alloc ObMvccRow fail");
         ret = OB_ALLOCATE_MEMORY_FAILED;
       } else {
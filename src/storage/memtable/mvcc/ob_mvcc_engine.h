@@ -17,6 +17,7 @@
 #include "storage/memtable/mvcc/ob_mvcc_define.h"
 #include "storage/memtable/mvcc/ob_multi_version_iterator.h"
 #include "storage/memtable/mvcc/ob_mvcc_iterator.h"
+#include "storage/memtable/mvcc/ob_mvcc_row_allocator.h"
 #include "storage/memtable/mvcc/ob_query_engine.h"
 #include "storage/memtable/ob_row_compactor.h"
 
@@ -114,6 +115,7 @@ public:
   // estimate_scan_row_count estimate the row count for the range
   int estimate_scan_row_count(const ObMvccScanRange &range,
                               storage::ObPartitionEst &part_est) const;
+  int64_t get_row_allocated() const { return row_allocator_.get_allocated(); }
 private:
   int try_compact_row_when_mvcc_read_(const share::SCN &snapshot_version,
                                       ObMvccRow &row);
@@ -127,6 +129,7 @@ private:
   ObMTKVBuilder *kv_builder_;
   ObQueryEngine *query_engine_;
   common::ObIAllocator *engine_allocator_;
+  ObMvccRowAllocator row_allocator_;
   ObMemtable *memtable_;
 };
 }
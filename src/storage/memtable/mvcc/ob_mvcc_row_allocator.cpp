@@ -0,0 +1,66 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "storage/memtable/mvcc/ob_mvcc_row_allocator.h"
+#include "lib/thread_local/ob_tsi_utils.h"
+
+namespace oceanbase
+{
+using namespace common;
+namespace memtable
+{
+
+void *ObMvccRowAllocator::alloc_row()
+{
+  void *ptr = NULL;
+  if (OB_ISNULL(allocator_)) {
+    // not inited
+  } else if (ATOMIC_LOAD(&direct_row_count_) < DIRECT_ROW_COUNT
+             && ATOMIC_FAA(&direct_row_count_, 1) < DIRECT_ROW_COUNT) {
+    if (OB_ISNULL(ptr = allocator_->alloc(ROW_SIZE))) {
+      TRANS_LOG(WARN, "alloc mvcc row fail", K(get_allocated()));
+    } else {
+      ATOMIC_FAA(&alloc_memory_, ROW_SIZE);
+    }
+  } else {
+    ptr = alloc_from_slab();
+  }
+  return ptr;
+}
+
+void *ObMvccRowAllocator::alloc_from_slab()
+{
+  void *ptr = NULL;
+  Slab **slab_addr = slabs_ + icpu_id() % MAX_SLAB_COUNT;
+  Slab *slab = ATOMIC_LOAD(slab_addr);
+  if (OB_NOT_NULL(slab)) {
+    ptr = slab->alloc();
+  }
+  if (OB_ISNULL(ptr)) {
+    Slab *new_slab = NULL;
+    if (OB_ISNULL(new_slab = (Slab *)allocator_->alloc(SLAB_SIZE))) {
+      TRANS_LOG(WARN, "alloc mvcc row slab fail", K(get_allocated()));
+    } else {
+      // the first row of the new slab is kept by us
+      new_slab->init(ROW_SIZE);
+      ptr = new_slab->buf_;
+      ATOMIC_FAA(&alloc_memory_, SLAB_SIZE);
+      // another thread on the same cpu may have switched the slab, the rest
+      // of the slab that loses is left unused.
+      UNUSED(ATOMIC_BCAS(slab_addr, slab, new_slab));
+    }
+  }
+  return ptr;
+}
+
+}
+}
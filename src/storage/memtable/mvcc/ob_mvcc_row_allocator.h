@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_MEMTABLE_MVCC_OB_MVCC_ROW_ALLOCATOR_
+#define OCEANBASE_MEMTABLE_MVCC_OB_MVCC_ROW_ALLOCATOR_
+
+#include "share/ob_define.h"
+#include "lib/allocator/ob_allocator.h"
+#include "storage/memtable/mvcc/ob_mvcc_row.h"
+
+namespace oceanbase
+{
+namespace memtable
+{
+
+// Slab allocator of ObMvccRow for one memtable.
+//
+// The first DIRECT_ROW_COUNT rows are allocated one by one, so a small
+// memtable does not hold a partly used slab per writing cpu. After that
+// slabs of ROW_COUNT_PER_SLAB rows are taken from the memstore allocator
+// of the memtable, so they are counted by the memstore throttle when
+// taken and released with the memtable. Slabs are selected by cpu to
+// spread concurrent writers, each carves rows with a single
+// fetch-and-add, rows are never freed one by one.
+class ObMvccRowAllocator
+{
+private:
+  enum {
+    MAX_SLAB_COUNT = common::OB_MAX_CPU_NUM,
+    ROW_COUNT_PER_SLAB = 64
+  };
+  static const int64_t ROW_SIZE = sizeof(ObMvccRow);
+  struct Slab
+  {
+    void init(const int64_t pos)
+    {
+      pos_ = pos;
+      limit_ = ROW_COUNT_PER_SLAB * ROW_SIZE;
+    }
+    void *alloc()
+    {
+      char *ret = NULL;
+      int64_t pos = 0;
+      if ((pos = ATOMIC_LOAD(&pos_)) < limit_) {
+        pos = ATOMIC_FAA(&pos_, ROW_SIZE);
+        ret = (pos + ROW_SIZE <= limit_) ? buf_ + pos : NULL;
+      }
+      return ret;
+    }
+    int64_t pos_;
+    int64_t limit_;
+    char buf_[0];
+  };
+public:
+  static const int64_t SLAB_SIZE = sizeof(Slab) + ROW_COUNT_PER_SLAB * ROW_SIZE;
+  static const int64_t DIRECT_ROW_COUNT = 1024;
+public:
+  ObMvccRowAllocator() : allocator_(NULL), alloc_memory_(0), direct_row_count_(0) { reset(); }
+  ~ObMvccRowAllocator() {}
+  void init(common::ObIAllocator *allocator)
+  {
+    reset();
+    allocator_ = allocator;
+  }
+  // the slabs are owned by the memtable allocator and released with it
+  void reset()
+  {
+    memset(slabs_, 0, sizeof(slabs_));
+    alloc_memory_ = 0;
+    direct_row_count_ = 0;
+    allocator_ = NULL;
+  }
+  // return an uninitialized row, NULL if out of memory
+  void *alloc_row();
+  int64_t get_allocated() const { return ATOMIC_LOAD(&alloc_memory_); }
+private:
+  void *alloc_from_slab();
+private:
+  common::ObIAllocator *allocator_;
+  int64_t alloc_memory_;
+  int64_t direct_row_count_;
+  Slab *slabs_[MAX_SLAB_COUNT];
+  DISALLOW_COPY_AND_ASSIGN(ObMvccRowAllocator);
+};
+
+}
+}
+
+#endif //OCEANBASE_MEMTABLE_MVCC_OB_MVCC_ROW_ALLOCATOR_
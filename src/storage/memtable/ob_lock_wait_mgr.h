@@ -272,6 +272,13 @@ public:
     RLOCAL_INLINE(Node*, node);
     return node;
   }
+  // coroutine worker executes requests alternately on one thread, the
+  // thread local states need be switched together with the request.
+  static void swap_thread_ctx(Node *&node, uint64_t &hold_key)
+  {
+    std::swap(get_thread_node(), node);
+    std::swap(get_thread_hold_key(), hold_key);
+  }
 
 protected:
   // obtain the request waiting on the row or transaction
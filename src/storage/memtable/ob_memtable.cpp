@@ -1313,6 +1313,11 @@ int64_t ObMemtable::get_btree_alloc_memory() const
   return query_engine_.btree_alloc_memory();
 }
 
+int64_t ObMemtable::get_row_alloc_memory() const
+{
+  return mvcc_engine_.get_row_allocated();
+}
+
 int ObMemtable::inc_unsubmitted_cnt()
 {
   int ret = OB_SUCCESS;
@@ -2038,6 +2043,7 @@ int ObMemtable::dump2text(const char *fname)
             get_hash_item_count(), get_hash_alloc_memory());
     fprintf(fd, "btree_item_count=%ld, btree_alloc_size=%ld\n",
             get_btree_item_count(), get_btree_alloc_memory());
+    fprintf(fd, "row_alloc_size=%ld\n", get_row_alloc_memory());
     query_engine_.dump2text(fd);
   }
   if (NULL != fd) {
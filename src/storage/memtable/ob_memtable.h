@@ -325,6 +325,7 @@ public:
   int64_t get_hash_alloc_memory() const;
   int64_t get_btree_item_count() const;
   int64_t get_btree_alloc_memory() const;
+  int64_t get_row_alloc_memory() const;
   virtual bool can_be_minor_merged() override;
   virtual int get_frozen_schema_version(int64_t &schema_version) const override;
   virtual bool is_frozen_memtable() const override;
@@ -114,7 +114,8 @@ bool ObTableStoreStat::is_valid() const
       || !single_get_stat_.is_valid() || !multi_get_stat_.is_valid() || !index_back_stat_.is_valid()
       || !single_scan_stat_.is_valid() || !multi_scan_stat_.is_valid()
       || !exist_row_.is_valid() ||!get_row_.is_valid() || !scan_row_.is_valid()
-      || logical_read_cnt_ < 0 || physical_read_cnt_ < 0) {
+      || logical_read_cnt_ < 0 || physical_read_cnt_ < 0
+      || block_io_wait_time_ < 0 || max_prefetch_depth_ < 0) {
     valid = false;
   }
   return valid;
@@ -163,6 +164,8 @@ int ObTableStoreStat::add(const ObTableStoreStat& other)
 
     logical_read_cnt_ += other.logical_read_cnt_;
     physical_read_cnt_ += other.physical_read_cnt_;
+    block_io_wait_time_ += other.block_io_wait_time_;
+    max_prefetch_depth_ = MAX(max_prefetch_depth_, other.max_prefetch_depth_);
   }
   return ret;
 }
@@ -113,7 +113,8 @@ public:
                K_(exist_row), K_(get_row), K_(scan_row),
                K_(sstable_bf_filter_cnt), K_(sstable_bf_empty_read_cnt),
                K_(sstable_bf_access_cnt), K_(rowkey_prefix),
-               K_(logical_read_cnt), K_(physical_read_cnt));
+               K_(logical_read_cnt), K_(physical_read_cnt),
+               K_(block_io_wait_time), K_(max_prefetch_depth));
 
   share::ObLSID ls_id_;
   common::ObTabletID tablet_id_;
@@ -152,6 +153,8 @@ public:
   int64_t rowkey_prefix_;
   int64_t logical_read_cnt_;
   int64_t physical_read_cnt_;
+  int64_t block_io_wait_time_; // time waiting for prefetched data block io, in us
+  int64_t max_prefetch_depth_;
 };
 
 struct ObTableStoreStatKey
@@ -52,7 +52,21 @@ int ObTransCond::wait(const int64_t wait_time_us, int &result)
     int64_t left_time_us = wait_time_us;
     int64_t start_time_us = ObClockGenerator::getClock();
     THIS_WORKER.sched_wait();
-    {
+    if (THIS_WORKER.can_coro_yield()) {
+      // give the worker to other requests, poll the result once resumed
+      while (!ATOMIC_LOAD(&finished_) && OB_SUCC(ret)) {
+        left_time_us = wait_time_us - (ObClockGenerator::getClock() - start_time_us);
+        if (left_time_us <= 0) {
+          ret = OB_TIMEOUT;
+        } else {
+          THIS_WORKER.coro_yield();
+        }
+      }
+      ObMonitor<Mutex>::Lock guard(monitor_);
+      if (finished_) {
+        result = result_;
+      }
+    } else {
       ObMonitor<Mutex>::Lock guard(monitor_);
       while (!finished_ && OB_SUCC(ret)) {
         left_time_us = wait_time_us - (ObClockGenerator::getClock() - start_time_us);
@@ -84,7 +98,13 @@ void ObTransCond::notify(const int result)
 
 void ObTransCond::usleep(const int64_t us)
 {
-  if (us > 0) {
+  if (us <= 0) {
+    // do nothing
+  } else if (THIS_WORKER.can_coro_yield()) {
+    THIS_WORKER.sched_wait();
+    THIS_WORKER.sleep_us(us);
+    THIS_WORKER.sched_run();
+  } else {
     ObMonitor<Mutex> monitor;
     THIS_WORKER.sched_wait();
     (void)monitor.timed_wait(ObSysTime(us));
@@ -17,6 +17,7 @@
 #include "lib/stat/ob_session_stat.h"
 #include "lib/ob_name_id_def.h"
 #include "lib/ob_running_mode.h"
+#include "lib/worker.h"
 #include "ob_trans_ctx.h"
 #include "ob_trans_factory.h"
 #include "ob_trans_functor.h"
@@ -1224,7 +1225,7 @@ int ObTransService::validate_snapshot_version_(const SCN snapshot,
         if (expire_ts <= ObClockGenerator::getClock()) {
           ret = OB_TIMEOUT;
         } else {
-          ob_usleep(100);
+          THIS_WORKER.sleep_us(100);
         }
       } else if (OB_FAIL(ret)) {
         TRANS_LOG(WARN, "get gts fail", KR(ret));
@@ -1325,7 +1326,7 @@ int ObTransService::wait_follower_readable_(ObLS &ls,
         stmt_timeout = expire_ts - ObClockGenerator::getClock();
         compare_timeout = compare_expired_time - ObClockGenerator::getClock();
         retry_interval = MIN(MIN3(GCONF.weak_read_version_refresh_interval, compare_timeout, stmt_timeout), 100000);
-        ob_usleep(static_cast<int>(retry_interval));
+        THIS_WORKER.sleep_us(retry_interval);
       } else {
         // do nothing
       }
@@ -1460,7 +1461,7 @@ int ObTransService::acquire_global_snapshot__(const int64_t expire_ts,
         if (interrupt_checker()) {
           ret = OB_ERR_INTERRUPTED;
         } else {
-          ob_usleep(500);
+          THIS_WORKER.sleep_us(500);
         }
       } else {
         TRANS_LOG(WARN, "get gts fail", K(now));
@@ -25,6 +25,7 @@
 #include "ob_gts_rpc.h"
 #include "storage/tx/ob_trans_factory.h"
 #include "lib/thread/ob_thread_name.h"
+#include "lib/worker.h"
 #include "ob_location_adapter.h"
 #include "observer/omt/ob_multi_tenant.h"
 
@@ -878,7 +879,7 @@ int ObTsMgr::get_ts_sync(const uint64_t tenant_id,
           if (OB_EAGAIN != ret) {
             TRANS_LOG(WARN, "get gts error", K(ret), K(tenant_id), K(stc));
           } else {
-            ob_usleep(sleep_us);
+            THIS_WORKER.sleep_us(sleep_us);
             sleep_us = sleep_us * 2;
             sleep_us = (sleep_us >= 1000000 ? 1000000 : sleep_us);
             // rewrite ret
@@ -14,9 +14,11 @@
 
 #include "lib/utility/ob_print_utils.h"
 #include "lib/alloc/memory_dump.h"
+#include "lib/alloc/ob_malloc_thread_cache.h"
 #include "observer/omt/ob_multi_tenant.h"                  // ObMultiTenant
 #include "share/ob_tenant_mgr.h"                           // get_virtual_memory_used
 #include "share/allocator/ob_memstore_allocator_mgr.h"     // ObMemstoreAllocatorMgr
+#include "sql/engine/ob_exec_page_allocator.h"             // ObExecPageAllocator
 #include "storage/tx_storage/ob_tenant_freezer.h"          // ObTenantFreezer
 #include "storage/tx_storage/ob_tenant_memory_printer.h"
 
@@ -130,7 +132,8 @@ int ObTenantMemoryPrinter::print_tenant_usage()
     _STORAGE_LOG(INFO,
         "[CHUNK_MGR] free=%ld pushes=%ld pops=%ld limit=%'15ld hold=%'15ld total_hold=%'15ld used=%'15ld" \
         " freelist_hold=%'15ld maps=%'15ld unmaps=%'15ld large_maps=%'15ld large_unmaps=%'15ld" \
-        " memalign=%d"
+        " memalign=%d hugetlb_hold=%'15ld huge_page_pool_total=%'15ld huge_page_pool_used=%'15ld"
+        " huge_page_pool_page_size=%ld"
 #ifndef ENABLE_SANITY
         " virtual_memory_used=%'15ld\n",
 #else
@@ -149,12 +152,22 @@ int ObTenantMemoryPrinter::print_tenant_usage()
         CHUNK_MGR.get_large_maps(),
         CHUNK_MGR.get_large_unmaps(),
         0,
+        CHUNK_MGR.get_hugetlb_hold(),
+        CHUNK_MGR.get_huge_page_pool_total(),
+        CHUNK_MGR.get_huge_page_pool_used(),
+        CHUNK_MGR.get_huge_page_pool_page_size(),
 #ifndef ENABLE_SANITY
         memory_used
 #else
         memory_used - CHUNK_MGR.get_shadow_hold(), memory_used
 #endif
         );
+    _STORAGE_LOG(INFO, "[MALLOC_TCACHE] max_cache_size=%'15ld total_hold=%'15ld\n",
+        lib::ObMallocThreadCache::get_max_cache_size(),
+        lib::ObMallocThreadCache::get_total_hold());
+    _STORAGE_LOG(INFO, "[EXEC_PAGE_CACHE] enabled=%d total_cached=%'15ld\n",
+        sql::ObExecPageAllocator::is_enabled(),
+        sql::ObExecPageAllocator::get_total_cached_size());
     print_mutex_.unlock();
   }
 
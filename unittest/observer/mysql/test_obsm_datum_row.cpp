@@ -0,0 +1,225 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "lib/allocator/page_arena.h"
+#include "observer/mysql/obsm_datum_row.h"
+#include "observer/mysql/obsm_row.h"
+#include "sql/engine/expr/ob_expr.h"
+#include "sql/engine/ob_exec_context.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::obmysql;
+using namespace oceanbase::sql;
+
+class TestSMDatumRow : public ::testing::Test
+{
+public:
+  static const int64_t BATCH_SIZE = 4;
+  static const int64_t MAX_COL_CNT = 8;
+  static const int64_t RES_BUF_SIZE = 64;
+  static const int64_t ROW_BUF_SIZE = 4096;
+  TestSMDatumRow()
+    : alloc_("TestSMDatumRow"), exec_ctx_(alloc_), eval_ctx_(exec_ctx_)
+  {}
+  virtual void SetUp() override
+  {
+    const int64_t frame_size = (sizeof(ObDatum) + RES_BUF_SIZE) * BATCH_SIZE * MAX_COL_CNT
+        + sizeof(ObEvalInfo) * MAX_COL_CNT;
+    eval_ctx_.frames_ = static_cast<char **>(alloc_.alloc(sizeof(char *)));
+    ASSERT_TRUE(nullptr != eval_ctx_.frames_);
+    eval_ctx_.frames_[0] = static_cast<char *>(alloc_.alloc(frame_size));
+    ASSERT_TRUE(nullptr != eval_ctx_.frames_[0]);
+    MEMSET(eval_ctx_.frames_[0], 0, frame_size);
+    eval_ctx_.set_max_batch_size(BATCH_SIZE);
+    frame_pos_ = 0;
+    memset(long_str_, 'x', sizeof(long_str_));
+  }
+  virtual void TearDown() override
+  {
+    exprs_.reset();
+    fields_.reset();
+    alloc_.reset();
+  }
+protected:
+  ObExpr *add_column(const ObObjType type, const int16_t scale)
+  {
+    ObExpr *expr = new (alloc_.alloc(sizeof(ObExpr))) ObExpr();
+    expr->frame_idx_ = 0;
+    expr->batch_result_ = true;
+    expr->obj_meta_.set_type(type);
+    expr->obj_meta_.set_collation_type(ob_is_string_or_lob_type(type)
+                                       ? CS_TYPE_UTF8MB4_GENERAL_CI : CS_TYPE_BINARY);
+    expr->obj_datum_map_ = ObDatum::get_obj_datum_map_type(type);
+    expr->datum_meta_.type_ = type;
+    expr->datum_off_ = frame_pos_;
+    frame_pos_ += sizeof(ObDatum) * BATCH_SIZE;
+    expr->eval_info_off_ = frame_pos_;
+    frame_pos_ += sizeof(ObEvalInfo);
+    ObDatum *datums = expr->locate_batch_datums(eval_ctx_);
+    for (int64_t i = 0; i < BATCH_SIZE; ++i) {
+      datums[i].ptr_ = eval_ctx_.frames_[0] + frame_pos_;
+      frame_pos_ += RES_BUF_SIZE;
+    }
+    ObField field;
+    field.type_.set_type(type);
+    field.accuracy_.set_scale(scale);
+    field.charsetnr_ = CS_TYPE_UTF8MB4_GENERAL_CI;
+    EXPECT_EQ(OB_SUCCESS, exprs_.push_back(expr));
+    EXPECT_EQ(OB_SUCCESS, fields_.push_back(field));
+    return expr;
+  }
+  // int, uint, decimal(10, 2), varchar, batch rows:
+  // 0: plain values, 1: all NULL, 2: negative, max and long string, 3: zero and empty string
+  void prepare_rows()
+  {
+    ObDatum *ints = add_column(ObIntType, 0)->locate_batch_datums(eval_ctx_);
+    ObDatum *uints = add_column(ObUInt64Type, 0)->locate_batch_datums(eval_ctx_);
+    ObDatum *nmbs = add_column(ObNumberType, 2)->locate_batch_datums(eval_ctx_);
+    ObDatum *strs = add_column(ObVarcharType, 0)->locate_batch_datums(eval_ctx_);
+    const char *nmb_strs[] = {"123.45", NULL, "-98765432.10", "0"};
+    for (int64_t i = 0; i < BATCH_SIZE; ++i) {
+      if (NULL == nmb_strs[i]) {
+        nmbs[i].set_null();
+      } else {
+        number::ObNumber nmb;
+        ASSERT_EQ(OB_SUCCESS, nmb.from(nmb_strs[i], alloc_));
+        nmbs[i].set_number(nmb);
+      }
+    }
+    ints[0].set_int(42);
+    uints[0].set_uint(7);
+    strs[0].set_string("hello", 5);
+    ints[1].set_null();
+    uints[1].set_null();
+    strs[1].set_null();
+    ints[2].set_int(INT64_MIN);
+    uints[2].set_uint(UINT64_MAX);
+    // longer than 250 bytes, length encoded with 3 bytes
+    strs[2].set_string(long_str_, sizeof(long_str_));
+    ints[3].set_int(0);
+    uints[3].set_uint(0);
+    strs[3].set_string("", 0);
+  }
+  // serialize row batch_idx with the datum encoder and with ObSMRow of the converted ObObj row
+  void check_same_encoding(const ObSMDatumRowEncoder &encoder, const MYSQL_PROTOCOL_TYPE type,
+                           const int64_t batch_idx)
+  {
+    ObObj cells[MAX_COL_CNT];
+    for (int64_t i = 0; i < exprs_.count(); ++i) {
+      const ObExpr *expr = exprs_.at(i);
+      ASSERT_EQ(OB_SUCCESS, expr->locate_batch_datums(eval_ctx_)[batch_idx].to_obj(
+          cells[i], expr->obj_meta_, expr->obj_datum_map_));
+    }
+    ObNewRow row;
+    row.cells_ = cells;
+    row.count_ = exprs_.count();
+    ObDataTypeCastParams dtc_params;
+    ObSMRow sm_row(type, row, dtc_params, &fields_);
+    ObSMDatumRow datum_row(encoder, batch_idx);
+    char expect_buf[ROW_BUF_SIZE];
+    char buf[ROW_BUF_SIZE];
+    int64_t expect_pos = 0;
+    int64_t pos = 0;
+    ASSERT_EQ(OB_SUCCESS, sm_row.serialize(expect_buf, ROW_BUF_SIZE, expect_pos));
+    ASSERT_EQ(OB_SUCCESS, datum_row.serialize(buf, ROW_BUF_SIZE, pos));
+    ASSERT_EQ(expect_pos, pos);
+    ASSERT_EQ(0, MEMCMP(expect_buf, buf, pos)) << "type " << type << " row " << batch_idx;
+  }
+  ObArenaAllocator alloc_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  int64_t frame_pos_;
+  char long_str_[300];
+  ObSEArray<ObExpr *, MAX_COL_CNT> exprs_;
+  ObSEArray<ObField, MAX_COL_CNT> fields_;
+};
+
+TEST_F(TestSMDatumRow, same_as_row_encoding)
+{
+  prepare_rows();
+  ObDataTypeCastParams dtc_params;
+  const MYSQL_PROTOCOL_TYPE types[] = {TEXT, BINARY};
+  for (int64_t t = 0; t < ARRAYSIZEOF(types); ++t) {
+    ObSMDatumRowEncoder encoder;
+    bool is_usable = false;
+    ASSERT_EQ(OB_SUCCESS, encoder.init(types[t], exprs_, eval_ctx_, fields_, dtc_params,
+                                       CHARSET_UTF8MB4, is_usable));
+    ASSERT_TRUE(is_usable);
+    ASSERT_EQ(exprs_.count(), encoder.get_column_cnt());
+    for (int64_t i = 0; i < BATCH_SIZE; ++i) {
+      check_same_encoding(encoder, types[t], i);
+    }
+  }
+}
+
+TEST_F(TestSMDatumRow, short_buffer)
+{
+  prepare_rows();
+  ObDataTypeCastParams dtc_params;
+  ObSMDatumRowEncoder encoder;
+  bool is_usable = false;
+  ASSERT_EQ(OB_SUCCESS, encoder.init(TEXT, exprs_, eval_ctx_, fields_, dtc_params,
+                                     CHARSET_UTF8MB4, is_usable));
+  ASSERT_TRUE(is_usable);
+  // the packet sender flushes and retries on size overflow
+  ObSMDatumRow datum_row(encoder, 2);
+  char buf[64];
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SIZE_OVERFLOW, datum_row.serialize(buf, sizeof(buf), pos));
+}
+
+TEST_F(TestSMDatumRow, fallback_to_row_encoding)
+{
+  prepare_rows();
+  ObDataTypeCastParams dtc_params;
+  bool is_usable = true;
+  {
+    // lob/text columns need lob locator handling of the row path
+    ObSMDatumRowEncoder encoder;
+    add_column(ObLongTextType, 0);
+    ASSERT_EQ(OB_SUCCESS, encoder.init(TEXT, exprs_, eval_ctx_, fields_, dtc_params,
+                                       CHARSET_UTF8MB4, is_usable));
+    ASSERT_FALSE(is_usable);
+    ASSERT_FALSE(encoder.is_inited());
+    ASSERT_EQ(0, encoder.get_column_cnt());
+    exprs_.pop_back();
+    fields_.pop_back();
+  }
+  {
+    // strings in another result charset need to be converted
+    ObSMDatumRowEncoder encoder;
+    ASSERT_EQ(OB_SUCCESS, encoder.init(TEXT, exprs_, eval_ctx_, fields_, dtc_params,
+                                       CHARSET_GBK, is_usable));
+    ASSERT_FALSE(is_usable);
+  }
+  {
+    // ps protocol needs a cast to the field type
+    ObSMDatumRowEncoder encoder;
+    fields_.at(0).type_.set_type(ObInt32Type);
+    ASSERT_EQ(OB_SUCCESS, encoder.init(BINARY, exprs_, eval_ctx_, fields_, dtc_params,
+                                       CHARSET_UTF8MB4, is_usable));
+    ASSERT_FALSE(is_usable);
+    // text protocol does not cast
+    ASSERT_EQ(OB_SUCCESS, encoder.init(TEXT, exprs_, eval_ctx_, fields_, dtc_params,
+                                       CHARSET_UTF8MB4, is_usable));
+    ASSERT_TRUE(is_usable);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
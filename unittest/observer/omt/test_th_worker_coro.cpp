@@ -0,0 +1,195 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#define private public
+#define protected public
+#include "observer/omt/ob_th_worker.h"
+#include "lib/ash/ob_active_session_guard.h"
+#include "lib/lock/ob_latch.h"
+#include "lib/lock/ob_spin_lock.h"
+#include "lib/oblog/ob_warning_buffer.h"
+#include "lib/stat/ob_session_stat.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::lib;
+using namespace oceanbase::omt;
+
+static const int64_t STACK_SIZE = 256L << 10;
+
+struct YieldCtx
+{
+  ObThWorker *worker_;
+  int64_t step_;
+  bool can_yield_[4];
+};
+
+static void yield_under_latch(void *arg)
+{
+  YieldCtx &ctx = *static_cast<YieldCtx*>(arg);
+  ObThWorker &worker = *ctx.worker_;
+  ctx.can_yield_[0] = worker.can_coro_yield();
+  {
+    ObSpinLock lock;
+    ObSpinLockGuard guard(lock);
+    ctx.can_yield_[1] = worker.can_coro_yield();
+    // refused, the coroutine goes on without giving the thread out
+    worker.coro_yield();
+    ctx.step_++;
+  }
+  {
+    ObLatch latch;
+    if (OB_SUCCESS == latch.rdlock(ObLatchIds::DEFAULT_SPIN_RWLOCK)) {
+      ctx.can_yield_[2] = worker.can_coro_yield();
+      latch.unlock();
+    }
+  }
+  ctx.can_yield_[3] = worker.can_coro_yield();
+  worker.coro_yield();
+  ctx.step_++;
+}
+
+TEST(TestThWorkerCoro, yield_under_latch)
+{
+  ObThWorker worker;
+  ObThWorker::CoTask task;
+  YieldCtx ctx = {&worker, 0, {false, true, true, false}};
+  get_count_hold_latch() = true;
+  ASSERT_EQ(OB_SUCCESS, task.co_.init(OB_SERVER_TENANT_ID, STACK_SIZE));
+  ASSERT_EQ(OB_SUCCESS, task.co_.start(yield_under_latch, &ctx));
+  // not on coroutine
+  ASSERT_FALSE(worker.can_coro_yield());
+
+  // latches held by the resumer are not held by the coroutine
+  ObSpinLock resumer_lock;
+  ObSpinLockGuard guard(resumer_lock);
+  const int64_t hold_latch_cnt = get_hold_latch_cnt();
+  ASSERT_LT(0, hold_latch_cnt);
+  worker.cur_co_task_ = &task;
+  // switch the count as swap_co_task_ctx does
+  std::swap(get_hold_latch_cnt(), task.hold_latch_cnt_);
+  ASSERT_EQ(OB_SUCCESS, task.co_.resume());
+  std::swap(get_hold_latch_cnt(), task.hold_latch_cnt_);
+  ASSERT_TRUE(task.co_.is_suspended());
+  ASSERT_EQ(1, ctx.step_);
+  ASSERT_TRUE(ctx.can_yield_[0]);
+  ASSERT_FALSE(ctx.can_yield_[1]);
+  ASSERT_FALSE(ctx.can_yield_[2]);
+  ASSERT_TRUE(ctx.can_yield_[3]);
+  ASSERT_EQ(hold_latch_cnt, get_hold_latch_cnt());
+  ASSERT_EQ(0, task.hold_latch_cnt_);
+
+  std::swap(get_hold_latch_cnt(), task.hold_latch_cnt_);
+  ASSERT_EQ(OB_SUCCESS, task.co_.resume());
+  std::swap(get_hold_latch_cnt(), task.hold_latch_cnt_);
+  ASSERT_EQ(2, ctx.step_);
+  ASSERT_EQ(ObCoRoutine::CO_FINISHED, task.co_.get_state());
+  worker.cur_co_task_ = nullptr;
+  get_count_hold_latch() = false;
+}
+
+TEST(TestThWorkerCoro, hold_latch_cnt)
+{
+  // not counted on threads without coroutines
+  ObLatch latch0;
+  get_hold_latch_cnt() = 0;
+  ASSERT_EQ(OB_SUCCESS, latch0.wrlock(ObLatchIds::DEFAULT_SPIN_RWLOCK));
+  ASSERT_EQ(0, get_hold_latch_cnt());
+  ASSERT_EQ(OB_SUCCESS, latch0.unlock());
+  ASSERT_EQ(0, get_hold_latch_cnt());
+
+  get_count_hold_latch() = true;
+  const int64_t hold_latch_cnt = get_hold_latch_cnt();
+  ObLatch latch;
+  ASSERT_EQ(OB_SUCCESS, latch.wrlock(ObLatchIds::DEFAULT_SPIN_RWLOCK));
+  ASSERT_EQ(hold_latch_cnt + 1, get_hold_latch_cnt());
+  // failed lock is not counted
+  ASSERT_EQ(OB_EAGAIN, latch.try_rdlock(ObLatchIds::DEFAULT_SPIN_RWLOCK));
+  ASSERT_EQ(hold_latch_cnt + 1, get_hold_latch_cnt());
+  ASSERT_EQ(OB_SUCCESS, latch.unlock());
+  ASSERT_EQ(hold_latch_cnt, get_hold_latch_cnt());
+  ObLatchMutex mutex;
+  ASSERT_EQ(OB_SUCCESS, mutex.try_lock(ObLatchIds::DEFAULT_MUTEX));
+  ASSERT_EQ(OB_EAGAIN, mutex.try_lock(ObLatchIds::DEFAULT_MUTEX));
+  ASSERT_EQ(hold_latch_cnt + 1, get_hold_latch_cnt());
+  ASSERT_EQ(OB_SUCCESS, mutex.unlock());
+  ASSERT_EQ(hold_latch_cnt, get_hold_latch_cnt());
+  get_count_hold_latch() = false;
+}
+
+TEST(TestThWorkerCoro, hold_latch_cnt_cross_thread)
+{
+  ObLatch latch;
+  get_count_hold_latch() = true;
+  get_hold_latch_cnt() = 0;
+  ASSERT_EQ(OB_SUCCESS, latch.wrlock(ObLatchIds::DEFAULT_SPIN_RWLOCK));
+  ASSERT_EQ(1, get_hold_latch_cnt());
+  int64_t unlocker_cnt = -1;
+  std::thread unlocker([&]() {
+    get_count_hold_latch() = true;
+    latch.unlock();
+    unlocker_cnt = get_hold_latch_cnt();
+  });
+  unlocker.join();
+  // the unlocker doesn't go below zero, the locker keeps its count
+  ASSERT_EQ(0, unlocker_cnt);
+  ASSERT_EQ(1, get_hold_latch_cnt());
+  get_hold_latch_cnt() = 0;
+  get_count_hold_latch() = false;
+}
+
+TEST(TestThWorkerCoro, swap_thread_ctx)
+{
+  ObThWorker worker;
+  ObThWorker::CoTask task;
+  ActiveSessionStat task_stat;
+  ObWarningBuffer thread_wb;
+  ob_setup_tsi_warning_buffer(&thread_wb);
+  ActiveSessionStat *thread_stat = &ObActiveSessionGuard::get_stat();
+  task.wb_ = &task.default_wb_;
+  task.ash_stat_ = &task_stat;
+  task.di_tenant_id_ = OB_SYS_TENANT_ID;
+  task.di_session_id_ = 1001;
+
+  // switch in
+  worker.swap_co_task_ctx(task);
+  ASSERT_EQ(&task.default_wb_, ob_get_tsi_warning_buffer());
+  ASSERT_EQ(&task_stat, &ObActiveSessionGuard::get_stat());
+  ObSessionDIBuffer *di_buffer = ObDITls<ObSessionDIBuffer>::get_instance();
+  if (is_diagnose_info_enabled() && nullptr != di_buffer) {
+    ASSERT_TRUE(nullptr != di_buffer->get_curr_session());
+    ASSERT_EQ(1001, di_buffer->get_curr_session()->session_id_);
+  }
+  ob_get_tsi_warning_buffer()->append_warning("warning of coroutine", OB_ERR_UNEXPECTED);
+
+  // switch out, the thread gets back its own states
+  worker.swap_co_task_ctx(task);
+  ASSERT_EQ(&thread_wb, ob_get_tsi_warning_buffer());
+  ASSERT_EQ(0, thread_wb.get_readable_warning_count());
+  ASSERT_EQ(1, task.default_wb_.get_readable_warning_count());
+  ASSERT_EQ(thread_stat, &ObActiveSessionGuard::get_stat());
+  ASSERT_EQ(&task_stat, task.ash_stat_);
+  ASSERT_EQ(&task.default_wb_, task.wb_);
+  if (is_diagnose_info_enabled() && nullptr != di_buffer) {
+    ASSERT_EQ(1001, task.di_session_id_);
+    ASSERT_TRUE(nullptr == di_buffer->get_curr_session()
+                || 1001 != di_buffer->get_curr_session()->session_id_);
+  }
+  ob_setup_default_tsi_warning_buffer();
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
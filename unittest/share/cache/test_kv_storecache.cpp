@@ -144,6 +144,32 @@ TEST(ObKVCacheInstMap, memory)
   // inst_map.destroy();
 }
 
+TEST(ObKVCacheFrequencySketch, normal)
+{
+  ObKVCacheFrequencySketch sketch;
+  ASSERT_NE(OB_SUCCESS, sketch.init(0));
+  ASSERT_EQ(OB_SUCCESS, sketch.init(1024));
+  ASSERT_NE(OB_SUCCESS, sketch.init(1024));
+
+  ASSERT_EQ(0, sketch.estimate(100));
+  sketch.increment(100);
+  sketch.increment(100);
+  ASSERT_GE(sketch.estimate(100), 2);
+  for (int64_t i = 0; i < 100; ++i) {
+    sketch.increment(200);
+  }
+  // counters saturate at 15
+  ASSERT_EQ(15, sketch.estimate(200));
+
+  // all counters are halved after sample_size_ increments
+  sketch.add_cnt_ = sketch.sample_size_ - 1;
+  sketch.increment(300);
+  ASSERT_EQ(sketch.sample_size_ / 2, sketch.add_cnt_);
+  ASSERT_EQ(7, sketch.estimate(200));
+  sketch.destroy();
+  ASSERT_EQ(0, sketch.estimate(200));
+}
+
 TEST(ObKVGlobalCache, normal)
 {
   int ret = OB_SUCCESS;
@@ -720,6 +746,76 @@ TEST_F(TestKVCache, test_hold_size)
   ASSERT_TRUE(cache.store_size(tenant_id_) >= hold_size);
 }
 
+TEST_F(TestKVCache, test_priority_class)
+{
+  static const int64_t K_SIZE = 16;
+  static const int64_t V_SIZE = 16 * 1024;
+  typedef TestKVCacheKey<K_SIZE> TestKey;
+  typedef TestKVCacheValue<V_SIZE> TestValue;
+
+  ObKVCache<TestKey, TestValue> cache;
+  ASSERT_EQ(OB_SUCCESS, cache.init("test_priority"));
+
+  int64_t priority_class = KVCACHE_PRIORITY_MAX;
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, ObKVGlobalCache::get_instance().get_priority_class(tenant_id_, "test_priority", priority_class));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, ObKVGlobalCache::get_instance().set_tenant_cache_qos(
+      tenant_id_, "test_priority", KVCACHE_PRIORITY_MAX, 0));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, ObKVGlobalCache::get_instance().set_tenant_cache_qos(
+      tenant_id_, "not_exist", KVCACHE_PRIORITY_HIGH, 0));
+
+  // the cache instance is created by qos setting
+  const int64_t reserved_size = 4 * 1024 * 1024;
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().set_tenant_cache_qos(
+      tenant_id_, "test_priority", KVCACHE_PRIORITY_HIGH, reserved_size));
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().get_priority_class(tenant_id_, "test_priority", priority_class));
+  ASSERT_EQ(KVCACHE_PRIORITY_HIGH, priority_class);
+  int64_t hold_size = 0;
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().get_hold_size(tenant_id_, "test_priority", hold_size));
+  ASSERT_EQ(reserved_size, hold_size);
+
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().set_priority_class(tenant_id_, "test_priority", KVCACHE_PRIORITY_LOW));
+  ASSERT_EQ(OB_SUCCESS, ObKVGlobalCache::get_instance().get_priority_class(tenant_id_, "test_priority", priority_class));
+  ASSERT_EQ(KVCACHE_PRIORITY_LOW, priority_class);
+  ASSERT_EQ(OB_INVALID_ARGUMENT, ObKVGlobalCache::get_instance().set_priority_class(tenant_id_, "test_priority", -1));
+}
+
+TEST_F(TestKVCache, test_admission_alloc)
+{
+  static const int64_t K_SIZE = 16;
+  static const int64_t V_SIZE = 64;
+  typedef TestKVCacheKey<K_SIZE> TestKey;
+  typedef TestKVCacheValue<V_SIZE> TestValue;
+
+  ObKVCache<TestKey, TestValue> cache;
+  ASSERT_EQ(OB_SUCCESS, cache.init("test_admission"));
+  TestKey hot_key;
+  TestKey cold_key;
+  hot_key.v_ = 1;
+  hot_key.tenant_id_ = tenant_id_;
+  cold_key.v_ = 2;
+  cold_key.tenant_id_ = tenant_id_;
+  const TestValue *pvalue = NULL;
+  ObKVCacheHandle handle;
+  ObKVCacheInstHandle inst_handle;
+  ObKVCachePair *kvpair = NULL;
+
+  // a key missed repeatedly is allocated in the protected segment
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(hot_key, pvalue, handle));
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, cache.get(hot_key, pvalue, handle));
+  ASSERT_EQ(OB_SUCCESS, cache.alloc(hot_key, tenant_id_, K_SIZE, V_SIZE, kvpair, handle, inst_handle));
+  ASSERT_EQ(LFU, handle.mb_handle_->policy_);
+  ASSERT_EQ(1, inst_handle.get_inst()->status_.protected_put_cnt_.value());
+
+  // other keys and allocations without key stay in the probation segment
+  handle.reset();
+  ASSERT_EQ(OB_SUCCESS, cache.alloc(cold_key, tenant_id_, K_SIZE, V_SIZE, kvpair, handle, inst_handle));
+  ASSERT_EQ(LRU, handle.mb_handle_->policy_);
+  handle.reset();
+  ASSERT_EQ(OB_SUCCESS, cache.alloc(tenant_id_, K_SIZE, V_SIZE, kvpair, handle, inst_handle));
+  ASSERT_EQ(LRU, handle.mb_handle_->policy_);
+  ASSERT_EQ(1, inst_handle.get_inst()->status_.protected_put_cnt_.value());
+}
+
 // TEST_F(TestKVCache, sync_wash_mbs)
 // {
 //   CHUNK_MGR.set_limit(512 * 1024 * 1024);
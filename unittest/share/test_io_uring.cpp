@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define private public
+#include "share/ob_io_uring.h"
+#undef private
+
+namespace oceanbase
+{
+namespace unittest
+{
+using namespace common;
+using namespace share;
+
+class TestIOUring : public ::testing::Test
+{
+public:
+  static const int64_t BUF_SIZE = 4096;
+  static const int64_t IO_CNT = 16;
+  TestIOUring() : fd_(-1) {}
+  virtual ~TestIOUring() {}
+  virtual void SetUp()
+  {
+    snprintf(file_name_, sizeof(file_name_), "test_io_uring_%d.data", getpid());
+    fd_ = ::open(file_name_, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    ASSERT_GE(fd_, 0);
+  }
+  virtual void TearDown()
+  {
+    ::close(fd_);
+    ::unlink(file_name_);
+  }
+  // reap until expect_cnt events returned
+  void reap_all(ObIOUring &ring, const int64_t expect_cnt, ObIOUringEvent *events)
+  {
+    int64_t total_cnt = 0;
+    struct timespec timeout;
+    timeout.tv_sec = 1;
+    timeout.tv_nsec = 0;
+    for (int64_t i = 0; total_cnt < expect_cnt && i < 100; ++i) {
+      int64_t complete_cnt = 0;
+      ASSERT_EQ(OB_SUCCESS, ring.reap(events + total_cnt, expect_cnt - total_cnt, 1, 10, &timeout, complete_cnt));
+      total_cnt += complete_cnt;
+    }
+    ASSERT_EQ(expect_cnt, total_cnt);
+  }
+protected:
+  char file_name_[128];
+  int fd_;
+};
+
+TEST_F(TestIOUring, read_write)
+{
+  ObIOUring ring;
+  int ret = ring.init(IO_CNT * 2);
+  if (OB_NOT_SUPPORTED == ret) {
+    // old kernel or build environment without io_uring
+    return;
+  }
+  ASSERT_EQ(OB_SUCCESS, ret);
+  ASSERT_EQ(OB_SUCCESS, ring.register_file(fd_));
+
+  static char write_bufs[IO_CNT][BUF_SIZE];
+  static char read_bufs[IO_CNT][BUF_SIZE];
+  ObIOUringEvent events[IO_CNT];
+  for (int64_t i = 0; i < IO_CNT; ++i) {
+    MEMSET(write_bufs[i], static_cast<int>('a' + i), BUF_SIZE);
+    ASSERT_EQ(OB_SUCCESS, ring.submit_write(fd_, write_bufs[i], BUF_SIZE, i * BUF_SIZE, write_bufs[i]));
+  }
+  reap_all(ring, IO_CNT, events);
+  for (int64_t i = 0; i < IO_CNT; ++i) {
+    ASSERT_EQ(BUF_SIZE, events[i].res_);
+  }
+
+  for (int64_t i = 0; i < IO_CNT; ++i) {
+    ASSERT_EQ(OB_SUCCESS, ring.submit_read(fd_, read_bufs[i], BUF_SIZE, i * BUF_SIZE, read_bufs[i]));
+  }
+  reap_all(ring, IO_CNT, events);
+  for (int64_t i = 0; i < IO_CNT; ++i) {
+    ASSERT_EQ(BUF_SIZE, events[i].res_);
+    const int64_t idx = (static_cast<char (*)[BUF_SIZE]>(events[i].data_) - read_bufs);
+    ASSERT_TRUE(idx >= 0 && idx < IO_CNT);
+    ASSERT_EQ(0, MEMCMP(read_bufs[idx], write_bufs[idx], BUF_SIZE));
+  }
+
+  // read beyond the end of file returns 0 bytes
+  ASSERT_EQ(OB_SUCCESS, ring.submit_read(fd_, read_bufs[0], BUF_SIZE, IO_CNT * BUF_SIZE, nullptr));
+  reap_all(ring, 1, events);
+  ASSERT_EQ(0, events[0].res_);
+
+  // no event and no wait
+  int64_t complete_cnt = 0;
+  ASSERT_EQ(OB_SUCCESS, ring.reap(events, IO_CNT, 0, 0, nullptr, complete_cnt));
+  ASSERT_EQ(0, complete_cnt);
+  ring.destroy();
+  ASSERT_FALSE(ring.is_inited());
+}
+
+} // end namespace unittest
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_io_uring.log*");
+  OB_LOGGER.set_file_name("test_io_uring.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,207 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "lib/allocator/page_arena.h"
+#include "sql/das/ob_data_access_service.h"
+#include "sql/das/ob_das_async_access.h"
+#include "sql/das/ob_das_task.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+using namespace oceanbase::transaction;
+
+class MockDASTaskOp : public ObIDASTaskOp
+{
+public:
+  MockDASTaskOp(ObIAllocator &alloc) : ObIDASTaskOp(alloc) {}
+  virtual int open_op() override { return OB_SUCCESS; }
+  virtual int release_op() override { return OB_SUCCESS; }
+  virtual int decode_task_result(ObIDASTaskResult *task_result) override
+  {
+    UNUSED(task_result);
+    return OB_SUCCESS;
+  }
+  virtual int init_task_info() override { return OB_SUCCESS; }
+  virtual int swizzling_remote_task(ObDASRemoteInfo *remote_info) override
+  {
+    UNUSED(remote_info);
+    return OB_SUCCESS;
+  }
+};
+
+class MockDASTaskResult : public ObIDASTaskResult
+{
+public:
+  virtual int init(const ObIDASTaskOp &task_op) override
+  {
+    UNUSED(task_op);
+    return OB_SUCCESS;
+  }
+};
+
+class TestDASRemoteTaskBatch : public ::testing::Test
+{
+public:
+  static const int64_t MAX_TASK_CNT = 64;
+  TestDASRemoteTaskBatch() : allocator_("TestDASBatch") {}
+  virtual void SetUp() override
+  {
+    svr1_.set_ip_addr("127.0.0.1", 2882);
+    svr2_.set_ip_addr("127.0.0.2", 2882);
+    for (int64_t i = 0; i < MAX_TASK_CNT; ++i) {
+      ops_[i] = new (op_bufs_[i]) MockDASTaskOp(allocator_);
+    }
+  }
+  virtual void TearDown() override
+  {
+    for (int64_t i = 0; i < batches_.count(); ++i) {
+      batches_.at(i)->~ObDASRemoteTaskBatch();
+    }
+    batches_.reset();
+    for (int64_t i = 0; i < MAX_TASK_CNT; ++i) {
+      ops_[i]->~MockDASTaskOp();
+    }
+    allocator_.reset();
+  }
+protected:
+  int add_task(const int64_t idx, ObDASTabletLoc &loc, ObTxReadSnapshot &snapshot,
+               const int64_t task_size, const int64_t batch_size)
+  {
+    ops_[idx]->set_tablet_loc(&loc);
+    ops_[idx]->set_snapshot(&snapshot);
+    return ObDataAccessService::add_remote_task_to_batch(allocator_, batches_, *ops_[idx],
+                                                         task_size, batch_size);
+  }
+  ObArenaAllocator allocator_;
+  ObAddr svr1_;
+  ObAddr svr2_;
+  char op_bufs_[MAX_TASK_CNT][sizeof(MockDASTaskOp)];
+  MockDASTaskOp *ops_[MAX_TASK_CNT];
+  ObSEArray<ObDASRemoteTaskBatch*, 8> batches_;
+};
+
+TEST_F(TestDASRemoteTaskBatch, split_by_server_and_snapshot)
+{
+  ObDASTabletLoc loc1;
+  ObDASTabletLoc loc2;
+  ObTxReadSnapshot snapshot1;
+  ObTxReadSnapshot snapshot2;
+  loc1.server_ = svr1_;
+  loc2.server_ = svr2_;
+  // svr1/snapshot1, svr2/snapshot1, svr1/snapshot2 in turn
+  for (int64_t i = 0; i < 9; ++i) {
+    ObDASTabletLoc &loc = (1 == i % 3) ? loc2 : loc1;
+    ObTxReadSnapshot &snapshot = (2 == i % 3) ? snapshot2 : snapshot1;
+    ASSERT_EQ(OB_SUCCESS, add_task(i, loc, snapshot, 100, 16));
+  }
+  ASSERT_EQ(3, batches_.count());
+  for (int64_t i = 0; i < batches_.count(); ++i) {
+    ObDASRemoteTaskBatch *batch = batches_.at(i);
+    ASSERT_EQ(3, batch->task_ops_.count());
+    ASSERT_EQ(300, batch->task_size_);
+    for (int64_t j = 0; j < batch->task_ops_.count(); ++j) {
+      // tasks keep their order inside the batch
+      ASSERT_EQ(ops_[i + j * 3], batch->task_ops_.at(j));
+      ASSERT_EQ(batch->runner_svr_, batch->task_ops_.at(j)->get_tablet_loc()->server_);
+      ASSERT_EQ(batch->snapshot_, batch->task_ops_.at(j)->get_snapshot());
+    }
+  }
+}
+
+TEST_F(TestDASRemoteTaskBatch, split_by_task_count)
+{
+  ObDASTabletLoc loc;
+  ObTxReadSnapshot snapshot;
+  loc.server_ = svr1_;
+  for (int64_t i = 0; i < 10; ++i) {
+    ASSERT_EQ(OB_SUCCESS, add_task(i, loc, snapshot, 100, 4));
+  }
+  ASSERT_EQ(3, batches_.count());
+  ASSERT_EQ(4, batches_.at(0)->task_ops_.count());
+  ASSERT_EQ(4, batches_.at(1)->task_ops_.count());
+  ASSERT_EQ(2, batches_.at(2)->task_ops_.count());
+}
+
+TEST_F(TestDASRemoteTaskBatch, split_by_result_size)
+{
+  // every task may return one packet of result, a large batch size is capped by the batch packet size
+  const int64_t max_task_cnt = das::OB_DAS_MAX_BATCH_PACKET_SIZE / das::OB_DAS_MAX_PACKET_SIZE;
+  ObDASTabletLoc loc;
+  ObTxReadSnapshot snapshot;
+  loc.server_ = svr1_;
+  for (int64_t i = 0; i < max_task_cnt + 1; ++i) {
+    ASSERT_EQ(OB_SUCCESS, add_task(i, loc, snapshot, 100, 1024));
+  }
+  ASSERT_EQ(2, batches_.count());
+  ASSERT_EQ(max_task_cnt, batches_.at(0)->task_ops_.count());
+  ASSERT_EQ(1, batches_.at(1)->task_ops_.count());
+}
+
+TEST_F(TestDASRemoteTaskBatch, split_by_request_size)
+{
+  const int64_t big_task_size = das::OB_DAS_MAX_BATCH_PACKET_SIZE / 2;
+  ObDASTabletLoc loc;
+  ObTxReadSnapshot snapshot;
+  loc.server_ = svr1_;
+  ASSERT_EQ(OB_SUCCESS, add_task(0, loc, snapshot, big_task_size, 16));
+  ASSERT_EQ(OB_SUCCESS, add_task(1, loc, snapshot, big_task_size, 16));
+  ASSERT_EQ(OB_SUCCESS, add_task(2, loc, snapshot, 1, 16));
+  // a task larger than the limit still goes out, alone in its batch
+  ASSERT_EQ(OB_SUCCESS, add_task(3, loc, snapshot, das::OB_DAS_MAX_BATCH_PACKET_SIZE + 1, 16));
+  ASSERT_EQ(OB_SUCCESS, add_task(4, loc, snapshot, 1, 16));
+  ASSERT_EQ(3, batches_.count());
+  ASSERT_EQ(2, batches_.at(0)->task_ops_.count());
+  ASSERT_EQ(das::OB_DAS_MAX_BATCH_PACKET_SIZE, batches_.at(0)->task_size_);
+  // the later small task joins the last batch with room left
+  ASSERT_EQ(2, batches_.at(1)->task_ops_.count());
+  ASSERT_EQ(ops_[2], batches_.at(1)->task_ops_.at(0));
+  ASSERT_EQ(ops_[4], batches_.at(1)->task_ops_.at(1));
+  ASSERT_EQ(1, batches_.at(2)->task_ops_.count());
+  ASSERT_EQ(ops_[3], batches_.at(2)->task_ops_.at(0));
+  ASSERT_FALSE(batches_.at(2)->can_add_task(1, 16));
+}
+
+TEST_F(TestDASRemoteTaskBatch, merge_op_has_more)
+{
+  MockDASTaskResult results[3];
+  ObDASTaskResp single_resp;
+  ASSERT_EQ(OB_SUCCESS, single_resp.add_op_result(&results[0]));
+  // single task response without per op flags falls back to has_more_
+  single_resp.set_has_more(true);
+  ASSERT_TRUE(single_resp.op_has_more(0));
+
+  ObDASTaskResp batch_resp;
+  for (int64_t i = 0; i < 3; ++i) {
+    ASSERT_EQ(OB_SUCCESS, batch_resp.add_op_result(&results[i]));
+  }
+  ASSERT_EQ(OB_INVALID_ARGUMENT, batch_resp.set_op_has_more(3, true));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, batch_resp.set_op_has_more(-1, true));
+  ASSERT_EQ(OB_SUCCESS, batch_resp.set_op_has_more(0, false));
+  ASSERT_FALSE(batch_resp.has_more_);
+  ASSERT_EQ(OB_SUCCESS, batch_resp.set_op_has_more(1, true));
+  ASSERT_EQ(OB_SUCCESS, batch_resp.set_op_has_more(2, false));
+  ASSERT_EQ(3, batch_resp.op_has_more_.count());
+  ASSERT_FALSE(batch_resp.op_has_more(0));
+  ASSERT_TRUE(batch_resp.op_has_more(1));
+  ASSERT_FALSE(batch_resp.op_has_more(2));
+  // the response has more as long as any of its ops has
+  ASSERT_TRUE(batch_resp.has_more_);
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
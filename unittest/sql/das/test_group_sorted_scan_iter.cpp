@@ -0,0 +1,122 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "sql/das/ob_group_scan_iter.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class TestGroupSortedScanIter : public ::testing::Test
+{
+public:
+  static const int64_t MAX_RANGE_CNT = 16;
+  virtual void SetUp() override
+  {
+    // sort_ranges and the output replay do not touch the exprs or the storage iterator
+    iter_.inited_ = true;
+  }
+protected:
+  void build_ranges(const int64_t *keys, const int64_t cnt, ObIArray<ObNewRange> &ranges)
+  {
+    for (int64_t i = 0; i < cnt; ++i) {
+      ObNewRange range;
+      objs_[i].set_int(keys[i]);
+      ASSERT_EQ(OB_SUCCESS, range.build_range(1, ObRowkey(&objs_[i], 1)));
+      range.group_idx_ = i;
+      ASSERT_EQ(OB_SUCCESS, ranges.push_back(range));
+    }
+  }
+  ObGroupSortedScanIter iter_;
+  ObObj objs_[MAX_RANGE_CNT];
+};
+
+TEST_F(TestGroupSortedScanIter, sorted_unique_ranges_pass_through)
+{
+  const int64_t keys[] = {1, 3, 5, 7};
+  ObSEArray<ObNewRange, 16> ranges;
+  build_ranges(keys, ARRAYSIZEOF(keys), ranges);
+  ASSERT_EQ(OB_SUCCESS, iter_.sort_ranges(ranges, false));
+  ASSERT_FALSE(iter_.is_sorted());
+  ASSERT_EQ(ARRAYSIZEOF(keys), ranges.count());
+  for (int64_t i = 0; i < ranges.count(); ++i) {
+    ASSERT_EQ(i, ranges.at(i).get_group_idx());
+    ASSERT_EQ(keys[i], ranges.at(i).get_start_key().get_obj_ptr()[0].get_int());
+  }
+
+  // the same ranges of a reverse scan are out of order
+  ASSERT_EQ(OB_SUCCESS, iter_.sort_ranges(ranges, true));
+  ASSERT_TRUE(iter_.is_sorted());
+  ASSERT_EQ(7, ranges.at(0).get_start_key().get_obj_ptr()[0].get_int());
+  ASSERT_EQ(1, ranges.at(3).get_start_key().get_obj_ptr()[0].get_int());
+}
+
+TEST_F(TestGroupSortedScanIter, sort_and_dedup_ranges)
+{
+  const int64_t keys[] = {5, 3, 5, 1, 3};
+  ObSEArray<ObNewRange, 16> ranges;
+  build_ranges(keys, ARRAYSIZEOF(keys), ranges);
+  ASSERT_EQ(OB_SUCCESS, iter_.sort_ranges(ranges, false));
+  ASSERT_TRUE(iter_.is_sorted());
+  // ranges sent to storage are sorted and unique, labelled by their unique index
+  ASSERT_EQ(3, ranges.count());
+  for (int64_t i = 0; i < ranges.count(); ++i) {
+    ASSERT_EQ(i * 2 + 1, ranges.at(i).get_start_key().get_obj_ptr()[0].get_int());
+    ASSERT_EQ(i, ranges.at(i).get_group_idx());
+  }
+  // every original range keeps its group and points to its unique range
+  const int64_t expect_uniq_idx[] = {2, 1, 2, 0, 1};
+  ASSERT_EQ(ARRAYSIZEOF(keys), iter_.out_ranges_.count());
+  for (int64_t i = 0; i < iter_.out_ranges_.count(); ++i) {
+    ASSERT_EQ(i, iter_.out_ranges_.at(i).group_idx_);
+    ASSERT_EQ(expect_uniq_idx[i], iter_.out_ranges_.at(i).uniq_idx_);
+  }
+  ASSERT_EQ(3, iter_.uniq_spans_.count());
+}
+
+TEST_F(TestGroupSortedScanIter, output_in_group_order)
+{
+  const int64_t keys[] = {5, 3, 5, 1, 3, 9};
+  ObSEArray<ObNewRange, 16> ranges;
+  build_ranges(keys, ARRAYSIZEOF(keys), ranges);
+  ASSERT_EQ(OB_SUCCESS, iter_.sort_ranges(ranges, false));
+  ASSERT_EQ(4, ranges.count());
+  // storage output in sorted range order: key 1 -> rows 0, 1; key 3 -> row 2;
+  // key 5 -> rows 3, 4; key 9 -> no row
+  iter_.uniq_spans_.at(0).begin_ = 0;
+  iter_.uniq_spans_.at(0).count_ = 2;
+  iter_.uniq_spans_.at(1).begin_ = 2;
+  iter_.uniq_spans_.at(1).count_ = 1;
+  iter_.uniq_spans_.at(2).begin_ = 3;
+  iter_.uniq_spans_.at(2).count_ = 2;
+  iter_.is_loaded_ = true;
+
+  // replayed in the original range order, duplicated ranges output their rows again
+  const int64_t expect_row_ids[] = {3, 4, 2, 3, 4, 0, 1, 2};
+  const int64_t expect_groups[] = {0, 0, 1, 2, 2, 3, 3, 4};
+  int64_t row_id = 0;
+  int64_t group_idx = 0;
+  for (int64_t i = 0; i < ARRAYSIZEOF(expect_row_ids); ++i) {
+    ASSERT_EQ(OB_SUCCESS, iter_.next_output_row(row_id, group_idx));
+    ASSERT_EQ(expect_row_ids[i], row_id);
+    ASSERT_EQ(expect_groups[i], group_idx);
+  }
+  ASSERT_EQ(OB_ITER_END, iter_.next_output_row(row_id, group_idx));
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,210 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "lib/allocator/page_arena.h"
+#include "sql/dtl/ob_dtl_columnar_codec.h"
+#include "sql/dtl/ob_dtl_rpc_proxy.h"
+#include "sql/dtl/ob_dtl_basic_channel.h"
+#include "sql/engine/basic/ob_chunk_datum_store.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+using namespace oceanbase::sql::dtl;
+
+static const int64_t BUF_SIZE = 64 * 1024;
+static const int64_t COL_CNT = 3;
+
+// response of the servers before the columnar format
+struct OldDtlRpcDataResponse
+{
+  OB_UNIS_VERSION(1);
+public:
+  OldDtlRpcDataResponse() : is_block_(false), recode_(OB_SUCCESS) {}
+  bool is_block_;
+  int recode_;
+};
+OB_SERIALIZE_MEMBER(OldDtlRpcDataResponse, is_block_, recode_);
+
+// rows of (bigint, nullable varchar, int), as the datum msg writer builds them
+static int64_t fill_rows(char *buf, const int64_t row_cnt)
+{
+  ObChunkDatumStore::Block *block = nullptr;
+  EXPECT_EQ(OB_SUCCESS, ObChunkDatumStore::init_block_buffer(buf, BUF_SIZE, block));
+  int64_t offset = sizeof(ObChunkDatumStore::Block);
+  char str[64];
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    ObChunkDatumStore::StoredRow *sr = reinterpret_cast<ObChunkDatumStore::StoredRow *>(buf + offset);
+    char *row = buf + offset;
+    int64_t pos = sizeof(ObChunkDatumStore::StoredRow) + sizeof(ObDatum) * COL_CNT;
+    int64_t bigint_val = i * 1000;
+    int32_t int_val = static_cast<int32_t>(i % 7);
+    ObDatum src[COL_CNT];
+    src[0].set_string(reinterpret_cast<const char *>(&bigint_val), sizeof(bigint_val));
+    if (0 == i % 5) {
+      src[1].set_null();
+    } else {
+      snprintf(str, sizeof(str), "value_%ld", i);
+      src[1].set_string(str, static_cast<int32_t>(strlen(str)));
+    }
+    src[2].set_string(reinterpret_cast<const char *>(&int_val), sizeof(int_val));
+    sr->cnt_ = COL_CNT;
+    for (int64_t j = 0; j < COL_CNT; ++j) {
+      ObDatum *datum = new (&sr->cells()[j]) ObDatum();
+      EXPECT_EQ(OB_SUCCESS, ObChunkDatumStore::deep_copy_unswizzling(
+          src[j], datum, row, BUF_SIZE - offset, pos));
+    }
+    sr->row_size_ = static_cast<uint32_t>(pos);
+    offset += pos;
+    block->rows_++;
+  }
+  return offset;
+}
+
+// compare datum by datum, the paddings of ObDatum are not encoded
+static void check_rows(const char *expect, const char *actual, const int64_t pos)
+{
+  typedef ObChunkDatumStore::StoredRow StoredRow;
+  ASSERT_EQ(0, MEMCMP(expect, actual, sizeof(ObChunkDatumStore::Block)));
+  int64_t offset = sizeof(ObChunkDatumStore::Block);
+  while (offset < pos) {
+    const StoredRow *l = reinterpret_cast<const StoredRow *>(expect + offset);
+    const StoredRow *r = reinterpret_cast<const StoredRow *>(actual + offset);
+    ASSERT_EQ(l->cnt_, r->cnt_);
+    ASSERT_EQ(l->row_size_, r->row_size_);
+    for (int64_t j = 0; j < l->cnt_; ++j) {
+      ASSERT_EQ(l->cells()[j].pack_, r->cells()[j].pack_);
+      if (!l->cells()[j].is_null()) {
+        ASSERT_EQ(l->cells()[j].ptr_, r->cells()[j].ptr_);
+      }
+    }
+    const int64_t data_offset = sizeof(StoredRow) + sizeof(ObDatum) * l->cnt_;
+    ASSERT_EQ(0, MEMCMP(expect + offset + data_offset, actual + offset + data_offset,
+                        l->row_size_ - data_offset));
+    offset += l->row_size_;
+  }
+  ASSERT_EQ(pos, offset);
+}
+
+static void init_buffer(ObDtlLinkedBuffer &buffer, char *buf, const int64_t pos)
+{
+  buffer.set_buf(buf);
+  buffer.set_size(BUF_SIZE);
+  buffer.set_pos(pos);
+  buffer.set_data_msg(true);
+  buffer.set_msg_type(PX_DATUM_ROW);
+  buffer.tenant_id() = OB_SERVER_TENANT_ID;
+}
+
+TEST(TestDtlColumnarCodec, encode_decode)
+{
+  const ObCompressorType types[] = { NONE_COMPRESSOR, LZ4_COMPRESSOR, ZSTD_1_3_8_COMPRESSOR };
+  char *raw = static_cast<char *>(ob_malloc(BUF_SIZE, ObNewModIds::TEST));
+  ASSERT_TRUE(NULL != raw);
+  MEMSET(raw, 0, BUF_SIZE);
+  const int64_t pos = fill_rows(raw, 500);
+  for (int64_t i = 0; i < ARRAYSIZEOF(types); ++i) {
+    ObDtlColumnarCodec codec;
+    ObDtlLinkedBuffer src;
+    ObDtlLinkedBuffer dst;
+    init_buffer(src, raw, pos);
+    ASSERT_EQ(OB_SUCCESS, codec.encode(src, types[i], dst));
+    ASSERT_TRUE(ObDtlColumnarCodec::is_columnar(dst));
+    ASSERT_LT(dst.size(), pos);
+
+    ObArenaAllocator allocator;
+    ASSERT_EQ(OB_SUCCESS, ObDtlColumnarCodec::decode(dst, allocator));
+    ASSERT_FALSE(ObDtlColumnarCodec::is_columnar(dst));
+    ASSERT_EQ(BUF_SIZE, dst.size());
+    ASSERT_EQ(pos, dst.pos());
+    check_rows(raw, dst.buf(), pos);
+  }
+  ob_free(raw);
+}
+
+TEST(TestDtlColumnarCodec, not_supported)
+{
+  ObDtlColumnarCodec codec;
+  char *raw = static_cast<char *>(ob_malloc(BUF_SIZE, ObNewModIds::TEST));
+  ASSERT_TRUE(NULL != raw);
+  MEMSET(raw, 0, BUF_SIZE);
+  const int64_t pos = fill_rows(raw, 100);
+  ObDtlLinkedBuffer src;
+  ObDtlLinkedBuffer dst;
+
+  // control message
+  init_buffer(src, raw, pos);
+  src.set_data_msg(false);
+  ASSERT_EQ(OB_NOT_SUPPORTED, codec.encode(src, LZ4_COMPRESSOR, dst));
+
+  // empty block
+  init_buffer(src, raw, sizeof(ObChunkDatumStore::Block));
+  ASSERT_EQ(OB_NOT_SUPPORTED, codec.encode(src, LZ4_COMPRESSOR, dst));
+
+  // rows not built by unswizzling
+  init_buffer(src, raw, pos);
+  ObChunkDatumStore::StoredRow *sr = reinterpret_cast<ObChunkDatumStore::StoredRow *>(
+      raw + sizeof(ObChunkDatumStore::Block));
+  sr->cells()[0].ptr_ = reinterpret_cast<const char *>(1);
+  ASSERT_EQ(OB_NOT_SUPPORTED, codec.encode(src, LZ4_COMPRESSOR, dst));
+  ob_free(raw);
+}
+
+TEST(TestDtlColumnarCodec, negotiate_with_response)
+{
+  char buf[256];
+  int64_t pos = 0;
+  int64_t len = 0;
+
+  // a server before the columnar format never reports it
+  OldDtlRpcDataResponse old_resp;
+  old_resp.is_block_ = true;
+  ASSERT_EQ(OB_SUCCESS, old_resp.serialize(buf, sizeof(buf), pos));
+  len = pos;
+  pos = 0;
+  ObDtlRpcDataResponse resp;
+  ASSERT_EQ(OB_SUCCESS, resp.deserialize(buf, len, pos));
+  ASSERT_TRUE(resp.is_block_);
+  ASSERT_FALSE(resp.columnar_supported_);
+
+  // a server with it reports it, and an old one ignores it
+  ObDtlRpcDataResponse new_resp;
+  new_resp.columnar_supported_ = true;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, new_resp.serialize(buf, sizeof(buf), pos));
+  len = pos;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, resp.deserialize(buf, len, pos));
+  ASSERT_TRUE(resp.columnar_supported_);
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, old_resp.deserialize(buf, len, pos));
+  ASSERT_EQ(len, pos);
+
+  // the channel keeps the capability across messages
+  SendMsgResponse msg_response;
+  ASSERT_EQ(OB_SUCCESS, msg_response.init());
+  ASSERT_FALSE(msg_response.is_columnar_supported());
+  ASSERT_EQ(OB_SUCCESS, msg_response.start());
+  msg_response.set_columnar_supported();
+  ASSERT_EQ(OB_SUCCESS, msg_response.on_finish(false, OB_SUCCESS));
+  ASSERT_EQ(OB_SUCCESS, msg_response.wait());
+  ASSERT_EQ(OB_SUCCESS, msg_response.start());
+  ASSERT_TRUE(msg_response.is_columnar_supported());
+  ASSERT_EQ(OB_SUCCESS, msg_response.on_finish(false, OB_SUCCESS));
+  ASSERT_EQ(OB_SUCCESS, msg_response.wait());
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
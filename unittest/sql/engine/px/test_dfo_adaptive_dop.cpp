@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_EXE
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "sql/engine/px/ob_dfo_scheduler.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class ObDfoAdaptiveDopTest : public ::testing::Test
+{
+public:
+  const static int64_t TEST_SQC_COUNT = 3;
+  const static int64_t ROWS_PER_WORKER = 100;
+
+  ObDfoAdaptiveDopTest()
+    : allocator_(),
+      input_dfo_(allocator_),
+      child_(allocator_)
+  {}
+  virtual ~ObDfoAdaptiveDopTest() = default;
+  virtual void SetUp()
+  {
+    for (int64_t i = 0; i < TEST_SQC_COUNT; ++i) {
+      ObPxSqcMeta sqc;
+      sqc.set_sqc_id(i);
+      ASSERT_EQ(OB_SUCCESS, input_dfo_.add_sqc(sqc));
+    }
+    ASSERT_EQ(OB_SUCCESS, child_.append_child_dfo(&input_dfo_));
+    child_.set_assigned_worker_count(16);
+  }
+  virtual void TearDown() {};
+
+  void finish_sqc(int64_t idx, int64_t output_rows)
+  {
+    ObPxSqcMeta *sqc = NULL;
+    ASSERT_EQ(OB_SUCCESS, input_dfo_.get_sqc(idx, sqc));
+    sqc->set_thread_finish(true);
+    sqc->set_output_rows(output_rows);
+  }
+protected:
+  ObArenaAllocator allocator_;
+  ObDfo input_dfo_;
+  ObDfo child_;
+};
+
+TEST_F(ObDfoAdaptiveDopTest, all_reported)
+{
+  finish_sqc(0, 150);
+  finish_sqc(1, 0);
+  finish_sqc(2, 120);
+  input_dfo_.set_thread_finish(true);
+  int64_t dop = 0;
+  ASSERT_EQ(OB_SUCCESS, ObParallelDfoScheduler::calc_adaptive_dop(child_, ROWS_PER_WORKER, dop));
+  ASSERT_EQ(3, dop);
+}
+
+TEST_F(ObDfoAdaptiveDopTest, empty_input)
+{
+  for (int64_t i = 0; i < TEST_SQC_COUNT; ++i) {
+    finish_sqc(i, 0);
+  }
+  input_dfo_.set_thread_finish(true);
+  int64_t dop = 0;
+  ASSERT_EQ(OB_SUCCESS, ObParallelDfoScheduler::calc_adaptive_dop(child_, ROWS_PER_WORKER, dop));
+  ASSERT_EQ(1, dop);
+}
+
+TEST_F(ObDfoAdaptiveDopTest, partial_report)
+{
+  int64_t dop = 0;
+  // input dfo is still running
+  finish_sqc(0, 150);
+  ASSERT_EQ(OB_SUCCESS, ObParallelDfoScheduler::calc_adaptive_dop(child_, ROWS_PER_WORKER, dop));
+  ASSERT_EQ(0, dop);
+
+  // the dfo is finished, but sqc 1 ended without reporting its rows, e.g. a mocked finish msg
+  finish_sqc(1, -1);
+  finish_sqc(2, 120);
+  input_dfo_.set_thread_finish(true);
+  ASSERT_EQ(OB_SUCCESS, ObParallelDfoScheduler::calc_adaptive_dop(child_, ROWS_PER_WORKER, dop));
+  ASSERT_EQ(0, dop);
+
+  // a sqc never sent the finish msg
+  ObPxSqcMeta *sqc = NULL;
+  ASSERT_EQ(OB_SUCCESS, input_dfo_.get_sqc(1, sqc));
+  sqc->set_thread_finish(false);
+  sqc->set_output_rows(0);
+  ASSERT_EQ(OB_SUCCESS, ObParallelDfoScheduler::calc_adaptive_dop(child_, ROWS_PER_WORKER, dop));
+  ASSERT_EQ(0, dop);
+
+  finish_sqc(1, 30);
+  ASSERT_EQ(OB_SUCCESS, ObParallelDfoScheduler::calc_adaptive_dop(child_, ROWS_PER_WORKER, dop));
+  ASSERT_EQ(3, dop);
+}
+
+TEST_F(ObDfoAdaptiveDopTest, finish_msg_default)
+{
+  // a finish msg from a server that does not count rows leaves the default
+  ObPxFinishSqcResultMsg msg;
+  ASSERT_EQ(-1, msg.sqc_output_rows_);
+  msg.sqc_output_rows_ = 10;
+  msg.reset();
+  ASSERT_EQ(-1, msg.sqc_output_rows_);
+  ObPxSqcMeta sqc;
+  ASSERT_EQ(-1, sqc.get_output_rows());
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_dfo_adaptive_dop.log*");
+  OB_LOGGER.set_file_name("test_dfo_adaptive_dop.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
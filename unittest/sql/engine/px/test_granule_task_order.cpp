@@ -0,0 +1,126 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_EXE
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+
+#include "sql/engine/px/ob_granule_pump.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class ObGranuleTaskOrderTest : public ::testing::Test
+{
+public:
+  const static int64_t TEST_PARTITION_COUNT = 5;
+  const static int64_t TEST_RANGE_COUNT = 2;
+
+  ObGranuleTaskOrderTest() = default;
+  virtual ~ObGranuleTaskOrderTest() = default;
+  virtual void SetUp() {};
+  virtual void TearDown() {};
+};
+
+TEST_F(ObGranuleTaskOrderTest, largest_first)
+{
+  ObDASTabletLoc tablet_locs[TEST_PARTITION_COUNT];
+  ObSEArray<ObDASTabletLoc *, 8> tablets;
+  ObSEArray<ObDASTabletLoc *, 16> taskset_tablets;
+  ObSEArray<ObNewRange, 16> taskset_ranges;
+  ObSEArray<int64_t, 16> taskset_idxs;
+  ObSEArray<int64_t, 8> sizes;
+  // partition 3 is the largest one, 1 and 4 have the same size
+  const int64_t partition_sizes[TEST_PARTITION_COUNT] = { 10, 30, 5, 1000, 30 };
+  const int64_t expect_order[TEST_PARTITION_COUNT] = { 3, 1, 4, 0, 2 };
+  for (int64_t i = 0; i < TEST_PARTITION_COUNT; ++i) {
+    tablet_locs[i].tablet_id_ = ObTabletID(200001 + i);
+    ASSERT_EQ(OB_SUCCESS, tablets.push_back(&tablet_locs[i]));
+    ASSERT_EQ(OB_SUCCESS, sizes.push_back(partition_sizes[i]));
+    for (int64_t j = 0; j < TEST_RANGE_COUNT; ++j) {
+      ObNewRange range;
+      range.set_whole_range();
+      ASSERT_EQ(OB_SUCCESS, taskset_tablets.push_back(&tablet_locs[i]));
+      ASSERT_EQ(OB_SUCCESS, taskset_ranges.push_back(range));
+      ASSERT_EQ(OB_SUCCESS, taskset_idxs.push_back(i));
+    }
+  }
+  ObGITaskSet task_set;
+  ASSERT_EQ(OB_SUCCESS, task_set.construct_taskset(taskset_tablets, taskset_ranges, taskset_idxs,
+                                                   ObGITaskSet::GI_RANDOM_NONE));
+  ASSERT_EQ(OB_SUCCESS, task_set.set_largest_first_order(tablets, sizes));
+
+  // the ranges of a partition are still fetched in one task
+  for (int64_t i = 0; i < TEST_PARTITION_COUNT; ++i) {
+    ObGranuleTaskInfo info;
+    ASSERT_EQ(OB_SUCCESS, task_set.get_next_gi_task(info));
+    ASSERT_EQ(&tablet_locs[expect_order[i]], info.tablet_loc_);
+    ASSERT_EQ(TEST_RANGE_COUNT, info.ranges_.count());
+  }
+  ObGranuleTaskInfo info;
+  ASSERT_EQ(OB_ITER_END, task_set.get_next_gi_task(info));
+
+  // sizes do not match the tablets
+  sizes.pop_back();
+  ASSERT_EQ(OB_INVALID_ARGUMENT, task_set.set_largest_first_order(tablets, sizes));
+}
+
+TEST_F(ObGranuleTaskOrderTest, largest_first_keep_hash_value)
+{
+  ObDASTabletLoc tablet_locs[TEST_PARTITION_COUNT];
+  ObSEArray<ObDASTabletLoc *, 8> tablets;
+  ObSEArray<ObDASTabletLoc *, 16> taskset_tablets;
+  ObSEArray<ObNewRange, 16> taskset_ranges;
+  ObSEArray<int64_t, 16> taskset_idxs;
+  ObSEArray<int64_t, 8> sizes;
+  const int64_t partition_sizes[TEST_PARTITION_COUNT] = { 7, 300, 20, 4000, 1 };
+  const int64_t expect_order[TEST_PARTITION_COUNT] = { 3, 1, 2, 0, 4 };
+  for (int64_t i = 0; i < TEST_PARTITION_COUNT; ++i) {
+    tablet_locs[i].tablet_id_ = ObTabletID(200001 + i);
+    ASSERT_EQ(OB_SUCCESS, tablets.push_back(&tablet_locs[i]));
+    ASSERT_EQ(OB_SUCCESS, sizes.push_back(partition_sizes[i]));
+    for (int64_t j = 0; j < TEST_RANGE_COUNT; ++j) {
+      ObNewRange range;
+      range.set_whole_range();
+      ASSERT_EQ(OB_SUCCESS, taskset_tablets.push_back(&tablet_locs[i]));
+      ASSERT_EQ(OB_SUCCESS, taskset_ranges.push_back(range));
+      ASSERT_EQ(OB_SUCCESS, taskset_idxs.push_back(i));
+    }
+  }
+  ObGITaskSet task_set;
+  ASSERT_EQ(OB_SUCCESS, task_set.construct_taskset(taskset_tablets, taskset_ranges, taskset_idxs,
+                                                   ObGITaskSet::GI_RANDOM_TASK));
+  uint64_t hash_values[TEST_PARTITION_COUNT];
+  for (int64_t i = 0; i < task_set.gi_task_set_.count(); ++i) {
+    const ObGITaskSet::ObGITaskInfo &task = task_set.gi_task_set_.at(i);
+    ASSERT_EQ(0, task.partition_size_);
+    hash_values[task.idx_] = task.hash_value_;
+  }
+  ASSERT_EQ(OB_SUCCESS, task_set.set_largest_first_order(tablets, sizes));
+
+  // the sizes are kept aside, the random hash of the tasks is not overwritten
+  ASSERT_EQ(TEST_PARTITION_COUNT * TEST_RANGE_COUNT, task_set.gi_task_set_.count());
+  for (int64_t i = 0; i < task_set.gi_task_set_.count(); ++i) {
+    const ObGITaskSet::ObGITaskInfo &task = task_set.gi_task_set_.at(i);
+    ASSERT_EQ(expect_order[i / TEST_RANGE_COUNT], task.idx_);
+    ASSERT_EQ(partition_sizes[task.idx_], task.partition_size_);
+    ASSERT_EQ(hash_values[task.idx_], task.hash_value_);
+  }
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
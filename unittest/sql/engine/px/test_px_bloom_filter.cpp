@@ -0,0 +1,193 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_EXE
+#include <gtest/gtest.h>
+
+#include "lib/allocator/page_arena.h"
+#include "lib/hash_func/murmur_hash.h"
+#include "lib/time/ob_time_utility.h"
+#include "sql/engine/px/ob_px_bloom_filter.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class ObPxBloomFilterTest : public ::testing::Test
+{
+public:
+  const static int64_t BATCH_SIZE = 256;
+
+  ObPxBloomFilterTest() : allocator_("TestPxBF"), skip_(NULL) {}
+  virtual ~ObPxBloomFilterTest() = default;
+  virtual void SetUp()
+  {
+    void *mem = allocator_.alloc(ObBitVector::memory_size(BATCH_SIZE));
+    ASSERT_TRUE(NULL != mem);
+    skip_ = to_bit_vector(mem);
+    skip_->init(BATCH_SIZE);
+  }
+  virtual void TearDown() {};
+  static uint64_t hash(const int64_t v)
+  {
+    return murmurhash64A(&v, sizeof(v), 0);
+  }
+protected:
+  ObArenaAllocator allocator_;
+  ObBitVector *skip_;
+};
+
+TEST_F(ObPxBloomFilterTest, batch_equals_row)
+{
+  const int64_t rows = 100000;
+  ObPxBloomFilter row_filter;
+  ObPxBloomFilter batch_filter;
+  ASSERT_EQ(OB_SUCCESS, row_filter.init(rows, allocator_));
+  ASSERT_EQ(OB_SUCCESS, batch_filter.init(rows, allocator_));
+  uint64_t hash_values[BATCH_SIZE];
+  // 插入偶数, 每个 batch 中下标为 3 的倍数的行被跳过
+  for (int64_t begin = 0; begin < rows; begin += BATCH_SIZE) {
+    skip_->init(BATCH_SIZE);
+    for (int64_t i = 0; i < BATCH_SIZE; ++i) {
+      hash_values[i] = hash((begin + i) * 2);
+      if (0 == i % 3) {
+        skip_->set(i);
+      } else {
+        ASSERT_EQ(OB_SUCCESS, row_filter.put(hash_values[i]));
+      }
+    }
+    ASSERT_EQ(OB_SUCCESS, batch_filter.put_batch(hash_values, *skip_, BATCH_SIZE));
+  }
+  ASSERT_EQ(0, MEMCMP(row_filter.get_bits_array(), batch_filter.get_bits_array(),
+                      row_filter.get_bits_array_length() * sizeof(int64_t)));
+
+  int64_t match_cnt = 0;
+  int64_t skip_visit_cnt = 0;
+  for (int64_t begin = 0; begin < rows * 2; begin += BATCH_SIZE) {
+    skip_->init(BATCH_SIZE);
+    for (int64_t i = 0; i < BATCH_SIZE; ++i) {
+      hash_values[i] = hash(begin + i);
+      if (0 == i % 5) {
+        skip_->set(i);
+      }
+    }
+    ASSERT_EQ(OB_SUCCESS, batch_filter.might_contain_batch(hash_values, *skip_, BATCH_SIZE,
+      [&](int64_t idx, bool is_match) {
+        bool expect = false;
+        int ret = row_filter.might_contain(hash_values[idx], expect);
+        EXPECT_EQ(expect, is_match);
+        skip_visit_cnt += skip_->at(idx) ? 1 : 0;
+        match_cnt += is_match ? 1 : 0;
+        return ret;
+      }));
+  }
+  ASSERT_EQ(0, skip_visit_cnt);
+  ASSERT_LT(0, match_cnt);
+}
+
+TEST_F(ObPxBloomFilterTest, large_filter_batch_equals_row)
+{
+  // 大于 LLC 的 filter, 批量探测走预取流水线, 每行结果须与逐行探测一致
+  const int64_t rows = 8L * 1024 * 1024;
+  const int64_t probe_rows = 1024L * 1024;
+  ObPxBloomFilter filter;
+  ASSERT_EQ(OB_SUCCESS, filter.init(rows, allocator_));
+  uint64_t hash_values[BATCH_SIZE];
+  skip_->init(BATCH_SIZE);
+  for (int64_t begin = 0; begin < rows; begin += BATCH_SIZE) {
+    for (int64_t i = 0; i < BATCH_SIZE; ++i) {
+      hash_values[i] = hash(begin * 2 + i);
+    }
+    ASSERT_EQ(OB_SUCCESS, filter.put_batch(hash_values, *skip_, BATCH_SIZE));
+  }
+
+  int64_t match_cnt = 0;
+  int64_t visit_cnt = 0;
+  for (int64_t begin = 0; begin < probe_rows; begin += BATCH_SIZE) {
+    skip_->init(BATCH_SIZE);
+    for (int64_t i = 0; i < BATCH_SIZE; ++i) {
+      hash_values[i] = hash(begin * 3 + i);
+      if (0 == i % 7) {
+        skip_->set(i);
+      }
+    }
+    ASSERT_EQ(OB_SUCCESS, filter.might_contain_batch(hash_values, *skip_, BATCH_SIZE,
+      [&](int64_t idx, bool is_match) {
+        bool expect = false;
+        int ret = filter.might_contain(hash_values[idx], expect);
+        EXPECT_EQ(expect, is_match);
+        EXPECT_FALSE(skip_->at(idx));
+        ++visit_cnt;
+        match_cnt += is_match ? 1 : 0;
+        return ret;
+      }));
+  }
+  ASSERT_EQ(probe_rows - probe_rows / BATCH_SIZE * ((BATCH_SIZE + 6) / 7), visit_cnt);
+  ASSERT_LT(0, match_cnt);
+}
+
+// 仅用于手工对比耗时: --gtest_also_run_disabled_tests
+TEST_F(ObPxBloomFilterTest, DISABLED_probe_perf)
+{
+  // 大于 LLC 的 filter, 比较逐行探测和流水线批量探测的耗时
+  const int64_t rows = 8L * 1024 * 1024;
+  const int64_t probe_rows = 32L * 1024 * 1024;
+  ObPxBloomFilter filter;
+  ASSERT_EQ(OB_SUCCESS, filter.init(rows, allocator_));
+  uint64_t hash_values[BATCH_SIZE];
+  skip_->init(BATCH_SIZE);
+  for (int64_t begin = 0; begin < rows; begin += BATCH_SIZE) {
+    for (int64_t i = 0; i < BATCH_SIZE; ++i) {
+      hash_values[i] = hash(begin + i);
+    }
+    ASSERT_EQ(OB_SUCCESS, filter.put_batch(hash_values, *skip_, BATCH_SIZE));
+  }
+
+  int64_t row_match = 0;
+  int64_t begin_time = ObTimeUtil::current_time();
+  for (int64_t begin = 0; begin < probe_rows; begin += BATCH_SIZE) {
+    for (int64_t i = 0; i < BATCH_SIZE; ++i) {
+      hash_values[i] = hash(begin + i);
+    }
+    for (int64_t i = 0; i < BATCH_SIZE; ++i) {
+      bool is_match = false;
+      ASSERT_EQ(OB_SUCCESS, filter.might_contain(hash_values[i], is_match));
+      row_match += is_match ? 1 : 0;
+    }
+  }
+  int64_t row_time = ObTimeUtil::current_time() - begin_time;
+
+  int64_t batch_match = 0;
+  begin_time = ObTimeUtil::current_time();
+  for (int64_t begin = 0; begin < probe_rows; begin += BATCH_SIZE) {
+    for (int64_t i = 0; i < BATCH_SIZE; ++i) {
+      hash_values[i] = hash(begin + i);
+    }
+    ASSERT_EQ(OB_SUCCESS, filter.might_contain_batch(hash_values, *skip_, BATCH_SIZE,
+      [&](int64_t idx, bool is_match) {
+        UNUSED(idx);
+        batch_match += is_match ? 1 : 0;
+        return OB_SUCCESS;
+      }));
+  }
+  int64_t batch_time = ObTimeUtil::current_time() - begin_time;
+  ASSERT_EQ(row_match, batch_match);
+  LOG_INFO("px bloom filter probe time", K(rows), K(probe_rows),
+           "bits_array_len", filter.get_bits_array_length(),
+           K(row_time), K(batch_time), K(row_match));
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,145 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL_EXE
+#include <gtest/gtest.h>
+
+#include "lib/allocator/page_arena.h"
+#include "sql/engine/px/ob_px_bloom_filter.h"
+
+using namespace oceanbase;
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class ObPxRuntimeFilterTest : public ::testing::Test
+{
+public:
+  const static int64_t TEST_DATA_LENGTH = 1000;
+
+  ObPxRuntimeFilterTest() : allocator_("TestRtFilter") {}
+  virtual ~ObPxRuntimeFilterTest() = default;
+  virtual void SetUp() {};
+  virtual void TearDown() {};
+  void init_filter(ObPxBloomFilter &filter)
+  {
+    ASSERT_EQ(OB_SUCCESS, filter.init(TEST_DATA_LENGTH, allocator_));
+    ASSERT_EQ(OB_SUCCESS, filter.init_in_list(allocator_));
+    // key 0 有符号, key 1 无符号
+    filter.init_range(0x3, 0x2);
+  }
+protected:
+  ObArenaAllocator allocator_;
+};
+
+TEST_F(ObPxRuntimeFilterTest, range_and_in_list)
+{
+  ObPxBloomFilter filter;
+  init_filter(filter);
+  ASSERT_TRUE(filter.has_range(0));
+  ASSERT_TRUE(filter.has_range(1));
+  ASSERT_FALSE(filter.has_range(2));
+  ASSERT_TRUE(filter.is_range_unsigned(1));
+  // 空 range 不包含任何值
+  ASSERT_FALSE(filter.range_might_contain(0, 0));
+  ASSERT_FALSE(filter.range_might_contain(1, 0));
+
+  for (int64_t i = -100; i <= 100; ++i) {
+    ASSERT_EQ(OB_SUCCESS, filter.put(static_cast<uint64_t>(i) * 7919));
+    filter.update_range(0, i);
+    filter.update_range(1, i + 100);
+  }
+  ASSERT_TRUE(filter.is_in_list_valid());
+  for (int64_t i = -100; i <= 100; ++i) {
+    ASSERT_TRUE(filter.in_list_contain(static_cast<uint64_t>(i) * 7919));
+  }
+  ASSERT_FALSE(filter.in_list_contain(7919 * 101));
+  ASSERT_TRUE(filter.range_might_contain(0, -100));
+  ASSERT_TRUE(filter.range_might_contain(0, 100));
+  ASSERT_FALSE(filter.range_might_contain(0, -101));
+  ASSERT_FALSE(filter.range_might_contain(0, 101));
+  ASSERT_TRUE(filter.range_might_contain(1, 0));
+  ASSERT_TRUE(filter.range_might_contain(1, 200));
+  ASSERT_FALSE(filter.range_might_contain(1, 201));
+  // 按无符号比较, -1 是最大值
+  ASSERT_FALSE(filter.range_might_contain(1, -1));
+
+  filter.reset_filter();
+  ASSERT_TRUE(filter.is_in_list_valid());
+  ASSERT_FALSE(filter.in_list_contain(0));
+  ASSERT_FALSE(filter.range_might_contain(0, 0));
+}
+
+TEST_F(ObPxRuntimeFilterTest, in_list_overflow)
+{
+  ObPxBloomFilter filter;
+  init_filter(filter);
+  for (int64_t i = 1; i <= ObPxBloomFilter::MAX_IN_LIST_COUNT; ++i) {
+    ASSERT_EQ(OB_SUCCESS, filter.put(i));
+    // 重复值不占用 in-list 空间
+    ASSERT_EQ(OB_SUCCESS, filter.put(i));
+  }
+  ASSERT_TRUE(filter.is_in_list_valid());
+  ASSERT_EQ(OB_SUCCESS, filter.put(ObPxBloomFilter::MAX_IN_LIST_COUNT + 1));
+  ASSERT_FALSE(filter.is_in_list_valid());
+  bool is_match = false;
+  ASSERT_EQ(OB_SUCCESS, filter.might_contain(ObPxBloomFilter::MAX_IN_LIST_COUNT + 1, is_match));
+  ASSERT_TRUE(is_match);
+}
+
+TEST_F(ObPxRuntimeFilterTest, merge_and_serialize)
+{
+  ObPxBloomFilter build;
+  ObPxBloomFilter probe;
+  init_filter(build);
+  init_filter(probe);
+  for (int64_t i = 10; i < 20; ++i) {
+    ASSERT_EQ(OB_SUCCESS, build.put(i));
+    build.update_range(0, i);
+    build.update_range(1, i);
+  }
+  build.set_begin_idx(0);
+  build.set_end_idx(build.get_bits_array_length() - 1);
+
+  char buf[64 * 1024];
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, build.serialize(buf, sizeof(buf), pos));
+  ASSERT_EQ(pos, build.get_serialize_size());
+  ObPxBloomFilter piece;
+  int64_t data_len = pos;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, piece.deserialize(buf, data_len, pos));
+  ASSERT_TRUE(piece.is_in_list_valid());
+
+  ASSERT_EQ(OB_SUCCESS, probe.merge_filter(&piece));
+  ASSERT_TRUE(probe.is_in_list_valid());
+  for (int64_t i = 10; i < 20; ++i) {
+    ASSERT_TRUE(probe.in_list_contain(i));
+  }
+  ASSERT_FALSE(probe.in_list_contain(20));
+  ASSERT_TRUE(probe.range_might_contain(0, 10));
+  ASSERT_TRUE(probe.range_might_contain(0, 19));
+  ASSERT_FALSE(probe.range_might_contain(0, 20));
+
+  // 不带 range 和 in-list 的 filter 合并后, 两者均失效
+  ObPxBloomFilter plain;
+  ASSERT_EQ(OB_SUCCESS, plain.init(TEST_DATA_LENGTH, allocator_));
+  ASSERT_EQ(OB_SUCCESS, probe.merge_filter(&plain));
+  ASSERT_FALSE(probe.is_in_list_valid());
+  ASSERT_FALSE(probe.has_range(0));
+  ASSERT_FALSE(probe.has_range(1));
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
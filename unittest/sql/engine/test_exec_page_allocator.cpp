@@ -0,0 +1,162 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <thread>
+#include "sql/engine/ob_exec_page_allocator.h"
+#include "lib/allocator/page_arena.h"
+
+using namespace oceanbase::common;
+using namespace oceanbase::sql;
+
+class TestExecPageAllocator : public ::testing::Test
+{
+public:
+  virtual void SetUp()
+  {
+    // as a worker of tenant OB_SERVER_TENANT_ID
+    ObExecPageAllocator::set_thread_tenant(OB_SERVER_TENANT_ID);
+    ObExecPageAllocator::set_enabled(true);
+  }
+  virtual void TearDown()
+  {
+    ObExecPageAllocator::set_thread_tenant(OB_INVALID_TENANT_ID);
+    ObExecPageAllocator::set_enabled(true);
+  }
+};
+
+TEST_F(TestExecPageAllocator, reuse_pages)
+{
+  ObExecPageAllocator &page_alloc = ObExecPageAllocator::get_instance();
+  ObMemAttr attr(OB_SERVER_TENANT_ID, "ExecPageTest");
+  void *page = page_alloc.alloc(OB_MALLOC_NORMAL_BLOCK_SIZE, attr);
+  ASSERT_NE(nullptr, page);
+  page_alloc.free(page);
+  EXPECT_EQ(OB_MALLOC_NORMAL_BLOCK_SIZE, ObExecPageAllocator::get_cached_size());
+  EXPECT_EQ(OB_MALLOC_NORMAL_BLOCK_SIZE, ObExecPageAllocator::get_total_cached_size());
+  EXPECT_EQ(page, page_alloc.alloc(OB_MALLOC_NORMAL_BLOCK_SIZE, attr));
+  EXPECT_EQ(0, ObExecPageAllocator::get_cached_size());
+  EXPECT_EQ(0, ObExecPageAllocator::get_total_cached_size());
+  page_alloc.free(page);
+
+  // big pages are not cached
+  void *big = page_alloc.alloc(OB_MALLOC_NORMAL_BLOCK_SIZE + 1, attr);
+  ASSERT_NE(nullptr, big);
+  page_alloc.free(big);
+  EXPECT_EQ(OB_MALLOC_NORMAL_BLOCK_SIZE, ObExecPageAllocator::get_cached_size());
+
+  // pages of another ctx flush the cache
+  ObMemAttr attr2(OB_SERVER_TENANT_ID, "ExecPageTest", ObCtxIds::WORK_AREA);
+  void *page2 = page_alloc.alloc(OB_MALLOC_NORMAL_BLOCK_SIZE, attr2);
+  ASSERT_NE(nullptr, page2);
+  EXPECT_EQ(0, ObExecPageAllocator::get_cached_size());
+  page_alloc.free(page2);
+  EXPECT_EQ(OB_MALLOC_NORMAL_BLOCK_SIZE, ObExecPageAllocator::get_cached_size());
+}
+
+TEST_F(TestExecPageAllocator, bounded)
+{
+  ObExecPageAllocator &page_alloc = ObExecPageAllocator::get_instance();
+  ObMemAttr attr(OB_SERVER_TENANT_ID, "ExecPageTest");
+  const int64_t cnt = ObExecPageAllocator::MAX_CACHED_NORMAL_PAGES * 2;
+  void *pages[cnt] = {};
+  for (int64_t i = 0; i < cnt; i++) {
+    ASSERT_NE(nullptr, pages[i] = page_alloc.alloc(OB_MALLOC_NORMAL_BLOCK_SIZE, attr));
+  }
+  for (int64_t i = 0; i < cnt; i++) {
+    page_alloc.free(pages[i]);
+  }
+  EXPECT_EQ(ObExecPageAllocator::MAX_CACHED_NORMAL_PAGES * OB_MALLOC_NORMAL_BLOCK_SIZE,
+            ObExecPageAllocator::get_cached_size());
+}
+
+TEST_F(TestExecPageAllocator, arena_reset)
+{
+  ObArenaAllocator arena(ObExecPageAllocator::get_instance(), OB_MALLOC_NORMAL_BLOCK_SIZE, true);
+  arena.set_label("ExecPageTest");
+  for (int64_t i = 0; i < 10; i++) {
+    ASSERT_NE(nullptr, arena.alloc(1024));
+  }
+  ASSERT_NE(nullptr, arena.alloc(OB_MALLOC_MIDDLE_BLOCK_SIZE * 2));
+  const int64_t pages = arena.total() / OB_MALLOC_NORMAL_BLOCK_SIZE;
+  EXPECT_EQ(0, ObExecPageAllocator::get_cached_size());
+  // all the normal pages go back to the worker in one step
+  arena.reset();
+  EXPECT_LE(2 * OB_MALLOC_NORMAL_BLOCK_SIZE, ObExecPageAllocator::get_cached_size());
+  EXPECT_GE(pages * OB_MALLOC_NORMAL_BLOCK_SIZE, ObExecPageAllocator::get_cached_size());
+}
+
+TEST_F(TestExecPageAllocator, other_tenant)
+{
+  ObExecPageAllocator &page_alloc = ObExecPageAllocator::get_instance();
+  // pages of another tenant, e.g. allocated under MTL_SWITCH
+  ob_get_tenant_id() = OB_SYS_TENANT_ID;
+  page_alloc.free(page_alloc.alloc(OB_MALLOC_NORMAL_BLOCK_SIZE, ObMemAttr(OB_SYS_TENANT_ID, "ExecPageTest")));
+  EXPECT_EQ(0, ObExecPageAllocator::get_cached_size());
+  ob_get_tenant_id() = OB_SERVER_TENANT_ID;
+
+  // the worker leaves its tenant
+  page_alloc.free(page_alloc.alloc(OB_MALLOC_NORMAL_BLOCK_SIZE, ObMemAttr(OB_SERVER_TENANT_ID, "ExecPageTest")));
+  EXPECT_EQ(OB_MALLOC_NORMAL_BLOCK_SIZE, ObExecPageAllocator::get_cached_size());
+  ObExecPageAllocator::set_thread_tenant(OB_INVALID_TENANT_ID);
+  EXPECT_EQ(0, ObExecPageAllocator::get_cached_size());
+  EXPECT_EQ(0, ObExecPageAllocator::get_total_cached_size());
+}
+
+TEST_F(TestExecPageAllocator, non_worker_thread)
+{
+  std::thread th([]() {
+    ob_get_tenant_id() = OB_SERVER_TENANT_ID;
+    ObExecPageAllocator &page_alloc = ObExecPageAllocator::get_instance();
+    page_alloc.free(page_alloc.alloc(OB_MALLOC_NORMAL_BLOCK_SIZE, ObMemAttr(OB_SERVER_TENANT_ID, "ExecPageTest")));
+    EXPECT_EQ(0, ObExecPageAllocator::get_cached_size());
+  });
+  th.join();
+  EXPECT_EQ(0, ObExecPageAllocator::get_total_cached_size());
+}
+
+TEST_F(TestExecPageAllocator, disabled)
+{
+  ObExecPageAllocator &page_alloc = ObExecPageAllocator::get_instance();
+  ObMemAttr attr(OB_SERVER_TENANT_ID, "ExecPageTest");
+  void *page = page_alloc.alloc(OB_MALLOC_NORMAL_BLOCK_SIZE, attr);
+  void *page2 = page_alloc.alloc(OB_MALLOC_NORMAL_BLOCK_SIZE, attr);
+  ASSERT_NE(nullptr, page);
+  ASSERT_NE(nullptr, page2);
+  page_alloc.free(page);
+  EXPECT_EQ(OB_MALLOC_NORMAL_BLOCK_SIZE, ObExecPageAllocator::get_cached_size());
+  // pages cached before are given back on next free
+  ObExecPageAllocator::set_enabled(false);
+  page_alloc.free(page2);
+  EXPECT_EQ(0, ObExecPageAllocator::get_cached_size());
+  EXPECT_EQ(0, ObExecPageAllocator::get_total_cached_size());
+}
+
+TEST_F(TestExecPageAllocator, thread_exit)
+{
+  std::thread th([]() {
+    ObExecPageAllocator::set_thread_tenant(OB_SERVER_TENANT_ID);
+    ObExecPageAllocator &page_alloc = ObExecPageAllocator::get_instance();
+    page_alloc.free(page_alloc.alloc(OB_MALLOC_MIDDLE_BLOCK_SIZE, ObMemAttr(OB_SERVER_TENANT_ID, "ExecPageTest")));
+    EXPECT_EQ(OB_MALLOC_MIDDLE_BLOCK_SIZE, ObExecPageAllocator::get_cached_size());
+    EXPECT_EQ(OB_MALLOC_MIDDLE_BLOCK_SIZE, ObExecPageAllocator::get_total_cached_size());
+  });
+  th.join();
+  EXPECT_EQ(0, ObExecPageAllocator::get_cached_size());
+  EXPECT_EQ(0, ObExecPageAllocator::get_total_cached_size());
+}
+
+int main(int argc, char **argv)
+{
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,225 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+
+#include "lib/allocator/page_arena.h"
+#include "lib/container/ob_se_array.h"
+#include "storage/blocksstable/ob_row_cache.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+
+namespace unittest
+{
+
+class TestRowCacheValue : public ::testing::Test
+{
+public:
+  TestRowCacheValue() : allocator_(ObModIds::TEST) {}
+  virtual ~TestRowCacheValue() {}
+  virtual void SetUp() {}
+  virtual void TearDown() { allocator_.reset(); }
+protected:
+  // projected row of cols_index, datum of column i holds i * 10, varchar for the odd columns
+  void prepare_row(const ObIArray<int32_t> &cols_index, ObDatumRow &row);
+  int copy_value(const ObRowCacheValue &value, ObRowCacheValue *&copied);
+  ObArenaAllocator allocator_;
+  char str_buf_[16][16];
+};
+
+void TestRowCacheValue::prepare_row(const ObIArray<int32_t> &cols_index, ObDatumRow &row)
+{
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, cols_index.count()));
+  row.count_ = cols_index.count();
+  row.row_flag_.set_flag(ObDmlFlag::DF_INSERT);
+  for (int64_t i = 0; i < cols_index.count(); ++i) {
+    const int32_t col_idx = cols_index.at(i);
+    if (col_idx % 2 == 0) {
+      row.storage_datums_[i].set_int(col_idx * 10);
+    } else {
+      const int len = snprintf(str_buf_[col_idx], sizeof(str_buf_[col_idx]), "col_%d", col_idx);
+      row.storage_datums_[i].set_string(str_buf_[col_idx], len);
+    }
+  }
+}
+
+int TestRowCacheValue::copy_value(const ObRowCacheValue &value, ObRowCacheValue *&copied)
+{
+  int ret = OB_SUCCESS;
+  ObIKVCacheValue *kv_value = nullptr;
+  const int64_t size = value.size();
+  char *buf = nullptr;
+  if (OB_ISNULL(buf = static_cast<char *>(allocator_.alloc(size)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+  } else if (OB_FAIL(value.deep_copy(buf, size, kv_value))) {
+  } else {
+    copied = static_cast<ObRowCacheValue *>(kv_value);
+  }
+  return ret;
+}
+
+TEST_F(TestRowCacheValue, get_datum_idx)
+{
+  const int64_t column_cnt = 130;
+  uint64_t bitmap[3] = {0, 0, 0};
+  ObRowCacheValue value;
+  // full row maps column index to itself
+  value.column_cnt_ = column_cnt;
+  for (int64_t i = 0; i < column_cnt; ++i) {
+    ASSERT_TRUE(value.has_column(i));
+    ASSERT_EQ(i, value.get_datum_idx(i));
+  }
+  ASSERT_FALSE(value.has_column(-1));
+  ASSERT_FALSE(value.has_column(column_cnt));
+
+  // columns on the word edges
+  const int64_t cols[] = {0, 5, 63, 64, 127, 128, 129};
+  for (int64_t i = 0; i < ARRAYSIZEOF(cols); ++i) {
+    bitmap[cols[i] >> 6] |= (1UL << (cols[i] & 63));
+  }
+  value.column_bitmap_ = bitmap;
+  ASSERT_TRUE(value.is_partial_row());
+  for (int64_t i = 0; i < ARRAYSIZEOF(cols); ++i) {
+    ASSERT_TRUE(value.has_column(cols[i]));
+    ASSERT_EQ(i, value.get_datum_idx(cols[i]));
+  }
+  ASSERT_FALSE(value.has_column(1));
+  ASSERT_FALSE(value.has_column(62));
+  ASSERT_FALSE(value.has_column(65));
+}
+
+TEST_F(TestRowCacheValue, init_partial)
+{
+  const int64_t column_cnt = 8;
+  ObSEArray<int32_t, 8> cols_index;
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, cols_index.push_back(5));
+  ASSERT_EQ(OB_SUCCESS, cols_index.push_back(2));
+  ASSERT_EQ(OB_SUCCESS, cols_index.push_back(9)); // new added column
+  prepare_row(cols_index, row);
+
+  ObRowCacheValue value;
+  ASSERT_EQ(OB_INVALID_ARGUMENT, value.init_partial(1, row, cols_index, 0));
+  ObSEArray<int32_t, 8> short_index;
+  ASSERT_EQ(OB_SUCCESS, short_index.push_back(5));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, value.init_partial(1, row, short_index, column_cnt));
+
+  ASSERT_EQ(OB_SUCCESS, value.init_partial(1, row, cols_index, column_cnt));
+  ASSERT_TRUE(value.is_valid());
+  ASSERT_FALSE(value.is_row_not_exist());
+  // the bitmap is only built on deep copy
+  ASSERT_FALSE(value.is_partial_row());
+  const int64_t expect_size = sizeof(uint64_t) + 2 * sizeof(ObStorageDatum)
+      + row.storage_datums_[0].get_deep_copy_size() + row.storage_datums_[1].get_deep_copy_size();
+  ASSERT_EQ(expect_size, value.size_);
+  ASSERT_EQ(sizeof(ObRowCacheValue) + expect_size, value.size());
+}
+
+TEST_F(TestRowCacheValue, deep_copy_partial)
+{
+  const int64_t column_cnt = 8;
+  ObSEArray<int32_t, 8> cols_index;
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, cols_index.push_back(5));
+  ASSERT_EQ(OB_SUCCESS, cols_index.push_back(0));
+  ASSERT_EQ(OB_SUCCESS, cols_index.push_back(2));
+  ASSERT_EQ(OB_SUCCESS, cols_index.push_back(9)); // new added column
+  prepare_row(cols_index, row);
+
+  ObRowCacheValue value;
+  ObRowCacheValue *copied = nullptr;
+  ASSERT_EQ(OB_SUCCESS, value.init_partial(100, row, cols_index, column_cnt));
+  ASSERT_EQ(OB_SUCCESS, copy_value(value, copied));
+  ASSERT_TRUE(nullptr != copied);
+  ASSERT_TRUE(copied->is_partial_row());
+  ASSERT_EQ(100, copied->get_start_log_ts());
+  ASSERT_EQ(column_cnt, copied->get_column_cnt());
+  ASSERT_TRUE(copied->get_flag().is_insert());
+  // datums are in ascending column order
+  ASSERT_EQ(0, copied->get_datum_idx(0));
+  ASSERT_EQ(1, copied->get_datum_idx(2));
+  ASSERT_EQ(2, copied->get_datum_idx(5));
+  ASSERT_EQ(0, copied->get_datums()[copied->get_datum_idx(0)].get_int());
+  ASSERT_EQ(20, copied->get_datums()[copied->get_datum_idx(2)].get_int());
+  ASSERT_EQ(0, copied->get_datums()[copied->get_datum_idx(5)].get_string().compare("col_5"));
+  // the copy does not point to the source row
+  ASSERT_NE(row.storage_datums_[0].ptr_, copied->get_datums()[copied->get_datum_idx(5)].ptr_);
+  for (int64_t i = 0; i < column_cnt; ++i) {
+    ASSERT_EQ(0 == i || 2 == i || 5 == i, copied->has_column(i));
+  }
+
+  ObSEArray<int32_t, 8> request;
+  ASSERT_EQ(OB_SUCCESS, request.push_back(2));
+  ASSERT_EQ(OB_SUCCESS, request.push_back(10)); // new added column is always covered
+  ASSERT_TRUE(copied->contain_columns(request));
+  ASSERT_EQ(OB_SUCCESS, request.push_back(3));
+  ASSERT_FALSE(copied->contain_columns(request));
+}
+
+TEST_F(TestRowCacheValue, not_exist_row)
+{
+  ObRowCacheValue value;
+  ObRowCacheValue *copied = nullptr;
+  value.init_not_exist(100);
+  ASSERT_TRUE(value.is_valid());
+  ASSERT_EQ(OB_SUCCESS, copy_value(value, copied));
+  ASSERT_TRUE(copied->is_row_not_exist());
+  ASSERT_TRUE(copied->get_flag().is_not_exist());
+  ASSERT_EQ(100, copied->get_start_log_ts());
+  ASSERT_FALSE(copied->is_partial_row());
+
+  ObSEArray<int32_t, 8> request;
+  ASSERT_EQ(OB_SUCCESS, request.push_back(3));
+  ASSERT_EQ(OB_SUCCESS, request.push_back(7));
+  ASSERT_TRUE(copied->contain_columns(request));
+}
+
+TEST_F(TestRowCacheValue, deep_copy_without_datums)
+{
+  ObSEArray<int32_t, 8> cols_index;
+  ObDatumRow row;
+  ObRowCacheValue value;
+  ObRowCacheValue *copied = nullptr;
+  ASSERT_EQ(OB_SUCCESS, cols_index.push_back(0));
+  ASSERT_EQ(OB_SUCCESS, cols_index.push_back(1));
+  prepare_row(cols_index, row);
+  row.row_flag_.set_flag(ObDmlFlag::DF_DELETE);
+  ASSERT_EQ(OB_SUCCESS, value.init(200, row));
+  value.block_id_.set_block_index(7);
+  value.set_row_not_exist();
+  ASSERT_TRUE(value.is_valid());
+  ASSERT_EQ(OB_SUCCESS, copy_value(value, copied));
+  // the copy keeps the meta of the value even if it holds no datum
+  ASSERT_EQ(nullptr, copied->get_datums());
+  ASSERT_TRUE(copied->is_row_not_exist());
+  ASSERT_EQ(200, copied->get_start_log_ts());
+  ASSERT_TRUE(copied->get_flag().is_delete());
+  ASSERT_EQ(value.get_block_id(), copied->get_block_id());
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_row_cache_value.log*");
+  OB_LOGGER.set_file_name("test_row_cache_value.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
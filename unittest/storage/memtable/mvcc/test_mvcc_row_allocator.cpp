@@ -0,0 +1,97 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "storage/memtable/mvcc/ob_mvcc_row_allocator.h"
+
+#include "../utils_mod_allocator.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace oceanbase
+{
+namespace unittest
+{
+using namespace oceanbase::common;
+using namespace oceanbase::memtable;
+
+TEST(TestObMvccRowAllocator, alloc_row)
+{
+  ObModAllocator allocator;
+  ObMvccRowAllocator row_allocator;
+  EXPECT_EQ(nullptr, row_allocator.alloc_row());
+  row_allocator.init(&allocator);
+  // rows of a small memtable are allocated one by one
+  const int64_t direct_size = ObMvccRowAllocator::DIRECT_ROW_COUNT * sizeof(ObMvccRow);
+  for (int64_t i = 0; i < ObMvccRowAllocator::DIRECT_ROW_COUNT; ++i) {
+    ASSERT_NE(nullptr, row_allocator.alloc_row());
+    EXPECT_EQ((i + 1) * (int64_t)sizeof(ObMvccRow), row_allocator.get_allocated());
+  }
+  void *row1 = row_allocator.alloc_row();
+  void *row2 = row_allocator.alloc_row();
+  ASSERT_NE(nullptr, row1);
+  ASSERT_NE(nullptr, row2);
+  EXPECT_EQ(sizeof(ObMvccRow), (char *)row2 - (char *)row1);
+  const int64_t slab_size = ObMvccRowAllocator::SLAB_SIZE;
+  EXPECT_EQ(direct_size + slab_size, row_allocator.get_allocated());
+  row_allocator.reset();
+  EXPECT_EQ(0, row_allocator.get_allocated());
+}
+
+TEST(TestObMvccRowAllocator, concurrent_alloc)
+{
+  constexpr int64_t THREAD_COUNT = 16;
+  constexpr int64_t ROW_COUNT = 10000;
+  ObModAllocator allocator;
+  ObMvccRowAllocator row_allocator;
+  row_allocator.init(&allocator);
+  std::vector<void *> rows[THREAD_COUNT];
+  std::thread threads[THREAD_COUNT];
+  for (int64_t i = 0; i < THREAD_COUNT; ++i) {
+    threads[i] = std::thread([&, i]() {
+      for (int64_t j = 0; j < ROW_COUNT; ++j) {
+        void *row = row_allocator.alloc_row();
+        ASSERT_NE(nullptr, row);
+        memset(row, 0, sizeof(ObMvccRow));
+        rows[i].push_back(row);
+      }
+    });
+  }
+  for (int64_t i = 0; i < THREAD_COUNT; ++i) {
+    threads[i].join();
+  }
+  std::vector<void *> all_rows;
+  for (int64_t i = 0; i < THREAD_COUNT; ++i) {
+    all_rows.insert(all_rows.end(), rows[i].begin(), rows[i].end());
+  }
+  std::sort(all_rows.begin(), all_rows.end());
+  for (int64_t i = 1; i < (int64_t)all_rows.size(); ++i) {
+    // no row is handed out twice
+    ASSERT_LE((char *)all_rows[i - 1] + sizeof(ObMvccRow), (char *)all_rows[i]);
+  }
+  const int64_t direct_size = ObMvccRowAllocator::DIRECT_ROW_COUNT * sizeof(ObMvccRow);
+  EXPECT_EQ(0, (row_allocator.get_allocated() - direct_size) % ObMvccRowAllocator::SLAB_SIZE);
+  EXPECT_LE(THREAD_COUNT * ROW_COUNT * (int64_t)sizeof(ObMvccRow), row_allocator.get_allocated());
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_file_name("test_mvcc_row_allocator.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,133 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "storage/access/ob_index_tree_prefetcher.h"
+#include "storage/access/ob_table_access_context.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace storage;
+using namespace blocksstable;
+
+namespace unittest
+{
+
+class TestIndexTreePrefetcher : public ::testing::Test
+{
+public:
+  typedef ObIndexTreeMultiPassPrefetcher Prefetcher;
+  TestIndexTreePrefetcher() : allocator_(ObModIds::TEST) {}
+  virtual void SetUp()
+  {
+    access_ctx_.stmt_allocator_ = &allocator_;
+    prefetcher_.access_ctx_ = &access_ctx_;
+    // same as init of a scan
+    prefetcher_.max_micro_handle_cnt_ = Prefetcher::DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
+    prefetcher_.max_prefetch_depth_ = Prefetcher::DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
+  }
+  virtual void TearDown()
+  {
+    prefetcher_.reset();
+  }
+  // consume a window of data blocks, each costs consume_time and waits io for io_wait_time
+  void consume_window(const int64_t consume_time, const int64_t io_wait_time)
+  {
+    for (int64_t i = 0; i < Prefetcher::ADAPTIVE_PREFETCH_WINDOW; i++) {
+      prefetcher_.adjust_prefetch_depth(now_, 0 < io_wait_time, io_wait_time);
+      now_ += consume_time + io_wait_time;
+    }
+  }
+protected:
+  ObArenaAllocator allocator_;
+  ObTableAccessContext access_ctx_;
+  Prefetcher prefetcher_;
+  int64_t now_ = 1000000;
+};
+
+TEST_F(TestIndexTreePrefetcher, shrink_on_cache_hit)
+{
+  consume_window(10, 0);
+  consume_window(10, 0);
+  EXPECT_EQ(Prefetcher::DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT / 2, prefetcher_.max_prefetch_depth_);
+  EXPECT_FALSE(prefetcher_.is_io_bound_);
+  for (int64_t i = 0; i < 8; i++) {
+    consume_window(10, 0);
+  }
+  EXPECT_EQ(Prefetcher::MIN_SCAN_PREFETCH_DEPTH, prefetcher_.max_prefetch_depth_);
+  EXPECT_EQ(0, prefetcher_.expected_micro_handle_cnt_);
+}
+
+TEST_F(TestIndexTreePrefetcher, grow_by_consumption_rate)
+{
+  // waits of 200us is hidden by 32 + 32 * 200 / 100 = 96 blocks in flight
+  consume_window(100, 200);
+  consume_window(100, 200);
+  EXPECT_EQ(96, prefetcher_.max_prefetch_depth_);
+  EXPECT_TRUE(prefetcher_.is_io_bound_);
+  EXPECT_EQ(96, prefetcher_.expected_micro_handle_cnt_);
+
+  // still waiting for io, grows up to the max ring size
+  consume_window(1, 200);
+  EXPECT_EQ(Prefetcher::MAX_SCAN_MICRO_DATA_HANDLE_CNT, prefetcher_.max_prefetch_depth_);
+  EXPECT_EQ(Prefetcher::MAX_SCAN_MICRO_DATA_HANDLE_CNT, prefetcher_.expected_micro_handle_cnt_);
+
+  // short io wait keeps the depth
+  consume_window(100, 50);
+  consume_window(100, 50);
+  EXPECT_EQ(Prefetcher::MAX_SCAN_MICRO_DATA_HANDLE_CNT, prefetcher_.max_prefetch_depth_);
+}
+
+TEST_F(TestIndexTreePrefetcher, expand_ring)
+{
+  const int64_t old_cnt = Prefetcher::DEFAULT_SCAN_MICRO_DATA_HANDLE_CNT;
+  // live entries wrap around the default ring
+  prefetcher_.cur_micro_data_fetch_idx_ = 20;
+  prefetcher_.micro_data_prefetch_idx_ = 50;
+  for (int64_t idx = 20; idx < 50; idx++) {
+    prefetcher_.micro_data_infos_[idx % old_cnt].nested_offset_ = idx;
+    prefetcher_.micro_data_handles_[idx % old_cnt].block_index_ = static_cast<int32_t>(idx);
+  }
+  consume_window(1, 200);
+  consume_window(1, 200);
+  ASSERT_EQ(Prefetcher::MAX_SCAN_MICRO_DATA_HANDLE_CNT, prefetcher_.expected_micro_handle_cnt_);
+  ASSERT_EQ(OB_SUCCESS, prefetcher_.expand_micro_data_ring());
+  const int64_t new_cnt = Prefetcher::MAX_SCAN_MICRO_DATA_HANDLE_CNT;
+  EXPECT_EQ(new_cnt, prefetcher_.max_micro_handle_cnt_);
+  EXPECT_EQ(0, prefetcher_.expected_micro_handle_cnt_);
+  EXPECT_NE(prefetcher_.default_micro_data_infos_, prefetcher_.micro_data_infos_);
+  EXPECT_NE(prefetcher_.default_micro_data_handles_, prefetcher_.micro_data_handles_);
+  for (int64_t idx = 20; idx < 50; idx++) {
+    EXPECT_EQ(idx, prefetcher_.micro_data_infos_[idx % new_cnt].nested_offset_);
+    EXPECT_EQ(idx, prefetcher_.micro_data_handles_[idx % new_cnt].block_index_);
+  }
+  EXPECT_EQ(20, prefetcher_.current_micro_handle().block_index_);
+
+  prefetcher_.reset();
+  EXPECT_EQ(prefetcher_.default_micro_data_infos_, prefetcher_.micro_data_infos_);
+  EXPECT_EQ(prefetcher_.default_micro_data_handles_, prefetcher_.micro_data_handles_);
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_index_tree_prefetcher.log*");
+  OB_LOGGER.set_file_name("test_index_tree_prefetcher.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -20,6 +20,7 @@
 #include "share/io/io_schedule/ob_io_mclock.h"
 #undef private
 #include "share/ob_local_device.h"
+#include "share/config/ob_server_config.h"
 #include "lib/thread/thread_pool.h"
 #include "lib/file/file_directory_utils.h"
 
@@ -540,6 +541,131 @@ TEST_F(TestIOStruct, MClockQueue)
   }
 }
 
+TEST_F(TestIOStruct, IOLatencyHistogram)
+{
+  ObIOLatencyHistogram histogram;
+  ASSERT_EQ(0, histogram.get_count());
+  ASSERT_EQ(0, histogram.get_percentile_us(0.5));
+
+  // bucket edges, bucket i counts [2^(i-1), 2^i) us
+  histogram.record(-1, false);
+  histogram.record(0, false);
+  ASSERT_EQ(2, histogram.buckets_[0]);
+  histogram.record(1, false);
+  ASSERT_EQ(1, histogram.buckets_[1]);
+  histogram.record(2, false);
+  histogram.record(3, false);
+  ASSERT_EQ(2, histogram.buckets_[2]);
+  histogram.record(4, false);
+  ASSERT_EQ(1, histogram.buckets_[3]);
+  histogram.record((1L << 22) - 1, false);
+  ASSERT_EQ(1, histogram.buckets_[22]);
+  histogram.record(1L << 22, false);
+  histogram.record(INT64_MAX, true);
+  ASSERT_EQ(2, histogram.buckets_[ObIOLatencyHistogram::BUCKET_CNT - 1]);
+  ASSERT_EQ(1, histogram.deadline_miss_count_);
+  ASSERT_EQ(10, histogram.get_count());
+
+  // percentile is the upper bound of the bucket of its nearest rank
+  histogram.reset();
+  ASSERT_EQ(0, histogram.get_count());
+  ASSERT_EQ(0, histogram.deadline_miss_count_);
+  for (int64_t i = 0; i < 90; ++i) {
+    histogram.record(100, false); // [64, 128)
+  }
+  for (int64_t i = 0; i < 9; ++i) {
+    histogram.record(1000, false); // [512, 1024)
+  }
+  histogram.record(10000, true); // [8192, 16384)
+  ASSERT_EQ(100, histogram.get_count());
+  ASSERT_EQ(128, histogram.get_percentile_us(0.01));
+  ASSERT_EQ(128, histogram.get_percentile_us(0.5));
+  ASSERT_EQ(128, histogram.get_percentile_us(0.9));
+  ASSERT_EQ(1024, histogram.get_percentile_us(0.91));
+  ASSERT_EQ(1024, histogram.get_percentile_us(0.99));
+  ASSERT_EQ(16384, histogram.get_percentile_us(0.999));
+  ASSERT_EQ(16384, histogram.get_percentile_us(1));
+
+  // diff only counts the requests since last histogram
+  ObIOLatencyHistogram last_histogram = histogram;
+  histogram.record(10000, true);
+  histogram.record(1, false);
+  ObIOLatencyHistogram diff_histogram;
+  diff_histogram.diff(histogram, last_histogram);
+  ASSERT_EQ(2, diff_histogram.get_count());
+  ASSERT_EQ(1, diff_histogram.buckets_[1]);
+  ASSERT_EQ(1, diff_histogram.buckets_[14]);
+  ASSERT_EQ(1, diff_histogram.deadline_miss_count_);
+  ASSERT_EQ(1, diff_histogram.get_percentile_us(0.5));
+  ASSERT_EQ(16384, diff_histogram.get_percentile_us(0.99));
+}
+
+TEST_F(TestIOStruct, MClockDeadlineOrder)
+{
+  ASSERT_EQ(ObIOLatencyClass::USER_GET, get_io_latency_class(ObIOCategory::USER_IO, ObIOMode::READ, 16L * 1024L));
+  ASSERT_EQ(ObIOLatencyClass::USER_SCAN, get_io_latency_class(ObIOCategory::USER_IO, ObIOMode::READ, 16L * 1024L + 1));
+  ASSERT_EQ(ObIOLatencyClass::USER_SCAN, get_io_latency_class(ObIOCategory::USER_IO, ObIOMode::WRITE, 4096));
+  ASSERT_EQ(ObIOLatencyClass::BACKGROUND, get_io_latency_class(ObIOCategory::SYS_IO, ObIOMode::READ, 4096));
+
+  ObMClockQueue mqueue;
+  ASSERT_SUCC(mqueue.init());
+  const int64_t enqueue_ts = ObTimeUtility::current_time();
+  ObIORequest get_req;
+  get_req.io_info_.flag_.set_mode(ObIOMode::READ);
+  get_req.io_info_.flag_.set_category(ObIOCategory::USER_IO);
+  get_req.io_info_.size_ = 4096;
+  get_req.time_log_.enqueue_ts_ = enqueue_ts;
+  ObIORequest sys_req;
+  sys_req.io_info_.flag_.set_mode(ObIOMode::READ);
+  sys_req.io_info_.flag_.set_category(ObIOCategory::SYS_IO);
+  sys_req.io_info_.size_ = 2L * 1024L * 1024L;
+  sys_req.time_log_.enqueue_ts_ = enqueue_ts;
+  ObPhyQueue get_queue;
+  ObPhyQueue sys_queue;
+  ASSERT_TRUE(get_queue.req_list_.add_last(&get_req));
+  ASSERT_TRUE(sys_queue.req_list_.add_last(&sys_req));
+  get_queue.update_deadline();
+  sys_queue.update_deadline();
+  const int64_t get_target_us = get_io_latency_target_us(ObIOLatencyClass::USER_GET);
+  ASSERT_EQ(enqueue_ts + get_target_us, get_queue.deadline_ts_);
+  ASSERT_EQ(enqueue_ts + get_target_us / 2, get_queue.urgent_ts_);
+  ASSERT_EQ(enqueue_ts + get_io_latency_target_us(ObIOLatencyClass::BACKGROUND), sys_queue.deadline_ts_);
+
+  // sys queue has the min proportion, get queue has the earliest deadline
+  sys_queue.proportion_ts_ = enqueue_ts;
+  get_queue.proportion_ts_ = enqueue_ts + 1;
+  ASSERT_SUCC(mqueue.push_ready_heap(&sys_queue));
+  ASSERT_SUCC(mqueue.push_ready_heap(&get_queue));
+
+  const bool old_enable = GCONF._enable_io_deadline_schedule;
+  GCONF._enable_io_deadline_schedule.set_value("False");
+  ASSERT_EQ(&sys_queue, mqueue.choose_ready_queue(get_queue.urgent_ts_));
+  GCONF._enable_io_deadline_schedule.set_value("True");
+  // not urgent yet, keep the min proportion
+  ASSERT_EQ(&sys_queue, mqueue.choose_ready_queue(get_queue.urgent_ts_ - 1));
+  // urgent queue goes first once half of its target is elapsed
+  ASSERT_EQ(&get_queue, mqueue.choose_ready_queue(get_queue.urgent_ts_));
+  ASSERT_EQ(&get_queue, mqueue.choose_ready_queue(get_queue.deadline_ts_ + 1));
+  // an empty queue is never picked by deadline
+  get_queue.req_list_.remove_first();
+  ASSERT_EQ(&sys_queue, mqueue.choose_ready_queue(get_queue.deadline_ts_ + 1));
+  ASSERT_TRUE(get_queue.req_list_.add_last(&get_req));
+  // the queue with min proportion is also the most urgent one
+  get_queue.proportion_ts_ = enqueue_ts - 1;
+  ASSERT_SUCC(mqueue.ready_heap_.remove(&get_queue));
+  ASSERT_SUCC(mqueue.ready_heap_.push(&get_queue));
+  ASSERT_EQ(&get_queue, mqueue.choose_ready_queue(get_queue.urgent_ts_ - 1));
+  ASSERT_EQ(&get_queue, mqueue.choose_ready_queue(get_queue.urgent_ts_));
+  GCONF._enable_io_deadline_schedule.set_value(old_enable ? "True" : "False");
+
+  ASSERT_SUCC(mqueue.ready_heap_.remove(&get_queue));
+  ASSERT_SUCC(mqueue.deadline_heap_.remove(&get_queue));
+  ASSERT_SUCC(mqueue.ready_heap_.remove(&sys_queue));
+  ASSERT_SUCC(mqueue.deadline_heap_.remove(&sys_queue));
+  get_queue.req_list_.remove_first();
+  sys_queue.req_list_.remove_first();
+}
+
 TEST_F(TestIOStruct, IOCallbackManager)
 {
   // test init
@@ -0,0 +1,137 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "storage/compaction/ob_partition_merge_iter.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace storage;
+using namespace blocksstable;
+using namespace compaction;
+using namespace share::schema;
+
+namespace unittest
+{
+
+class TestMicroBlockReuse : public ::testing::Test
+{
+public:
+  static const int64_t OLD_SCHEMA_VERSION = 100;
+  static const int64_t NEW_SCHEMA_VERSION = 200;
+  static const int64_t COLUMN_CNT = 4;
+  virtual void SetUp()
+  {
+    for (int64_t i = 0; i < COLUMN_CNT; ++i) {
+      ObColDesc col;
+      col.col_id_ = OB_APP_MIN_COLUMN_ID + i;
+      col.col_type_.set_int();
+      ASSERT_EQ(OB_SUCCESS, column_ids_.push_back(col));
+    }
+    iter_.schema_version_ = NEW_SCHEMA_VERSION;
+    iter_.row_store_type_ = ENCODING_ROW_STORE;
+    iter_.column_ids_ = &column_ids_;
+    iter_.compressor_type_ = ObCompressorType::ZSTD_1_3_8_COMPRESSOR;
+    iter_.encrypt_id_ = 0;
+    iter_.master_key_id_ = 0;
+
+    // meta of a macro block written by the old schema version
+    meta_val_.column_count_ = COLUMN_CNT;
+    meta_val_.compressor_type_ = ObCompressorType::ZSTD_1_3_8_COMPRESSOR;
+    meta_val_.encrypt_id_ = 0;
+    meta_val_.master_key_id_ = 0;
+    MEMSET(meta_val_.encrypt_key_, 0, sizeof(meta_val_.encrypt_key_));
+  }
+  virtual void TearDown()
+  {
+    iter_.column_ids_ = nullptr;
+  }
+protected:
+  ObSEArray<ObColDesc, COLUMN_CNT> column_ids_;
+  ObDataBlockMetaVal meta_val_;
+  ObPartitionMicroMergeIter iter_;
+};
+
+TEST_F(TestMicroBlockReuse, same_layout)
+{
+  ASSERT_TRUE(iter_.can_reuse_older_micro_block(meta_val_));
+}
+
+TEST_F(TestMicroBlockReuse, column_count_changed)
+{
+  meta_val_.column_count_ = COLUMN_CNT - 1;
+  ASSERT_FALSE(iter_.can_reuse_older_micro_block(meta_val_));
+}
+
+TEST_F(TestMicroBlockReuse, compressor_changed)
+{
+  // alter table set compression between the two schema versions, the old blocks are rewritten
+  meta_val_.compressor_type_ = ObCompressorType::LZ4_COMPRESSOR;
+  ASSERT_FALSE(iter_.can_reuse_older_micro_block(meta_val_));
+  meta_val_.compressor_type_ = ObCompressorType::NONE_COMPRESSOR;
+  ASSERT_FALSE(iter_.can_reuse_older_micro_block(meta_val_));
+  meta_val_.compressor_type_ = iter_.compressor_type_;
+  ASSERT_TRUE(iter_.can_reuse_older_micro_block(meta_val_));
+}
+
+TEST_F(TestMicroBlockReuse, encryption_changed)
+{
+  meta_val_.encrypt_id_ = 1;
+  ASSERT_FALSE(iter_.can_reuse_older_micro_block(meta_val_));
+  meta_val_.encrypt_id_ = 0;
+  meta_val_.master_key_id_ = 1;
+  ASSERT_FALSE(iter_.can_reuse_older_micro_block(meta_val_));
+  meta_val_.master_key_id_ = 0;
+  meta_val_.encrypt_key_[0] = 'k';
+  ASSERT_FALSE(iter_.can_reuse_older_micro_block(meta_val_));
+}
+
+TEST_F(TestMicroBlockReuse, check_need_reuse)
+{
+  // same schema version keeps reusing
+  iter_.curr_block_desc_.schema_version_ = NEW_SCHEMA_VERSION;
+  iter_.curr_block_desc_.row_store_type_ = ENCODING_ROW_STORE;
+  iter_.check_need_reuse_micro_block();
+  ASSERT_TRUE(iter_.need_reuse_micro_block_);
+
+  // row store type changed
+  iter_.curr_block_desc_.row_store_type_ = FLAT_ROW_STORE;
+  iter_.check_need_reuse_micro_block();
+  ASSERT_FALSE(iter_.need_reuse_micro_block_);
+
+  // older schema version without macro meta is rewritten
+  iter_.curr_block_desc_.schema_version_ = OLD_SCHEMA_VERSION;
+  iter_.curr_block_desc_.row_store_type_ = ENCODING_ROW_STORE;
+  iter_.curr_block_desc_.macro_meta_ = nullptr;
+  iter_.check_need_reuse_micro_block();
+  ASSERT_FALSE(iter_.need_reuse_micro_block_);
+
+  // newer schema version
+  iter_.curr_block_desc_.schema_version_ = NEW_SCHEMA_VERSION + 1;
+  iter_.check_need_reuse_micro_block();
+  ASSERT_FALSE(iter_.need_reuse_micro_block_);
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_micro_block_reuse.log*");
+  OB_LOGGER.set_file_name("test_micro_block_reuse.log");
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}